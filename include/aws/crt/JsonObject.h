@@ -31,6 +31,13 @@ namespace Aws
              */
             JsonObject(const String &stringToParse);
 
+            /**
+             * Constructs a JSON DOM by parsing the input bytes directly, without first copying them into a String.
+             * The bytes only need to live through the duration of the call.
+             * Call WasParseSuccessful() on new object to determine if parse was successful.
+             */
+            explicit JsonObject(ByteCursor bytesToParse);
+
             /**
              * Construct a deep copy.
              * Prefer using a @ref JsonView if copying is not needed.
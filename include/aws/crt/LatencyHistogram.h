@@ -0,0 +1,105 @@
+#pragma once
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+#include <aws/crt/Exports.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace Aws
+{
+    namespace Crt
+    {
+        /**
+         * Fixed-size histogram of durations, in nanoseconds, with power-of-two bucket boundaries.
+         *
+         * Bucket 0 holds zero-length samples and bucket i (i > 0) holds samples in [2^(i-1), 2^i - 1] nanoseconds,
+         * which gives a relative error of at most 2x across the full range with no allocation.  This type is not
+         * thread-safe; owners are expected to synchronize access.
+         */
+        class AWS_CRT_CPP_API LatencyHistogram final
+        {
+          public:
+            static const size_t BUCKET_COUNT = 64;
+
+            LatencyHistogram() noexcept;
+
+            /**
+             * Adds a sample to the histogram.
+             *
+             * @param durationNs sample duration in nanoseconds
+             */
+            void Record(uint64_t durationNs) noexcept;
+
+            /**
+             * Adds all samples of another histogram to this one.
+             *
+             * @param other histogram to merge in
+             */
+            void Merge(const LatencyHistogram &other) noexcept;
+
+            /**
+             * Removes all samples.
+             */
+            void Reset() noexcept;
+
+            /**
+             * @return number of samples recorded
+             */
+            uint64_t GetSampleCount() const noexcept { return m_sampleCount; }
+
+            /**
+             * @return sum of all recorded durations, in nanoseconds
+             */
+            uint64_t GetTotalNs() const noexcept { return m_totalNs; }
+
+            /**
+             * @return smallest recorded duration, in nanoseconds, or 0 if empty
+             */
+            uint64_t GetMinNs() const noexcept { return m_sampleCount > 0 ? m_minNs : 0; }
+
+            /**
+             * @return largest recorded duration, in nanoseconds, or 0 if empty
+             */
+            uint64_t GetMaxNs() const noexcept { return m_maxNs; }
+
+            /**
+             * @return mean recorded duration, in nanoseconds, or 0 if empty
+             */
+            uint64_t GetMeanNs() const noexcept { return m_sampleCount > 0 ? m_totalNs / m_sampleCount : 0; }
+
+            /**
+             * Estimates a percentile from the bucket counts.  The result is the upper bound of the bucket the
+             * percentile falls in, clamped to the observed maximum.
+             *
+             * @param percentile value in [0, 100]
+             *
+             * @return estimated duration in nanoseconds, or 0 if empty
+             */
+            uint64_t GetPercentileNs(double percentile) const noexcept;
+
+            /**
+             * @param bucketIndex index in [0, BUCKET_COUNT)
+             *
+             * @return number of samples in the bucket
+             */
+            uint64_t GetBucketCount(size_t bucketIndex) const noexcept;
+
+            /**
+             * @param bucketIndex index in [0, BUCKET_COUNT)
+             *
+             * @return inclusive upper bound of the bucket, in nanoseconds
+             */
+            static uint64_t GetBucketUpperBoundNs(size_t bucketIndex) noexcept;
+
+          private:
+            uint64_t m_buckets[BUCKET_COUNT];
+            uint64_t m_sampleCount;
+            uint64_t m_totalNs;
+            uint64_t m_minNs;
+            uint64_t m_maxNs;
+        };
+    } // namespace Crt
+} // namespace Aws
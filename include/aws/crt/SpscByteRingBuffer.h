@@ -0,0 +1,97 @@
+#pragma once
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+#include <aws/crt/Types.h>
+
+#include <atomic>
+
+namespace Aws
+{
+    namespace Crt
+    {
+        /**
+         * Fixed-capacity byte FIFO for exactly one producer thread and one consumer thread.
+         *
+         * Write() and Read() never block and never allocate; each side only publishes its own position with a
+         * release store and reads the other side's with an acquire load, so no lock is needed.  Calling Write() from
+         * two threads at once, or Read() from two threads at once, is not supported.
+         */
+        class AWS_CRT_CPP_API SpscByteRingBuffer final
+        {
+          public:
+            /**
+             * @param capacity number of bytes the buffer can hold
+             * @param allocator allocator for the buffer's storage
+             */
+            SpscByteRingBuffer(size_t capacity, Allocator *allocator = ApiAllocator()) noexcept;
+            ~SpscByteRingBuffer();
+
+            SpscByteRingBuffer(const SpscByteRingBuffer &) = delete;
+            SpscByteRingBuffer(SpscByteRingBuffer &&) = delete;
+            SpscByteRingBuffer &operator=(const SpscByteRingBuffer &) = delete;
+            SpscByteRingBuffer &operator=(SpscByteRingBuffer &&) = delete;
+
+            /**
+             * @return true if the buffer's storage was allocated
+             */
+            explicit operator bool() const noexcept { return m_buffer != nullptr; }
+
+            /**
+             * @return number of bytes the buffer can hold
+             */
+            size_t GetCapacity() const noexcept { return m_capacity; }
+
+            /**
+             * @return number of bytes written but not yet read.  Exact when called from either side, as long as the
+             * other side is idle; otherwise a snapshot.
+             */
+            size_t GetSize() const noexcept;
+
+            /**
+             * @return number of bytes that can currently be written
+             */
+            size_t GetFreeSpace() const noexcept { return m_capacity - GetSize(); }
+
+            /**
+             * Producer side. Copies as much of data as fits.
+             *
+             * @param data bytes to append
+             * @return number of bytes copied
+             */
+            size_t Write(ByteCursor data) noexcept;
+
+            /**
+             * Consumer side. Moves as many bytes as are available, up to the spare capacity of dest, to the end of
+             * dest.
+             *
+             * @param dest buffer to append to
+             * @return number of bytes moved
+             */
+            size_t Read(ByteBuf &dest) noexcept;
+
+            /**
+             * Consumer side. Gets the next byte without consuming it.
+             *
+             * @param out set to the next byte, if there is one
+             * @return false if the buffer is empty
+             */
+            bool Peek(uint8_t &out) const noexcept;
+
+            /**
+             * Discards all buffered bytes. Only valid while neither side is in use.
+             */
+            void Reset() noexcept;
+
+          private:
+            Allocator *m_allocator;
+            uint8_t *m_buffer;
+            size_t m_capacity;
+
+            /* Total bytes ever written and read; their difference is the buffered size */
+            std::atomic<uint64_t> m_writeCount;
+            std::atomic<uint64_t> m_readCount;
+        };
+    } // namespace Crt
+} // namespace Aws
@@ -234,6 +234,14 @@ namespace Aws
                  */
                 size_t GetRemainingLength() noexcept;
 
+                /**
+                 * Point the decoder at a new source, discarding any decoding state of the previous one.  Lets one
+                 * decoder be reused across many sources without reallocating it.
+                 *
+                 * @param src The src data to decode from.
+                 */
+                void ResetSource(ByteCursor src) noexcept;
+
                 /**
                  * Decode the next element and store it in the decoder cache if there was no element cached.
                  * If there was an element cached, just return the type of the cached element.
@@ -0,0 +1,154 @@
+#pragma once
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+#include <aws/crt/http/HttpConnection.h>
+
+#include <atomic>
+#include <future>
+
+struct aws_http2_stream_manager;
+
+namespace Aws
+{
+    namespace Crt
+    {
+        namespace Http
+        {
+            /**
+             * Invoked when a stream has been acquired from an Http2StreamManager. On success, `stream` is already
+             * activated and errorCode is AWS_ERROR_SUCCESS. On failure, `stream` is null and errorCode contains the
+             * cause; no other callback of the request will be invoked.
+             */
+            using OnStreamAcquired = std::function<void(std::shared_ptr<HttpClientStream> stream, int errorCode)>;
+
+            /**
+             * Configuration for an Http2StreamManager
+             */
+            class AWS_CRT_CPP_API Http2StreamManagerOptions
+            {
+              public:
+                Http2StreamManagerOptions() noexcept;
+                Http2StreamManagerOptions(const Http2StreamManagerOptions &rhs) = default;
+                Http2StreamManagerOptions(Http2StreamManagerOptions &&rhs) = default;
+
+                Http2StreamManagerOptions &operator=(const Http2StreamManagerOptions &rhs) = default;
+                Http2StreamManagerOptions &operator=(Http2StreamManagerOptions &&rhs) = default;
+
+                /**
+                 * The http connection options to use for each connection created by the manager.  The connection
+                 * setup and shutdown callbacks are not used.  Unless Http2PriorKnowledge is set, TlsOptions are
+                 * required and must negotiate "h2" through ALPN.
+                 */
+                HttpClientConnectionOptions ConnectionOptions;
+
+                /**
+                 * The maximum number of connections the manager is allowed to create
+                 */
+                size_t MaxConnections;
+
+                /**
+                 * The maximum number of streams multiplexed over a single connection.  The manager also respects the
+                 * server's SETTINGS_MAX_CONCURRENT_STREAMS, whichever is lower.  0 means no limit beyond the server's.
+                 */
+                size_t MaxConcurrentStreamsPerConnection;
+
+                /**
+                 * The number of concurrent streams per connection the manager aims for.  Once every connection
+                 * carries this many streams, a new connection is opened (up to MaxConnections) rather than piling
+                 * more streams onto existing ones.  0 means streams are packed up to MaxConcurrentStreamsPerConnection.
+                 */
+                size_t IdealConcurrentStreamsPerConnection;
+
+                /**
+                 * Connect with HTTP/2 over cleartext without upgrade negotiation.  Only valid without TlsOptions.
+                 */
+                bool Http2PriorKnowledge;
+
+                /**
+                 * If non-zero, a PING is sent on each connection at this period and the connection is closed if the
+                 * PING is not acknowledged within ConnectionPingTimeoutMs.
+                 */
+                size_t ConnectionPingPeriodMs;
+
+                /**
+                 * Time to wait for a PING acknowledgement before closing the connection.  Only used when
+                 * ConnectionPingPeriodMs is set.
+                 */
+                size_t ConnectionPingTimeoutMs;
+
+                /**
+                 * If set, a connection is closed once a stream on it completes with a 5xx response, so that new
+                 * streams are routed to a fresh connection.
+                 */
+                bool CloseConnectionOnServerError;
+
+                /**
+                 * If set, InitiateShutdown() returns a future that completes once the manager has released all of its
+                 * resources.  See HttpClientConnectionManagerOptions::EnableBlockingShutdown.
+                 */
+                bool EnableBlockingShutdown;
+            };
+
+            /**
+             * Multiplexes HTTP/2 streams to a single endpoint over a small pool of connections.
+             */
+            class AWS_CRT_CPP_API Http2StreamManager final : public std::enable_shared_from_this<Http2StreamManager>
+            {
+              public:
+                ~Http2StreamManager();
+
+                /**
+                 * Acquires a stream for the request.  The manager picks a connection with spare concurrency, opening
+                 * one if needed, makes the request on it and activates the stream.  onStreamAcquired is invoked with
+                 * the activated stream, after which the callbacks of requestOptions are invoked as for any other
+                 * HttpClientStream.
+                 *
+                 * requestOptions.request must stay valid until the stream completes or the acquisition fails.
+                 *
+                 * @param requestOptions request and stream callbacks. UseManualDataWrites is not supported.
+                 * @param onStreamAcquired callback invoked once the stream is activated or the acquisition fails
+                 * @return true if the acquisition was queued, false otherwise (no callback)
+                 */
+                bool AcquireStream(
+                    const HttpRequestOptions &requestOptions,
+                    const OnStreamAcquired &onStreamAcquired) noexcept;
+
+                /**
+                 * Starts shutdown of the stream manager.  Returns a future that, if EnableBlockingShutdown was set,
+                 * completes once all streams and connections have been released.
+                 *
+                 * @return future which will complete when shutdown has completed
+                 */
+                std::future<void> InitiateShutdown() noexcept;
+
+                /**
+                 * Factory function for stream managers
+                 *
+                 * @param streamManagerOptions stream manager configuration data
+                 * @param allocator allocator to use
+                 * @return a new stream manager instance, or nullptr on failure
+                 */
+                static std::shared_ptr<Http2StreamManager> NewStreamManager(
+                    const Http2StreamManagerOptions &streamManagerOptions,
+                    Allocator *allocator = ApiAllocator()) noexcept;
+
+              private:
+                Http2StreamManager(const Http2StreamManagerOptions &options, Allocator *allocator) noexcept;
+
+                Allocator *m_allocator;
+
+                aws_http2_stream_manager *m_streamManager;
+
+                Http2StreamManagerOptions m_options;
+                std::promise<void> m_shutdownPromise;
+                std::atomic<bool> m_releaseInvoked;
+
+                static void s_onStreamAcquired(aws_http_stream *stream, int errorCode, void *userData) noexcept;
+
+                static void s_shutdownCompleted(void *userData) noexcept;
+            };
+        } // namespace Http
+    } // namespace Crt
+} // namespace Aws
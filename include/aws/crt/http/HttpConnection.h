@@ -7,14 +7,17 @@
 #include <aws/http/proxy.h>
 #include <aws/http/request_response.h>
 
+#include <aws/crt/SpscByteRingBuffer.h>
 #include <aws/crt/Types.h>
 #include <aws/crt/io/Bootstrap.h>
 #include <aws/crt/io/SocketOptions.h>
 #include <aws/crt/io/Stream.h>
 #include <aws/crt/io/TlsOptions.h>
 
+#include <atomic>
 #include <functional>
 #include <memory>
+#include <mutex>
 
 namespace Aws
 {
@@ -32,6 +35,11 @@ namespace Aws
             class HttpClientStream;
             class HttpRequest;
             class HttpProxyStrategy;
+            class Http2StreamManager;
+            class HttpClientStreamPool;
+            class HttpContentDecoder;
+            class HttpBodyChunkPool;
+            class WriteBufferSegmentStream;
             using HttpHeader = aws_http_header;
 
             /**
@@ -84,6 +92,48 @@ namespace Aws
              */
             using OnIncomingBody = std::function<void(HttpStream &stream, const ByteCursor &data)>;
 
+            /**
+             * A piece of response body that, unlike the cursor passed to `OnIncomingBody`, can be held past the
+             * callback that delivered it, e.g. to hand it to another thread.  Chunks are recycled by their stream, and
+             * the stream's read window is credited with a chunk's size when the last reference to the chunk is
+             * dropped.
+             */
+            class AWS_CRT_CPP_API HttpBodyChunk final
+            {
+              public:
+                HttpBodyChunk(const HttpBodyChunk &) = delete;
+                HttpBodyChunk(HttpBodyChunk &&) = delete;
+                HttpBodyChunk &operator=(const HttpBodyChunk &) = delete;
+                HttpBodyChunk &operator=(HttpBodyChunk &&) = delete;
+
+                /**
+                 * @return the chunk's bytes, valid for as long as the chunk is
+                 */
+                ByteCursor GetData() const noexcept { return aws_byte_cursor_from_buf(&m_buffer); }
+
+                /**
+                 * @return number of bytes in the chunk
+                 */
+                size_t size() const noexcept { return m_buffer.len; }
+
+              private:
+                explicit HttpBodyChunk(Allocator *allocator) noexcept;
+                ~HttpBodyChunk();
+
+                ByteBuf m_buffer;
+
+                friend class HttpBodyChunkPool;
+            };
+
+            /**
+             * Invoked as chunks of the body are read, in place of `OnIncomingBody`.  `chunk` may be kept for as long
+             * as needed.  With manual window management the read window is opened by each chunk's size as the chunk
+             * is released, so HttpStream::UpdateWindow() must not also be called for these bytes; holding chunks is
+             * what applies back pressure.
+             */
+            using OnIncomingBodyChunk =
+                std::function<void(HttpStream &stream, std::shared_ptr<const HttpBodyChunk> chunk)>;
+
             /**
              * Invoked upon completion of the stream. This means the request has been sent and a completed response
              * has been received (in client mode), or the request has been received and the response has been completed.
@@ -94,6 +144,57 @@ namespace Aws
              */
             using OnStreamComplete = std::function<void(HttpStream &stream, int errorCode)>;
 
+            /**
+             * Invoked when the bytes buffered by `HttpClientStream::WriteData(ByteCursor, ...)` reach the high-water
+             * mark (`aboveHighWaterMark` is true), and again once they drain to half of it (`aboveHighWaterMark` is
+             * false).  Producers should pause between the two.  May be invoked from the writing thread or from the
+             * connection's event loop thread.
+             */
+            using OnWriteBufferLevelChanged = std::function<void(HttpClientStream &stream, bool aboveHighWaterMark)>;
+
+            /**
+             * Receives the events of a pooled stream (see HttpClientConnection::NewPooledClientStream()).  This is the
+             * interface equivalent of the callbacks in HttpRequestOptions; one handler can serve any number of
+             * streams, so starting a request does not copy any callable state.
+             */
+            class AWS_CRT_CPP_API HttpStreamHandler
+            {
+              public:
+                virtual ~HttpStreamHandler() = default;
+
+                /**
+                 * See `OnIncomingHeaders` for more info.
+                 */
+                virtual void OnIncomingHeaders(
+                    HttpStream &stream,
+                    enum aws_http_header_block headerBlock,
+                    const HttpHeader *headersArray,
+                    std::size_t headersCount) = 0;
+
+                /**
+                 * See `OnIncomingHeadersBlockDone` for more info. Does nothing by default.
+                 */
+                virtual void OnIncomingHeadersBlockDone(HttpStream &stream, enum aws_http_header_block headerBlock)
+                {
+                    (void)stream;
+                    (void)headerBlock;
+                }
+
+                /**
+                 * See `OnIncomingBody` for more info. Does nothing by default.
+                 */
+                virtual void OnIncomingBody(HttpStream &stream, const ByteCursor &data)
+                {
+                    (void)stream;
+                    (void)data;
+                }
+
+                /**
+                 * See `OnStreamComplete` for more info. A pooled stream is recycled as soon as this returns.
+                 */
+                virtual void OnStreamComplete(HttpStream &stream, int errorCode) = 0;
+            };
+
             /**
              * POD structure used for setting up an Http Request
              */
@@ -115,6 +216,12 @@ namespace Aws
                  */
                 OnIncomingBody onIncomingBody;
 
+                /**
+                 * See `OnIncomingBodyChunk` for more info.  If set, it is invoked instead of onIncomingBody.  Not
+                 * supported on pooled streams.
+                 */
+                OnIncomingBodyChunk onIncomingBodyChunk;
+
                 /**
                  * See `OnStreamComplete` for more info. This value can be empty.
                  */
@@ -140,6 +247,156 @@ namespace Aws
                  * end_stream=true.
                  */
                 bool UseManualDataWrites = false;
+
+                /**
+                 * Capacity, in bytes, of the buffer behind `HttpClientStream::WriteData(ByteCursor, ...)`.  The
+                 * buffer is allocated on the first such write; 0 means 64KiB.  Only used with UseManualDataWrites.
+                 */
+                size_t WriteBufferSize = 0;
+
+                /**
+                 * Buffered byte count at which `onWriteBufferLevelChanged` reports that the producer should pause.
+                 * 0 means three quarters of WriteBufferSize.
+                 */
+                size_t WriteBufferHighWaterMark = 0;
+
+                /**
+                 * See `OnWriteBufferLevelChanged` for more info. This value can be empty.
+                 */
+                OnWriteBufferLevelChanged onWriteBufferLevelChanged;
+
+                /**
+                 * When true, a response body sent with `Content-Encoding: gzip` or `deflate` is decompressed as it
+                 * arrives, on the connection's event loop, and `onIncomingBody` receives the decompressed data.
+                 * Bodies with any other content coding are delivered unchanged.  A body that fails to decompress, or
+                 * ends before its compressed data does, fails the stream with AWS_ERROR_HTTP_PROTOCOL_ERROR.  In builds
+                 * without zlib (USE_ZLIB=OFF), a compressed body fails the stream with
+                 * AWS_ERROR_PLATFORM_NOT_SUPPORTED instead.
+                 *
+                 * With manual window management, `HttpStream::UpdateWindow()` is then called with the number of
+                 * decompressed bytes consumed, and the connection's window is opened by the corresponding share of
+                 * compressed bytes.
+                 */
+                bool DecompressResponseBody = false;
+
+                /**
+                 * If non-zero, and the response body is being decompressed, the largest decompressed body accepted.
+                 * A body that decompresses to more than this, as a compression bomb would, fails the stream with
+                 * AWS_ERROR_OVERFLOW_DETECTED.  Set this whenever the server is not trusted.
+                 */
+                uint64_t MaxDecompressedBodySize = 0;
+            };
+
+            /**
+             * Monotonic timestamps, in nanoseconds from aws_high_res_clock_get_ticks(), of how a connection was set up
+             * and obtained.  A timestamp is 0 if that phase did not happen or could not be observed.
+             */
+            struct AWS_CRT_CPP_API HttpConnectionTimings
+            {
+                /**
+                 * HttpClientConnectionManager::AcquireConnection() was called.  Only set on pooled connections.
+                 */
+                uint64_t AcquireStartNs = 0;
+
+                /**
+                 * The connection manager handed the connection over
+                 */
+                uint64_t AcquiredNs = 0;
+
+                /**
+                 * HttpClientConnection::CreateConnection() was called.  Not set on pooled connections, which the
+                 * manager sets up on its own.
+                 */
+                uint64_t ConnectStartNs = 0;
+
+                /**
+                 * Host resolution, TCP connect and any TLS negotiation, which are not reported separately, finished
+                 */
+                uint64_t ConnectEndNs = 0;
+            };
+
+            /**
+             * Monotonic timestamps, in nanoseconds from aws_high_res_clock_get_ticks(), of the phases of one request.
+             * A timestamp is 0 if that phase did not happen or could not be observed.  The durations between phases
+             * are 0 if either end is missing.
+             */
+            struct AWS_CRT_CPP_API HttpStreamTimings
+            {
+                /**
+                 * Timings of the connection the request was sent on
+                 */
+                HttpConnectionTimings Connection;
+
+                /**
+                 * The stream was activated, or for a stream from Http2StreamManager, requested
+                 */
+                uint64_t ActivatedNs = 0;
+
+                /**
+                 * The first byte of the request was written to the connection
+                 */
+                uint64_t SendStartNs = 0;
+
+                /**
+                 * The last byte of the request was written to the connection
+                 */
+                uint64_t SendEndNs = 0;
+
+                /**
+                 * The first byte of the response was received
+                 */
+                uint64_t ReceiveStartNs = 0;
+
+                /**
+                 * The main header block of the response was complete
+                 */
+                uint64_t ResponseHeadersEndNs = 0;
+
+                /**
+                 * The last byte of the response was received
+                 */
+                uint64_t ReceiveEndNs = 0;
+
+                /**
+                 * The stream completed
+                 */
+                uint64_t CompletedNs = 0;
+
+                /**
+                 * @return time spent waiting for a connection from the connection manager
+                 */
+                uint64_t GetConnectionAcquisitionTimeNs() const noexcept;
+
+                /**
+                 * @return time spent setting up the connection, if it was set up for this request
+                 */
+                uint64_t GetConnectTimeNs() const noexcept;
+
+                /**
+                 * @return time from activation until the request started going out, spent queued behind other
+                 * streams or waiting for the peer's flow-control window
+                 */
+                uint64_t GetSendWaitTimeNs() const noexcept;
+
+                /**
+                 * @return time spent writing the request
+                 */
+                uint64_t GetSendTimeNs() const noexcept;
+
+                /**
+                 * @return time from the end of the request to the first byte of the response, i.e. server time
+                 */
+                uint64_t GetTimeToFirstByteNs() const noexcept;
+
+                /**
+                 * @return time spent receiving the response, from its first byte to its last
+                 */
+                uint64_t GetReceiveTimeNs() const noexcept;
+
+                /**
+                 * @return time from activation to completion
+                 */
+                uint64_t GetTotalTimeNs() const noexcept;
             };
 
             /**
@@ -172,10 +429,18 @@ namespace Aws
                  * You do not need to call this unless you utilized the `outWindowUpdateSize` in `OnIncomingBody`.
                  * See `OnIncomingBody` for more information.
                  *
-                 * `incrementSize` is the amount to update the read window by.
+                 * `incrementSize` is the amount to update the read window by.  If the response body is being
+                 * decompressed (see `HttpRequestOptions::DecompressResponseBody`), this is a count of decompressed
+                 * bytes.
                  */
                 void UpdateWindow(std::size_t incrementSize) noexcept;
 
+                /**
+                 * @return timestamps of the request's phases.  Complete once `OnStreamComplete` is invoked; for a
+                 * pooled stream, read them before it returns.
+                 */
+                const HttpStreamTimings &GetTimings() const noexcept { return m_timings; }
+
               protected:
                 aws_http_stream *m_stream;
                 std::shared_ptr<HttpClientConnection> m_connection;
@@ -185,8 +450,39 @@ namespace Aws
                 OnIncomingHeaders m_onIncomingHeaders;
                 OnIncomingHeadersBlockDone m_onIncomingHeadersBlockDone;
                 OnIncomingBody m_onIncomingBody;
+                OnIncomingBodyChunk m_onIncomingBodyChunk;
                 OnStreamComplete m_onStreamComplete;
 
+                /* Only created if m_onIncomingBodyChunk is set */
+                ScopedResource<HttpBodyChunkPool> m_bodyChunkPool;
+
+                /* If set, takes the place of the callbacks above */
+                HttpStreamHandler *m_handler;
+
+                /* The pool this stream returns to on completion, or null if the stream is not pooled */
+                HttpClientStreamPool *m_pool;
+
+                bool m_decompressResponseBody;
+                uint64_t m_maxDecompressedBodySize;
+
+                /* Created once the response headers name a content coding the decoder understands */
+                ScopedResource<HttpContentDecoder> m_contentDecoder;
+
+                /*
+                 * Window accounting for decompressed bodies: compressed bytes received but not yet credited back to
+                 * the connection, and decompressed bytes delivered but not yet passed to UpdateWindow().
+                 */
+                std::mutex m_windowLock;
+                size_t m_pendingCompressedWindow;
+                size_t m_pendingDecompressedWindow;
+
+                int DecodeIncomingBody(const ByteCursor &data) noexcept;
+                int DeliverIncomingBody(const ByteCursor &data) noexcept;
+                bool InitBodyChunkPool(OnIncomingBodyChunk onIncomingBodyChunk, Allocator *allocator) noexcept;
+                void OnBodyChunkReleased(HttpBodyChunk *chunk) noexcept;
+
+                HttpStreamTimings m_timings;
+
                 static int s_onIncomingHeaders(
                     struct aws_http_stream *stream,
                     enum aws_http_header_block headerBlock,
@@ -201,9 +497,16 @@ namespace Aws
                     struct aws_http_stream *stream,
                     const struct aws_byte_cursor *data,
                     void *userData) noexcept;
+                static void s_onStreamMetrics(
+                    struct aws_http_stream *stream,
+                    const struct aws_http_stream_metrics *metrics,
+                    void *userData) noexcept;
                 static void s_onStreamComplete(struct aws_http_stream *stream, int errorCode, void *userData) noexcept;
 
                 friend class HttpClientConnection;
+                friend class Http2StreamManager;
+                friend class HttpClientStreamPool;
+                friend class HttpBodyChunkPool;
             };
 
             struct ClientStreamCallbackData
@@ -245,11 +548,42 @@ namespace Aws
                     const OnWriteDataComplete &onComplete,
                     bool endStream = false) noexcept;
 
+                /**
+                 * Copies data into the stream's fixed-size write buffer and queues it to be sent.  Requires
+                 * `HttpRequestOptions::UseManualDataWrites`.  The buffer is a single-producer ring, so this must not
+                 * be called from more than one thread at a time.
+                 *
+                 * Nothing is queued if data does not fit in the buffer's free space: the call fails with
+                 * AWS_IO_READ_WOULD_BLOCK, and should be retried once `onWriteBufferLevelChanged` reports that the
+                 * buffer has drained.  Data larger than the whole buffer fails with AWS_ERROR_INVALID_ARGUMENT.
+                 *
+                 * @param data bytes to send. Copied before this returns.
+                 * @param onComplete invoked once the bytes have been written to the connection, or have failed to be
+                 * @param endStream true if this is the last write of the request body
+                 * @return AWS_OP_SUCCESS, or AWS_OP_ERR with the error raised
+                 */
+                int WriteData(ByteCursor data, const OnWriteDataComplete &onComplete, bool endStream = false) noexcept;
+
               private:
                 HttpClientStream(const std::shared_ptr<HttpClientConnection> &connection) noexcept;
 
+                void UpdateWriteBufferLevel() noexcept;
+
                 ClientStreamCallbackData m_callbackData;
+
+                size_t m_writeBufferSize;
+                size_t m_writeBufferHighWaterMark;
+                OnWriteBufferLevelChanged m_onWriteBufferLevelChanged;
+                ScopedResource<SpscByteRingBuffer> m_writeBuffer;
+                std::atomic<bool> m_writeBufferAboveHighWaterMark;
+
+                /* Bytes left in the buffer by writes that failed to queue; the next write's segment skips them */
+                size_t m_writeBufferOrphanedBytes;
+
+                friend class WriteBufferSegmentStream;
                 friend class HttpClientConnection;
+                friend class Http2StreamManager;
+                friend class HttpClientStreamPool;
             };
 
             /**
@@ -550,6 +884,42 @@ namespace Aws
                  */
                 std::shared_ptr<HttpClientStream> NewClientStream(const HttpRequestOptions &requestOptions) noexcept;
 
+                /**
+                 * Make a new client initiated request on this connection using a stream recycled from this
+                 * connection's pool.  Once the pool has warmed up to the number of concurrent requests, starting a
+                 * request makes no C++ heap allocations.
+                 *
+                 * The connection owns the returned stream.  The pointer is valid until `handler.OnStreamComplete()`
+                 * returns, after which the stream is reused for a later request.  You must not keep references to the
+                 * stream (including ones from shared_from_this()) past that point, and you must keep this connection
+                 * alive while the stream is in flight.  Until it is activated, the stream holds no reference to the
+                 * connection, so a stream that is never activated is simply freed along with the connection.
+                 *
+                 * The pool belongs to the underlying connection: on a connection from an HttpClientConnectionManager,
+                 * it is kept while the connection sits in the manager's pool and reused by later acquisitions of it.
+                 *
+                 * You must call HttpClientStream::Activate() to begin outgoing processing of the stream; a stream that
+                 * fails to activate goes straight back to the pool.
+                 *
+                 * @param request the request to send. Must stay valid until the stream completes.
+                 * @param handler receives the stream's events. Must stay valid until the stream completes.
+                 * @param useManualDataWrites see `HttpRequestOptions::UseManualDataWrites`
+                 * @return the stream on success, nullptr on failure (see LastError())
+                 */
+                HttpClientStream *NewPooledClientStream(
+                    HttpRequest &request,
+                    HttpStreamHandler &handler,
+                    bool useManualDataWrites = false) noexcept;
+
+                /**
+                 * As above, but with the callbacks of requestOptions, which are moved into the pooled stream instead
+                 * of being copied.
+                 *
+                 * @param requestOptions request and stream callbacks
+                 * @return the stream on success, nullptr on failure (see LastError())
+                 */
+                HttpClientStream *NewPooledClientStream(HttpRequestOptions &&requestOptions) noexcept;
+
                 /**
                  * @return true unless the connection is closed or closing.
                  */
@@ -574,6 +944,11 @@ namespace Aws
                  */
                 int LastError() const noexcept { return m_lastError; }
 
+                /**
+                 * @return timestamps of how this connection was set up or obtained
+                 */
+                const HttpConnectionTimings &GetTimings() const noexcept { return m_connectionTimings; }
+
                 /**
                  * Create a new Https Connection to hostName:port, using `socketOptions` for tcp options and
                  * `tlsConnOptions` for TLS/SSL options. If `tlsConnOptions` is null http (plain-text) will be used.
@@ -589,11 +964,42 @@ namespace Aws
               protected:
                 HttpClientConnection(aws_http_connection *m_connection, Allocator *allocator) noexcept;
                 aws_http_connection *m_connection;
+                HttpConnectionTimings m_connectionTimings;
+
+                /**
+                 * If set, invoked with the timings of each stream on this connection as it completes, before the
+                 * stream's own completion callback.
+                 */
+                std::function<void(const HttpStreamTimings &timings)> m_onStreamCompleted;
+
+                /**
+                 * Hands over the pool of recycled streams so that it can be kept with the underlying connection, and
+                 * used again by a later wrapper of it.  Must only be called once no pooled stream is in flight.
+                 *
+                 * @return the pool, or nullptr if there is none or a stream made from it was never activated, in which
+                 * case the pool is freed instead
+                 */
+                std::shared_ptr<HttpClientStreamPool> DetachStreamPool() noexcept;
+
+                /**
+                 * Adopts a pool of recycled streams detached from an earlier wrapper of the same connection.
+                 */
+                void AttachStreamPool(std::shared_ptr<HttpClientStreamPool> streamPool) noexcept;
 
               private:
                 Allocator *m_allocator;
                 int m_lastError;
 
+                std::mutex m_streamPoolLock;
+                std::shared_ptr<HttpClientStreamPool> m_streamPool;
+
+                HttpClientStreamPool *GetStreamPool() noexcept;
+
+                HttpClientStream *MakePooledRequest(
+                    HttpClientStream *stream,
+                    HttpRequest &request,
+                    bool useManualDataWrites) noexcept;
+
                 static void s_onClientConnectionSetup(
                     struct aws_http_connection *connection,
                     int error_code,
@@ -602,6 +1008,8 @@ namespace Aws
                     struct aws_http_connection *connection,
                     int error_code,
                     void *user_data) noexcept;
+
+                friend class HttpStream;
             };
 
         } // namespace Http
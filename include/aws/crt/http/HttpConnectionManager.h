@@ -3,6 +3,7 @@
  * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
  * SPDX-License-Identifier: Apache-2.0.
  */
+#include <aws/crt/LatencyHistogram.h>
 #include <aws/crt/http/HttpConnection.h>
 
 #include <atomic>
@@ -18,6 +19,10 @@ namespace Aws
     {
         namespace Http
         {
+            class PooledConnectionRegistry;
+            struct MinConnectionsMaintenance;
+            struct PrewarmOperation;
+
             /**
              * Invoked when a connection from the pool is available. If a connection was successfully obtained
              * the connection shared_ptr can be seated into your own copy of connection. If it failed, errorCode
@@ -49,6 +54,40 @@ namespace Aws
                  */
                 size_t MaxConnections;
 
+                /**
+                 * If non-zero, the manager opens this many connections as soon as it is created, and opens
+                 * replacements whenever connections are dropped from the pool, so that requests after startup don't
+                 * pay for DNS, TCP and TLS setup.  Capped at MaxConnections.  The pool is checked when connections
+                 * are released and once a second, so connections that were reaped for sitting idle longer than
+                 * MaxConnectionIdleTimeMs, or closed by the server, are replaced too.
+                 */
+                size_t MinConnections;
+
+                /**
+                 * If non-zero, connections that have sat idle in the pool for longer than this are closed.
+                 */
+                uint64_t MaxConnectionIdleTimeMs;
+
+                /**
+                 * If non-zero, the maximum number of AcquireConnection() calls that may be waiting for a connection
+                 * at once.  Acquisitions beyond this fail immediately, through their callback, with
+                 * AWS_ERROR_HTTP_CONNECTION_MANAGER_MAX_PENDING_ACQUISITIONS_EXCEEDED instead of queueing.
+                 */
+                uint64_t MaxPendingConnectionAcquisitions;
+
+                /**
+                 * If non-zero, a connection that has been in use for longer than this, measured from the first time
+                 * it was handed out, is closed when it is next returned to the pool instead of being reused.  This
+                 * bounds how long a connection stays pinned to one server behind a load balancer.
+                 */
+                uint64_t MaxConnectionLifetimeMs;
+
+                /**
+                 * If set, the timings (see HttpStreamTimings) of every request made on the manager's connections are
+                 * aggregated into the request histograms of HttpClientConnectionManagerMetrics.
+                 */
+                bool EnableRequestTimingMetrics;
+
                 /** If set, initiate shutdown will return a future that will allow a user to block until the
                  * connection manager has completely released all resources. This isn't necessary during the normal
                  * flow of an application, but it is useful for scenarios, such as tests, that need deterministic
@@ -59,6 +98,47 @@ namespace Aws
                 bool EnableBlockingShutdown;
             };
 
+            /**
+             * Snapshot of a connection manager's pool and acquisition queue
+             */
+            struct AWS_CRT_CPP_API HttpClientConnectionManagerMetrics
+            {
+                /**
+                 * Number of idle connections in the pool
+                 */
+                size_t AvailableConnections = 0;
+
+                /**
+                 * Number of connections currently handed out
+                 */
+                size_t LeasedConnections = 0;
+
+                /**
+                 * Number of AcquireConnection() calls waiting for a connection
+                 */
+                size_t PendingAcquisitions = 0;
+
+                /**
+                 * Number of acquisitions that completed with an error
+                 */
+                uint64_t FailedAcquisitions = 0;
+
+                /**
+                 * Time from AcquireConnection() to its callback, for every completed acquisition
+                 */
+                LatencyHistogram AcquisitionWaitTime;
+
+                /**
+                 * Per-request phase durations, only recorded if EnableRequestTimingMetrics is set.  See the
+                 * corresponding HttpStreamTimings getters.  Phases a request skipped are not recorded.
+                 */
+                LatencyHistogram RequestSendWaitTime;
+                LatencyHistogram RequestSendTime;
+                LatencyHistogram RequestTimeToFirstByte;
+                LatencyHistogram RequestReceiveTime;
+                LatencyHistogram RequestTotalTime;
+            };
+
             /**
              * Manages a pool of connections to a specific endpoint using the same socket and tls options.
              */
@@ -89,6 +169,26 @@ namespace Aws
                  */
                 std::future<void> InitiateShutdown() noexcept;
 
+                /**
+                 * @return a snapshot of the pool's connection counts and acquisition statistics
+                 */
+                HttpClientConnectionManagerMetrics GetMetrics() const noexcept;
+
+                /**
+                 * Opens connections, in parallel, until the pool holds at least `count` connections, counting ones
+                 * currently handed out.  The new connections are returned to the pool idle and ready for use.
+                 *
+                 * Each new connection is returned to the pool as soon as it is established, where acquisitions made
+                 * in the meantime can take it.
+                 * Connections still being acquired by other prewarms count towards `count`, so overlapping prewarms
+                 * never ask for more than MaxConnections between them.
+                 *
+                 * @param count number of connections to have open. Capped at MaxConnections.
+                 * @return future resolving, once prewarming is finished, to the number of connections it returned to
+                 * the pool.  Connections that failed to open are not counted.
+                 */
+                std::future<size_t> Prewarm(size_t count) noexcept;
+
                 /**
                  * Factory function for connection managers
                  *
@@ -113,14 +213,70 @@ namespace Aws
                 std::promise<void> m_shutdownPromise;
                 std::atomic<bool> m_releaseInvoked;
 
+                mutable std::mutex m_metricsLock;
+                LatencyHistogram m_acquisitionWaitTime;
+                uint64_t m_failedAcquisitions;
+
+                LatencyHistogram m_requestSendWaitTime;
+                LatencyHistogram m_requestSendTime;
+                LatencyHistogram m_requestTimeToFirstByte;
+                LatencyHistogram m_requestReceiveTime;
+                LatencyHistogram m_requestTotalTime;
+
+                /* First lease times and recycled streams of each connection */
+                std::shared_ptr<PooledConnectionRegistry> m_pooledConnections;
+
+                /* Acquisitions made by prewarms that have not completed yet */
+                size_t m_prewarmConnectionsInFlight;
+
+                /* Lets prewarms started from the event loop take a reference only while the manager is still owned */
+                std::weak_ptr<HttpClientConnectionManager> m_selfReference;
+
+                /* Link to the MinConnections timer, severed when the manager shuts down */
+                std::shared_ptr<MinConnectionsMaintenance> m_minConnectionsMaintenance;
+
+                /* When a connection release last checked the pool for MinConnections */
+                std::atomic<uint64_t> m_lastReleaseMaintenanceNs;
+
+                void OnAcquisitionCompleted(
+                    uint64_t acquireTimestampNs,
+                    aws_http_connection *connection,
+                    int errorCode) noexcept;
+
+                void OnAcquisitionFailed(int errorCode) noexcept;
+
+                void OnConnectionReleased(aws_http_connection *connection) noexcept;
+
+                std::future<size_t> StartPrewarm(size_t count, bool skipIfOpen) noexcept;
+
+                void StartMinConnectionsMaintenance() noexcept;
+
+                void StopMinConnectionsMaintenance() noexcept;
+
+                /* Returns false once the pool no longer needs maintaining */
+                bool MaintainMinConnections() noexcept;
+
+                /* MaintainMinConnections(), at most once per check interval however often connections are released */
+                void MaintainMinConnectionsOnRelease() noexcept;
+
+                void OnStreamCompleted(const HttpStreamTimings &timings) noexcept;
+
                 static void s_onConnectionSetup(
                     aws_http_connection *connection,
                     int errorCode,
                     void *userData) noexcept;
 
+                static void s_onPrewarmConnectionSetup(
+                    aws_http_connection *connection,
+                    int errorCode,
+                    void *userData) noexcept;
+
+                static void s_onPrewarmAcquisitionFinished(PrewarmOperation *prewarm) noexcept;
+
                 static void s_shutdownCompleted(void *userData) noexcept;
 
                 friend class ManagedConnection;
+                friend struct MinConnectionsMaintenanceTask;
             };
         } // namespace Http
     } // namespace Crt
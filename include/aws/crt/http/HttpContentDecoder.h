@@ -0,0 +1,122 @@
+#pragma once
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+#include <aws/crt/Types.h>
+
+#include <functional>
+
+namespace Aws
+{
+    namespace Crt
+    {
+        namespace Http
+        {
+            /**
+             * Content codings understood by HttpContentDecoder
+             */
+            enum class HttpContentEncoding
+            {
+                /**
+                 * No coding; data is passed through unchanged
+                 */
+                Identity,
+
+                /**
+                 * gzip file format (RFC 1952). Concatenated members are decoded one after another.
+                 */
+                Gzip,
+
+                /**
+                 * zlib format (RFC 1950). Raw deflate data without the zlib wrapper, which some servers send
+                 * instead, is detected and accepted as well.
+                 */
+                Deflate,
+            };
+
+            /**
+             * Invoked with each chunk of decoded data. The cursor is only valid for the duration of the call.
+             */
+            using OnDecodedData = std::function<void(const ByteCursor &data)>;
+
+            /**
+             * Incremental decoder for a compressed http message body, built on zlib.
+             *
+             * Input can be split at any byte boundary.  Decoded data is handed out from a 32KiB output buffer, so
+             * besides that buffer and zlib's own window no buffering or copying happens between the compressed input
+             * and the decoded chunks.  Not thread-safe.
+             *
+             * Gzip and Deflate need the library to be built with zlib (the USE_ZLIB CMake option, on by default).
+             * Without it, creating a decoder for them fails with AWS_ERROR_PLATFORM_NOT_SUPPORTED.
+             */
+            class AWS_CRT_CPP_API HttpContentDecoder final
+            {
+              public:
+                /**
+                 * @param encoding content coding of the data to decode
+                 * @param allocator allocator for the decoder's buffers, including zlib's
+                 */
+                HttpContentDecoder(HttpContentEncoding encoding, Allocator *allocator = ApiAllocator()) noexcept;
+                ~HttpContentDecoder();
+
+                HttpContentDecoder(const HttpContentDecoder &) = delete;
+                HttpContentDecoder(HttpContentDecoder &&) = delete;
+                HttpContentDecoder &operator=(const HttpContentDecoder &) = delete;
+                HttpContentDecoder &operator=(HttpContentDecoder &&) = delete;
+
+                /**
+                 * @return true if the decoder was successfully created
+                 */
+                explicit operator bool() const noexcept { return m_impl != nullptr; }
+
+                /**
+                 * Maps a Content-Encoding header value to the coding it names.
+                 *
+                 * @param headerValue value of a Content-Encoding header
+                 * @return the coding, or an empty Optional if it is not one this decoder understands
+                 */
+                static Optional<HttpContentEncoding> EncodingFromHeaderValue(ByteCursor headerValue) noexcept;
+
+                /**
+                 * Decodes the next piece of input.
+                 *
+                 * @param input compressed data
+                 * @param onDecodedData invoked zero or more times with the data decoded from input
+                 * @return true on success.  On failure, AWS_ERROR_HTTP_PROTOCOL_ERROR is raised and the decoder
+                 * rejects all further input.
+                 */
+                bool Decode(ByteCursor input, const OnDecodedData &onDecodedData) noexcept;
+
+                /**
+                 * Limits how much decoded data the decoder hands out, so that a small, maliciously compressed input
+                 * can't expand without bound.  Once decoding would exceed the limit, Decode() fails with
+                 * AWS_ERROR_OVERFLOW_DETECTED, without handing out the data beyond it, and rejects all further input.
+                 *
+                 * @param maxOutputBytes largest total number of decoded bytes; 0, the default, means no limit
+                 */
+                void SetMaxOutputByteCount(uint64_t maxOutputBytes) noexcept;
+
+                /**
+                 * @return true if the input so far ends exactly at the end of the compressed data, including any
+                 * trailer and its checksum
+                 */
+                bool IsComplete() const noexcept;
+
+                /**
+                 * @return number of compressed bytes passed to Decode()
+                 */
+                uint64_t GetInputByteCount() const noexcept;
+
+                /**
+                 * @return number of decoded bytes handed out
+                 */
+                uint64_t GetOutputByteCount() const noexcept;
+
+              private:
+                struct Impl;
+                ScopedResource<Impl> m_impl;
+            };
+        } // namespace Http
+    } // namespace Crt
+} // namespace Aws
@@ -7,6 +7,7 @@
 #include <aws/crt/Types.h>
 
 #include <memory>
+#include <mutex>
 
 struct aws_http_proxy_strategy;
 
@@ -56,7 +57,11 @@ namespace Aws
              */
             struct AWS_CRT_CPP_API HttpProxyStrategyAdaptiveConfig
             {
-                HttpProxyStrategyAdaptiveConfig() : KerberosGetToken(), NtlmGetCredential(), NtlmGetToken() {}
+                HttpProxyStrategyAdaptiveConfig()
+                    : KerberosGetToken(), NtlmGetCredential(), NtlmGetToken(), TokenCacheTtlMs(0),
+                      CacheKerberosTokens(false)
+                {
+                }
 
                 /**
                  * User-supplied callback for fetching kerberos tokens
@@ -72,6 +77,58 @@ namespace Aws
                  * User-supplied callback for fetching an ntlm token
                  */
                 NtlmGetTokenFunction NtlmGetToken;
+
+                /**
+                 * If non-zero, ntlm credentials are cached for this long and reused for the CONNECT requests of later
+                 * connections made with the strategy, instead of invoking NtlmGetCredential for every connection.  Ntlm
+                 * challenge responses are bound to their connection and are never cached.
+                 */
+                uint64_t TokenCacheTtlMs;
+
+                /**
+                 * If set, kerberos tokens are cached for TokenCacheTtlMs as well.  Kerberos/SPNEGO tokens are
+                 * normally single-use, and proxies with replay protection reject a token presented twice, so only
+                 * enable this if KerberosGetToken returns tokens the proxy accepts more than once.
+                 */
+                bool CacheKerberosTokens;
+            };
+
+            /**
+             * A proxy credential that is fetched once and then reused until it is older than a time-to-live.  The
+             * adaptive strategy uses this to cache credentials when HttpProxyStrategyAdaptiveConfig::TokenCacheTtlMs
+             * is set.  Thread-safe.
+             */
+            class AWS_CRT_CPP_API CachedProxyCredential
+            {
+              public:
+                /**
+                 * @param ttlMs how long a fetched credential is reused for; 0 disables caching
+                 */
+                explicit CachedProxyCredential(uint64_t ttlMs) noexcept;
+
+                CachedProxyCredential(const CachedProxyCredential &) = delete;
+                CachedProxyCredential &operator=(const CachedProxyCredential &) = delete;
+
+                /**
+                 * Gets the cached credential if it is still fresh, otherwise invokes fetchCredential and caches what
+                 * it returns.  fetchCredential is invoked without any lock held.
+                 *
+                 * @param fetchCredential callback that fetches a new credential
+                 * @param credential receives the credential
+                 * @return true on success, false if fetchCredential failed
+                 */
+                bool Get(const KerberosGetTokenFunction &fetchCredential, String &credential);
+
+                /**
+                 * Discards the cached credential, so that the next Get() fetches a new one.
+                 */
+                void Clear() noexcept;
+
+              private:
+                uint64_t m_ttlNs;
+                std::mutex m_lock;
+                String m_value;
+                uint64_t m_expirationNs;
             };
 
             /**
@@ -87,6 +144,14 @@ namespace Aws
                 /// @private
                 struct aws_http_proxy_strategy *GetUnderlyingHandle() const noexcept { return m_strategy; }
 
+                /**
+                 * Discards any credentials or tokens the strategy has cached, so that the next connection fetches
+                 * new ones.  HttpClientConnection::CreateConnection() does this whenever a connection using the
+                 * strategy fails to be established, and an HttpClientConnectionManager whenever an acquisition fails
+                 * for any reason other than the manager's own pending-acquisition limit or shutdown.
+                 */
+                virtual void ClearCachedCredentials() noexcept {}
+
                 /**
                  * Creates a proxy strategy that performs basic authentication
                  * @param config basic authentication configuration options
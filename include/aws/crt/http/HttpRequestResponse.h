@@ -8,7 +8,10 @@
 #include <aws/crt/Types.h>
 #include <aws/crt/io/Stream.h>
 
+#include <iterator>
+
 struct aws_http_header;
+struct aws_http_headers;
 struct aws_http_message;
 
 namespace Aws
@@ -28,6 +31,107 @@ namespace Aws
         {
             using HttpHeader = aws_http_header;
 
+            /**
+             * Read-only view over a list of http headers, either those of an HttpMessage or a raw array such as the
+             * one passed to `OnIncomingHeaders`.  The view does not copy the headers; it, and every cursor it hands
+             * out, is only valid as long as the underlying headers are neither modified nor destroyed.
+             */
+            class AWS_CRT_CPP_API HttpHeaderView
+            {
+              public:
+                /**
+                 * Forward iterator over the headers of a view, yielding each header by value
+                 */
+                class AWS_CRT_CPP_API Iterator
+                {
+                  public:
+                    using iterator_category = std::forward_iterator_tag;
+                    using value_type = HttpHeader;
+                    using difference_type = std::ptrdiff_t;
+                    using pointer = const HttpHeader *;
+                    using reference = HttpHeader;
+
+                    Iterator(const HttpHeaderView *view, size_t index) noexcept : m_view(view), m_index(index) {}
+
+                    HttpHeader operator*() const noexcept { return (*m_view)[m_index]; }
+
+                    Iterator &operator++() noexcept
+                    {
+                        ++m_index;
+                        return *this;
+                    }
+
+                    Iterator operator++(int) noexcept
+                    {
+                        Iterator previous = *this;
+                        ++m_index;
+                        return previous;
+                    }
+
+                    bool operator==(const Iterator &rhs) const noexcept
+                    {
+                        return m_view == rhs.m_view && m_index == rhs.m_index;
+                    }
+
+                    bool operator!=(const Iterator &rhs) const noexcept { return !(*this == rhs); }
+
+                  private:
+                    const HttpHeaderView *m_view;
+                    size_t m_index;
+                };
+
+                /**
+                 * Creates a view over an array of headers
+                 * @param headers array of headers
+                 * @param count number of headers in the array
+                 */
+                HttpHeaderView(const HttpHeader *headers, size_t count) noexcept;
+
+                /**
+                 * @return the number of headers in the view
+                 */
+                size_t size() const noexcept;
+
+                /**
+                 * @return true if the view contains no headers
+                 */
+                bool empty() const noexcept { return size() == 0; }
+
+                /**
+                 * @param index index of the header to get. Must be less than size().
+                 * @return the header at index
+                 */
+                HttpHeader operator[](size_t index) const noexcept;
+
+                Iterator begin() const noexcept { return Iterator(this, 0); }
+                Iterator end() const noexcept { return Iterator(this, size()); }
+
+                /**
+                 * Finds the first header with a given name, comparing names case-insensitively.
+                 * @param name header name to look for
+                 * @return the value of the first matching header, if any
+                 */
+                Optional<ByteCursor> FindHeader(ByteCursor name) const noexcept;
+
+                /**
+                 * Gets the values of every header with a given name, in order, comparing names case-insensitively.
+                 * @param name header name to look for
+                 * @param allocator memory allocator for the returned vector
+                 * @return the values of all matching headers
+                 */
+                Vector<ByteCursor> GetHeaderValues(ByteCursor name, Allocator *allocator = ApiAllocator()) const
+                    noexcept;
+
+              private:
+                explicit HttpHeaderView(const struct aws_http_headers *headers) noexcept;
+
+                const HttpHeader *m_headerArray;
+                size_t m_headerArrayCount;
+                const struct aws_http_headers *m_headers;
+
+                friend class HttpMessage;
+            };
+
             /**
              * Base class representing a mutable http request or response.
              */
@@ -73,6 +177,32 @@ namespace Aws
                  */
                 Optional<HttpHeader> GetHeader(size_t index) const noexcept;
 
+                /**
+                 * Gets an iterable view of the message's headers.  The view is invalidated by any change to the
+                 * message's headers.
+                 * @return a view of the headers in this message
+                 */
+                HttpHeaderView GetHeaders() const noexcept;
+
+                /**
+                 * Finds the first header with a given name, comparing names case-insensitively.  Like the rest of
+                 * HttpMessage, this is not safe to call concurrently with other operations on the message.
+                 *
+                 * @param name header name to look for
+                 * @return the value of the first matching header, if any.  The cursor is invalidated by any change
+                 * to the message's headers.
+                 */
+                Optional<ByteCursor> FindHeader(ByteCursor name) const noexcept;
+
+                /**
+                 * Gets the values of every header with a given name, in order, comparing names case-insensitively.
+                 *
+                 * @param name header name to look for
+                 * @return the values of all matching headers.  The cursors are invalidated by any change to the
+                 * message's headers.
+                 */
+                Vector<ByteCursor> GetHeaderValues(ByteCursor name) const noexcept;
+
                 /**
                  * Adds a header to the request
                  * @param header header to add
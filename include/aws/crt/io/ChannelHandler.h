@@ -6,6 +6,7 @@
 
 #include <aws/crt/Exports.h>
 #include <aws/crt/Types.h>
+#include <aws/crt/io/EventLoop.h>
 #include <aws/io/channel.h>
 
 #include <chrono>
@@ -20,6 +21,8 @@ namespace Aws
     {
         namespace Io
         {
+            struct TaskWrapperPool;
+
             enum class ChannelDirection
             {
                 Read,
@@ -31,12 +34,6 @@ namespace Aws
                 ApplicationData,
             };
 
-            enum class TaskStatus
-            {
-                RunReady,
-                Canceled,
-            };
-
             /**
              * Wrapper for aws-c-io channel handlers. The semantics are identical as the functions on
              * aws_channel_handler.
@@ -145,14 +142,17 @@ namespace Aws
 
                 /**
                  * Schedule a task to run on the next "tick" of the event loop.
-                 * If the channel is completely shut down, the task will run with the 'Canceled' status.
+                 * If the channel is completely shut down, or the task can't be scheduled for lack of memory, the task
+                 * will run with the 'Canceled' status.
+                 * The wrappers that carry tasks are recycled per handler, so scheduling doesn't allocate in the
+                 * steady state beyond what the std::function itself needs.
                  */
                 void ScheduleTask(std::function<void(TaskStatus)> &&task);
 
                 /**
                  * Schedule a task to run after a desired length of time has passed.
                  * The task will run with the 'Canceled' status if the channel completes shutdown
-                 * before that length of time elapses.
+                 * before that length of time elapses, or right away if it can't be scheduled for lack of memory.
                  */
                 void ScheduleTask(std::function<void(TaskStatus)> &&task, std::chrono::nanoseconds run_in);
 
@@ -171,6 +171,17 @@ namespace Aws
                  */
                 struct aws_io_message *AcquireMaxSizeMessageForWrite();
 
+                /**
+                 * Acquire several aws_io_messages from the channel's pool, e.g. for a handler that splits one read
+                 * into many frames. Up to count messages are appended to messages.
+                 * Returns the number of messages acquired, which is less than count only if acquisition failed.
+                 */
+                size_t AcquireMessagesFromPool(
+                    MessageType messageType,
+                    size_t sizeHint,
+                    size_t count,
+                    Vector<struct aws_io_message *> &messages);
+
                 /**
                  * Send a message in the read or write direction.
                  * Returns true if message successfully sent.
@@ -178,6 +189,13 @@ namespace Aws
                  */
                 bool SendMessage(struct aws_io_message *message, ChannelDirection direction);
 
+                /**
+                 * Send messages in order in the read or write direction, stopping at the first one that is rejected.
+                 * Sent messages are removed from messages; any left were not sent and you must release them yourself.
+                 * Returns true if all messages were sent.
+                 */
+                bool SendMessages(Vector<struct aws_io_message *> &messages, ChannelDirection direction);
+
                 /**
                  * Issue a window update notification upstream.
                  * Returns true if successful.
@@ -210,6 +228,7 @@ namespace Aws
 
               private:
                 std::shared_ptr<ChannelHandler> m_selfReference;
+                std::shared_ptr<TaskWrapperPool> m_taskWrapperPool;
                 static struct aws_channel_handler_vtable s_vtable;
 
                 static void s_Destroy(struct aws_channel_handler *handler);
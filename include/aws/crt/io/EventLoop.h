@@ -0,0 +1,235 @@
+#pragma once
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+#include <aws/crt/LatencyHistogram.h>
+#include <aws/crt/Types.h>
+
+#include <aws/common/task_scheduler.h>
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+struct aws_event_loop;
+
+namespace Aws
+{
+    namespace Crt
+    {
+        namespace Io
+        {
+            struct EventLoopState;
+
+            enum class TaskStatus
+            {
+                RunReady,
+                Canceled,
+            };
+
+            /**
+             * @private
+             * Intrusive task node used by EventLoop::Schedule().  Callables that fit are constructed directly in
+             * storage; larger ones are allocated separately and storage holds a pointer to them.  Nodes are pooled
+             * per loop.
+             */
+            struct EventLoopTaskNode
+            {
+                static const size_t INLINE_CAPACITY = 64;
+
+                using Invoker = void (*)(EventLoopTaskNode &node, TaskStatus status);
+
+                alignas(std::max_align_t) unsigned char storage[INLINE_CAPACITY];
+
+                /* Invokes the stored callable, then destroys it */
+                Invoker invoke;
+
+                struct aws_task task;
+                Allocator *allocator;
+                std::shared_ptr<EventLoopState> state;
+                EventLoopTaskNode *nextFree;
+            };
+
+            /**
+             * Point-in-time statistics of a single event loop.
+             */
+            struct AWS_CRT_CPP_API EventLoopStatistics
+            {
+                /**
+                 * Index of the loop within its EventLoopGroup
+                 */
+                size_t LoopIndex = 0;
+
+                /**
+                 * Load factor reported by the loop: the time, in nanoseconds, the loop's thread spent running tasks
+                 * and handling I/O events over the most recent measurement window (about one second).  A loop whose
+                 * load factor approaches one second of work per second is saturated.
+                 */
+                size_t LoadFactor = 0;
+
+                /**
+                 * Delay between when each scheduler lag probe was due and when the loop ran it.  Empty unless
+                 * EventLoopGroup::EnableSchedulerLagProbes() was called.
+                 */
+                LatencyHistogram SchedulerLag;
+
+                /**
+                 * Tasks scheduled with EventLoop::Schedule() or EventLoop::ScheduleAt() that haven't run yet
+                 */
+                size_t PendingTaskCount = 0;
+
+                /**
+                 * Total tasks scheduled with EventLoop::Schedule() or EventLoop::ScheduleAt()
+                 */
+                uint64_t ScheduledTaskCount = 0;
+            };
+
+            /**
+             * Non-owning handle to one event loop of an EventLoopGroup.  Handles are cheap to copy and remain usable
+             * for as long as the EventLoopGroup they came from is alive.
+             */
+            class AWS_CRT_CPP_API EventLoop final
+            {
+              public:
+                EventLoop() noexcept;
+
+                /**
+                 * @return true if the handle refers to an event loop
+                 */
+                explicit operator bool() const noexcept { return m_eventLoop != nullptr; }
+
+                /**
+                 * @return true if called from this loop's thread
+                 */
+                bool IsCallersThread() const noexcept;
+
+                /**
+                 * @return current time, in nanoseconds, of the clock the loop schedules tasks against
+                 */
+                uint64_t GetCurrentClockTimeNs() const noexcept;
+
+                /**
+                 * @return statistics of this loop.  See EventLoopStatistics.
+                 */
+                EventLoopStatistics GetStatistics() const noexcept;
+
+                /**
+                 * @return allocator configured for this loop (see EventLoopOptions::LoopAllocator), or the group's
+                 * allocator if none was configured.  Work placed on the loop should allocate from it.
+                 */
+                Allocator *GetAllocator() const noexcept { return m_allocator; }
+
+                /**
+                 * Schedules fn to run on this loop's thread as soon as possible.  Safe to call from any thread.
+                 *
+                 * fn is invoked exactly once, as fn(TaskStatus): with TaskStatus::RunReady, or with
+                 * TaskStatus::Canceled if the loop shuts down first.  Callables of up to
+                 * EventLoopTaskNode::INLINE_CAPACITY bytes, such as lambdas capturing a few pointers, are stored
+                 * inline in a pooled task node, so once the pool is warm scheduling them does not allocate.
+                 *
+                 * @param fn callable taking a TaskStatus
+                 * @return true on success, false if the handle is empty or allocation failed
+                 */
+                template <typename Fn> bool Schedule(Fn &&fn) noexcept
+                {
+                    return ScheduleTaskNode(std::forward<Fn>(fn), false, 0);
+                }
+
+                /**
+                 * Schedules fn to run on this loop's thread at a point in time.  Behaves like Schedule() otherwise.
+                 *
+                 * @param fn callable taking a TaskStatus
+                 * @param runAtNs time, in nanoseconds on the loop's clock (see GetCurrentClockTimeNs()), to run fn at
+                 * @return true on success, false if the handle is empty or allocation failed
+                 */
+                template <typename Fn> bool ScheduleAt(Fn &&fn, uint64_t runAtNs) noexcept
+                {
+                    return ScheduleTaskNode(std::forward<Fn>(fn), true, runAtNs);
+                }
+
+                /// @private
+                struct aws_event_loop *GetUnderlyingHandle() const noexcept { return m_eventLoop; }
+
+              private:
+                friend class EventLoopGroup;
+
+                EventLoop(
+                    struct aws_event_loop *eventLoop,
+                    std::shared_ptr<EventLoopState> state,
+                    Allocator *allocator) noexcept;
+
+                template <typename Fn> bool ScheduleTaskNode(Fn &&fn, bool runLater, uint64_t runAtNs) noexcept
+                {
+                    using Callable = typename std::decay<Fn>::type;
+                    using FitsInline = std::integral_constant<
+                        bool,
+                        sizeof(Callable) <= EventLoopTaskNode::INLINE_CAPACITY &&
+                            alignof(Callable) <= alignof(std::max_align_t)>;
+
+                    EventLoopTaskNode *node = AcquireTaskNode();
+                    if (node == nullptr)
+                    {
+                        return false;
+                    }
+
+                    if (!EmplaceCallable<Callable>(*node, std::forward<Fn>(fn), FitsInline()))
+                    {
+                        ReleaseTaskNode(node);
+                        return false;
+                    }
+
+                    SubmitTaskNode(node, runLater, runAtNs);
+                    return true;
+                }
+
+                template <typename Callable, typename Fn>
+                static bool EmplaceCallable(EventLoopTaskNode &node, Fn &&fn, std::true_type) noexcept
+                {
+                    new (node.storage) Callable(std::forward<Fn>(fn));
+                    node.invoke = &s_InvokeInline<Callable>;
+                    return true;
+                }
+
+                template <typename Callable, typename Fn>
+                static bool EmplaceCallable(EventLoopTaskNode &node, Fn &&fn, std::false_type) noexcept
+                {
+                    Callable *callable = New<Callable>(node.allocator, std::forward<Fn>(fn));
+                    if (callable == nullptr)
+                    {
+                        return false;
+                    }
+
+                    new (node.storage) Callable *(callable);
+                    node.invoke = &s_InvokeAllocated<Callable>;
+                    return true;
+                }
+
+                template <typename Callable> static void s_InvokeInline(EventLoopTaskNode &node, TaskStatus status)
+                {
+                    auto *callable = reinterpret_cast<Callable *>(node.storage);
+                    (*callable)(status);
+                    callable->~Callable();
+                }
+
+                template <typename Callable> static void s_InvokeAllocated(EventLoopTaskNode &node, TaskStatus status)
+                {
+                    Callable *callable = *reinterpret_cast<Callable **>(node.storage);
+                    (*callable)(status);
+                    Delete(callable, node.allocator);
+                }
+
+                EventLoopTaskNode *AcquireTaskNode() const noexcept;
+                static void ReleaseTaskNode(EventLoopTaskNode *node) noexcept;
+                static void s_OnTaskNode(struct aws_task *task, void *arg, enum aws_task_status status);
+                void SubmitTaskNode(EventLoopTaskNode *node, bool runLater, uint64_t runAtNs) const noexcept;
+
+                struct aws_event_loop *m_eventLoop;
+                std::shared_ptr<EventLoopState> m_state;
+                Allocator *m_allocator;
+            };
+        } // namespace Io
+    } // namespace Crt
+} // namespace Aws
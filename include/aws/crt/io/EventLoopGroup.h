@@ -4,6 +4,8 @@
  * SPDX-License-Identifier: Apache-2.0.
  */
 #include <aws/crt/Types.h>
+#include <aws/crt/Optional.h>
+#include <aws/crt/io/EventLoop.h>
 
 #include <aws/io/event_loop.h>
 
@@ -13,6 +15,51 @@ namespace Aws
     {
         namespace Io
         {
+            /**
+             * Settings for one loop of an EventLoopGroup.
+             */
+            struct AWS_CRT_CPP_API EventLoopOptions
+            {
+                /**
+                 * Cpus the loop's thread may run on.  The thread is restricted to the cpus in this set that it could
+                 * already run on, which are those of EventLoopGroupOptions::CpuGroup when one is set; if none are
+                 * left, group creation fails with AWS_ERROR_INVALID_ARGUMENT.  Empty leaves the thread's affinity
+                 * unchanged.  Pinning a loop is currently only supported on Linux; elsewhere a non-empty set fails
+                 * group creation with AWS_ERROR_PLATFORM_NOT_SUPPORTED.
+                 */
+                Vector<uint16_t> CpuSet;
+
+                /**
+                 * Allocator for work placed on this loop, for example one backed by memory local to the NUMA node of
+                 * the loop's cpus.  Handed out by EventLoop::GetAllocator().  Defaults to the group's allocator.
+                 */
+                Allocator *LoopAllocator = nullptr;
+            };
+
+            /**
+             * Configuration for an EventLoopGroup.
+             */
+            struct AWS_CRT_CPP_API EventLoopGroupOptions
+            {
+                /**
+                 * Number of event-loops to create when Loops is empty.  0 creates one for each processor on the
+                 * machine.  Must be 0 or match the size of Loops otherwise.
+                 */
+                uint16_t ThreadCount = 0;
+
+                /**
+                 * CPU group (e.g. NUMA node) that all loop threads are pinned to, as with the cpuGroup constructor.
+                 * Per-loop cpu sets narrow this further: a loop runs on the intersection of the group's cpus and its
+                 * EventLoopOptions::CpuSet.
+                 */
+                Optional<uint16_t> CpuGroup;
+
+                /**
+                 * Per-loop settings, indexed by loop index.  When non-empty, one loop is created per entry.
+                 */
+                Vector<EventLoopOptions> Loops;
+            };
+
             /**
              * A collection of event loops.
              *
@@ -45,6 +92,12 @@ namespace Aws
                  * @param allocator memory allocator to use.
                  */
                 EventLoopGroup(uint16_t cpuGroup, uint16_t threadCount, Allocator *allocator = ApiAllocator()) noexcept;
+                /**
+                 * @param options: loop count, cpu placement and per-loop allocators. Creation fails if any loop can't
+                 * be pinned to its cpu set.
+                 * @param allocator memory allocator to use.
+                 */
+                EventLoopGroup(const EventLoopGroupOptions &options, Allocator *allocator = ApiAllocator()) noexcept;
                 ~EventLoopGroup();
                 EventLoopGroup(const EventLoopGroup &) = delete;
                 EventLoopGroup(EventLoopGroup &&) noexcept;
@@ -61,12 +114,58 @@ namespace Aws
                  */
                 int LastError() const;
 
+                /**
+                 * @return number of event loops in the group
+                 */
+                size_t GetLoopCount() const noexcept;
+
+                /**
+                 * Gets a specific loop, for explicitly placing work on it.
+                 *
+                 * @param index index in [0, GetLoopCount())
+                 * @return handle to the loop, or an empty handle if index is out of range
+                 */
+                EventLoop GetLoopAt(size_t index) noexcept;
+
+                /**
+                 * Gets the loop that the group would currently assign new work to, the same way channels pick their
+                 * loop: the less loaded of two loops picked at random.
+                 *
+                 * @return handle to the loop, or an empty handle if the group is invalid
+                 */
+                EventLoop GetNextLoop() noexcept;
+
+                /**
+                 * @return statistics of every loop in the group, ordered by loop index
+                 */
+                Vector<EventLoopStatistics> GetStatistics() const;
+
+                /**
+                 * Starts measuring scheduler lag on every loop: each loop runs a timer task every intervalMs
+                 * milliseconds and records how late it ran in EventLoopStatistics::SchedulerLag.  Probes run until
+                 * this object is destroyed.
+                 *
+                 * @param intervalMs interval between probes, in milliseconds; must be non-zero
+                 * @return true on success.  Fails with AWS_ERROR_INVALID_STATE if probes were already enabled, and
+                 * with AWS_ERROR_INVALID_ARGUMENT if intervalMs is 0.  No probe is left running on failure.
+                 */
+                bool EnableSchedulerLagProbes(uint64_t intervalMs) noexcept;
+
                 /// @private
                 aws_event_loop_group *GetUnderlyingHandle() noexcept;
 
               private:
+                /* On failure, releases the group and records the error in m_lastError */
+                bool InitLoopStates() noexcept;
+                bool PinLoop(size_t index, const Vector<uint16_t> &cpuSet) noexcept;
+                void StopSchedulerLagProbes() noexcept;
+
                 aws_event_loop_group *m_eventLoopGroup;
                 int m_lastError;
+                Allocator *m_allocator;
+                Vector<std::shared_ptr<EventLoopState>> m_loopStates;
+                Vector<Allocator *> m_loopAllocators;
+                bool m_lagProbesEnabled;
             };
         } // namespace Io
 
@@ -3,11 +3,14 @@
  * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
  * SPDX-License-Identifier: Apache-2.0.
  */
+#include <aws/crt/LatencyHistogram.h>
 #include <aws/crt/Types.h>
 
 #include <aws/io/host_resolver.h>
 
 #include <functional>
+#include <memory>
+#include <mutex>
 
 namespace Aws
 {
@@ -17,6 +20,8 @@ namespace Aws
         {
             class EventLoopGroup;
             class HostResolver;
+            struct DefaultHostResolverState;
+            struct CustomHostResolverBridge;
 
             using HostAddress = aws_host_address;
 
@@ -43,6 +48,71 @@ namespace Aws
                 virtual aws_host_resolution_config *GetConfig() noexcept = 0;
             };
 
+            /**
+             * Configuration for a DefaultHostResolver
+             */
+            struct AWS_CRT_CPP_API DefaultHostResolverOptions
+            {
+                /**
+                 * The number of unique hosts to maintain in the cache.
+                 */
+                size_t MaxHosts = 8;
+
+                /**
+                 * How long, in seconds, to keep an address in the cache before evicting it.
+                 */
+                size_t MaxTTL = 30;
+
+                /**
+                 * How often, in milliseconds, a host in use is re-resolved in the background.  Cached addresses keep
+                 * being served while that happens.  0 uses the native default.
+                 */
+                uint64_t ResolveFrequencyMs = 0;
+
+                /**
+                 * If non-zero, hosts requested within this many milliseconds are kept warm: they are re-resolved in
+                 * the background before their cache entry would lapse, so that the next ResolveHost() for them is
+                 * answered from the cache rather than waiting on a fresh resolution.
+                 */
+                uint64_t KeepWarmWindowMs = 0;
+            };
+
+            /**
+             * Resolution statistics for one host, as seen through a DefaultHostResolver
+             */
+            struct AWS_CRT_CPP_API HostResolutionStatistics
+            {
+                /**
+                 * Calls to ResolveHost() for the host
+                 */
+                uint64_t RequestCount = 0;
+
+                /**
+                 * Requests answered straight from the cache
+                 */
+                uint64_t CacheHitCount = 0;
+
+                /**
+                 * Requests that had to wait for a resolution
+                 */
+                uint64_t CacheMissCount = 0;
+
+                /**
+                 * Requests that completed with an error
+                 */
+                uint64_t FailureCount = 0;
+
+                /**
+                 * Background resolutions issued to keep the host warm
+                 */
+                uint64_t KeepWarmCount = 0;
+
+                /**
+                 * Time from ResolveHost() to its callback
+                 */
+                LatencyHistogram ResolveLatency;
+            };
+
             /**
              * A wrapper around the CRT default host resolution system that uses getaddrinfo() farmed off
              * to separate threads in order to resolve names.
@@ -76,6 +146,18 @@ namespace Aws
                  */
                 DefaultHostResolver(size_t maxHosts, size_t maxTTL, Allocator *allocator = ApiAllocator()) noexcept;
 
+                /**
+                 * Resolves DNS addresses.
+                 *
+                 * @param elGroup: EventLoopGroup to use.
+                 * @param options: cache size, TTL and refresh behavior.
+                 * @param allocator memory allocator to use.
+                 */
+                DefaultHostResolver(
+                    EventLoopGroup &elGroup,
+                    const DefaultHostResolverOptions &options,
+                    Allocator *allocator = ApiAllocator()) noexcept;
+
                 ~DefaultHostResolver();
                 DefaultHostResolver(const DefaultHostResolver &) = delete;
                 DefaultHostResolver &operator=(const DefaultHostResolver &) = delete;
@@ -100,6 +182,12 @@ namespace Aws
                  */
                 bool ResolveHost(const String &host, const OnHostResolved &onResolved) noexcept override;
 
+                /**
+                 * @return statistics of every host requested through this resolver, up to MaxHosts of the most
+                 * recently requested ones
+                 */
+                Map<String, HostResolutionStatistics> GetHostStatistics() const;
+
                 /// @private
                 aws_host_resolver *GetUnderlyingHandle() noexcept override { return m_resolver; }
                 /// @private
@@ -110,6 +198,7 @@ namespace Aws
                 aws_host_resolution_config m_config;
                 Allocator *m_allocator;
                 bool m_initialized;
+                std::shared_ptr<DefaultHostResolverState> m_state;
 
                 static void s_onHostResolved(
                     struct aws_host_resolver *resolver,
@@ -118,6 +207,109 @@ namespace Aws
                     const struct aws_array_list *host_addresses,
                     void *user_data);
             };
+
+            /**
+             * Base class for host resolvers implemented in C++.  Subclasses only implement ResolveHost(); this class
+             * backs a native aws_host_resolver with it, so a subclass can be handed to a ClientBootstrap (and
+             * everything built on it) in place of DefaultHostResolver.
+             *
+             * The native resolver may outlive this object, since bootstraps and connections hold references to it.
+             * Once this object is detached, resolutions through the native resolver fail with
+             * AWS_ERROR_INVALID_STATE.  Subclasses must call Detach() first thing in their destructor, before any of
+             * their own members are destroyed.
+             */
+            class AWS_CRT_CPP_API CustomHostResolver : public HostResolver
+            {
+              public:
+                ~CustomHostResolver() override;
+                CustomHostResolver(const CustomHostResolver &) = delete;
+                CustomHostResolver &operator=(const CustomHostResolver &) = delete;
+                CustomHostResolver(CustomHostResolver &&) = delete;
+                CustomHostResolver &operator=(CustomHostResolver &&) = delete;
+
+                /**
+                 * @return true if the instance is in a valid state, false otherwise.
+                 */
+                operator bool() const noexcept { return m_resolver != nullptr; }
+
+                /**
+                 * Counts the addresses the resolver currently knows for a host, without resolving it.  Native
+                 * components use this to size connection pools.  The default implementation knows of none.
+                 *
+                 * @param host host name
+                 * @param flags which kinds of address to count: AWS_GET_HOST_ADDRESS_COUNT_RECORD_TYPE_A and/or
+                 * AWS_GET_HOST_ADDRESS_COUNT_RECORD_TYPE_AAAA
+                 * @return number of addresses
+                 */
+                virtual size_t GetHostAddressCount(const String &host, uint32_t flags) noexcept;
+
+                /// @private
+                aws_host_resolver *GetUnderlyingHandle() noexcept override { return m_resolver; }
+                /// @private
+                aws_host_resolution_config *GetConfig() noexcept override { return &m_config; }
+
+              protected:
+                CustomHostResolver(Allocator *allocator = ApiAllocator()) noexcept;
+
+                /**
+                 * Stops the native resolver from calling into this object, waiting for any call already in progress
+                 * to return.  Safe to call more than once.
+                 */
+                void Detach() noexcept;
+
+                Allocator *m_allocator;
+
+              private:
+                aws_host_resolver *m_resolver;
+                aws_host_resolution_config m_config;
+                CustomHostResolverBridge *m_bridge;
+            };
+
+            /**
+             * Host resolver answering from a fixed table of addresses, without any network traffic or delay.  Useful
+             * for benchmarks, local stand-ins for remote services and deployments that pin endpoints to known IPs.
+             *
+             * Host names are matched case-insensitively.  Addresses are returned in the order they were added.
+             * Names that aren't in the table fail with AWS_IO_DNS_NO_ADDRESS_FOR_HOST.
+             */
+            class AWS_CRT_CPP_API StaticHostResolver final : public CustomHostResolver
+            {
+              public:
+                StaticHostResolver(Allocator *allocator = ApiAllocator()) noexcept;
+                ~StaticHostResolver() override;
+
+                /**
+                 * Adds an address for a host.
+                 *
+                 * @param host host name
+                 * @param address IPv4 or IPv6 address, in text form
+                 * @return true on success. Fails with AWS_ERROR_INVALID_ARGUMENT if address isn't an IP address.
+                 */
+                bool AddAddress(const String &host, const String &address) noexcept;
+
+                /**
+                 * Adds the entries of a hosts file, in the format of /etc/hosts: an address followed by one or more
+                 * host names per line, with '#' starting a comment.  Lines with an invalid address are skipped.
+                 *
+                 * @param path path of the file
+                 * @return true if the file was read
+                 */
+                bool LoadHostsFile(const char *path) noexcept;
+
+                /**
+                 * Answers from the table, invoking onResolved before returning.
+                 */
+                bool ResolveHost(const String &host, const OnHostResolved &onResolved) noexcept override;
+
+                /**
+                 * Counts the host's addresses in the table.
+                 */
+                size_t GetHostAddressCount(const String &host, uint32_t flags) noexcept override;
+
+              private:
+                std::mutex m_lock;
+                Map<String, Vector<HostAddress>> m_addresses;
+            };
         } // namespace Io
     } // namespace Crt
 } // namespace Aws
@@ -95,6 +95,28 @@ namespace Aws
                     return aws_input_stream_get_length(&m_underlying_stream, &length) == 0;
                 }
 
+                /**
+                 * Reads data from the stream without copying it: the stream lends a cursor over its own memory,
+                 * such as a memory-mapped file or an in-memory buffer, and advances past the data lent.  The
+                 * cursor stays valid until it is passed to ReleaseCursor(), even if the stream is read further or
+                 * seeked in the meantime.  Every cursor read must be released, before the stream is destroyed.
+                 *
+                 * Not every stream can lend its memory.  Those that can't fail with AWS_ERROR_UNSUPPORTED_OPERATION,
+                 * and the data should be read with Read() instead.
+                 *
+                 * @param cursor output parameter for the data read.  Empty at the end of the stream, or if no data is
+                 * currently available.
+                 * @param maxLength maximum number of bytes to read
+                 * @return success/failure
+                 */
+                bool ReadCursor(ByteCursor &cursor, size_t maxLength);
+
+                /**
+                 * Returns a cursor obtained from ReadCursor() to the stream
+                 * @param cursor the cursor, as returned by ReadCursor()
+                 */
+                void ReleaseCursor(const ByteCursor &cursor) noexcept;
+
               protected:
                 Allocator *m_allocator;
                 aws_input_stream m_underlying_stream;
@@ -158,6 +180,25 @@ namespace Aws
                  */
                 virtual int64_t PeekImpl() const noexcept = 0;
 
+                /**
+                 * Lends up to maxLength bytes of the stream's own memory, starting at the current position, and
+                 * advances past them.  The memory must stay valid and unchanged until ReleaseCursorImpl() is called
+                 * for the cursor.
+                 *
+                 * The default implementation raises AWS_ERROR_UNSUPPORTED_OPERATION.  Streams that override it should
+                 * also override ReleaseCursorImpl() if lending memory needs any bookkeeping.
+                 *
+                 * @return true if nothing went wrong, including if the cursor is empty because the end of the
+                 * stream was reached.  Return false if an actual failure condition occurs, you SHOULD also raise an
+                 * error via aws_raise_error().
+                 */
+                virtual bool ReadCursorImpl(ByteCursor &cursor, size_t maxLength) noexcept;
+
+                /**
+                 * Takes back memory lent by ReadCursorImpl().  The default implementation does nothing.
+                 */
+                virtual void ReleaseCursorImpl(const ByteCursor &cursor) noexcept;
+
               private:
                 static int s_Seek(aws_input_stream *stream, int64_t offset, enum aws_stream_seek_basis basis);
                 static int s_Read(aws_input_stream *stream, aws_byte_buf *dest);
@@ -192,6 +233,77 @@ namespace Aws
               private:
                 std::shared_ptr<Aws::Crt::Io::IStream> m_stream;
             };
+
+            /**
+             * How MmapFileInputStream reads its file
+             */
+            enum class FileReadMode
+            {
+                /**
+                 * Map the file where the platform supports it and the file is non-empty, otherwise use positional
+                 * reads.  Files on network and FUSE filesystems (NFS, SMB/CIFS, FUSE, Ceph, ...) always use
+                 * positional reads; this is detected on Linux and Apple platforms.
+                 */
+                Auto,
+
+                /**
+                 * Always map the file.  Fails where the platform doesn't support it, or for empty files.
+                 */
+                Mmap,
+
+                /**
+                 * Always use positional reads (pread).  Prefer this for files that may be truncated while read,
+                 * which a mapping reports by killing the process with SIGBUS, and for files on network filesystems
+                 * that Auto doesn't recognize, where faulting in pages of a mapping can stall for a long time.
+                 */
+                PositionalRead,
+            };
+
+            /***
+             * Implementation of Aws::Crt::Io::InputStream over a regular file, for large request bodies.
+             *
+             * The file is memory-mapped where possible and the kernel is advised it will be read sequentially, so
+             * reads are a single copy out of the page cache with readahead, and ReadCursor() lends the mapped pages
+             * without copying at all.  Otherwise the file is read with positional reads.  Either way the length is
+             * taken once when the file is opened, and seeking only moves the read position.
+             */
+            class AWS_CRT_CPP_API MmapFileInputStream : public InputStream
+            {
+              public:
+                /**
+                 * @param path path of the file to read
+                 * @param mode how to read the file
+                 * @param allocator allocator for the stream's state
+                 */
+                MmapFileInputStream(
+                    const char *path,
+                    FileReadMode mode = FileReadMode::Auto,
+                    Aws::Crt::Allocator *allocator = ApiAllocator()) noexcept;
+                ~MmapFileInputStream() override;
+
+                /**
+                 * @return true if the file was opened.  Otherwise the error was raised by the constructor.
+                 */
+                bool IsValid() const noexcept override;
+
+                /**
+                 * @return true if the file is memory-mapped, false if it is read with positional reads
+                 */
+                bool IsMapped() const noexcept;
+
+              protected:
+                bool ReadImpl(ByteBuf &buffer) noexcept override;
+                bool ReadSomeImpl(ByteBuf &buffer) noexcept override;
+                StreamStatus GetStatusImpl() const noexcept override;
+                int64_t GetLengthImpl() const noexcept override;
+                bool SeekImpl(int64_t offset, StreamSeekBasis seekBasis) noexcept override;
+                int64_t PeekImpl() const noexcept override;
+                bool ReadCursorImpl(ByteCursor &cursor, size_t maxLength) noexcept override;
+
+              private:
+                struct Impl;
+                ScopedResource<Impl> m_impl;
+            };
         } // namespace Io
     } // namespace Crt
 } // namespace Aws
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: Apache-2.0.
  */
 
+#include <aws/crt/LatencyHistogram.h>
 #include <aws/crt/Types.h>
 #include <aws/crt/io/ChannelHandler.h>
 #include <aws/io/tls_channel_handler.h>
@@ -22,6 +23,7 @@ namespace Aws
             class Pkcs11Lib;
             class TlsContextPkcs11Options;
             struct TlsConnectionInfo;
+            struct TlsHandshakeMetricsState;
             enum class CertificateSource;
 
             enum class TlsMode
@@ -374,6 +376,9 @@ namespace Aws
                 int m_lastError = AWS_ERROR_SUCCESS;
                 bool m_isInit = false;
 
+                // Handshake metrics state the native options report to, if any; kept alive as long as they are
+                std::shared_ptr<TlsHandshakeMetricsState> m_handshakeMetrics;
+
                 // Internal metrics tracking fields
                 CertificateSource m_metricsCertificateSource;
                 aws_tls_versions m_metricsTlsVersion;
@@ -382,6 +387,59 @@ namespace Aws
                 friend class TlsContext;
             };
 
+            /**
+             * Outcome of a single TLS handshake of a connection created from a TlsContext
+             */
+            struct AWS_CRT_CPP_API TlsHandshakeMetrics
+            {
+                /**
+                 * AWS_ERROR_SUCCESS if the handshake succeeded, otherwise the error it failed with
+                 */
+                int ErrorCode = AWS_ERROR_SUCCESS;
+
+                /**
+                 * Time, in nanoseconds, from the start of negotiation until it completed.  0 if the TLS
+                 * implementation doesn't report handshake timing.
+                 */
+                uint64_t HandshakeDurationNs = 0;
+
+                /**
+                 * Protocol negotiated with ALPN.  Empty if the handshake failed or no protocol was agreed upon.
+                 */
+                String NegotiatedProtocol;
+            };
+
+            /**
+             * Invoked on the connection's event loop thread when a TLS handshake completes
+             */
+            using OnTlsHandshakeCompleted = std::function<void(const TlsHandshakeMetrics &metrics)>;
+
+            /**
+             * Aggregate handshake statistics of the connections created from a TlsContext
+             */
+            struct AWS_CRT_CPP_API TlsHandshakeStatistics
+            {
+                /**
+                 * Handshakes that succeeded
+                 */
+                uint64_t SuccessCount = 0;
+
+                /**
+                 * Handshakes that failed
+                 */
+                uint64_t FailureCount = 0;
+
+                /**
+                 * Durations of the handshakes, successful or not, for which the TLS implementation reported timing
+                 */
+                LatencyHistogram HandshakeLatency;
+
+                /**
+                 * Number of successful handshakes per protocol negotiated with ALPN, with "" for none
+                 */
+                Map<String, uint64_t> NegotiatedProtocolCounts;
+            };
+
             /**
              * Stateful context for TLS with a given configuration.  Per-connection TLS "contexts"
              * (TlsConnectionOptions) are instantiated from this as needed.
@@ -413,6 +471,31 @@ namespace Aws
                  */
                 int GetInitializationError() const noexcept { return m_initializationError; }
 
+                /**
+                 * Sets a callback invoked with the metrics of each handshake of connections whose options are
+                 * created, by NewConnectionOptions(), from this context or any copy of it from now on.
+                 *
+                 * Handshakes are reported through the TlsConnectionOptions a connection was created with, so they
+                 * must outlive the connection's setup.  The connections and connection managers of this library keep
+                 * their own copy for that long.
+                 *
+                 * @param onHandshakeCompleted callback, or an empty function to stop observing handshakes
+                 */
+                void SetOnHandshakeCompleted(OnTlsHandshakeCompleted onHandshakeCompleted) noexcept;
+
+                /**
+                 * Starts collecting the statistics returned by GetHandshakeStatistics() for connections whose
+                 * options are created from this context or any copy of it from now on.  Handshakes are only
+                 * observed once statistics or a SetOnHandshakeCompleted() callback are enabled.
+                 */
+                void EnableHandshakeStatistics() noexcept;
+
+                /**
+                 * @return statistics of the handshakes of connections created from this context and its copies.
+                 * All zero unless EnableHandshakeStatistics() was called.
+                 */
+                TlsHandshakeStatistics GetHandshakeStatistics() const noexcept;
+
                 /// @private
                 aws_tls_ctx *GetUnderlyingHandle() const noexcept { return m_ctx.get(); }
 
@@ -420,6 +503,7 @@ namespace Aws
                 bool isValid() const noexcept { return m_ctx && m_initializationError == AWS_ERROR_SUCCESS; }
 
                 std::shared_ptr<aws_tls_ctx> m_ctx;
+                std::shared_ptr<TlsHandshakeMetricsState> m_handshakeMetrics;
                 int m_initializationError;
                 // Internal metrics tracking fields, track the certificate source
                 CertificateSource m_metricsCertificateSource;
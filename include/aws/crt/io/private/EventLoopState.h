@@ -0,0 +1,70 @@
+/*! \cond DOXYGEN_PRIVATE
+** Hide API from this file in doxygen. Set DOXYGEN_PRIVATE in doxygen
+** config to enable this file for doxygen.
+*/
+
+#pragma once
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+#include <aws/crt/LatencyHistogram.h>
+#include <aws/crt/io/EventLoop.h>
+
+#include <atomic>
+#include <mutex>
+
+namespace Aws
+{
+    namespace Crt
+    {
+        namespace Io
+        {
+            /**
+             * @private
+             * State the C++ bindings keep for one event loop: statistics and the pool of task nodes. Shared between
+             * the EventLoopGroup, the EventLoop handles it gives out and any task scheduled on the loop on their
+             * behalf.
+             */
+            struct EventLoopState
+            {
+                EventLoopState(size_t index, Allocator *allocator) noexcept
+                    : loopIndex(index), allocator(allocator), probesStopped(false), freeTaskNodes(nullptr),
+                      freeTaskNodeCount(0), pendingTaskCount(0), scheduledTaskCount(0)
+                {
+                }
+
+                ~EventLoopState()
+                {
+                    while (freeTaskNodes != nullptr)
+                    {
+                        EventLoopTaskNode *node = freeTaskNodes;
+                        freeTaskNodes = node->nextFree;
+                        Delete(node, allocator);
+                    }
+                }
+
+                size_t loopIndex;
+
+                /* Allocator configured for the loop; task nodes and oversized callables come from it */
+                Allocator *allocator;
+
+                std::mutex lock;
+                LatencyHistogram schedulerLag;
+
+                /* Set once the owning EventLoopGroup is destroyed; pending lag probes stop rescheduling */
+                std::atomic<bool> probesStopped;
+
+                /* Task nodes that finished running, kept for reuse by the next EventLoop::Schedule() */
+                std::mutex taskNodeLock;
+                EventLoopTaskNode *freeTaskNodes;
+                size_t freeTaskNodeCount;
+
+                std::atomic<size_t> pendingTaskCount;
+                std::atomic<uint64_t> scheduledTaskCount;
+            };
+
+        } // namespace Io
+    } // namespace Crt
+} // namespace Aws
+/*! \endcond */
@@ -205,6 +205,38 @@ namespace Aws
                  * ACK before they can be completed.
                  */
                 uint64_t unackedOperationSize;
+
+                /**
+                 * Number of round-trip samples taken from acknowledged operations.  Always zero unless round-trip
+                 * estimation is enabled with Mqtt5ClientOptions::WithRttEstimationEnabled().
+                 */
+                uint64_t rttSampleCount;
+
+                /**
+                 * Smoothed round-trip time between sending a QoS 1 PUBLISH, SUBSCRIBE or UNSUBSCRIBE and receiving its
+                 * acknowledgement, in milliseconds
+                 */
+                uint64_t smoothedRttMs;
+
+                /**
+                 * Smoothed mean deviation of the round-trip time, in milliseconds
+                 */
+                uint64_t rttVariationMs;
+
+                /**
+                 * Ack timeout derived from the round-trip estimate, in seconds.  Zero until a sample is taken.
+                 *
+                 * Advisory only: the running client keeps the ack timeout it was created with.
+                 */
+                uint32_t derivedAckTimeoutSec;
+
+                /**
+                 * Ping timeout derived from the round-trip estimate, in milliseconds, kept below the keep-alive
+                 * interval.  Zero until a sample is taken.
+                 *
+                 * Like derivedAckTimeoutSec, this is advisory only: it is never applied to the running client.
+                 */
+                uint32_t derivedPingTimeoutMs;
             };
 
             /**
@@ -665,6 +697,42 @@ namespace Aws
                  */
                 Mqtt5ClientOptions &WithAckTimeoutSec(uint32_t ackTimeoutSec) noexcept;
 
+                /**
+                 * Sets whether the client estimates the round-trip time to the broker.  Each QoS 1 PUBLISH, SUBSCRIBE
+                 * and UNSUBSCRIBE that is acknowledged yields a sample, which is folded into a smoothed estimate and
+                 * deviation the same way TCP computes SRTT and RTTVAR.  Ack and ping timeouts are derived from the
+                 * estimate, and all values are reported through Mqtt5Client::GetOperationStatistics().
+                 *
+                 * Operations submitted while the client is offline, or while other operations are still waiting to be
+                 * written, are not sampled, and neither are operations acknowledged on a later connection than the one
+                 * they were submitted on.
+                 *
+                 * The derived timeouts are advisory only.  The client's ack and ping timeouts are fixed when it is
+                 * created and are not changed by the estimate, not even when it reconnects, and neither is its
+                 * reconnect backoff.  Use WithTimeoutsFromRttEstimate() to carry the derived timeouts over to a
+                 * replacement client.
+                 *
+                 * Disabled by default.
+                 *
+                 * @param enabled whether to estimate round-trip time
+                 *
+                 * @return this option object
+                 */
+                Mqtt5ClientOptions &WithRttEstimationEnabled(bool enabled) noexcept;
+
+                /**
+                 * Sets the ack and ping timeouts to the values derived from another client's round-trip estimate.
+                 * Timeouts are left unchanged if the statistics contain no round-trip samples.  The ping timeout is
+                 * kept below the keep-alive interval of the connect options, so set those with WithConnectOptions()
+                 * first.
+                 *
+                 * @param statistics operation statistics of a client with round-trip estimation enabled
+                 *
+                 * @return this option object
+                 */
+                Mqtt5ClientOptions &WithTimeoutsFromRttEstimate(
+                    const Mqtt5ClientOperationStatistics &statistics) noexcept;
+
                 /**
                  * Sets callback for transform HTTP request.
                  * This callback allows a custom transformation of the HTTP request that acts as the websocket
@@ -896,6 +964,11 @@ namespace Aws
                  */
                 uint32_t m_ackTimeoutSec;
 
+                /**
+                 * Whether the client estimates round-trip time from operation acknowledgements
+                 */
+                bool m_rttEstimationEnabled;
+
                 bool m_enableMetrics = true;
                 Crt::Optional<Crt::Mqtt::AWSIoTMetrics> m_sdkMetrics;
 
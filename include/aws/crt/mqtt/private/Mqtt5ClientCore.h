@@ -19,6 +19,56 @@ namespace Aws
     {
         namespace Mqtt5
         {
+            /**
+             * Round-trip time estimator for operation acknowledgements, following the SRTT/RTTVAR computation of
+             * RFC 6298.  Samples arrive on the client's event loop while statistics are read from user threads.
+             *
+             * Only operations submitted on an established connection are sampled, and only if that connection is
+             * still the current one when they are acknowledged, so that time spent offline does not count as
+             * round-trip time.
+             */
+            class Mqtt5RttEstimator final
+            {
+              public:
+                /**
+                 * @param keepAliveIntervalSec keep-alive interval of the client's connections; the derived ping
+                 * timeout is kept below it.  0 if the client doesn't send pings.
+                 */
+                explicit Mqtt5RttEstimator(uint16_t keepAliveIntervalSec) noexcept;
+
+                void OnConnectionSuccess() noexcept;
+
+                void OnDisconnection() noexcept;
+
+                /**
+                 * @return id of the current connection, or 0 if the client is not connected
+                 */
+                uint64_t GetConnectionId() const noexcept;
+
+                /**
+                 * Adds a sample for an operation submitted on connection connectionId.  Ignored if that is not the
+                 * current connection.
+                 */
+                void AddSample(uint64_t rttNs, uint64_t connectionId) noexcept;
+
+                void GetStatistics(Mqtt5ClientOperationStatistics &statistics) const noexcept;
+
+                /**
+                 * Caps a ping timeout below the keep-alive interval, which the native client requires.
+                 */
+                static uint32_t s_clampPingTimeoutMs(uint32_t pingTimeoutMs, uint16_t keepAliveIntervalSec) noexcept;
+
+              private:
+                uint16_t m_keepAliveIntervalSec;
+
+                mutable std::mutex m_lock;
+                uint64_t m_connectionId;
+                bool m_connected;
+                uint64_t m_sampleCount;
+                uint64_t m_smoothedRttNs;
+                uint64_t m_rttVariationNs;
+            };
+
             /**
              * The Mqtt5ClientCore is an internal class for Mqtt5Client. The class is used to handle communication
              * between Mqtt5Client and underlying c mqtt5 client. This class should only be used internally by
@@ -121,6 +171,21 @@ namespace Aws
 
                 struct aws_mqtt5_client *GetUnderlyingHandle() const noexcept { return m_client; }
 
+                /**
+                 * Fills in the round-trip fields of the statistics; leaves them untouched if estimation is disabled.
+                 */
+                void GetRttStatistics(Mqtt5ClientOperationStatistics &statistics) const noexcept;
+
+                /**
+                 * Starts a round-trip sample for an operation about to be submitted.
+                 *
+                 * @return id of the connection to pass to RecordRttSample(), or 0 if the operation would not be
+                 * written right away because the client is offline or other operations are waiting ahead of it
+                 */
+                uint64_t BeginRttSample() noexcept;
+
+                void RecordRttSample(uint64_t rttNs, uint64_t connectionId) noexcept;
+
               private:
                 Mqtt5ClientCore(const Mqtt5ClientOptions &options, Allocator *allocator = ApiAllocator()) noexcept;
 
@@ -221,6 +286,9 @@ namespace Aws
                  */
                 std::recursive_mutex m_callback_lock;
 
+                /* Only set if round-trip estimation is enabled */
+                ScopedResource<Mqtt5RttEstimator> m_rttEstimator;
+
                 aws_mqtt5_client *m_client;
                 Allocator *m_allocator;
             };
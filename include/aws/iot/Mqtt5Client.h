@@ -25,6 +25,7 @@ namespace Aws
 
     namespace Iot
     {
+        class Mqtt5ConnectScheduler;
 
         /**
          * Class encapsulating configuration for establishing an Aws IoT Mqtt5 Connectin with custom authorizer
@@ -121,6 +122,8 @@ namespace Aws
          */
         class AWS_CRT_CPP_API Mqtt5ClientBuilder final
         {
+            friend class Mqtt5ConnectScheduler;
+
           public:
             /**
              * Set the builder up for MTLS using certPath and pkeyPath. These are files on disk and must be in the
@@ -451,6 +454,27 @@ namespace Aws
              */
             Mqtt5ClientBuilder &WithAckTimeoutSeconds(uint32_t ackTimeoutSec) noexcept;
 
+            /**
+             * Sets whether the client estimates the round-trip time to the broker from operation acknowledgements.
+             * See Crt::Mqtt5::Mqtt5ClientOptions::WithRttEstimationEnabled().
+             *
+             * @param enabled whether to estimate round-trip time
+             *
+             * @return this option object
+             */
+            Mqtt5ClientBuilder &WithRttEstimationEnabled(bool enabled) noexcept;
+
+            /**
+             * Sets the ack and ping timeouts to the values derived from another client's round-trip estimate.
+             * See Crt::Mqtt5::Mqtt5ClientOptions::WithTimeoutsFromRttEstimate().
+             *
+             * @param statistics operation statistics of a client with round-trip estimation enabled
+             *
+             * @return this option object
+             */
+            Mqtt5ClientBuilder &WithTimeoutsFromRttEstimate(
+                const Crt::Mqtt5::Mqtt5ClientOperationStatistics &statistics) noexcept;
+
             /**
              * Overrides the default SDK Name to send as a metric in the MQTT CONNECT packet.
              *
@@ -667,6 +691,14 @@ namespace Aws
 
             Crt::Mqtt5::Mqtt5ClientOptions *m_options;
 
+            /**
+             * Copies of the user's bootstrap and lifecycle callbacks, kept so that a Mqtt5ConnectScheduler can
+             * override them for one build and then restore the builder.
+             */
+            Crt::Io::ClientBootstrap *m_bootstrap;
+            OnConnectionSuccessHandler m_onConnectionSuccess;
+            OnConnectionFailureHandler m_onConnectionFailure;
+
             /* Error */
             int m_lastError;
 
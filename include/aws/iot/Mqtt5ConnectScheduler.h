@@ -0,0 +1,221 @@
+#pragma once
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+#include <aws/crt/Exports.h>
+#include <aws/crt/Optional.h>
+#include <aws/crt/Types.h>
+#include <aws/iot/Mqtt5Client.h>
+
+#include <functional>
+#include <memory>
+
+#if !BYO_CRYPTO
+
+namespace Aws
+{
+    namespace Iot
+    {
+        class Mqtt5ConnectSchedulerState;
+
+        /**
+         * Progress of a fleet of clients started through an Mqtt5ConnectScheduler
+         */
+        struct AWS_CRT_CPP_API Mqtt5ConnectSchedulerStatistics
+        {
+            Mqtt5ConnectSchedulerStatistics()
+                : clientCount(0), startedClientCount(0), connectedClientCount(0), connectionFailureCount(0)
+            {
+            }
+
+            /**
+             * Number of clients built through the scheduler
+             */
+            uint64_t clientCount;
+
+            /**
+             * Number of clients the scheduler has called Start() on so far
+             */
+            uint64_t startedClientCount;
+
+            /**
+             * Number of clients that have successfully connected at least once
+             */
+            uint64_t connectedClientCount;
+
+            /**
+             * Total number of failed connection attempts across all clients, including retries
+             */
+            uint64_t connectionFailureCount;
+
+            /**
+             * Time between Mqtt5ConnectScheduler::Start() and the first successful connection of the last client.
+             * Empty until every client has connected.
+             */
+            Crt::Optional<uint64_t> timeToAllConnectedMs;
+        };
+
+        /**
+         * Invoked once every client built through the scheduler has successfully connected.  Invoked on an event loop
+         * thread.
+         */
+        using OnAllClientsConnectedHandler = std::function<void(const Mqtt5ConnectSchedulerStatistics &)>;
+
+        /**
+         * Configuration for an Mqtt5ConnectScheduler
+         */
+        class AWS_CRT_CPP_API Mqtt5ConnectSchedulerOptions final
+        {
+            friend class Mqtt5ConnectScheduler;
+            friend class Mqtt5ConnectSchedulerState;
+
+          public:
+            Mqtt5ConnectSchedulerOptions() noexcept;
+
+            /**
+             * Sets the sustained rate at which the scheduler starts clients.  This is the refill rate of the token
+             * bucket.  A value of 0 disables pacing and clients are started as soon as their jitter delay elapses.
+             *
+             * Defaults to 100 connects per second.
+             *
+             * @param connectsPerSecond number of clients to start per second
+             *
+             * @return this options object
+             */
+            Mqtt5ConnectSchedulerOptions &WithConnectsPerSecond(double connectsPerSecond) noexcept;
+
+            /**
+             * Sets the token bucket capacity: the number of clients that may be started back-to-back before pacing
+             * kicks in.
+             *
+             * Defaults to 1.
+             *
+             * @param burstSize maximum number of tokens in the bucket
+             *
+             * @return this options object
+             */
+            Mqtt5ConnectSchedulerOptions &WithBurstSize(uint32_t burstSize) noexcept;
+
+            /**
+             * Sets the upper bound of the random delay applied to each client's start, measured from
+             * Mqtt5ConnectScheduler::Start().  Each client draws its delay uniformly from [0, maxStartJitterMs].
+             *
+             * Defaults to 0 (no jitter).
+             *
+             * @param maxStartJitterMs maximum start delay in milliseconds
+             *
+             * @return this options object
+             */
+            Mqtt5ConnectSchedulerOptions &WithMaxStartJitterMs(uint32_t maxStartJitterMs) noexcept;
+
+            /**
+             * Sets the bootstraps that clients are balanced across.  Each client built through the scheduler is
+             * assigned the bootstrap that currently has the fewest clients.  An MQTT5 client binds to one event loop
+             * of its bootstrap's EventLoopGroup when it is created, so to balance clients across individual event
+             * loop threads pass one bootstrap per single-threaded EventLoopGroup.
+             *
+             * If left empty, the builder's own bootstrap is used unchanged.
+             *
+             * @param bootstraps bootstraps to distribute clients across.  They must outlive the clients.
+             *
+             * @return this options object
+             */
+            Mqtt5ConnectSchedulerOptions &WithBootstraps(Crt::Vector<Crt::Io::ClientBootstrap *> bootstraps) noexcept;
+
+            /**
+             * Sets the callback invoked once every client built through the scheduler has connected.
+             *
+             * @param callback
+             *
+             * @return this options object
+             */
+            Mqtt5ConnectSchedulerOptions &WithAllClientsConnectedCallback(
+                OnAllClientsConnectedHandler callback) noexcept;
+
+          private:
+            double m_connectsPerSecond;
+            uint32_t m_burstSize;
+            uint32_t m_maxStartJitterMs;
+            Crt::Vector<Crt::Io::ClientBootstrap *> m_bootstraps;
+            OnAllClientsConnectedHandler m_onAllClientsConnected;
+        };
+
+        /**
+         * Paces the Start() of a large number of MQTT5 clients so that host resolution, TLS handshakes and the
+         * broker's connect rate limit are not hit all at once.
+         *
+         * Clients are built through the scheduler from a Mqtt5ClientBuilder and are started, after
+         * Mqtt5ConnectScheduler::Start(), in order of a randomly jittered start time subject to a token bucket rate
+         * limit.
+         */
+        class AWS_CRT_CPP_API Mqtt5ConnectScheduler final
+        {
+          public:
+            /**
+             * Factory function for a connect scheduler
+             *
+             * @param options scheduler configuration
+             * @param allocator memory allocator to use
+             *
+             * @return a new scheduler, or nullptr on failure
+             */
+            static std::shared_ptr<Mqtt5ConnectScheduler> NewMqtt5ConnectScheduler(
+                const Mqtt5ConnectSchedulerOptions &options,
+                Crt::Allocator *allocator = Crt::ApiAllocator()) noexcept;
+
+            /**
+             * Builds a client from the builder and registers it with the scheduler.  The client is not started; the
+             * scheduler will start it after Start() is called.  Connection success and failure callbacks already set
+             * on the builder are still invoked.
+             *
+             * Must be called before Start().
+             *
+             * @param builder builder to create the client from
+             *
+             * @return the new client, or nullptr on failure
+             */
+            std::shared_ptr<Crt::Mqtt5::Mqtt5Client> Build(Mqtt5ClientBuilder &builder) noexcept;
+
+            /**
+             * Begins starting the registered clients.
+             *
+             * @return true if the scheduler was started, false if it was already started or failed to schedule
+             */
+            bool Start() noexcept;
+
+            /**
+             * @return a snapshot of the scheduler's progress
+             */
+            Mqtt5ConnectSchedulerStatistics GetStatistics() const noexcept;
+
+            /**
+             * @return the value of the last aws error encountered by operations on this instance.
+             */
+            int LastError() const noexcept { return m_lastError ? m_lastError : AWS_ERROR_UNKNOWN; }
+
+            /**
+             * Stops any clients that have not yet been started from being started.  Clients that were already started
+             * are left running.
+             */
+            ~Mqtt5ConnectScheduler();
+
+            Mqtt5ConnectScheduler(const Mqtt5ConnectScheduler &) = delete;
+            Mqtt5ConnectScheduler(Mqtt5ConnectScheduler &&) = delete;
+            Mqtt5ConnectScheduler &operator=(const Mqtt5ConnectScheduler &) = delete;
+            Mqtt5ConnectScheduler &operator=(Mqtt5ConnectScheduler &&) = delete;
+
+          private:
+            Mqtt5ConnectScheduler(const Mqtt5ConnectSchedulerOptions &options, Crt::Allocator *allocator) noexcept;
+
+            Crt::Allocator *m_allocator;
+            Crt::Vector<Crt::Io::ClientBootstrap *> m_bootstraps;
+            Crt::Vector<size_t> m_bootstrapClientCounts;
+            std::shared_ptr<Mqtt5ConnectSchedulerState> m_state;
+            int m_lastError;
+        };
+
+    } // namespace Iot
+} // namespace Aws
+
+#endif // !BYO_CRYPTO
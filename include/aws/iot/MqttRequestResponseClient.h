@@ -7,9 +7,12 @@
 #include <aws/crt/Exports.h>
 
 #include <aws/crt/Allocator.h>
+#include <aws/crt/JsonObject.h>
+#include <aws/crt/LatencyHistogram.h>
 #include <aws/crt/Optional.h>
 #include <aws/crt/Types.h>
 #include <aws/crt/Variant.h>
+#include <aws/crt/cbor/Cbor.h>
 #include <aws/crt/mqtt/Mqtt5Packets.h>
 #include <aws/mqtt/request-response/request_response_client.h>
 
@@ -252,6 +255,110 @@ namespace Aws
              */
             using IncomingPublishEventHandler = std::function<void(IncomingPublishEvent &&)>;
 
+            /**
+             * Interface for decoding a message payload into an instance of a modeled type.
+             *
+             * The payload is borrowed from the underlying MQTT client and is only valid for the duration of the call;
+             * implementations must decode from it in place rather than retaining it.
+             *
+             * @tparam T modeled message type to decode into
+             */
+            template <typename T> class IPayloadDecoder
+            {
+              public:
+                virtual ~IPayloadDecoder() = default;
+
+                /**
+                 * Decodes a payload into an existing instance of the modeled type.
+                 *
+                 * @param payload message payload, valid only for the duration of the call
+                 * @param target instance to decode into.  The same instance may be reused across calls, so decoders
+                 * must overwrite every field they populate.
+                 * @return true if the payload was successfully decoded, false otherwise
+                 */
+                virtual bool Decode(Aws::Crt::ByteCursor payload, T &target) noexcept = 0;
+            };
+
+            /**
+             * Payload decoder that parses a JSON payload directly from the borrowed payload bytes, without an
+             * intermediate String copy, and hands the resulting view to a user-supplied function.
+             *
+             * The JSON parser builds a document tree for every payload, so this decoder allocates per message.  Use
+             * CborPayloadDecoder where per-message allocations matter.
+             *
+             * @tparam T modeled message type to decode into
+             */
+            template <typename T> class JsonPayloadDecoder : public IPayloadDecoder<T>
+            {
+              public:
+                /**
+                 * Signature of the function that fills the modeled type from a JSON view
+                 */
+                using ViewDecodeFunction = bool (*)(const Aws::Crt::JsonView &view, T &target);
+
+                explicit JsonPayloadDecoder(ViewDecodeFunction decodeFunction) : m_decodeFunction(decodeFunction) {}
+
+                bool Decode(Aws::Crt::ByteCursor payload, T &target) noexcept override
+                {
+                    Aws::Crt::JsonObject document(payload);
+                    if (!document.WasParseSuccessful())
+                    {
+                        return false;
+                    }
+
+                    return m_decodeFunction(document.View(), target);
+                }
+
+              private:
+                ViewDecodeFunction m_decodeFunction;
+            };
+
+            /**
+             * Payload decoder that walks a CBOR payload directly from the borrowed payload bytes with a
+             * Cbor::CborDecoder and hands the decoder to a user-supplied function.
+             *
+             * The Cbor::CborDecoder is created once and pointed at each new payload, and text and byte strings are
+             * returned as cursors into the payload, so decoding itself does not allocate.  Because the decoder is
+             * reused, an instance must only be used by streams of a single client, whose payloads arrive serially.
+             *
+             * @tparam T modeled message type to decode into
+             */
+            template <typename T> class CborPayloadDecoder : public IPayloadDecoder<T>
+            {
+              public:
+                /**
+                 * Signature of the function that fills the modeled type from a CBOR decoder positioned at the start of
+                 * the payload
+                 */
+                using CborDecodeFunction = bool (*)(Aws::Crt::Cbor::CborDecoder &decoder, T &target);
+
+                explicit CborPayloadDecoder(
+                    CborDecodeFunction decodeFunction,
+                    Aws::Crt::Allocator *allocator = Aws::Crt::ApiAllocator())
+                    : m_decodeFunction(decodeFunction),
+                      m_decoder(
+                          Aws::Crt::New<Aws::Crt::Cbor::CborDecoder>(allocator, Aws::Crt::ByteCursor(), allocator),
+                          [allocator](Aws::Crt::Cbor::CborDecoder *decoder) { Aws::Crt::Delete(decoder, allocator); })
+                {
+                }
+
+                bool Decode(Aws::Crt::ByteCursor payload, T &target) noexcept override
+                {
+                    if (!m_decoder)
+                    {
+                        return false;
+                    }
+
+                    m_decoder->ResetSource(payload);
+
+                    return m_decodeFunction(*m_decoder, target);
+                }
+
+              private:
+                CborDecodeFunction m_decodeFunction;
+                Aws::Crt::ScopedResource<Aws::Crt::Cbor::CborDecoder> m_decoder;
+            };
+
             /**
              * Encapsulates a response to an AWS IoT Core MQTT-based service request
              *
@@ -474,6 +581,125 @@ namespace Aws
                 IncomingPublishEventHandler incomingPublishEventHandler;
             };
 
+            /**
+             * Configuration options for a streaming operation whose payloads are decoded in place into a modeled type.
+             *
+             * @tparam T modeled message type emitted by the stream
+             */
+            template <typename T> class DecodedStreamingOperationOptions
+            {
+              public:
+                DecodedStreamingOperationOptions() : m_subscriptionTopicFilter()
+                {
+                    AWS_ZERO_STRUCT(m_subscriptionTopicFilter);
+                }
+
+                /**
+                 * Sets the topic filter the streaming operation subscribes to.  The options do not own this topic
+                 * filter; it only needs to live until the stream is created.
+                 *
+                 * @param subscriptionTopicFilter topic filter to subscribe to
+                 * @return reference to this
+                 */
+                DecodedStreamingOperationOptions &WithSubscriptionTopicFilter(
+                    Aws::Crt::ByteCursor subscriptionTopicFilter)
+                {
+                    m_subscriptionTopicFilter = subscriptionTopicFilter;
+                    return *this;
+                }
+
+                /**
+                 * Sets the handler function a streaming operation will use for subscription status events.
+                 *
+                 * @param handler the handler function a streaming operation will use for subscription status events
+                 * @return reference to this
+                 */
+                DecodedStreamingOperationOptions &WithSubscriptionStatusEventHandler(
+                    const SubscriptionStatusEventHandler &handler)
+                {
+                    m_subscriptionStatusEventHandler = handler;
+                    return *this;
+                }
+
+                /**
+                 * Sets the decoder used to turn each message payload into the modeled type.
+                 *
+                 * @param decoder payload decoder
+                 * @return reference to this
+                 */
+                DecodedStreamingOperationOptions &WithPayloadDecoder(std::shared_ptr<IPayloadDecoder<T>> decoder)
+                {
+                    m_payloadDecoder = std::move(decoder);
+                    return *this;
+                }
+
+                /**
+                 * Sets the instance that each payload is decoded into.  If not set, the stream default-constructs one.
+                 * The instance is reused for every message, so no per-message allocation is needed for the target.
+                 *
+                 * @param target instance to decode into
+                 * @return reference to this
+                 */
+                DecodedStreamingOperationOptions &WithDecodeTarget(std::shared_ptr<T> target)
+                {
+                    m_decodeTarget = std::move(target);
+                    return *this;
+                }
+
+                /**
+                 * Sets the handler invoked with each successfully decoded message.  The reference is only valid for
+                 * the duration of the call.
+                 *
+                 * @param handler the handler function for decoded messages
+                 * @return reference to this
+                 */
+                DecodedStreamingOperationOptions &WithStreamHandler(const std::function<void(const T &)> &handler)
+                {
+                    m_streamHandler = handler;
+                    return *this;
+                }
+
+                /**
+                 * Sets the handler invoked with the raw event when a payload fails to decode.
+                 *
+                 * @param handler the handler function for undecodable messages
+                 * @return reference to this
+                 */
+                DecodedStreamingOperationOptions &WithDecodeFailureHandler(const IncomingPublishEventHandler &handler)
+                {
+                    m_decodeFailureHandler = handler;
+                    return *this;
+                }
+
+                Aws::Crt::ByteCursor GetSubscriptionTopicFilter() const { return m_subscriptionTopicFilter; }
+
+                const SubscriptionStatusEventHandler &GetSubscriptionStatusEventHandler() const
+                {
+                    return m_subscriptionStatusEventHandler;
+                }
+
+                const std::shared_ptr<IPayloadDecoder<T>> &GetPayloadDecoder() const { return m_payloadDecoder; }
+
+                const std::shared_ptr<T> &GetDecodeTarget() const { return m_decodeTarget; }
+
+                const std::function<void(const T &)> &GetStreamHandler() const { return m_streamHandler; }
+
+                const IncomingPublishEventHandler &GetDecodeFailureHandler() const { return m_decodeFailureHandler; }
+
+              private:
+                Aws::Crt::ByteCursor m_subscriptionTopicFilter;
+
+                SubscriptionStatusEventHandler m_subscriptionStatusEventHandler;
+
+                std::shared_ptr<IPayloadDecoder<T>> m_payloadDecoder;
+
+                std::shared_ptr<T> m_decodeTarget;
+
+                std::function<void(const T &)> m_streamHandler;
+
+                IncomingPublishEventHandler m_decodeFailureHandler;
+            };
+
             /**
              * Base type for all streaming operations
              */
@@ -567,6 +793,52 @@ namespace Aws
                  */
                 uint32_t GetOperationTimeoutInSeconds() const { return m_operationTimeoutInSeconds; }
 
+                /**
+                 * Sets whether the client tracks in-flight requests, per-topic latency and subscription usage so that
+                 * they can be read through IMqttRequestResponseClient::GetMetrics().  Tracking adds a lock and a small
+                 * amount of bookkeeping to every request, so it is off by default.
+                 *
+                 * @param enabled whether to collect operation metrics
+                 * @return reference to this
+                 */
+                RequestResponseClientOptions &WithOperationMetricsEnabled(bool enabled)
+                {
+                    m_operationMetricsEnabled = enabled;
+                    return *this;
+                }
+
+                /**
+                 * Gets whether the client collects operation metrics.
+                 *
+                 * @return whether the client collects operation metrics
+                 */
+                bool GetOperationMetricsEnabled() const { return m_operationMetricsEnabled; }
+
+                /**
+                 * Sets whether concurrent requests with an identical publish topic and payload are coalesced.  While a
+                 * request is in flight, any further request with the same publish topic and serialized payload is not
+                 * sent; instead its result handler is invoked with the response (or error) of the in-flight request.
+                 * This saves a publish and a response-path subscription per duplicate.
+                 *
+                 * Coalesced requests are assumed to share subscription topic filters and response paths; this holds
+                 * for service clients where both are derived from the publish topic.
+                 *
+                 * @param enabled whether to coalesce identical in-flight requests
+                 * @return reference to this
+                 */
+                RequestResponseClientOptions &WithRequestCoalescingEnabled(bool enabled)
+                {
+                    m_requestCoalescingEnabled = enabled;
+                    return *this;
+                }
+
+                /**
+                 * Gets whether the client coalesces identical in-flight requests.
+                 *
+                 * @return whether the client coalesces identical in-flight requests
+                 */
+                bool GetRequestCoalescingEnabled() const { return m_requestCoalescingEnabled; }
+
               private:
                 /**
                  * Maximum number of subscriptions that the client will concurrently use for request-response operations
@@ -582,6 +854,129 @@ namespace Aws
                  * Duration, in seconds, that a request-response operation will wait for completion before giving up
                  */
                 uint32_t m_operationTimeoutInSeconds = 0;
+
+                /**
+                 * Whether the client collects operation metrics
+                 */
+                bool m_operationMetricsEnabled = false;
+
+                /**
+                 * Whether the client coalesces identical in-flight requests
+                 */
+                bool m_requestCoalescingEnabled = false;
+            };
+
+            /**
+             * Metrics for the requests submitted to a single operation (publish) topic
+             */
+            struct AWS_CRT_CPP_API RequestResponseOperationMetrics
+            {
+                /**
+                 * Number of requests submitted to the topic
+                 */
+                uint64_t submittedCount = 0;
+
+                /**
+                 * Number of requests that completed with a response
+                 */
+                uint64_t successCount = 0;
+
+                /**
+                 * Number of requests that completed with an error, including timeouts
+                 */
+                uint64_t failureCount = 0;
+
+                /**
+                 * Number of requests that failed because they exceeded the operation timeout
+                 */
+                uint64_t timeoutCount = 0;
+
+                /**
+                 * Time from submission to completion of every completed request, successful or not
+                 */
+                Aws::Crt::LatencyHistogram latency;
+            };
+
+            /**
+             * Snapshot of a request-response client's operation metrics
+             */
+            struct AWS_CRT_CPP_API RequestResponseClientMetrics
+            {
+                /**
+                 * Number of submitted requests that have not yet completed
+                 */
+                uint64_t inFlightRequestCount = 0;
+
+                /**
+                 * Number of in-flight requests that carry a correlation token
+                 */
+                uint64_t inFlightCorrelatedRequestCount = 0;
+
+                /**
+                 * Number of requests submitted with a correlation token that was already in use by another in-flight
+                 * request.  Responses to such requests cannot be routed reliably.
+                 */
+                uint64_t duplicateCorrelationTokenCount = 0;
+
+                /**
+                 * Number of requests that were not sent because they were coalesced into an identical in-flight
+                 * request.  Coalesced requests are not counted as in-flight or completed.
+                 */
+                uint64_t coalescedRequestCount = 0;
+
+                /**
+                 * Age of the oldest in-flight request, in milliseconds
+                 */
+                uint64_t oldestInFlightRequestAgeMs = 0;
+
+                /**
+                 * Number of completed requests, successful or not
+                 */
+                uint64_t completedRequestCount = 0;
+
+                /**
+                 * Number of requests that failed because they exceeded the operation timeout
+                 */
+                uint64_t timeoutCount = 0;
+
+                /**
+                 * Estimated number of request-response subscriptions in use: the number of distinct subscription topic
+                 * filters across in-flight requests, capped at the configured maximum
+                 */
+                uint32_t requestResponseSubscriptionsInUse = 0;
+
+                /**
+                 * Configured maximum number of request-response subscriptions
+                 */
+                uint32_t maxRequestResponseSubscriptions = 0;
+
+                /**
+                 * Number of streaming subscriptions in use: the number of distinct topic filters across open streaming
+                 * operations
+                 */
+                uint32_t streamingSubscriptionsInUse = 0;
+
+                /**
+                 * Configured maximum number of streaming subscriptions
+                 */
+                uint32_t maxStreamingSubscriptions = 0;
+
+                /**
+                 * Per operation metrics, keyed by publish topic with the thing names, named shadow names and job ids of
+                 * AWS IoT thing topics replaced by "+".  At most 64 keys are tracked; requests to further topics are
+                 * counted under "#".
+                 */
+                Aws::Crt::Map<Aws::Crt::String, RequestResponseOperationMetrics> operations;
+
+                /**
+                 * @return fraction of completed requests that timed out
+                 */
+                double GetTimeoutRate() const
+                {
+                    return completedRequestCount > 0
+                               ? static_cast<double>(timeoutCount) / static_cast<double>(completedRequestCount)
+                               : 0.0;
+                }
             };
 
             /**
@@ -616,6 +1011,71 @@ namespace Aws
                  */
                 virtual std::shared_ptr<IStreamingOperation> CreateStream(
                     const StreamingOperationOptionsInternal &options) = 0;
+
+                /**
+                 * Creates a new streaming operation that decodes each incoming payload in place, straight from the
+                 * MQTT client's buffer, into the modeled type and invokes the stream handler with the result.
+                 *
+                 * Payloads are delivered serially on the client's event loop, so the decode target is reused across
+                 * messages.  Whether decoding allocates per message depends on the decoder and on T; see
+                 * JsonPayloadDecoder and CborPayloadDecoder.
+                 *
+                 * @tparam T modeled message type emitted by the stream
+                 * @param options configuration options for the streaming operation to construct
+                 * @param allocator allocator to use for the default decode target
+                 * @return a new streaming operation, or nullptr if creation failed
+                 */
+                template <typename T>
+                std::shared_ptr<IStreamingOperation> CreateDecodedStream(
+                    const DecodedStreamingOperationOptions<T> &options,
+                    Aws::Crt::Allocator *allocator = Aws::Crt::ApiAllocator())
+                {
+                    std::shared_ptr<IPayloadDecoder<T>> decoder = options.GetPayloadDecoder();
+                    if (!decoder)
+                    {
+                        aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+                        return nullptr;
+                    }
+
+                    std::shared_ptr<T> target = options.GetDecodeTarget();
+                    if (!target)
+                    {
+                        target = Aws::Crt::MakeShared<T>(allocator);
+                    }
+
+                    std::function<void(const T &)> streamHandler = options.GetStreamHandler();
+                    IncomingPublishEventHandler decodeFailureHandler = options.GetDecodeFailureHandler();
+
+                    StreamingOperationOptionsInternal internalOptions;
+                    internalOptions.subscriptionTopicFilter = options.GetSubscriptionTopicFilter();
+                    internalOptions.subscriptionStatusEventHandler = options.GetSubscriptionStatusEventHandler();
+                    internalOptions.incomingPublishEventHandler =
+                        [decoder, target, streamHandler, decodeFailureHandler](IncomingPublishEvent &&event)
+                    {
+                        if (decoder->Decode(event.GetPayload(), *target))
+                        {
+                            if (streamHandler)
+                            {
+                                streamHandler(*target);
+                            }
+                        }
+                        else if (decodeFailureHandler)
+                        {
+                            decodeFailureHandler(std::move(event));
+                        }
+                    };
+
+                    return CreateStream(internalOptions);
+                }
+
+                /**
+                 * Gets a snapshot of the client's operation metrics.  Metrics are only collected if enabled with
+                 * RequestResponseClientOptions::WithOperationMetricsEnabled(); otherwise an empty snapshot is
+                 * returned.
+                 *
+                 * @return a snapshot of the client's operation metrics
+                 */
+                virtual RequestResponseClientMetrics GetMetrics() const { return RequestResponseClientMetrics(); }
             };
 
             /**
@@ -26,6 +26,11 @@ namespace Aws
             m_value = aws_json_value_new_from_string(ApiAllocator(), ByteCursorFromString(stringToParse));
         }
 
+        JsonObject::JsonObject(ByteCursor bytesToParse)
+        {
+            m_value = aws_json_value_new_from_string(ApiAllocator(), bytesToParse);
+        }
+
         JsonObject::JsonObject(const JsonObject &other) : JsonObject(other.m_value) {}
 
         JsonObject::JsonObject(JsonObject &&other) noexcept
@@ -0,0 +1,136 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+#include <aws/crt/LatencyHistogram.h>
+
+#include <aws/common/math.h>
+
+#include <cmath>
+
+namespace Aws
+{
+    namespace Crt
+    {
+        const size_t LatencyHistogram::BUCKET_COUNT;
+
+        static size_t s_BucketIndex(uint64_t durationNs) noexcept
+        {
+            if (durationNs == 0)
+            {
+                return 0;
+            }
+
+            size_t index = 64 - aws_clz_u64(durationNs);
+            return index < LatencyHistogram::BUCKET_COUNT ? index : LatencyHistogram::BUCKET_COUNT - 1;
+        }
+
+        LatencyHistogram::LatencyHistogram() noexcept
+        {
+            Reset();
+        }
+
+        void LatencyHistogram::Record(uint64_t durationNs) noexcept
+        {
+            ++m_buckets[s_BucketIndex(durationNs)];
+            ++m_sampleCount;
+            m_totalNs = aws_add_u64_saturating(m_totalNs, durationNs);
+            if (durationNs < m_minNs)
+            {
+                m_minNs = durationNs;
+            }
+            if (durationNs > m_maxNs)
+            {
+                m_maxNs = durationNs;
+            }
+        }
+
+        void LatencyHistogram::Merge(const LatencyHistogram &other) noexcept
+        {
+            for (size_t i = 0; i < BUCKET_COUNT; ++i)
+            {
+                m_buckets[i] += other.m_buckets[i];
+            }
+
+            m_sampleCount += other.m_sampleCount;
+            m_totalNs = aws_add_u64_saturating(m_totalNs, other.m_totalNs);
+            if (other.m_minNs < m_minNs)
+            {
+                m_minNs = other.m_minNs;
+            }
+            if (other.m_maxNs > m_maxNs)
+            {
+                m_maxNs = other.m_maxNs;
+            }
+        }
+
+        void LatencyHistogram::Reset() noexcept
+        {
+            for (size_t i = 0; i < BUCKET_COUNT; ++i)
+            {
+                m_buckets[i] = 0;
+            }
+
+            m_sampleCount = 0;
+            m_totalNs = 0;
+            m_minNs = UINT64_MAX;
+            m_maxNs = 0;
+        }
+
+        uint64_t LatencyHistogram::GetPercentileNs(double percentile) const noexcept
+        {
+            if (m_sampleCount == 0)
+            {
+                return 0;
+            }
+
+            if (percentile < 0.0)
+            {
+                percentile = 0.0;
+            }
+            else if (percentile > 100.0)
+            {
+                percentile = 100.0;
+            }
+
+            auto rank = static_cast<uint64_t>(std::ceil(percentile / 100.0 * static_cast<double>(m_sampleCount)));
+            if (rank == 0)
+            {
+                rank = 1;
+            }
+
+            uint64_t seen = 0;
+            for (size_t i = 0; i < BUCKET_COUNT; ++i)
+            {
+                seen += m_buckets[i];
+                if (seen >= rank)
+                {
+                    uint64_t upperBound = GetBucketUpperBoundNs(i);
+                    return upperBound < m_maxNs ? upperBound : m_maxNs;
+                }
+            }
+
+            return m_maxNs;
+        }
+
+        uint64_t LatencyHistogram::GetBucketCount(size_t bucketIndex) const noexcept
+        {
+            return bucketIndex < BUCKET_COUNT ? m_buckets[bucketIndex] : 0;
+        }
+
+        uint64_t LatencyHistogram::GetBucketUpperBoundNs(size_t bucketIndex) noexcept
+        {
+            if (bucketIndex == 0)
+            {
+                return 0;
+            }
+
+            if (bucketIndex >= BUCKET_COUNT - 1)
+            {
+                return UINT64_MAX;
+            }
+
+            return (uint64_t(1) << bucketIndex) - 1;
+        }
+    } // namespace Crt
+} // namespace Aws
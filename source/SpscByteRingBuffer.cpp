@@ -0,0 +1,113 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+#include <aws/crt/SpscByteRingBuffer.h>
+
+#include <cstring>
+
+namespace Aws
+{
+    namespace Crt
+    {
+        SpscByteRingBuffer::SpscByteRingBuffer(size_t capacity, Allocator *allocator) noexcept
+            : m_allocator(allocator), m_buffer(nullptr), m_capacity(0), m_writeCount(0), m_readCount(0)
+        {
+            if (capacity > 0)
+            {
+                m_buffer = static_cast<uint8_t *>(aws_mem_acquire(allocator, capacity));
+            }
+
+            if (m_buffer)
+            {
+                m_capacity = capacity;
+            }
+        }
+
+        SpscByteRingBuffer::~SpscByteRingBuffer()
+        {
+            if (m_buffer)
+            {
+                aws_mem_release(m_allocator, m_buffer);
+                m_buffer = nullptr;
+            }
+        }
+
+        size_t SpscByteRingBuffer::GetSize() const noexcept
+        {
+            /* Load the read position first so the difference can never appear negative */
+            uint64_t readCount = m_readCount.load(std::memory_order_acquire);
+            uint64_t writeCount = m_writeCount.load(std::memory_order_acquire);
+            return static_cast<size_t>(writeCount - readCount);
+        }
+
+        size_t SpscByteRingBuffer::Write(ByteCursor data) noexcept
+        {
+            uint64_t writeCount = m_writeCount.load(std::memory_order_relaxed);
+            uint64_t readCount = m_readCount.load(std::memory_order_acquire);
+
+            size_t freeSpace = m_capacity - static_cast<size_t>(writeCount - readCount);
+            size_t toWrite = data.len < freeSpace ? data.len : freeSpace;
+            if (toWrite == 0)
+            {
+                return 0;
+            }
+
+            size_t offset = static_cast<size_t>(writeCount % m_capacity);
+            size_t firstPart = m_capacity - offset < toWrite ? m_capacity - offset : toWrite;
+            memcpy(m_buffer + offset, data.ptr, firstPart);
+            if (toWrite > firstPart)
+            {
+                memcpy(m_buffer, data.ptr + firstPart, toWrite - firstPart);
+            }
+
+            m_writeCount.store(writeCount + toWrite, std::memory_order_release);
+            return toWrite;
+        }
+
+        size_t SpscByteRingBuffer::Read(ByteBuf &dest) noexcept
+        {
+            uint64_t readCount = m_readCount.load(std::memory_order_relaxed);
+            uint64_t writeCount = m_writeCount.load(std::memory_order_acquire);
+
+            size_t available = static_cast<size_t>(writeCount - readCount);
+            size_t space = dest.capacity - dest.len;
+            size_t toRead = available < space ? available : space;
+            if (toRead == 0)
+            {
+                return 0;
+            }
+
+            size_t offset = static_cast<size_t>(readCount % m_capacity);
+            size_t firstPart = m_capacity - offset < toRead ? m_capacity - offset : toRead;
+            memcpy(dest.buffer + dest.len, m_buffer + offset, firstPart);
+            if (toRead > firstPart)
+            {
+                memcpy(dest.buffer + dest.len + firstPart, m_buffer, toRead - firstPart);
+            }
+            dest.len += toRead;
+
+            m_readCount.store(readCount + toRead, std::memory_order_release);
+            return toRead;
+        }
+
+        bool SpscByteRingBuffer::Peek(uint8_t &out) const noexcept
+        {
+            uint64_t readCount = m_readCount.load(std::memory_order_relaxed);
+            uint64_t writeCount = m_writeCount.load(std::memory_order_acquire);
+            if (writeCount == readCount)
+            {
+                return false;
+            }
+
+            out = m_buffer[readCount % m_capacity];
+            return true;
+        }
+
+        void SpscByteRingBuffer::Reset() noexcept
+        {
+            m_readCount.store(0, std::memory_order_relaxed);
+            m_writeCount.store(0, std::memory_order_relaxed);
+        }
+    } // namespace Crt
+} // namespace Aws
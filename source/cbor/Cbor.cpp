@@ -135,6 +135,12 @@ namespace Aws
                 return aws_cbor_decoder_get_remaining_length(m_decoder);
             }
 
+            void CborDecoder::ResetSource(ByteCursor src) noexcept
+            {
+                aws_cbor_decoder_reset_src(m_decoder, src);
+                m_lastError = AWS_ERROR_SUCCESS;
+            }
+
             Optional<CborType> CborDecoder::PeekType() noexcept
             {
                 enum aws_cbor_type out_type_c = AWS_CBOR_TYPE_UNKNOWN;
@@ -0,0 +1,296 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+#include <aws/crt/Api.h>
+#include <aws/crt/http/Http2StreamManager.h>
+#include <aws/crt/http/HttpProxyStrategy.h>
+#include <aws/crt/http/HttpRequestResponse.h>
+
+#include <aws/common/clock.h>
+#include <aws/http/http2_stream_manager.h>
+
+namespace Aws
+{
+    namespace Crt
+    {
+        namespace Http
+        {
+            /*
+             * Streams handed out by the stream manager live on connections owned by the manager.  The native stream
+             * keeps its connection alive until the stream is released, so this wrapper only borrows the connection
+             * for the lifetime of the HttpClientStream that holds it.
+             */
+            class StreamManagerConnection final : public HttpClientConnection
+            {
+              public:
+                StreamManagerConnection(aws_http_connection *connection, Aws::Crt::Allocator *allocator)
+                    : HttpClientConnection(connection, allocator)
+                {
+                }
+
+                ~StreamManagerConnection() override { m_connection = nullptr; }
+            };
+
+            struct StreamAcquisitionCallbackArgs
+            {
+                StreamAcquisitionCallbackArgs() = default;
+                OnStreamAcquired m_onStreamAcquired;
+                std::shared_ptr<HttpClientStream> m_stream;
+                std::shared_ptr<Http2StreamManager> m_streamManager;
+            };
+
+            void Http2StreamManager::s_shutdownCompleted(void *userData) noexcept
+            {
+                auto *streamManager = reinterpret_cast<Http2StreamManager *>(userData);
+                streamManager->m_shutdownPromise.set_value();
+            }
+
+            Http2StreamManagerOptions::Http2StreamManagerOptions() noexcept
+                : ConnectionOptions(), MaxConnections(2), MaxConcurrentStreamsPerConnection(0),
+                  IdealConcurrentStreamsPerConnection(0), Http2PriorKnowledge(false), ConnectionPingPeriodMs(0),
+                  ConnectionPingTimeoutMs(0), CloseConnectionOnServerError(false), EnableBlockingShutdown(false)
+            {
+            }
+
+            std::shared_ptr<Http2StreamManager> Http2StreamManager::NewStreamManager(
+                const Http2StreamManagerOptions &streamManagerOptions,
+                Allocator *allocator) noexcept
+            {
+                const auto &connectionOptions = streamManagerOptions.ConnectionOptions;
+                if (connectionOptions.TlsOptions && !(*connectionOptions.TlsOptions))
+                {
+                    AWS_LOGF_ERROR(
+                        AWS_LS_HTTP_GENERAL,
+                        "Cannot create Http2StreamManager: ConnectionOptions contain invalid TLSOptions.");
+                    aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+                    return nullptr;
+                }
+
+                if (connectionOptions.ProxyOptions && connectionOptions.ProxyOptions->TlsOptions &&
+                    !(*connectionOptions.ProxyOptions->TlsOptions))
+                {
+                    AWS_LOGF_ERROR(
+                        AWS_LS_HTTP_GENERAL,
+                        "Cannot create Http2StreamManager: ProxyOptions has ConnectionOptions that contain invalid "
+                        "TLSOptions.");
+                    aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+                    return nullptr;
+                }
+
+                auto *toSeat =
+                    static_cast<Http2StreamManager *>(aws_mem_acquire(allocator, sizeof(Http2StreamManager)));
+                if (!toSeat)
+                {
+                    return nullptr;
+                }
+
+                toSeat = new (toSeat) Http2StreamManager(streamManagerOptions, allocator);
+                std::shared_ptr<Http2StreamManager> streamManager(
+                    toSeat, [allocator](Http2StreamManager *manager) { Delete(manager, allocator); });
+
+                if (!streamManager->m_streamManager)
+                {
+                    return nullptr;
+                }
+
+                return streamManager;
+            }
+
+            Http2StreamManager::Http2StreamManager(
+                const Http2StreamManagerOptions &options,
+                Allocator *allocator) noexcept
+                : m_allocator(allocator), m_streamManager(nullptr), m_options(options), m_releaseInvoked(false)
+            {
+                const auto &connectionOptions = m_options.ConnectionOptions;
+                AWS_FATAL_ASSERT(connectionOptions.HostName.size() > 0);
+                AWS_FATAL_ASSERT(connectionOptions.Port > 0);
+
+                aws_http2_stream_manager_options managerOptions;
+                AWS_ZERO_STRUCT(managerOptions);
+
+                if (connectionOptions.Bootstrap != nullptr)
+                {
+                    managerOptions.bootstrap = connectionOptions.Bootstrap->GetUnderlyingHandle();
+                }
+                else
+                {
+                    managerOptions.bootstrap =
+                        ApiHandle::GetOrCreateStaticDefaultClientBootstrap()->GetUnderlyingHandle();
+                }
+
+                managerOptions.socket_options = &connectionOptions.SocketOptions.GetImpl();
+                managerOptions.host = aws_byte_cursor_from_c_str(connectionOptions.HostName.c_str());
+                managerOptions.port = connectionOptions.Port;
+                managerOptions.http2_prior_knowledge = m_options.Http2PriorKnowledge;
+                managerOptions.initial_window_size = connectionOptions.InitialWindowSize;
+                managerOptions.enable_read_back_pressure = connectionOptions.ManualWindowManagement;
+                managerOptions.close_connection_on_server_error = m_options.CloseConnectionOnServerError;
+                managerOptions.connection_ping_period_ms = m_options.ConnectionPingPeriodMs;
+                managerOptions.connection_ping_timeout_ms = m_options.ConnectionPingTimeoutMs;
+                managerOptions.ideal_concurrent_streams_per_connection = m_options.IdealConcurrentStreamsPerConnection;
+                managerOptions.max_concurrent_streams_per_connection = m_options.MaxConcurrentStreamsPerConnection;
+                managerOptions.max_connections = m_options.MaxConnections;
+
+                if (m_options.EnableBlockingShutdown)
+                {
+                    managerOptions.shutdown_complete_callback = s_shutdownCompleted;
+                    managerOptions.shutdown_complete_user_data = this;
+                }
+                else
+                {
+                    m_shutdownPromise.set_value();
+                }
+
+                aws_http_proxy_options proxyOptions;
+                AWS_ZERO_STRUCT(proxyOptions);
+                if (connectionOptions.ProxyOptions)
+                {
+                    /* This is verified by Http2StreamManager::NewStreamManager */
+                    AWS_FATAL_ASSERT(
+                        !connectionOptions.ProxyOptions->TlsOptions || *connectionOptions.ProxyOptions->TlsOptions);
+
+                    connectionOptions.ProxyOptions->InitializeRawProxyOptions(proxyOptions);
+                    managerOptions.proxy_options = &proxyOptions;
+                }
+
+                if (connectionOptions.TlsOptions)
+                {
+                    /* This is verified by Http2StreamManager::NewStreamManager */
+                    AWS_FATAL_ASSERT(*connectionOptions.TlsOptions);
+
+                    managerOptions.tls_connection_options = connectionOptions.TlsOptions->GetUnderlyingHandle();
+                }
+
+                m_streamManager = aws_http2_stream_manager_new(allocator, &managerOptions);
+                if (!m_streamManager && m_options.EnableBlockingShutdown)
+                {
+                    /* No shutdown callback will come; don't block the destructor waiting for one */
+                    m_shutdownPromise.set_value();
+                }
+            }
+
+            Http2StreamManager::~Http2StreamManager()
+            {
+                if (!m_releaseInvoked)
+                {
+                    aws_http2_stream_manager_release(m_streamManager);
+                    m_shutdownPromise.get_future().get();
+                }
+                m_streamManager = nullptr;
+            }
+
+            bool Http2StreamManager::AcquireStream(
+                const HttpRequestOptions &requestOptions,
+                const OnStreamAcquired &onStreamAcquired) noexcept
+            {
+                AWS_ASSERT(requestOptions.onIncomingHeaders);
+                AWS_ASSERT(requestOptions.onStreamComplete);
+
+                if (requestOptions.UseManualDataWrites)
+                {
+                    AWS_LOGF_ERROR(
+                        AWS_LS_HTTP_GENERAL, "Http2StreamManager: manual data writes are not supported for streams.");
+                    aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+                    return false;
+                }
+
+                /* The stream is created unseated and bound to its native stream and connection once acquired. */
+                auto *toSeat =
+                    static_cast<HttpClientStream *>(aws_mem_acquire(m_allocator, sizeof(HttpClientStream)));
+                if (!toSeat)
+                {
+                    return false;
+                }
+
+                toSeat = new (toSeat) HttpClientStream(nullptr);
+
+                Allocator *captureAllocator = m_allocator;
+                std::shared_ptr<HttpClientStream> stream(
+                    toSeat,
+                    [captureAllocator](HttpStream *stream) { Delete(stream, captureAllocator); },
+                    StlAllocator<HttpClientStream>(captureAllocator));
+
+                stream->m_onIncomingBody = requestOptions.onIncomingBody;
+                if (requestOptions.onIncomingBodyChunk &&
+                    !stream->InitBodyChunkPool(requestOptions.onIncomingBodyChunk, m_allocator))
+                {
+                    return false;
+                }
+                stream->m_onIncomingHeaders = requestOptions.onIncomingHeaders;
+                stream->m_onIncomingHeadersBlockDone = requestOptions.onIncomingHeadersBlockDone;
+                stream->m_onStreamComplete = requestOptions.onStreamComplete;
+                stream->m_decompressResponseBody = requestOptions.DecompressResponseBody;
+                stream->m_maxDecompressedBodySize = requestOptions.MaxDecompressedBodySize;
+                stream->m_callbackData.allocator = m_allocator;
+
+                auto *callbackArgs = Aws::Crt::New<StreamAcquisitionCallbackArgs>(m_allocator);
+                if (!callbackArgs)
+                {
+                    return false;
+                }
+
+                callbackArgs->m_onStreamAcquired = onStreamAcquired;
+                callbackArgs->m_stream = stream;
+                callbackArgs->m_streamManager = shared_from_this();
+
+                /* The manager activates the stream before handing it over, so the stream must keep itself alive
+                 * from here until completion, as HttpClientStream::Activate() does. */
+                stream->m_callbackData.stream = stream;
+                aws_high_res_clock_get_ticks(&stream->m_timings.ActivatedNs);
+
+                aws_http_make_request_options options;
+                AWS_ZERO_STRUCT(options);
+                options.self_size = sizeof(aws_http_make_request_options);
+                options.request = requestOptions.request->GetUnderlyingMessage();
+                options.on_response_body = HttpStream::s_onIncomingBody;
+                options.on_response_headers = HttpStream::s_onIncomingHeaders;
+                options.on_response_header_block_done = HttpStream::s_onIncomingHeaderBlockDone;
+                options.on_complete = HttpStream::s_onStreamComplete;
+                options.on_metrics = HttpStream::s_onStreamMetrics;
+                options.user_data = &stream->m_callbackData;
+
+                aws_http2_stream_manager_acquire_stream_options acquireOptions;
+                AWS_ZERO_STRUCT(acquireOptions);
+                acquireOptions.callback = s_onStreamAcquired;
+                acquireOptions.user_data = callbackArgs;
+                acquireOptions.options = &options;
+
+                aws_http2_stream_manager_acquire_stream(m_streamManager, &acquireOptions);
+                return true;
+            }
+
+            std::future<void> Http2StreamManager::InitiateShutdown() noexcept
+            {
+                m_releaseInvoked = true;
+                aws_http2_stream_manager_release(m_streamManager);
+                return m_shutdownPromise.get_future();
+            }
+
+            void Http2StreamManager::s_onStreamAcquired(aws_http_stream *stream, int errorCode, void *userData) noexcept
+            {
+                auto *callbackArgs = static_cast<StreamAcquisitionCallbackArgs *>(userData);
+                std::shared_ptr<Http2StreamManager> manager = std::move(callbackArgs->m_streamManager);
+                std::shared_ptr<HttpClientStream> streamObj = std::move(callbackArgs->m_stream);
+                auto callback = std::move(callbackArgs->m_onStreamAcquired);
+
+                Delete(callbackArgs, manager->m_allocator);
+
+                if (errorCode)
+                {
+                    streamObj->m_callbackData.stream = nullptr;
+                    callback(nullptr, errorCode);
+                    return;
+                }
+
+                streamObj->m_stream = stream;
+                streamObj->m_connection = std::allocate_shared<StreamManagerConnection>(
+                    StlAllocator<StreamManagerConnection>(manager->m_allocator),
+                    aws_http_stream_get_connection(stream),
+                    manager->m_allocator);
+
+                callback(std::move(streamObj), AWS_OP_SUCCESS);
+            }
+        } // namespace Http
+    } // namespace Crt
+} // namespace Aws
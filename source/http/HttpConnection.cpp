@@ -4,10 +4,14 @@
  */
 #include <aws/crt/Api.h>
 #include <aws/crt/http/HttpConnection.h>
+#include <aws/crt/http/HttpContentDecoder.h>
 #include <aws/crt/http/HttpProxyStrategy.h>
 #include <aws/crt/http/HttpRequestResponse.h>
 #include <aws/crt/io/Bootstrap.h>
 
+#include <aws/common/clock.h>
+#include <aws/io/io.h>
+
 namespace Aws
 {
     namespace Crt
@@ -23,7 +27,11 @@ namespace Aws
                 Allocator *allocator;
                 OnConnectionSetup onConnectionSetup;
                 OnConnectionShutdown onConnectionShutdown;
+                uint64_t connectStartNs = 0;
                 std::shared_ptr<HttpProxyStrategy> proxyStrategy;
+                /* Keep whatever the TLS options' negotiation callbacks report to alive until setup completes */
+                Optional<Io::TlsConnectionOptions> tlsOptions;
+                Optional<Io::TlsConnectionOptions> proxyTlsOptions;
             };
 
             class UnmanagedConnection final : public HttpClientConnection
@@ -36,6 +44,9 @@ namespace Aws
 
                 ~UnmanagedConnection() override
                 {
+                    /* The pooled streams go before the connection they were made on */
+                    DetachStreamPool();
+
                     if (m_connection)
                     {
                         aws_http_connection_release(m_connection);
@@ -44,6 +55,217 @@ namespace Aws
                 }
             };
 
+            /*
+             * Recycles HttpClientStream objects for one underlying connection.  Streams are allocated the first time
+             * the pool runs dry and are never freed until the connection is, so a warmed-up pool hands out and takes
+             * back streams without touching the heap.  The free list's capacity always covers every stream the pool
+             * owns, so returning a stream never reallocates it either.
+             *
+             * The pool is bound to whichever HttpClientConnection currently wraps the connection; a connection
+             * manager hands it from one wrapper to the next.  Streams only reference that wrapper strongly while
+             * they are active; an idle or never-activated stream holding one would keep its own owner alive.
+             */
+            class HttpClientStreamPool
+            {
+              public:
+                HttpClientStreamPool(HttpClientConnection &connection, Allocator *allocator) noexcept
+                    : m_connection(&connection), m_allocator(allocator),
+                      m_streams(StlAllocator<std::shared_ptr<HttpClientStream>>(allocator)),
+                      m_freeStreams(StlAllocator<HttpClientStream *>(allocator))
+                {
+                }
+
+                HttpClientConnection &GetConnection() const noexcept { return *m_connection; }
+
+                /* Only called while no stream is in flight, so no stream can be reading the old binding */
+                void Bind(HttpClientConnection *connection) noexcept { m_connection = connection; }
+
+                /* True if every stream the pool owns is back on the free list */
+                bool IsIdle() noexcept
+                {
+                    std::lock_guard<std::mutex> lock(m_lock);
+                    return m_freeStreams.size() == m_streams.size();
+                }
+
+                HttpClientStream *Acquire() noexcept
+                {
+                    std::lock_guard<std::mutex> lock(m_lock);
+                    if (!m_freeStreams.empty())
+                    {
+                        HttpClientStream *stream = m_freeStreams.back();
+                        m_freeStreams.pop_back();
+                        return stream;
+                    }
+
+                    auto *toSeat =
+                        static_cast<HttpClientStream *>(aws_mem_acquire(m_allocator, sizeof(HttpClientStream)));
+                    if (!toSeat)
+                    {
+                        return nullptr;
+                    }
+
+                    toSeat = new (toSeat) HttpClientStream(nullptr);
+
+                    Allocator *captureAllocator = m_allocator;
+                    std::shared_ptr<HttpClientStream> stream(
+                        toSeat,
+                        [captureAllocator](HttpStream *stream) { Delete(stream, captureAllocator); },
+                        StlAllocator<HttpClientStream>(captureAllocator));
+
+                    stream->m_pool = this;
+                    stream->m_callbackData.allocator = m_allocator;
+
+                    m_streams.push_back(stream);
+                    m_freeStreams.reserve(m_streams.size());
+
+                    return toSeat;
+                }
+
+                /* Clears the stream's per-request state and returns it to the free list. The pool, owned by the
+                 * connection the stream referenced, may be destroyed by the time this returns. */
+                void Recycle(HttpStream &stream) noexcept
+                {
+                    std::shared_ptr<HttpClientConnection> connection = std::move(stream.m_connection);
+
+                    if (stream.m_stream)
+                    {
+                        aws_http_stream_release(stream.m_stream);
+                        stream.m_stream = nullptr;
+                    }
+
+                    stream.m_handler = nullptr;
+                    stream.m_onIncomingHeaders = nullptr;
+                    stream.m_onIncomingHeadersBlockDone = nullptr;
+                    stream.m_onIncomingBody = nullptr;
+                    stream.m_onStreamComplete = nullptr;
+                    stream.m_timings = HttpStreamTimings();
+
+                    stream.m_decompressResponseBody = false;
+                    stream.m_maxDecompressedBodySize = 0;
+                    stream.m_contentDecoder = nullptr;
+                    stream.m_pendingCompressedWindow = 0;
+                    stream.m_pendingDecompressedWindow = 0;
+
+                    /* Keep the write buffer itself so that reuse does not reallocate it */
+                    auto &clientStream = static_cast<HttpClientStream &>(stream);
+                    clientStream.m_writeBufferSize = 0;
+                    clientStream.m_writeBufferHighWaterMark = 0;
+                    clientStream.m_onWriteBufferLevelChanged = nullptr;
+                    clientStream.m_writeBufferAboveHighWaterMark = false;
+                    clientStream.m_writeBufferOrphanedBytes = 0;
+                    if (clientStream.m_writeBuffer)
+                    {
+                        clientStream.m_writeBuffer->Reset();
+                    }
+
+                    std::lock_guard<std::mutex> lock(m_lock);
+                    m_freeStreams.push_back(static_cast<HttpClientStream *>(&stream));
+                }
+
+              private:
+                HttpClientConnection *m_connection;
+                Allocator *m_allocator;
+                std::mutex m_lock;
+                Vector<std::shared_ptr<HttpClientStream>> m_streams;
+                Vector<HttpClientStream *> m_freeStreams;
+            };
+
+            HttpBodyChunk::HttpBodyChunk(Allocator *allocator) noexcept
+            {
+                aws_byte_buf_init(&m_buffer, allocator, 0);
+            }
+
+            HttpBodyChunk::~HttpBodyChunk()
+            {
+                aws_byte_buf_clean_up(&m_buffer);
+            }
+
+            /* Number of released chunks, with their buffers, each stream keeps for reuse */
+            static const size_t s_maxFreeBodyChunks = 16;
+
+            /*
+             * Recycles the body chunks of one stream.  Each chunk handed out keeps its stream alive, so the pool
+             * outlives every chunk it hands out.
+             */
+            class HttpBodyChunkPool
+            {
+              public:
+                explicit HttpBodyChunkPool(Allocator *allocator) noexcept
+                    : m_allocator(allocator), m_freeChunks(StlAllocator<HttpBodyChunk *>(allocator))
+                {
+                }
+
+                ~HttpBodyChunkPool()
+                {
+                    for (HttpBodyChunk *chunk : m_freeChunks)
+                    {
+                        DestroyChunk(chunk);
+                    }
+                }
+
+                std::shared_ptr<const HttpBodyChunk> Acquire(HttpStream &stream, ByteCursor data) noexcept
+                {
+                    HttpBodyChunk *chunk = nullptr;
+                    {
+                        std::lock_guard<std::mutex> lock(m_lock);
+                        if (!m_freeChunks.empty())
+                        {
+                            chunk = m_freeChunks.back();
+                            m_freeChunks.pop_back();
+                        }
+                    }
+
+                    if (!chunk)
+                    {
+                        chunk = static_cast<HttpBodyChunk *>(aws_mem_acquire(m_allocator, sizeof(HttpBodyChunk)));
+                        if (!chunk)
+                        {
+                            return nullptr;
+                        }
+                        chunk = new (chunk) HttpBodyChunk(m_allocator);
+                    }
+
+                    chunk->m_buffer.len = 0;
+                    if (aws_byte_buf_append_dynamic(&chunk->m_buffer, &data))
+                    {
+                        Release(chunk);
+                        return nullptr;
+                    }
+
+                    std::shared_ptr<HttpStream> owner = stream.shared_from_this();
+                    return std::shared_ptr<const HttpBodyChunk>(
+                        chunk,
+                        [owner](const HttpBodyChunk *chunk)
+                        { owner->OnBodyChunkReleased(const_cast<HttpBodyChunk *>(chunk)); },
+                        StlAllocator<HttpBodyChunk>(m_allocator));
+                }
+
+                void Release(HttpBodyChunk *chunk) noexcept
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(m_lock);
+                        if (m_freeChunks.size() < s_maxFreeBodyChunks)
+                        {
+                            m_freeChunks.push_back(chunk);
+                            return;
+                        }
+                    }
+
+                    DestroyChunk(chunk);
+                }
+
+              private:
+                void DestroyChunk(HttpBodyChunk *chunk) noexcept
+                {
+                    chunk->~HttpBodyChunk();
+                    aws_mem_release(m_allocator, chunk);
+                }
+
+                Allocator *m_allocator;
+                std::mutex m_lock;
+                Vector<HttpBodyChunk *> m_freeChunks;
+            };
+
             void HttpClientConnection::s_onClientConnectionSetup(
                 struct aws_http_connection *connection,
                 int errorCode,
@@ -60,6 +282,9 @@ namespace Aws
 
                     if (connectionObj)
                     {
+                        connectionObj->m_connectionTimings.ConnectStartNs = callbackData->connectStartNs;
+                        aws_high_res_clock_get_ticks(&connectionObj->m_connectionTimings.ConnectEndNs);
+
                         callbackData->connection = connectionObj;
                         callbackData->onConnectionSetup(std::move(connectionObj), errorCode);
                         return;
@@ -68,6 +293,11 @@ namespace Aws
                     aws_http_connection_release(connection);
                     errorCode = aws_last_error();
                 }
+                else if (callbackData->proxyStrategy)
+                {
+                    /* A rejected CONNECT may be down to a stale cached token; make the next attempt fetch anew. */
+                    callbackData->proxyStrategy->ClearCachedCredentials();
+                }
 
                 callbackData->onConnectionSetup(nullptr, errorCode);
                 Delete(callbackData, callbackData->allocator);
@@ -128,6 +358,7 @@ namespace Aws
                     return false;
                 }
                 callbackData->onConnectionShutdown = connectionOptions.OnConnectionShutdownCallback;
+                aws_high_res_clock_get_ticks(&callbackData->connectStartNs);
                 callbackData->onConnectionSetup = connectionOptions.OnConnectionSetupCallback;
 
                 aws_http_client_connection_options options;
@@ -150,6 +381,7 @@ namespace Aws
 
                     options.tls_options =
                         const_cast<aws_tls_connection_options *>(connectionOptions.TlsOptions->GetUnderlyingHandle());
+                    callbackData->tlsOptions = connectionOptions.TlsOptions;
                 }
                 options.allocator = allocator;
                 options.user_data = callbackData;
@@ -178,6 +410,7 @@ namespace Aws
                        inline with underlying c structs. So keeping a ref to shared ptr, to make sure it survives after
                        options are gone. */
                     callbackData->proxyStrategy = proxyOpts.ProxyStrategy;
+                    callbackData->proxyTlsOptions = proxyOpts.TlsOptions;
                 }
 
                 if (aws_http_client_connect(&options))
@@ -208,6 +441,7 @@ namespace Aws
                 options.on_response_headers = HttpStream::s_onIncomingHeaders;
                 options.on_response_header_block_done = HttpStream::s_onIncomingHeaderBlockDone;
                 options.on_complete = HttpStream::s_onStreamComplete;
+                options.on_metrics = HttpStream::s_onStreamMetrics;
                 options.use_manual_data_writes = requestOptions.UseManualDataWrites;
 
                 /* Do the same ref counting trick we did with HttpClientConnection. We need to maintain a reference
@@ -225,10 +459,21 @@ namespace Aws
                         StlAllocator<HttpClientStream>(captureAllocator));
 
                     stream->m_onIncomingBody = requestOptions.onIncomingBody;
+                    if (requestOptions.onIncomingBodyChunk &&
+                        !stream->InitBodyChunkPool(requestOptions.onIncomingBodyChunk, m_allocator))
+                    {
+                        m_lastError = aws_last_error();
+                        return nullptr;
+                    }
                     stream->m_onIncomingHeaders = requestOptions.onIncomingHeaders;
                     stream->m_onIncomingHeadersBlockDone = requestOptions.onIncomingHeadersBlockDone;
                     stream->m_onStreamComplete = requestOptions.onStreamComplete;
                     stream->m_callbackData.allocator = m_allocator;
+                    stream->m_writeBufferSize = requestOptions.WriteBufferSize;
+                    stream->m_writeBufferHighWaterMark = requestOptions.WriteBufferHighWaterMark;
+                    stream->m_onWriteBufferLevelChanged = requestOptions.onWriteBufferLevelChanged;
+                    stream->m_decompressResponseBody = requestOptions.DecompressResponseBody;
+                    stream->m_maxDecompressedBodySize = requestOptions.MaxDecompressedBodySize;
 
                     // we purposefully do not set m_callbackData::stream because we don't want the reference count
                     // incremented until the request is kicked off via HttpClientStream::Activate(). Activate()
@@ -250,6 +495,130 @@ namespace Aws
                 return nullptr;
             }
 
+            HttpClientStreamPool *HttpClientConnection::GetStreamPool() noexcept
+            {
+                std::lock_guard<std::mutex> lock(m_streamPoolLock);
+                if (!m_streamPool)
+                {
+                    m_streamPool = MakeShared<HttpClientStreamPool>(m_allocator, *this, m_allocator);
+                }
+
+                return m_streamPool.get();
+            }
+
+            std::shared_ptr<HttpClientStreamPool> HttpClientConnection::DetachStreamPool() noexcept
+            {
+                std::shared_ptr<HttpClientStreamPool> streamPool;
+                {
+                    std::lock_guard<std::mutex> lock(m_streamPoolLock);
+                    streamPool = std::move(m_streamPool);
+                }
+
+                if (!streamPool)
+                {
+                    return nullptr;
+                }
+
+                streamPool->Bind(nullptr);
+
+                /* A stream that was made but never activated still has a request open on the connection */
+                if (!streamPool->IsIdle())
+                {
+                    return nullptr;
+                }
+
+                return streamPool;
+            }
+
+            void HttpClientConnection::AttachStreamPool(std::shared_ptr<HttpClientStreamPool> streamPool) noexcept
+            {
+                std::lock_guard<std::mutex> lock(m_streamPoolLock);
+                m_streamPool = std::move(streamPool);
+                if (m_streamPool)
+                {
+                    m_streamPool->Bind(this);
+                }
+            }
+
+            HttpClientStream *HttpClientConnection::NewPooledClientStream(
+                HttpRequest &request,
+                HttpStreamHandler &handler,
+                bool useManualDataWrites) noexcept
+            {
+                HttpClientStreamPool *pool = GetStreamPool();
+                HttpClientStream *stream = pool ? pool->Acquire() : nullptr;
+                if (!stream)
+                {
+                    m_lastError = aws_last_error();
+                    return nullptr;
+                }
+
+                stream->m_handler = &handler;
+                return MakePooledRequest(stream, request, useManualDataWrites);
+            }
+
+            HttpClientStream *HttpClientConnection::NewPooledClientStream(HttpRequestOptions &&requestOptions) noexcept
+            {
+                AWS_ASSERT(requestOptions.onIncomingHeaders);
+                AWS_ASSERT(requestOptions.onStreamComplete);
+
+                if (requestOptions.onIncomingBodyChunk)
+                {
+                    AWS_LOGF_ERROR(AWS_LS_HTTP_CONNECTION, "Body chunks are not supported on pooled streams.");
+                    aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+                    m_lastError = AWS_ERROR_INVALID_ARGUMENT;
+                    return nullptr;
+                }
+
+                HttpClientStreamPool *pool = GetStreamPool();
+                HttpClientStream *stream = pool ? pool->Acquire() : nullptr;
+                if (!stream)
+                {
+                    m_lastError = aws_last_error();
+                    return nullptr;
+                }
+
+                stream->m_onIncomingBody = std::move(requestOptions.onIncomingBody);
+                stream->m_onIncomingHeaders = std::move(requestOptions.onIncomingHeaders);
+                stream->m_onIncomingHeadersBlockDone = std::move(requestOptions.onIncomingHeadersBlockDone);
+                stream->m_onStreamComplete = std::move(requestOptions.onStreamComplete);
+                stream->m_writeBufferSize = requestOptions.WriteBufferSize;
+                stream->m_writeBufferHighWaterMark = requestOptions.WriteBufferHighWaterMark;
+                stream->m_onWriteBufferLevelChanged = std::move(requestOptions.onWriteBufferLevelChanged);
+                stream->m_decompressResponseBody = requestOptions.DecompressResponseBody;
+                stream->m_maxDecompressedBodySize = requestOptions.MaxDecompressedBodySize;
+                return MakePooledRequest(stream, *requestOptions.request, requestOptions.UseManualDataWrites);
+            }
+
+            HttpClientStream *HttpClientConnection::MakePooledRequest(
+                HttpClientStream *stream,
+                HttpRequest &request,
+                bool useManualDataWrites) noexcept
+            {
+                aws_http_make_request_options options;
+                AWS_ZERO_STRUCT(options);
+                options.self_size = sizeof(aws_http_make_request_options);
+                options.request = request.GetUnderlyingMessage();
+                options.on_response_body = HttpStream::s_onIncomingBody;
+                options.on_response_headers = HttpStream::s_onIncomingHeaders;
+                options.on_response_header_block_done = HttpStream::s_onIncomingHeaderBlockDone;
+                options.on_complete = HttpStream::s_onStreamComplete;
+                options.on_metrics = HttpStream::s_onStreamMetrics;
+                options.use_manual_data_writes = useManualDataWrites;
+                options.user_data = &stream->m_callbackData;
+
+                stream->m_stream = aws_http_connection_make_request(m_connection, &options);
+
+                if (!stream->m_stream)
+                {
+                    m_lastError = aws_last_error();
+                    stream->m_pool->Recycle(*stream);
+                    return nullptr;
+                }
+
+                return stream;
+            }
+
             bool HttpClientConnection::IsOpen() const noexcept
             {
                 return aws_http_connection_is_open(m_connection);
@@ -273,7 +642,47 @@ namespace Aws
                 void *userData) noexcept
             {
                 auto callbackData = static_cast<ClientStreamCallbackData *>(userData);
-                callbackData->stream->m_onIncomingHeaders(*callbackData->stream, headerBlock, headerArray, numHeaders);
+                HttpStream &stream = *callbackData->stream;
+
+                if (stream.m_decompressResponseBody && headerBlock == AWS_HTTP_HEADER_BLOCK_MAIN &&
+                    !stream.m_contentDecoder)
+                {
+                    HttpHeaderView headers(headerArray, numHeaders);
+                    Optional<ByteCursor> contentEncoding =
+                        headers.FindHeader(aws_byte_cursor_from_c_str("content-encoding"));
+                    Optional<HttpContentEncoding> encoding;
+                    if (contentEncoding)
+                    {
+                        encoding = HttpContentDecoder::EncodingFromHeaderValue(contentEncoding.value());
+                    }
+
+                    if (encoding && encoding.value() != HttpContentEncoding::Identity)
+                    {
+                        Allocator *allocator = callbackData->allocator;
+                        auto *decoder = New<HttpContentDecoder>(allocator, encoding.value(), allocator);
+                        if (!decoder)
+                        {
+                            return AWS_OP_ERR;
+                        }
+
+                        stream.m_contentDecoder = ScopedResource<HttpContentDecoder>(
+                            decoder, [allocator](HttpContentDecoder *decoder) { Delete(decoder, allocator); });
+                        if (!*stream.m_contentDecoder)
+                        {
+                            return AWS_OP_ERR;
+                        }
+                        stream.m_contentDecoder->SetMaxOutputByteCount(stream.m_maxDecompressedBodySize);
+                    }
+                }
+
+                if (stream.m_handler)
+                {
+                    stream.m_handler->OnIncomingHeaders(stream, headerBlock, headerArray, numHeaders);
+                }
+                else
+                {
+                    stream.m_onIncomingHeaders(stream, headerBlock, headerArray, numHeaders);
+                }
 
                 return AWS_OP_SUCCESS;
             }
@@ -284,10 +693,20 @@ namespace Aws
                 void *userData) noexcept
             {
                 auto callbackData = static_cast<ClientStreamCallbackData *>(userData);
+                HttpStream &stream = *callbackData->stream;
+
+                if (headerBlock == AWS_HTTP_HEADER_BLOCK_MAIN)
+                {
+                    aws_high_res_clock_get_ticks(&stream.m_timings.ResponseHeadersEndNs);
+                }
 
-                if (callbackData->stream->m_onIncomingHeadersBlockDone)
+                if (stream.m_handler)
+                {
+                    stream.m_handler->OnIncomingHeadersBlockDone(stream, headerBlock);
+                }
+                else if (stream.m_onIncomingHeadersBlockDone)
                 {
-                    callbackData->stream->m_onIncomingHeadersBlockDone(*callbackData->stream, headerBlock);
+                    stream.m_onIncomingHeadersBlockDone(stream, headerBlock);
                 }
 
                 return AWS_OP_SUCCESS;
@@ -299,24 +718,217 @@ namespace Aws
                 void *userData) noexcept
             {
                 auto callbackData = static_cast<ClientStreamCallbackData *>(userData);
+                HttpStream &stream = *callbackData->stream;
+
+                if (stream.m_contentDecoder)
+                {
+                    return stream.DecodeIncomingBody(*data);
+                }
+
+                return stream.DeliverIncomingBody(*data);
+            }
+
+            int HttpStream::DeliverIncomingBody(const ByteCursor &data) noexcept
+            {
+                if (m_handler)
+                {
+                    m_handler->OnIncomingBody(*this, data);
+                }
+                else if (m_onIncomingBodyChunk)
+                {
+                    std::shared_ptr<const HttpBodyChunk> chunk = m_bodyChunkPool->Acquire(*this, data);
+                    if (!chunk)
+                    {
+                        return AWS_OP_ERR;
+                    }
+                    m_onIncomingBodyChunk(*this, std::move(chunk));
+                }
+                else if (m_onIncomingBody)
+                {
+                    m_onIncomingBody(*this, data);
+                }
+
+                return AWS_OP_SUCCESS;
+            }
 
-                if (callbackData->stream->m_onIncomingBody)
+            bool HttpStream::InitBodyChunkPool(OnIncomingBodyChunk onIncomingBodyChunk, Allocator *allocator) noexcept
+            {
+                auto *pool = New<HttpBodyChunkPool>(allocator, allocator);
+                if (!pool)
                 {
-                    callbackData->stream->m_onIncomingBody(*callbackData->stream, *data);
+                    return false;
+                }
+
+                m_bodyChunkPool = ScopedResource<HttpBodyChunkPool>(
+                    pool, [allocator](HttpBodyChunkPool *pool) { Delete(pool, allocator); });
+                m_onIncomingBodyChunk = std::move(onIncomingBodyChunk);
+                return true;
+            }
+
+            void HttpStream::OnBodyChunkReleased(HttpBodyChunk *chunk) noexcept
+            {
+                size_t chunkSize = chunk->size();
+                m_bodyChunkPool->Release(chunk);
+                UpdateWindow(chunkSize);
+            }
+
+            int HttpStream::DecodeIncomingBody(const ByteCursor &data) noexcept
+            {
+                {
+                    std::lock_guard<std::mutex> lock(m_windowLock);
+                    m_pendingCompressedWindow += data.len;
+                }
+
+                bool delivered = true;
+                bool decoded = m_contentDecoder->Decode(
+                    data,
+                    [this, &delivered](const ByteCursor &decodedData)
+                    {
+                        {
+                            std::lock_guard<std::mutex> lock(m_windowLock);
+                            m_pendingDecompressedWindow += decodedData.len;
+                        }
+                        if (delivered && DeliverIncomingBody(decodedData))
+                        {
+                            delivered = false;
+                        }
+                    });
+
+                if (!decoded || !delivered)
+                {
+                    return AWS_OP_ERR;
+                }
+
+                /* Compressed bytes that have nothing left to show for them, such as headers, trailers, or data whose
+                 * output was all consumed already, would never be credited by the user, so credit them here. */
+                size_t windowIncrement = 0;
+                {
+                    std::lock_guard<std::mutex> lock(m_windowLock);
+                    if (m_pendingDecompressedWindow == 0)
+                    {
+                        windowIncrement = m_pendingCompressedWindow;
+                        m_pendingCompressedWindow = 0;
+                    }
+                }
+
+                if (windowIncrement > 0)
+                {
+                    aws_http_stream_update_window(m_stream, windowIncrement);
                 }
 
                 return AWS_OP_SUCCESS;
             }
 
+            /* The native metrics use -1 for phases that never happened */
+            static uint64_t s_nativeTimestamp(int64_t timestampNs) noexcept
+            {
+                return timestampNs > 0 ? static_cast<uint64_t>(timestampNs) : 0;
+            }
+
+            void HttpStream::s_onStreamMetrics(
+                struct aws_http_stream *,
+                const struct aws_http_stream_metrics *metrics,
+                void *userData) noexcept
+            {
+                auto callbackData = static_cast<ClientStreamCallbackData *>(userData);
+                HttpStreamTimings &timings = callbackData->stream->m_timings;
+
+                timings.SendStartNs = s_nativeTimestamp(metrics->send_start_timestamp_ns);
+                timings.SendEndNs = s_nativeTimestamp(metrics->send_end_timestamp_ns);
+                timings.ReceiveStartNs = s_nativeTimestamp(metrics->receive_start_timestamp_ns);
+                timings.ReceiveEndNs = s_nativeTimestamp(metrics->receive_end_timestamp_ns);
+            }
+
             void HttpStream::s_onStreamComplete(struct aws_http_stream *, int errorCode, void *userData) noexcept
             {
                 auto callbackData = static_cast<ClientStreamCallbackData *>(userData);
-                callbackData->stream->m_onStreamComplete(*callbackData->stream, errorCode);
-                callbackData->stream = nullptr;
+
+                HttpStreamTimings &timings = callbackData->stream->m_timings;
+                aws_high_res_clock_get_ticks(&timings.CompletedNs);
+                if (callbackData->stream->m_connection)
+                {
+                    HttpClientConnection &connection = *callbackData->stream->m_connection;
+                    timings.Connection = connection.m_connectionTimings;
+                    if (connection.m_onStreamCompleted)
+                    {
+                        connection.m_onStreamCompleted(timings);
+                    }
+                }
+
+                const auto &decoder = callbackData->stream->m_contentDecoder;
+                if (errorCode == AWS_ERROR_SUCCESS && decoder && decoder->GetInputByteCount() > 0 &&
+                    !decoder->IsComplete())
+                {
+                    AWS_LOGF_ERROR(
+                        AWS_LS_HTTP_STREAM,
+                        "id=%p: Response body ended before the end of its compressed data.",
+                        static_cast<void *>(callbackData->stream->m_stream));
+                    errorCode = AWS_ERROR_HTTP_PROTOCOL_ERROR;
+                }
+
+                if (callbackData->stream->m_handler)
+                {
+                    callbackData->stream->m_handler->OnStreamComplete(*callbackData->stream, errorCode);
+                }
+                else
+                {
+                    callbackData->stream->m_onStreamComplete(*callbackData->stream, errorCode);
+                }
+
+                std::shared_ptr<HttpStream> stream = std::move(callbackData->stream);
+                if (stream->m_pool)
+                {
+                    /* The pool keeps its own reference, so dropping ours first is safe */
+                    HttpStream &pooledStream = *stream;
+                    stream = nullptr;
+                    pooledStream.m_pool->Recycle(pooledStream);
+                }
+            }
+
+            static uint64_t s_elapsedNs(uint64_t startNs, uint64_t endNs) noexcept
+            {
+                return (startNs != 0 && endNs > startNs) ? endNs - startNs : 0;
+            }
+
+            uint64_t HttpStreamTimings::GetConnectionAcquisitionTimeNs() const noexcept
+            {
+                return s_elapsedNs(Connection.AcquireStartNs, Connection.AcquiredNs);
+            }
+
+            uint64_t HttpStreamTimings::GetConnectTimeNs() const noexcept
+            {
+                return s_elapsedNs(Connection.ConnectStartNs, Connection.ConnectEndNs);
+            }
+
+            uint64_t HttpStreamTimings::GetSendWaitTimeNs() const noexcept
+            {
+                return s_elapsedNs(ActivatedNs, SendStartNs);
+            }
+
+            uint64_t HttpStreamTimings::GetSendTimeNs() const noexcept
+            {
+                return s_elapsedNs(SendStartNs, SendEndNs);
+            }
+
+            uint64_t HttpStreamTimings::GetTimeToFirstByteNs() const noexcept
+            {
+                return s_elapsedNs(SendEndNs, ReceiveStartNs);
+            }
+
+            uint64_t HttpStreamTimings::GetReceiveTimeNs() const noexcept
+            {
+                return s_elapsedNs(ReceiveStartNs, ReceiveEndNs);
+            }
+
+            uint64_t HttpStreamTimings::GetTotalTimeNs() const noexcept
+            {
+                return s_elapsedNs(ActivatedNs, CompletedNs);
             }
 
             HttpStream::HttpStream(const std::shared_ptr<HttpClientConnection> &connection) noexcept
-                : m_stream(nullptr), m_connection(connection)
+                : m_stream(nullptr), m_connection(connection), m_handler(nullptr), m_pool(nullptr),
+                  m_decompressResponseBody(false), m_maxDecompressedBodySize(0), m_pendingCompressedWindow(0),
+                  m_pendingDecompressedWindow(0)
             {
             }
 
@@ -335,11 +947,12 @@ namespace Aws
 
             HttpClientConnection &HttpStream::GetConnection() const noexcept
             {
-                return *m_connection;
+                return m_pool ? m_pool->GetConnection() : *m_connection;
             }
 
             HttpClientStream::HttpClientStream(const std::shared_ptr<HttpClientConnection> &connection) noexcept
-                : HttpStream(connection)
+                : HttpStream(connection), m_writeBufferSize(0), m_writeBufferHighWaterMark(0),
+                  m_writeBufferAboveHighWaterMark(false), m_writeBufferOrphanedBytes(0)
             {
             }
 
@@ -358,10 +971,22 @@ namespace Aws
 
             bool HttpClientStream::Activate() noexcept
             {
+                if (m_pool)
+                {
+                    /* Copying our own reference costs no allocation; it keeps the connection, and with it the pool,
+                     * alive until the stream is recycled. */
+                    m_connection = m_pool->GetConnection().shared_from_this();
+                }
+
                 m_callbackData.stream = shared_from_this();
+                aws_high_res_clock_get_ticks(&m_timings.ActivatedNs);
                 if (aws_http_stream_activate(m_stream))
                 {
                     m_callbackData.stream = nullptr;
+                    if (m_pool)
+                    {
+                        m_pool->Recycle(*this);
+                    }
                     return false;
                 }
 
@@ -397,8 +1022,216 @@ namespace Aws
                 return aws_http_stream_write_data(m_stream, &options);
             }
 
+            static const size_t s_defaultWriteBufferSize = 64 * 1024;
+
+            /*
+             * Body data for one WriteData(ByteCursor, ...) call.  The bytes live in the stream's write buffer and are
+             * drained by the connection's event loop as it reads this stream.  Writes on a stream are sent in order,
+             * so segments consume the buffer in the same order their bytes were added.
+             */
+            class WriteBufferSegmentStream final : public Io::InputStream
+            {
+              public:
+                WriteBufferSegmentStream(
+                    std::shared_ptr<HttpStream> stream,
+                    size_t length,
+                    size_t bytesToDiscard,
+                    Allocator *allocator) noexcept
+                    : Io::InputStream(allocator), m_stream(std::move(stream)), m_length(length), m_remaining(length),
+                      m_bytesToDiscard(bytesToDiscard)
+                {
+                }
+
+                bool IsValid() const noexcept override { return true; }
+
+              protected:
+                bool ReadImpl(ByteBuf &buffer) noexcept override
+                {
+                    auto &stream = static_cast<HttpClientStream &>(*m_stream);
+                    DiscardOrphanedBytes();
+
+                    size_t space = buffer.capacity - buffer.len;
+                    ByteBuf limited = buffer;
+                    limited.capacity = buffer.len + (space < m_remaining ? space : m_remaining);
+                    m_remaining -= stream.m_writeBuffer->Read(limited);
+                    buffer.len = limited.len;
+
+                    stream.UpdateWriteBufferLevel();
+                    return true;
+                }
+
+                bool ReadSomeImpl(ByteBuf &buffer) noexcept override { return ReadImpl(buffer); }
+
+                Io::StreamStatus GetStatusImpl() const noexcept override
+                {
+                    Io::StreamStatus status;
+                    status.is_end_of_stream = m_remaining == 0;
+                    status.is_valid = true;
+                    return status;
+                }
+
+                int64_t GetLengthImpl() const noexcept override { return static_cast<int64_t>(m_length); }
+
+                bool SeekImpl(int64_t, Io::StreamSeekBasis) noexcept override
+                {
+                    aws_raise_error(AWS_IO_STREAM_INVALID_SEEK_POSITION);
+                    return false;
+                }
+
+                int64_t PeekImpl() const noexcept override
+                {
+                    DiscardOrphanedBytes();
+
+                    uint8_t next = 0;
+                    if (m_remaining == 0 ||
+                        !static_cast<HttpClientStream &>(*m_stream).m_writeBuffer->Peek(next))
+                    {
+                        return -1;
+                    }
+
+                    return next;
+                }
+
+              private:
+                /* Consumer side, like every other access to the buffer from this class */
+                void DiscardOrphanedBytes() const noexcept
+                {
+                    auto &writeBuffer = *static_cast<HttpClientStream &>(*m_stream).m_writeBuffer;
+                    uint8_t discardStorage[256];
+                    while (m_bytesToDiscard > 0)
+                    {
+                        ByteBuf discard = ByteBufFromEmptyArray(
+                            discardStorage,
+                            m_bytesToDiscard < sizeof(discardStorage) ? m_bytesToDiscard : sizeof(discardStorage));
+                        size_t discarded = writeBuffer.Read(discard);
+                        if (discarded == 0)
+                        {
+                            break;
+                        }
+                        m_bytesToDiscard -= discarded;
+                    }
+                }
+
+                std::shared_ptr<HttpStream> m_stream;
+                size_t m_length;
+                size_t m_remaining;
+                mutable size_t m_bytesToDiscard;
+            };
+
+            int HttpClientStream::WriteData(
+                ByteCursor data,
+                const OnWriteDataComplete &onComplete,
+                bool endStream) noexcept
+            {
+                Allocator *allocator = m_callbackData.allocator;
+                if (!m_writeBuffer)
+                {
+                    size_t capacity = m_writeBufferSize > 0 ? m_writeBufferSize : s_defaultWriteBufferSize;
+                    auto *writeBuffer = New<SpscByteRingBuffer>(allocator, capacity, allocator);
+                    if (!writeBuffer)
+                    {
+                        return AWS_OP_ERR;
+                    }
+
+                    m_writeBuffer = ScopedResource<SpscByteRingBuffer>(
+                        writeBuffer, [allocator](SpscByteRingBuffer *buffer) { Delete(buffer, allocator); });
+                    if (!*m_writeBuffer)
+                    {
+                        m_writeBuffer = nullptr;
+                        return aws_raise_error(AWS_ERROR_OOM);
+                    }
+                }
+
+                if (data.len > m_writeBuffer->GetCapacity())
+                {
+                    AWS_LOGF_ERROR(
+                        AWS_LS_HTTP_STREAM,
+                        "id=%p: Cannot write %zu bytes through a write buffer of %zu bytes.",
+                        static_cast<void *>(m_stream),
+                        data.len,
+                        m_writeBuffer->GetCapacity());
+                    return aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+                }
+
+                if (data.len > m_writeBuffer->GetFreeSpace())
+                {
+                    return aws_raise_error(AWS_IO_READ_WOULD_BLOCK);
+                }
+
+                auto segment = MakeShared<WriteBufferSegmentStream>(
+                    allocator, shared_from_this(), data.len, m_writeBufferOrphanedBytes, allocator);
+                if (!segment)
+                {
+                    return AWS_OP_ERR;
+                }
+
+                m_writeBuffer->Write(data);
+                if (WriteData(segment, onComplete, endStream))
+                {
+                    /* The bytes can't be taken back out of the ring, so have the next segment skip them */
+                    m_writeBufferOrphanedBytes += data.len;
+                    return AWS_OP_ERR;
+                }
+
+                m_writeBufferOrphanedBytes = 0;
+                UpdateWriteBufferLevel();
+                return AWS_OP_SUCCESS;
+            }
+
+            void HttpClientStream::UpdateWriteBufferLevel() noexcept
+            {
+                if (!m_onWriteBufferLevelChanged)
+                {
+                    return;
+                }
+
+                size_t capacity = m_writeBuffer->GetCapacity();
+                size_t highWaterMark =
+                    m_writeBufferHighWaterMark > 0 ? m_writeBufferHighWaterMark : capacity - capacity / 4;
+                size_t size = m_writeBuffer->GetSize();
+
+                /* Both sides call this, so the transitions are claimed atomically to report each one only once */
+                if (size >= highWaterMark)
+                {
+                    bool wasAbove = false;
+                    if (m_writeBufferAboveHighWaterMark.compare_exchange_strong(wasAbove, true))
+                    {
+                        m_onWriteBufferLevelChanged(*this, true);
+                    }
+                }
+                else if (size <= highWaterMark / 2)
+                {
+                    bool wasAbove = true;
+                    if (m_writeBufferAboveHighWaterMark.compare_exchange_strong(wasAbove, false))
+                    {
+                        m_onWriteBufferLevelChanged(*this, false);
+                    }
+                }
+            }
+
             void HttpStream::UpdateWindow(std::size_t incrementSize) noexcept
             {
+                if (m_contentDecoder)
+                {
+                    /* Convert decompressed bytes to the same share of the compressed bytes still held back */
+                    std::lock_guard<std::mutex> lock(m_windowLock);
+                    if (incrementSize >= m_pendingDecompressedWindow)
+                    {
+                        incrementSize = m_pendingCompressedWindow;
+                        m_pendingCompressedWindow = 0;
+                        m_pendingDecompressedWindow = 0;
+                    }
+                    else
+                    {
+                        size_t compressedIncrement = static_cast<size_t>(
+                            static_cast<uint64_t>(m_pendingCompressedWindow) * incrementSize /
+                            m_pendingDecompressedWindow);
+                        m_pendingCompressedWindow -= compressedIncrement;
+                        m_pendingDecompressedWindow -= incrementSize;
+                        incrementSize = compressedIncrement;
+                    }
+                }
+
                 aws_http_stream_update_window(m_stream, incrementSize);
             }
 
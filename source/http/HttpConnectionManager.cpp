@@ -7,7 +7,13 @@
 #include <aws/crt/http/HttpProxyStrategy.h>
 
 #include <algorithm>
+#include <aws/common/clock.h>
 #include <aws/http/connection_manager.h>
+#include <aws/io/channel.h>
+#include <aws/io/channel_bootstrap.h>
+#include <aws/io/event_loop.h>
+#include <condition_variable>
+#include <thread>
 
 namespace Aws
 {
@@ -20,6 +26,239 @@ namespace Aws
                 ConnectionManagerCallbackArgs() = default;
                 OnClientConnectionAvailable m_onClientConnectionAvailable;
                 std::shared_ptr<HttpClientConnectionManager> m_connectionManager;
+                uint64_t m_acquireTimestampNs = 0;
+            };
+
+            /*
+             * One Prewarm() call; owned by its acquisitions and by the call itself while it is still making them, the
+             * last of which to finish deletes it.
+             */
+            struct PrewarmOperation
+            {
+                explicit PrewarmOperation(Allocator *allocator)
+                    : m_heldConnections(StlAllocator<aws_http_connection *>(allocator))
+                {
+                }
+
+                std::shared_ptr<HttpClientConnectionManager> m_connectionManager;
+                std::promise<size_t> m_promise;
+                std::mutex m_lock;
+                size_t m_requested = 0;
+                size_t m_remaining = 0;
+                size_t m_prewarmed = 0;
+
+                /* Connections acquired while acquisitions are still being made; see StartPrewarm() */
+                bool m_acquiring = true;
+                Vector<aws_http_connection *> m_heldConnections;
+            };
+
+            /*
+             * What a manager keeps for each of its connections across leases: when it was first handed out, and the
+             * pool of streams recycled by the wrappers it was handed out in.  An entry is tied to its connection by a
+             * channel task that is scheduled to never run: the channel cancels it when it shuts down, which forgets
+             * the entry before the connection is freed and its address can be reused.  The channel itself is never
+             * held, and the entries keep the registry alive rather than the manager.
+             */
+            class PooledConnectionRegistry : public std::enable_shared_from_this<PooledConnectionRegistry>
+            {
+              public:
+                explicit PooledConnectionRegistry(Allocator *allocator) noexcept : m_allocator(allocator) {}
+
+                /* Adds an entry for the connection unless it has been handed out before */
+                void OnLeased(aws_http_connection *connection, uint64_t timestampNs) noexcept
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(m_lock);
+                        Entry entry;
+                        entry.firstLeaseNs = timestampNs;
+                        if (!m_entries.emplace(connection, std::move(entry)).second)
+                        {
+                            return;
+                        }
+                    }
+
+                    auto *shutdownTask = New<ShutdownTask>(m_allocator);
+                    if (!shutdownTask)
+                    {
+                        /* Untracked connections are neither expired nor keep their streams; the next lease retries */
+                        std::lock_guard<std::mutex> lock(m_lock);
+                        m_entries.erase(connection);
+                        return;
+                    }
+
+                    shutdownTask->registry = shared_from_this();
+                    shutdownTask->connection = connection;
+                    aws_channel_task_init(
+                        &shutdownTask->task, s_onChannelShutdown, shutdownTask, "HttpConnectionManagerRegistry");
+
+                    /* Outside the lock: a channel that has already shut down cancels the task right away */
+                    aws_channel_schedule_task_future(
+                        aws_http_connection_get_channel(connection), &shutdownTask->task, UINT64_MAX);
+                }
+
+                /* Returns false if the connection isn't tracked */
+                bool GetFirstLease(aws_http_connection *connection, uint64_t &timestampNs) noexcept
+                {
+                    std::lock_guard<std::mutex> lock(m_lock);
+                    auto iter = m_entries.find(connection);
+                    if (iter == m_entries.end())
+                    {
+                        return false;
+                    }
+
+                    timestampNs = iter->second.firstLeaseNs;
+                    return true;
+                }
+
+                std::shared_ptr<HttpClientStreamPool> TakeStreamPool(aws_http_connection *connection) noexcept
+                {
+                    std::lock_guard<std::mutex> lock(m_lock);
+                    auto iter = m_entries.find(connection);
+                    if (iter == m_entries.end())
+                    {
+                        return nullptr;
+                    }
+
+                    return std::move(iter->second.streamPool);
+                }
+
+                /* Keeps the pool for the connection's next lease; dropped if the connection has shut down */
+                void StoreStreamPool(
+                    aws_http_connection *connection,
+                    std::shared_ptr<HttpClientStreamPool> streamPool) noexcept
+                {
+                    std::lock_guard<std::mutex> lock(m_lock);
+                    auto iter = m_entries.find(connection);
+                    if (iter != m_entries.end())
+                    {
+                        /* The pool replaced, if any, is dropped outside the lock along with the argument */
+                        std::swap(iter->second.streamPool, streamPool);
+                    }
+                }
+
+              private:
+                struct Entry
+                {
+                    uint64_t firstLeaseNs = 0;
+                    std::shared_ptr<HttpClientStreamPool> streamPool;
+                };
+
+                struct ShutdownTask
+                {
+                    struct aws_channel_task task;
+                    std::shared_ptr<PooledConnectionRegistry> registry;
+                    aws_http_connection *connection = nullptr;
+                };
+
+                static void s_onChannelShutdown(struct aws_channel_task *task, void *arg, enum aws_task_status status)
+                {
+                    (void)task;
+                    (void)status;
+                    auto *shutdownTask = static_cast<ShutdownTask *>(arg);
+                    std::shared_ptr<PooledConnectionRegistry> registry = std::move(shutdownTask->registry);
+                    std::shared_ptr<HttpClientStreamPool> streamPool;
+                    {
+                        std::lock_guard<std::mutex> lock(registry->m_lock);
+                        auto iter = registry->m_entries.find(shutdownTask->connection);
+                        if (iter != registry->m_entries.end())
+                        {
+                            streamPool = std::move(iter->second.streamPool);
+                            registry->m_entries.erase(iter);
+                        }
+                    }
+
+                    Delete(shutdownTask, registry->m_allocator);
+                }
+
+                Allocator *m_allocator;
+                std::mutex m_lock;
+                Map<aws_http_connection *, Entry> m_entries;
+            };
+
+            /* How often a manager with MinConnections set checks for connections the pool has dropped */
+            static const uint64_t s_minConnectionsCheckIntervalMs = 1000;
+
+            /* How often, at most, connection releases check the pool of a manager with MinConnections set */
+            static const uint64_t s_minConnectionsReleaseCheckIntervalMs = 100;
+
+            /*
+             * Link between a manager and its MinConnections timer.  The manager clears it when it shuts down, so the
+             * timer never owns the manager and can never be the one to destroy it.
+             */
+            struct MinConnectionsMaintenance
+            {
+                std::mutex lock;
+                std::condition_variable signal;
+                HttpClientConnectionManager *connectionManager = nullptr;
+
+                /* Set while the timer is checking the pool, so that the manager can wait for it to finish */
+                bool checking = false;
+                std::thread::id checkingThread;
+            };
+
+            /* Timer task that tops up a manager's pool, then reschedules itself until the manager shuts down */
+            struct MinConnectionsMaintenanceTask
+            {
+                MinConnectionsMaintenanceTask(
+                    Allocator *allocator,
+                    struct aws_event_loop *eventLoop,
+                    std::shared_ptr<MinConnectionsMaintenance> maintenance) noexcept
+                    : allocator(allocator), eventLoop(eventLoop), maintenance(std::move(maintenance))
+                {
+                    AWS_ZERO_STRUCT(task);
+                }
+
+                void ScheduleNext(uint64_t nowNs) noexcept
+                {
+                    uint64_t intervalNs = aws_timestamp_convert(
+                        s_minConnectionsCheckIntervalMs, AWS_TIMESTAMP_MILLIS, AWS_TIMESTAMP_NANOS, NULL);
+                    aws_task_init(&task, s_onCheck, this, "HttpConnectionManagerMinConnections");
+                    aws_event_loop_schedule_task_future(eventLoop, &task, nowNs + intervalNs);
+                }
+
+                static void s_onCheck(struct aws_task *task, void *arg, enum aws_task_status status)
+                {
+                    (void)task;
+                    auto *maintenanceTask = static_cast<MinConnectionsMaintenanceTask *>(arg);
+                    MinConnectionsMaintenance &maintenance = *maintenanceTask->maintenance;
+
+                    HttpClientConnectionManager *manager = nullptr;
+                    {
+                        std::lock_guard<std::mutex> lock(maintenance.lock);
+                        if (status == AWS_TASK_STATUS_RUN_READY && maintenance.connectionManager)
+                        {
+                            manager = maintenance.connectionManager;
+                            maintenance.checking = true;
+                            maintenance.checkingThread = std::this_thread::get_id();
+                        }
+                    }
+
+                    /* The manager waits for this check before it goes away, unless it is destroyed by the check
+                     * itself, through the last prewarm completing inline; nothing touches it once that can happen. */
+                    bool keepChecking = manager && manager->MaintainMinConnections();
+
+                    if (manager)
+                    {
+                        std::lock_guard<std::mutex> lock(maintenance.lock);
+                        maintenance.checking = false;
+                        maintenance.signal.notify_all();
+                    }
+
+                    if (!keepChecking)
+                    {
+                        Delete(maintenanceTask, maintenanceTask->allocator);
+                        return;
+                    }
+
+                    uint64_t now = 0;
+                    aws_event_loop_current_clock_time(maintenanceTask->eventLoop, &now);
+                    maintenanceTask->ScheduleNext(now);
+                }
+
+                struct aws_task task;
+                Allocator *allocator;
+                struct aws_event_loop *eventLoop;
+                std::shared_ptr<MinConnectionsMaintenance> maintenance;
             };
 
             void HttpClientConnectionManager::s_shutdownCompleted(void *userData) noexcept
@@ -30,7 +269,9 @@ namespace Aws
             }
 
             HttpClientConnectionManagerOptions::HttpClientConnectionManagerOptions() noexcept
-                : ConnectionOptions(), MaxConnections(1), EnableBlockingShutdown(false)
+                : ConnectionOptions(), MaxConnections(1), MinConnections(0), MaxConnectionIdleTimeMs(0),
+                  MaxPendingConnectionAcquisitions(0), MaxConnectionLifetimeMs(0), EnableRequestTimingMetrics(false),
+                  EnableBlockingShutdown(false)
             {
             }
 
@@ -68,8 +309,12 @@ namespace Aws
                 if (toSeat)
                 {
                     toSeat = new (toSeat) HttpClientConnectionManager(connectionManagerOptions, allocator);
-                    return std::shared_ptr<HttpClientConnectionManager>(
+                    std::shared_ptr<HttpClientConnectionManager> connectionManager(
                         toSeat, [allocator](HttpClientConnectionManager *manager) { Delete(manager, allocator); });
+
+                    connectionManager->m_selfReference = connectionManager;
+                    connectionManager->StartMinConnectionsMaintenance();
+                    return connectionManager;
                 }
 
                 return nullptr;
@@ -78,12 +323,15 @@ namespace Aws
             HttpClientConnectionManager::HttpClientConnectionManager(
                 const HttpClientConnectionManagerOptions &options,
                 Allocator *allocator) noexcept
-                : m_allocator(allocator), m_connectionManager(nullptr), m_options(options), m_releaseInvoked(false)
+                : m_allocator(allocator), m_connectionManager(nullptr), m_options(options), m_releaseInvoked(false),
+                  m_failedAcquisitions(0), m_prewarmConnectionsInFlight(0), m_lastReleaseMaintenanceNs(0)
             {
                 const auto &connectionOptions = m_options.ConnectionOptions;
                 AWS_FATAL_ASSERT(connectionOptions.HostName.size() > 0);
                 AWS_FATAL_ASSERT(connectionOptions.Port > 0);
 
+                m_pooledConnections = MakeShared<PooledConnectionRegistry>(allocator, allocator);
+
                 aws_http_connection_manager_options managerOptions;
                 AWS_ZERO_STRUCT(managerOptions);
 
@@ -99,6 +347,8 @@ namespace Aws
 
                 managerOptions.port = connectionOptions.Port;
                 managerOptions.max_connections = m_options.MaxConnections;
+                managerOptions.max_connection_idle_in_milliseconds = m_options.MaxConnectionIdleTimeMs;
+                managerOptions.max_pending_connection_acquisitions = m_options.MaxPendingConnectionAcquisitions;
                 managerOptions.socket_options = &connectionOptions.SocketOptions.GetImpl();
                 managerOptions.initial_window_size = connectionOptions.InitialWindowSize;
 
@@ -141,6 +391,7 @@ namespace Aws
 
             HttpClientConnectionManager::~HttpClientConnectionManager()
             {
+                StopMinConnectionsMaintenance();
                 if (!m_releaseInvoked)
                 {
                     aws_http_connection_manager_release(m_connectionManager);
@@ -160,6 +411,7 @@ namespace Aws
 
                 connectionManagerCallbackArgs->m_connectionManager = shared_from_this();
                 connectionManagerCallbackArgs->m_onClientConnectionAvailable = onClientConnectionAvailable;
+                aws_high_res_clock_get_ticks(&connectionManagerCallbackArgs->m_acquireTimestampNs);
 
                 aws_http_connection_manager_acquire_connection(
                     m_connectionManager, s_onConnectionSetup, connectionManagerCallbackArgs);
@@ -169,28 +421,421 @@ namespace Aws
             std::future<void> HttpClientConnectionManager::InitiateShutdown() noexcept
             {
                 m_releaseInvoked = true;
+                StopMinConnectionsMaintenance();
                 aws_http_connection_manager_release(m_connectionManager);
                 return m_shutdownPromise.get_future();
             }
 
+            HttpClientConnectionManagerMetrics HttpClientConnectionManager::GetMetrics() const noexcept
+            {
+                HttpClientConnectionManagerMetrics metrics;
+
+                if (m_connectionManager)
+                {
+                    aws_http_manager_metrics nativeMetrics;
+                    AWS_ZERO_STRUCT(nativeMetrics);
+                    aws_http_connection_manager_fetch_metrics(m_connectionManager, &nativeMetrics);
+                    metrics.AvailableConnections = nativeMetrics.available_concurrency;
+                    metrics.LeasedConnections = nativeMetrics.leased_concurrency;
+                    metrics.PendingAcquisitions = nativeMetrics.pending_concurrency_acquires;
+                }
+
+                std::lock_guard<std::mutex> lock(m_metricsLock);
+                metrics.FailedAcquisitions = m_failedAcquisitions;
+                metrics.AcquisitionWaitTime = m_acquisitionWaitTime;
+                metrics.RequestSendWaitTime = m_requestSendWaitTime;
+                metrics.RequestSendTime = m_requestSendTime;
+                metrics.RequestTimeToFirstByte = m_requestTimeToFirstByte;
+                metrics.RequestReceiveTime = m_requestReceiveTime;
+                metrics.RequestTotalTime = m_requestTotalTime;
+
+                return metrics;
+            }
+
+            std::future<size_t> HttpClientConnectionManager::Prewarm(size_t count) noexcept
+            {
+                return StartPrewarm(count, false);
+            }
+
+            std::future<size_t> HttpClientConnectionManager::StartPrewarm(size_t count, bool skipIfOpen) noexcept
+            {
+                std::promise<size_t> finished;
+                std::future<size_t> result = finished.get_future();
+
+                if (!m_connectionManager)
+                {
+                    finished.set_value(0);
+                    return result;
+                }
+
+                size_t toAcquire = 0;
+                {
+                    /* Sizing and reserving happen under one lock so that concurrent prewarms can't both claim the
+                     * same shortfall, and together never hold more than MaxConnections. */
+                    std::lock_guard<std::mutex> lock(m_metricsLock);
+
+                    aws_http_manager_metrics nativeMetrics;
+                    AWS_ZERO_STRUCT(nativeMetrics);
+                    aws_http_connection_manager_fetch_metrics(m_connectionManager, &nativeMetrics);
+
+                    /* Acquiring n connections at once yields n distinct connections: the idle ones first, then new
+                     * ones.  Leased connections, and acquisitions other prewarms still have pending, already count
+                     * towards the target. */
+                    size_t committed = nativeMetrics.leased_concurrency + m_prewarmConnectionsInFlight;
+                    size_t target = (std::min)(count, m_options.MaxConnections);
+                    if (skipIfOpen && nativeMetrics.available_concurrency + committed >= target)
+                    {
+                        target = 0;
+                    }
+
+                    toAcquire = target > committed ? target - committed : 0;
+                    m_prewarmConnectionsInFlight += toAcquire;
+                }
+
+                if (toAcquire == 0)
+                {
+                    finished.set_value(0);
+                    return result;
+                }
+
+                /* Prewarms started by the MinConnections timer may race the manager's last owner going away */
+                std::shared_ptr<HttpClientConnectionManager> self = m_selfReference.lock();
+                auto *prewarm = self ? New<PrewarmOperation>(m_allocator, m_allocator) : nullptr;
+                if (!prewarm)
+                {
+                    std::lock_guard<std::mutex> lock(m_metricsLock);
+                    m_prewarmConnectionsInFlight -= toAcquire;
+                    finished.set_value(0);
+                    return result;
+                }
+
+                prewarm->m_connectionManager = std::move(self);
+                prewarm->m_promise = std::move(finished);
+                prewarm->m_requested = toAcquire;
+                prewarm->m_remaining = toAcquire + 1;
+                prewarm->m_heldConnections.reserve(toAcquire);
+
+                /*
+                 * Connections handed out while acquisitions are still being made are held until all of them are made,
+                 * so that each acquisition claims an idle connection of its own or has the pool open a new one.
+                 * Connections handed out after that go straight back to the pool.
+                 */
+                for (size_t i = 0; i < toAcquire; ++i)
+                {
+                    aws_http_connection_manager_acquire_connection(
+                        m_connectionManager, s_onPrewarmConnectionSetup, prewarm);
+                }
+
+                aws_http_connection_manager *connectionManager = m_connectionManager;
+                Vector<aws_http_connection *> heldConnections(StlAllocator<aws_http_connection *>(m_allocator));
+                {
+                    std::lock_guard<std::mutex> lock(prewarm->m_lock);
+                    prewarm->m_acquiring = false;
+                    heldConnections.swap(prewarm->m_heldConnections);
+                }
+
+                for (aws_http_connection *heldConnection : heldConnections)
+                {
+                    aws_http_connection_manager_release_connection(connectionManager, heldConnection);
+                }
+
+                /* May free prewarm, and with it the manager */
+                s_onPrewarmAcquisitionFinished(prewarm);
+
+                return result;
+            }
+
+            void HttpClientConnectionManager::s_onPrewarmConnectionSetup(
+                aws_http_connection *connection,
+                int errorCode,
+                void *userData) noexcept
+            {
+                auto *prewarm = static_cast<PrewarmOperation *>(userData);
+                HttpClientConnectionManager *manager = prewarm->m_connectionManager.get();
+                {
+                    /* Until it is released, a connection acquired by the prewarm shows up as leased instead */
+                    std::lock_guard<std::mutex> lock(manager->m_metricsLock);
+                    --manager->m_prewarmConnectionsInFlight;
+                }
+
+                if (errorCode)
+                {
+                    manager->OnAcquisitionFailed(errorCode);
+                }
+                else
+                {
+                    bool hold = false;
+                    {
+                        std::lock_guard<std::mutex> lock(prewarm->m_lock);
+                        ++prewarm->m_prewarmed;
+                        if (prewarm->m_acquiring)
+                        {
+                            prewarm->m_heldConnections.push_back(connection);
+                            hold = true;
+                        }
+                    }
+
+                    /* Back to the pool right away, where an acquisition waiting for it can take it */
+                    if (!hold)
+                    {
+                        aws_http_connection_manager_release_connection(manager->m_connectionManager, connection);
+                    }
+                }
+
+                s_onPrewarmAcquisitionFinished(prewarm);
+            }
+
+            void HttpClientConnectionManager::s_onPrewarmAcquisitionFinished(PrewarmOperation *prewarm) noexcept
+            {
+                {
+                    std::lock_guard<std::mutex> lock(prewarm->m_lock);
+                    if (--prewarm->m_remaining > 0)
+                    {
+                        return;
+                    }
+                }
+
+                std::shared_ptr<HttpClientConnectionManager> managerRef = std::move(prewarm->m_connectionManager);
+                AWS_LOGF_DEBUG(
+                    AWS_LS_HTTP_CONNECTION_MANAGER,
+                    "id=%p: Prewarmed %zu of %zu connections.",
+                    static_cast<void *>(managerRef->m_connectionManager),
+                    prewarm->m_prewarmed,
+                    prewarm->m_requested);
+
+                prewarm->m_promise.set_value(prewarm->m_prewarmed);
+                Delete(prewarm, managerRef->m_allocator);
+            }
+
+            void HttpClientConnectionManager::StartMinConnectionsMaintenance() noexcept
+            {
+                if (!MaintainMinConnections())
+                {
+                    return;
+                }
+
+                /* Idle connections can be reaped, or closed by the server, without anything being released, so
+                 * releases alone can't be relied on to notice the pool shrinking. */
+                Io::ClientBootstrap *bootstrap = m_options.ConnectionOptions.Bootstrap;
+                if (bootstrap == nullptr)
+                {
+                    bootstrap = ApiHandle::GetOrCreateStaticDefaultClientBootstrap();
+                }
+
+                struct aws_event_loop *eventLoop =
+                    aws_event_loop_group_get_next_loop(bootstrap->GetUnderlyingHandle()->event_loop_group);
+                auto maintenance = MakeShared<MinConnectionsMaintenance>(m_allocator);
+                MinConnectionsMaintenanceTask *maintenanceTask = nullptr;
+                if (maintenance)
+                {
+                    maintenanceTask =
+                        New<MinConnectionsMaintenanceTask>(m_allocator, m_allocator, eventLoop, maintenance);
+                }
+                if (!maintenanceTask)
+                {
+                    AWS_LOGF_WARN(
+                        AWS_LS_HTTP_CONNECTION_MANAGER,
+                        "id=%p: Failed to start MinConnections maintenance; the pool is only topped up on release.",
+                        static_cast<void *>(m_connectionManager));
+                    return;
+                }
+
+                maintenance->connectionManager = this;
+                m_minConnectionsMaintenance = std::move(maintenance);
+
+                uint64_t now = 0;
+                aws_event_loop_current_clock_time(eventLoop, &now);
+                maintenanceTask->ScheduleNext(now);
+            }
+
+            void HttpClientConnectionManager::StopMinConnectionsMaintenance() noexcept
+            {
+                if (!m_minConnectionsMaintenance)
+                {
+                    return;
+                }
+
+                /* The timer task itself can only be canceled from its event loop; it finds the link cleared and
+                 * frees itself instead.  A check already underway is waited for, unless this is that check. */
+                MinConnectionsMaintenance &maintenance = *m_minConnectionsMaintenance;
+                std::unique_lock<std::mutex> lock(maintenance.lock);
+                maintenance.connectionManager = nullptr;
+                maintenance.signal.wait(
+                    lock,
+                    [&maintenance]
+                    { return !maintenance.checking || maintenance.checkingThread == std::this_thread::get_id(); });
+            }
+
+            bool HttpClientConnectionManager::MaintainMinConnections() noexcept
+            {
+                if (m_options.MinConnections == 0 || m_releaseInvoked || !m_connectionManager)
+                {
+                    return false;
+                }
+
+                StartPrewarm(m_options.MinConnections, true);
+                return true;
+            }
+
+            void HttpClientConnectionManager::MaintainMinConnectionsOnRelease() noexcept
+            {
+                if (m_options.MinConnections == 0)
+                {
+                    return;
+                }
+
+                uint64_t now = 0;
+                aws_high_res_clock_get_ticks(&now);
+                uint64_t intervalNs = aws_timestamp_convert(
+                    s_minConnectionsReleaseCheckIntervalMs, AWS_TIMESTAMP_MILLIS, AWS_TIMESTAMP_NANOS, NULL);
+
+                /* Of the releases within one interval, only the one that claims it checks the pool */
+                uint64_t lastCheckNs = m_lastReleaseMaintenanceNs.load();
+                if (now - lastCheckNs < intervalNs ||
+                    !m_lastReleaseMaintenanceNs.compare_exchange_strong(lastCheckNs, now))
+                {
+                    return;
+                }
+
+                MaintainMinConnections();
+            }
+
+            void HttpClientConnectionManager::OnAcquisitionCompleted(
+                uint64_t acquireTimestampNs,
+                aws_http_connection *connection,
+                int errorCode) noexcept
+            {
+                uint64_t now = 0;
+                aws_high_res_clock_get_ticks(&now);
+
+                {
+                    std::lock_guard<std::mutex> lock(m_metricsLock);
+                    m_acquisitionWaitTime.Record(now > acquireTimestampNs ? now - acquireTimestampNs : 0);
+                    if (errorCode)
+                    {
+                        ++m_failedAcquisitions;
+                    }
+                }
+
+                if (errorCode)
+                {
+                    OnAcquisitionFailed(errorCode);
+                    return;
+                }
+
+                if (m_pooledConnections)
+                {
+                    m_pooledConnections->OnLeased(connection, now);
+                }
+            }
+
+            void HttpClientConnectionManager::OnAcquisitionFailed(int errorCode) noexcept
+            {
+                /* Failures the manager raises itself never reached the proxy */
+                if (errorCode == AWS_ERROR_HTTP_CONNECTION_MANAGER_MAX_PENDING_ACQUISITIONS_EXCEEDED ||
+                    errorCode == AWS_ERROR_HTTP_CONNECTION_MANAGER_SHUTTING_DOWN)
+                {
+                    return;
+                }
+
+                /* As with HttpClientConnection::CreateConnection(), a rejected CONNECT may be down to a stale cached
+                 * token; make the next connection the pool opens fetch anew. */
+                const auto &proxyOptions = m_options.ConnectionOptions.ProxyOptions;
+                if (proxyOptions && proxyOptions->ProxyStrategy)
+                {
+                    proxyOptions->ProxyStrategy->ClearCachedCredentials();
+                }
+            }
+
+            void HttpClientConnectionManager::OnConnectionReleased(aws_http_connection *connection) noexcept
+            {
+                uint64_t firstLeaseNs = 0;
+                if (m_options.MaxConnectionLifetimeMs == 0 || !m_pooledConnections ||
+                    !m_pooledConnections->GetFirstLease(connection, firstLeaseNs))
+                {
+                    return;
+                }
+
+                uint64_t now = 0;
+                aws_high_res_clock_get_ticks(&now);
+                uint64_t ageMs = aws_timestamp_convert(
+                    now > firstLeaseNs ? now - firstLeaseNs : 0, AWS_TIMESTAMP_NANOS, AWS_TIMESTAMP_MILLIS, NULL);
+                if (ageMs >= m_options.MaxConnectionLifetimeMs)
+                {
+                    /* A closed connection is dropped rather than returned to the pool when it is released, and its
+                     * record is forgotten once its channel has shut down */
+                    aws_http_connection_close(connection);
+                }
+            }
+
+            /* Records each duration that was observed; a skipped phase would otherwise show up as 0 */
+            static void s_recordIfObserved(LatencyHistogram &histogram, uint64_t durationNs) noexcept
+            {
+                if (durationNs > 0)
+                {
+                    histogram.Record(durationNs);
+                }
+            }
+
+            void HttpClientConnectionManager::OnStreamCompleted(const HttpStreamTimings &timings) noexcept
+            {
+                std::lock_guard<std::mutex> lock(m_metricsLock);
+                s_recordIfObserved(m_requestSendWaitTime, timings.GetSendWaitTimeNs());
+                s_recordIfObserved(m_requestSendTime, timings.GetSendTimeNs());
+                s_recordIfObserved(m_requestTimeToFirstByte, timings.GetTimeToFirstByteNs());
+                s_recordIfObserved(m_requestReceiveTime, timings.GetReceiveTimeNs());
+                s_recordIfObserved(m_requestTotalTime, timings.GetTotalTimeNs());
+            }
+
             class ManagedConnection final : public HttpClientConnection
             {
               public:
                 ManagedConnection(
                     aws_http_connection *connection,
-                    std::shared_ptr<HttpClientConnectionManager> connectionManager)
+                    std::shared_ptr<HttpClientConnectionManager> connectionManager,
+                    uint64_t acquireStartNs)
                     : HttpClientConnection(connection, connectionManager->m_allocator),
                       m_connectionManager(std::move(connectionManager))
                 {
+                    m_connectionTimings.AcquireStartNs = acquireStartNs;
+                    aws_high_res_clock_get_ticks(&m_connectionTimings.AcquiredNs);
+
+                    /* Pick up the streams recycled by earlier leases of this connection */
+                    if (m_connectionManager->m_pooledConnections)
+                    {
+                        AttachStreamPool(m_connectionManager->m_pooledConnections->TakeStreamPool(connection));
+                    }
+
+                    if (m_connectionManager->m_options.EnableRequestTimingMetrics)
+                    {
+                        /* This connection keeps the manager alive, so the raw pointer outlives the callback */
+                        HttpClientConnectionManager *manager = m_connectionManager.get();
+                        m_onStreamCompleted = [manager](const HttpStreamTimings &timings)
+                        { manager->OnStreamCompleted(timings); };
+                    }
                 }
 
                 ~ManagedConnection() override
                 {
                     if (m_connection)
                     {
+                        /* No pooled stream can be in flight, since each keeps this wrapper alive.  The pool goes back
+                         * to the manager before the connection does, so the next lease finds it. */
+                        std::shared_ptr<HttpClientStreamPool> streamPool = DetachStreamPool();
+                        if (m_connectionManager->m_pooledConnections)
+                        {
+                            m_connectionManager->m_pooledConnections->StoreStreamPool(
+                                m_connection, std::move(streamPool));
+                        }
+                        streamPool = nullptr;
+
+                        m_connectionManager->OnConnectionReleased(m_connection);
                         aws_http_connection_manager_release_connection(
                             m_connectionManager->m_connectionManager, m_connection);
                         m_connection = nullptr;
+
+                        /* Replace the connection if the pool dropped it */
+                        m_connectionManager->MaintainMinConnectionsOnRelease();
                     }
                 }
 
@@ -206,9 +851,12 @@ namespace Aws
                 auto callbackArgs = static_cast<ConnectionManagerCallbackArgs *>(userData);
                 std::shared_ptr<HttpClientConnectionManager> manager = callbackArgs->m_connectionManager;
                 auto callback = std::move(callbackArgs->m_onClientConnectionAvailable);
+                uint64_t acquireTimestampNs = callbackArgs->m_acquireTimestampNs;
 
                 Delete(callbackArgs, manager->m_allocator);
 
+                manager->OnAcquisitionCompleted(acquireTimestampNs, connection, errorCode);
+
                 if (errorCode)
                 {
                     callback(nullptr, errorCode);
@@ -216,7 +864,8 @@ namespace Aws
                 }
 
                 auto allocator = manager->m_allocator;
-                auto connectionRawObj = Aws::Crt::New<ManagedConnection>(manager->m_allocator, connection, manager);
+                auto connectionRawObj = Aws::Crt::New<ManagedConnection>(
+                    manager->m_allocator, connection, manager, acquireTimestampNs);
 
                 if (!connectionRawObj)
                 {
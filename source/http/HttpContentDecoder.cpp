@@ -0,0 +1,350 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+#include <aws/crt/http/HttpContentDecoder.h>
+
+#include <aws/http/http.h>
+
+#if defined(AWS_CRT_CPP_USE_ZLIB)
+#    include <zlib.h>
+#endif
+
+namespace Aws
+{
+    namespace Crt
+    {
+        namespace Http
+        {
+            /* Size of the buffer decoded data is handed out from */
+            static const size_t s_outputBufferSize = 32768;
+
+            enum class DecoderState
+            {
+                /* Deflate only: waiting for the two bytes that tell a zlib header from raw deflate data */
+                Detect,
+                Inflating,
+                Done,
+                Failed,
+            };
+
+#if defined(AWS_CRT_CPP_USE_ZLIB)
+            static voidpf s_zlibAlloc(voidpf opaque, uInt items, uInt size)
+            {
+                if (size != 0 && items > SIZE_MAX / size)
+                {
+                    return Z_NULL;
+                }
+                return aws_mem_acquire(static_cast<Allocator *>(opaque), static_cast<size_t>(items) * size);
+            }
+
+            static void s_zlibFree(voidpf opaque, voidpf address)
+            {
+                aws_mem_release(static_cast<Allocator *>(opaque), address);
+            }
+#endif
+
+            struct HttpContentDecoder::Impl
+            {
+                Impl(HttpContentEncoding encoding, Allocator *allocator) noexcept
+                    : allocator(allocator), encoding(encoding),
+                      state(encoding == HttpContentEncoding::Deflate ? DecoderState::Detect : DecoderState::Inflating)
+                {
+#if defined(AWS_CRT_CPP_USE_ZLIB)
+                    AWS_ZERO_STRUCT(zstream);
+                    zstream.zalloc = s_zlibAlloc;
+                    zstream.zfree = s_zlibFree;
+                    zstream.opaque = allocator;
+#endif
+                }
+
+                ~Impl()
+                {
+#if defined(AWS_CRT_CPP_USE_ZLIB)
+                    if (zstreamInitialized)
+                    {
+                        inflateEnd(&zstream);
+                    }
+#endif
+                    if (output)
+                    {
+                        aws_mem_release(allocator, output);
+                    }
+                }
+
+                Allocator *allocator;
+                HttpContentEncoding encoding;
+                DecoderState state;
+
+                uint8_t *output = nullptr;
+
+                uint64_t totalOutput = 0;
+                uint64_t totalInput = 0;
+
+                /* 0 if unlimited */
+                uint64_t maxOutput = 0;
+
+                /* Error raised by Decode() once the decoder has failed */
+                int failureError = AWS_ERROR_HTTP_PROTOCOL_ERROR;
+
+#if defined(AWS_CRT_CPP_USE_ZLIB)
+                z_stream zstream;
+                bool zstreamInitialized = false;
+
+                /* Deflate only: input held back until the format is known */
+                uint8_t detectBytes[2] = {0, 0};
+                size_t detectByteCount = 0;
+
+                /* windowBits as inflateInit2() takes them: gzip, zlib or raw deflate with a 32KiB window.  Only
+                 * fails for lack of memory. */
+                bool Init(int windowBits) noexcept
+                {
+                    if (inflateInit2(&zstream, windowBits) != Z_OK)
+                    {
+                        aws_raise_error(AWS_ERROR_OOM);
+                        return false;
+                    }
+
+                    zstreamInitialized = true;
+                    zstream.avail_out = static_cast<uInt>(s_outputBufferSize);
+                    return true;
+                }
+
+                bool Fail(int errorCode, const char *reason) noexcept
+                {
+                    AWS_LOGF_ERROR(AWS_LS_HTTP_STREAM, "Failed to decode http content: %s", reason);
+                    state = DecoderState::Failed;
+                    failureError = errorCode;
+                    aws_raise_error(errorCode);
+                    return false;
+                }
+
+                /* Hands out the decoded bytes in the output buffer, unless that would exceed the output limit */
+                bool Emit(size_t length, const OnDecodedData &onDecodedData) noexcept
+                {
+                    if (length == 0)
+                    {
+                        return true;
+                    }
+
+                    if (maxOutput > 0 && length > maxOutput - totalOutput)
+                    {
+                        return Fail(AWS_ERROR_OVERFLOW_DETECTED, "output exceeds the limit");
+                    }
+
+                    totalOutput += length;
+                    onDecodedData(ByteCursorFromArray(output, length));
+                    return true;
+                }
+
+                /* Inflates the input into the output buffer, handing out each buffer full as it is produced */
+                bool Inflate(ByteCursor &input, const OnDecodedData &onDecodedData) noexcept
+                {
+                    while (input.len > 0 || zstream.avail_out == 0)
+                    {
+                        if (state == DecoderState::Done)
+                        {
+                            if (input.len == 0)
+                            {
+                                return true;
+                            }
+
+                            if (encoding != HttpContentEncoding::Gzip)
+                            {
+                                /* Ignore anything after the end of a zlib or raw deflate stream */
+                                aws_byte_cursor_advance(&input, input.len);
+                                return true;
+                            }
+
+                            /* Another gzip member follows */
+                            inflateReset(&zstream);
+                            state = DecoderState::Inflating;
+                        }
+
+                        /* inflate() counts its input in a uInt */
+                        uInt inputLength = input.len > UINT32_MAX ? UINT32_MAX : static_cast<uInt>(input.len);
+                        zstream.next_in = const_cast<Bytef *>(input.ptr);
+                        zstream.avail_in = inputLength;
+                        zstream.next_out = output;
+                        zstream.avail_out = static_cast<uInt>(s_outputBufferSize);
+
+                        int result = inflate(&zstream, Z_NO_FLUSH);
+                        aws_byte_cursor_advance(&input, inputLength - zstream.avail_in);
+
+                        switch (result)
+                        {
+                            case Z_OK:
+                            case Z_BUF_ERROR:
+                                break;
+                            case Z_STREAM_END:
+                                state = DecoderState::Done;
+                                break;
+                            case Z_MEM_ERROR:
+                                return Fail(AWS_ERROR_OOM, "out of memory");
+                            default:
+                                return Fail(AWS_ERROR_HTTP_PROTOCOL_ERROR, zstream.msg ? zstream.msg : "invalid data");
+                        }
+
+                        if (!Emit(s_outputBufferSize - zstream.avail_out, onDecodedData))
+                        {
+                            return false;
+                        }
+
+                        /* No progress is possible until more input arrives */
+                        if (result == Z_BUF_ERROR)
+                        {
+                            return true;
+                        }
+                    }
+
+                    return true;
+                }
+
+                /* Deflate only: a zlib header is a deflate method nibble and a check value divisible by 31.  Raw
+                 * deflate data, which some servers send instead, doesn't match in practice: its first byte would
+                 * have to start a stored block with non-zero padding bits. */
+                bool Detect(ByteCursor &input, const OnDecodedData &onDecodedData) noexcept
+                {
+                    while (detectByteCount < 2 && input.len > 0)
+                    {
+                        detectBytes[detectByteCount++] = *input.ptr;
+                        aws_byte_cursor_advance(&input, 1);
+                    }
+                    if (detectByteCount < 2)
+                    {
+                        return true;
+                    }
+
+                    bool zlibWrapped =
+                        (detectBytes[0] & 0x0f) == 8 && (detectBytes[0] >> 4) <= 7 &&
+                        ((static_cast<unsigned>(detectBytes[0]) << 8) | detectBytes[1]) % 31 == 0;
+                    if (!Init(zlibWrapped ? MAX_WBITS : -MAX_WBITS))
+                    {
+                        return Fail(AWS_ERROR_OOM, "out of memory");
+                    }
+
+                    state = DecoderState::Inflating;
+                    ByteCursor held = ByteCursorFromArray(detectBytes, detectByteCount);
+                    return Inflate(held, onDecodedData);
+                }
+#endif
+
+                bool Decode(ByteCursor input, const OnDecodedData &onDecodedData) noexcept
+                {
+                    if (state == DecoderState::Failed)
+                    {
+                        aws_raise_error(failureError);
+                        return false;
+                    }
+
+                    totalInput += input.len;
+                    if (encoding == HttpContentEncoding::Identity)
+                    {
+                        totalOutput += input.len;
+                        onDecodedData(input);
+                        return true;
+                    }
+
+#if defined(AWS_CRT_CPP_USE_ZLIB)
+                    if (state == DecoderState::Detect && !Detect(input, onDecodedData))
+                    {
+                        return false;
+                    }
+
+                    return state == DecoderState::Detect || Inflate(input, onDecodedData);
+#else
+                    state = DecoderState::Failed;
+                    failureError = AWS_ERROR_PLATFORM_NOT_SUPPORTED;
+                    aws_raise_error(failureError);
+                    return false;
+#endif
+                }
+            };
+
+            HttpContentDecoder::HttpContentDecoder(HttpContentEncoding encoding, Allocator *allocator) noexcept
+                : m_impl(
+                      New<Impl>(allocator, encoding, allocator),
+                      [allocator](Impl *impl) { Delete(impl, allocator); })
+            {
+                if (!m_impl || encoding == HttpContentEncoding::Identity)
+                {
+                    return;
+                }
+
+#if defined(AWS_CRT_CPP_USE_ZLIB)
+                m_impl->output = static_cast<uint8_t *>(aws_mem_acquire(allocator, s_outputBufferSize));
+                if (!m_impl->output)
+                {
+                    m_impl = nullptr;
+                    return;
+                }
+
+                /* gzip is known up front; deflate waits for its first two bytes */
+                if (encoding == HttpContentEncoding::Gzip && !m_impl->Init(MAX_WBITS + 16))
+                {
+                    m_impl = nullptr;
+                }
+#else
+                AWS_LOGF_ERROR(
+                    AWS_LS_HTTP_STREAM, "Failed to create http content decoder: built without zlib (USE_ZLIB=OFF).");
+                aws_raise_error(AWS_ERROR_PLATFORM_NOT_SUPPORTED);
+                m_impl = nullptr;
+#endif
+            }
+
+            HttpContentDecoder::~HttpContentDecoder() = default;
+
+            Optional<HttpContentEncoding> HttpContentDecoder::EncodingFromHeaderValue(ByteCursor headerValue) noexcept
+            {
+                ByteCursor value = aws_byte_cursor_trim_pred(&headerValue, aws_char_is_space);
+
+                ByteCursor gzip = aws_byte_cursor_from_c_str("gzip");
+                ByteCursor xGzip = aws_byte_cursor_from_c_str("x-gzip");
+                ByteCursor deflate = aws_byte_cursor_from_c_str("deflate");
+                ByteCursor identity = aws_byte_cursor_from_c_str("identity");
+
+                if (aws_byte_cursor_eq_ignore_case(&value, &gzip) || aws_byte_cursor_eq_ignore_case(&value, &xGzip))
+                {
+                    return Optional<HttpContentEncoding>(HttpContentEncoding::Gzip);
+                }
+
+                if (aws_byte_cursor_eq_ignore_case(&value, &deflate))
+                {
+                    return Optional<HttpContentEncoding>(HttpContentEncoding::Deflate);
+                }
+
+                if (value.len == 0 || aws_byte_cursor_eq_ignore_case(&value, &identity))
+                {
+                    return Optional<HttpContentEncoding>(HttpContentEncoding::Identity);
+                }
+
+                return Optional<HttpContentEncoding>();
+            }
+
+            bool HttpContentDecoder::Decode(ByteCursor input, const OnDecodedData &onDecodedData) noexcept
+            {
+                return m_impl->Decode(input, onDecodedData);
+            }
+
+            void HttpContentDecoder::SetMaxOutputByteCount(uint64_t maxOutputBytes) noexcept
+            {
+                m_impl->maxOutput = maxOutputBytes;
+            }
+
+            bool HttpContentDecoder::IsComplete() const noexcept
+            {
+                return m_impl->encoding == HttpContentEncoding::Identity || m_impl->state == DecoderState::Done;
+            }
+
+            uint64_t HttpContentDecoder::GetInputByteCount() const noexcept
+            {
+                return m_impl->totalInput;
+            }
+
+            uint64_t HttpContentDecoder::GetOutputByteCount() const noexcept
+            {
+                return m_impl->totalOutput;
+            }
+        } // namespace Http
+    } // namespace Crt
+} // namespace Aws
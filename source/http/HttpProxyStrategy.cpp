@@ -4,6 +4,7 @@
  */
 #include <aws/crt/http/HttpProxyStrategy.h>
 
+#include <aws/common/clock.h>
 #include <aws/common/string.h>
 #include <aws/crt/http/HttpConnection.h>
 #include <aws/http/proxy.h>
@@ -46,6 +47,48 @@ namespace Aws
                 return Aws::Crt::MakeShared<HttpProxyStrategy>(allocator, strategy);
             }
 
+            CachedProxyCredential::CachedProxyCredential(uint64_t ttlMs) noexcept
+                : m_ttlNs(aws_timestamp_convert(ttlMs, AWS_TIMESTAMP_MILLIS, AWS_TIMESTAMP_NANOS, NULL)),
+                  m_expirationNs(0)
+            {
+            }
+
+            bool CachedProxyCredential::Get(const KerberosGetTokenFunction &fetchCredential, String &credential)
+            {
+                if (m_ttlNs == 0)
+                {
+                    return fetchCredential(credential);
+                }
+
+                uint64_t now = 0;
+                aws_high_res_clock_get_ticks(&now);
+                {
+                    std::lock_guard<std::mutex> lock(m_lock);
+                    if (now < m_expirationNs)
+                    {
+                        credential = m_value;
+                        return true;
+                    }
+                }
+
+                if (!fetchCredential(credential))
+                {
+                    return false;
+                }
+
+                std::lock_guard<std::mutex> lock(m_lock);
+                m_value = credential;
+                m_expirationNs = now + m_ttlNs;
+                return true;
+            }
+
+            void CachedProxyCredential::Clear() noexcept
+            {
+                std::lock_guard<std::mutex> lock(m_lock);
+                m_value.clear();
+                m_expirationNs = 0;
+            }
+
             class AdaptiveHttpProxyStrategy : public HttpProxyStrategy
             {
               public:
@@ -53,10 +96,19 @@ namespace Aws
                     Allocator *allocator,
                     const KerberosGetTokenFunction &kerberosGetToken,
                     const KerberosGetTokenFunction &ntlmGetCredential,
-                    const NtlmGetTokenFunction &ntlmGetToken)
+                    const NtlmGetTokenFunction &ntlmGetToken,
+                    uint64_t kerberosTokenCacheTtlMs,
+                    uint64_t ntlmCredentialCacheTtlMs)
                     : HttpProxyStrategy(nullptr), m_Allocator(allocator), m_KerberosGetToken(kerberosGetToken),
-                      m_NtlmGetCredential(ntlmGetCredential), m_NtlmGetToken(ntlmGetToken)
+                      m_NtlmGetCredential(ntlmGetCredential), m_NtlmGetToken(ntlmGetToken),
+                      m_KerberosTokenCache(kerberosTokenCacheTtlMs), m_NtlmCredentialCache(ntlmCredentialCacheTtlMs)
+                {
+                }
+
+                void ClearCachedCredentials() noexcept override
                 {
+                    m_KerberosTokenCache.Clear();
+                    m_NtlmCredentialCache.Clear();
                 }
 
                 void SetStrategy(struct aws_http_proxy_strategy *strategy)
@@ -70,7 +122,7 @@ namespace Aws
                     AdaptiveHttpProxyStrategy *strategy = reinterpret_cast<AdaptiveHttpProxyStrategy *>(user_data);
 
                     String ntlmCredential;
-                    if (strategy->m_NtlmGetCredential(ntlmCredential))
+                    if (strategy->m_NtlmCredentialCache.Get(strategy->m_NtlmGetCredential, ntlmCredential))
                     {
                         struct aws_string *token =
                             aws_string_new_from_c_str(strategy->m_Allocator, ntlmCredential.c_str());
@@ -95,7 +147,7 @@ namespace Aws
                     AdaptiveHttpProxyStrategy *strategy = reinterpret_cast<AdaptiveHttpProxyStrategy *>(user_data);
 
                     String kerberosToken;
-                    if (strategy->m_KerberosGetToken(kerberosToken))
+                    if (strategy->m_KerberosTokenCache.Get(strategy->m_KerberosGetToken, kerberosToken))
                     {
                         struct aws_string *token =
                             aws_string_new_from_c_str(strategy->m_Allocator, kerberosToken.c_str());
@@ -149,6 +201,9 @@ namespace Aws
                 KerberosGetTokenFunction m_KerberosGetToken;
                 KerberosGetTokenFunction m_NtlmGetCredential;
                 NtlmGetTokenFunction m_NtlmGetToken;
+
+                CachedProxyCredential m_KerberosTokenCache;
+                CachedProxyCredential m_NtlmCredentialCache;
             };
 
             std::shared_ptr<HttpProxyStrategy> HttpProxyStrategy::CreateAdaptiveHttpProxyStrategy(
@@ -157,7 +212,13 @@ namespace Aws
             {
                 std::shared_ptr<AdaptiveHttpProxyStrategy> adaptiveStrategy =
                     Aws::Crt::MakeShared<AdaptiveHttpProxyStrategy>(
-                        allocator, allocator, config.KerberosGetToken, config.NtlmGetCredential, config.NtlmGetToken);
+                        allocator,
+                        allocator,
+                        config.KerberosGetToken,
+                        config.NtlmGetCredential,
+                        config.NtlmGetToken,
+                        config.CacheKerberosTokens ? config.TokenCacheTtlMs : 0,
+                        config.TokenCacheTtlMs);
 
                 struct aws_http_proxy_strategy_tunneling_kerberos_options kerberosConfig;
                 AWS_ZERO_STRUCT(kerberosConfig);
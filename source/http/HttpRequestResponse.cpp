@@ -15,6 +15,60 @@ namespace Aws
     {
         namespace Http
         {
+            HttpHeaderView::HttpHeaderView(const HttpHeader *headers, size_t count) noexcept
+                : m_headerArray(headers), m_headerArrayCount(count), m_headers(nullptr)
+            {
+            }
+
+            HttpHeaderView::HttpHeaderView(const struct aws_http_headers *headers) noexcept
+                : m_headerArray(nullptr), m_headerArrayCount(0), m_headers(headers)
+            {
+            }
+
+            size_t HttpHeaderView::size() const noexcept
+            {
+                return m_headers ? aws_http_headers_count(m_headers) : m_headerArrayCount;
+            }
+
+            HttpHeader HttpHeaderView::operator[](size_t index) const noexcept
+            {
+                if (!m_headers)
+                {
+                    return m_headerArray[index];
+                }
+
+                HttpHeader header;
+                AWS_ZERO_STRUCT(header);
+                aws_http_headers_get_index(m_headers, index, &header);
+                return header;
+            }
+
+            Optional<ByteCursor> HttpHeaderView::FindHeader(ByteCursor name) const noexcept
+            {
+                for (const HttpHeader &header : *this)
+                {
+                    if (aws_byte_cursor_eq_ignore_case(&header.name, &name))
+                    {
+                        return Optional<ByteCursor>(header.value);
+                    }
+                }
+
+                return Optional<ByteCursor>();
+            }
+
+            Vector<ByteCursor> HttpHeaderView::GetHeaderValues(ByteCursor name, Allocator *allocator) const noexcept
+            {
+                Vector<ByteCursor> values(StlAllocator<ByteCursor>(allocator));
+                for (const HttpHeader &header : *this)
+                {
+                    if (aws_byte_cursor_eq_ignore_case(&header.name, &name))
+                    {
+                        values.push_back(header.value);
+                    }
+                }
+
+                return values;
+            }
 
             HttpMessage::HttpMessage(Allocator *allocator, struct aws_http_message *message) noexcept
                 : m_allocator(allocator), m_message(message), m_bodyStream(nullptr)
@@ -79,6 +133,21 @@ namespace Aws
                 return Optional<HttpHeader>(header);
             }
 
+            HttpHeaderView HttpMessage::GetHeaders() const noexcept
+            {
+                return HttpHeaderView(aws_http_message_get_const_headers(m_message));
+            }
+
+            Optional<ByteCursor> HttpMessage::FindHeader(ByteCursor name) const noexcept
+            {
+                return GetHeaders().FindHeader(name);
+            }
+
+            Vector<ByteCursor> HttpMessage::GetHeaderValues(ByteCursor name) const noexcept
+            {
+                return GetHeaders().GetHeaderValues(name, m_allocator);
+            }
+
             bool HttpMessage::AddHeader(const HttpHeader &header) noexcept
             {
                 return aws_http_message_add_header(m_message, header) == AWS_OP_SUCCESS;
@@ -5,6 +5,7 @@
 #include <aws/crt/io/ChannelHandler.h>
 
 #include <chrono>
+#include <mutex>
 
 namespace Aws
 {
@@ -100,7 +101,98 @@ namespace Aws
                 s_GatherStatistics,
             };
 
-            ChannelHandler::ChannelHandler(Allocator *allocator) : m_allocator(allocator)
+            struct TaskWrapper
+            {
+                struct aws_channel_task task
+                {
+                };
+                std::function<void(TaskStatus)> wrappingFn;
+                Allocator *allocator{};
+                /* Null if the handler's pool couldn't be allocated; the wrapper is then freed after one use */
+                std::shared_ptr<TaskWrapperPool> pool;
+                TaskWrapper *nextFree{};
+            };
+
+            /* Upper bound on the task wrappers each handler keeps for reuse */
+            static const size_t s_maxFreeTaskWrappers = 64;
+
+            /**
+             * Recycles the TaskWrappers of one handler. Pending wrappers keep the pool alive, so tasks canceled after
+             * the handler is gone can still be returned to it.
+             */
+            struct TaskWrapperPool
+            {
+                explicit TaskWrapperPool(Allocator *allocator) noexcept
+                    : allocator(allocator), freeWrappers(nullptr), freeCount(0)
+                {
+                }
+
+                ~TaskWrapperPool()
+                {
+                    while (freeWrappers != nullptr)
+                    {
+                        TaskWrapper *wrapper = freeWrappers;
+                        freeWrappers = wrapper->nextFree;
+                        Delete(wrapper, allocator);
+                    }
+                }
+
+                static TaskWrapper *Acquire(const std::shared_ptr<TaskWrapperPool> &pool, Allocator *allocator)
+                {
+                    TaskWrapper *wrapper = nullptr;
+                    if (pool)
+                    {
+                        std::lock_guard<std::mutex> lock(pool->lock);
+                        wrapper = pool->freeWrappers;
+                        if (wrapper != nullptr)
+                        {
+                            pool->freeWrappers = wrapper->nextFree;
+                            --pool->freeCount;
+                        }
+                    }
+
+                    if (wrapper == nullptr)
+                    {
+                        wrapper = New<TaskWrapper>(allocator);
+                        if (wrapper == nullptr)
+                        {
+                            return nullptr;
+                        }
+                        wrapper->allocator = allocator;
+                    }
+
+                    wrapper->pool = pool;
+                    wrapper->nextFree = nullptr;
+                    return wrapper;
+                }
+
+                static void Release(TaskWrapper *wrapper)
+                {
+                    wrapper->wrappingFn = nullptr;
+                    std::shared_ptr<TaskWrapperPool> pool = std::move(wrapper->pool);
+                    if (pool)
+                    {
+                        std::lock_guard<std::mutex> lock(pool->lock);
+                        if (pool->freeCount < s_maxFreeTaskWrappers)
+                        {
+                            wrapper->nextFree = pool->freeWrappers;
+                            pool->freeWrappers = wrapper;
+                            ++pool->freeCount;
+                            return;
+                        }
+                    }
+
+                    Delete(wrapper, wrapper->allocator);
+                }
+
+                Allocator *allocator;
+                std::mutex lock;
+                TaskWrapper *freeWrappers;
+                size_t freeCount;
+            };
+
+            ChannelHandler::ChannelHandler(Allocator *allocator)
+                : m_allocator(allocator), m_taskWrapperPool(MakeShared<TaskWrapperPool>(allocator, allocator))
             {
                 AWS_ZERO_STRUCT(m_handler);
                 m_handler.alloc = allocator;
@@ -136,12 +228,54 @@ namespace Aws
                 return aws_channel_thread_is_callers_thread(GetSlot()->channel);
             }
 
+            size_t ChannelHandler::AcquireMessagesFromPool(
+                MessageType messageType,
+                size_t sizeHint,
+                size_t count,
+                Vector<struct aws_io_message *> &messages)
+            {
+                struct aws_channel *channel = GetSlot()->channel;
+                messages.reserve(messages.size() + count);
+
+                size_t acquired = 0;
+                for (; acquired < count; ++acquired)
+                {
+                    struct aws_io_message *message = aws_channel_acquire_message_from_pool(
+                        channel, static_cast<aws_io_message_type>(messageType), sizeHint);
+                    if (message == nullptr)
+                    {
+                        break;
+                    }
+                    messages.push_back(message);
+                }
+
+                return acquired;
+            }
+
             bool ChannelHandler::SendMessage(struct aws_io_message *message, ChannelDirection direction)
             {
                 return aws_channel_slot_send_message(
                            GetSlot(), message, static_cast<aws_channel_direction>(direction)) == AWS_OP_SUCCESS;
             }
 
+            bool ChannelHandler::SendMessages(Vector<struct aws_io_message *> &messages, ChannelDirection direction)
+            {
+                struct aws_channel_slot *slot = GetSlot();
+
+                size_t sent = 0;
+                for (; sent < messages.size(); ++sent)
+                {
+                    if (aws_channel_slot_send_message(
+                            slot, messages[sent], static_cast<aws_channel_direction>(direction)) != AWS_OP_SUCCESS)
+                    {
+                        break;
+                    }
+                }
+
+                messages.erase(messages.begin(), messages.begin() + sent);
+                return messages.empty();
+            }
+
             bool ChannelHandler::IncrementUpstreamReadWindow(size_t windowUpdateSize)
             {
                 return aws_channel_slot_increment_read_window(GetSlot(), windowUpdateSize) == AWS_OP_SUCCESS;
@@ -178,27 +312,23 @@ namespace Aws
                 return m_handler.slot;
             }
 
-            struct TaskWrapper
-            {
-                struct aws_channel_task task
-                {
-                };
-                Allocator *allocator{};
-                std::function<void(TaskStatus)> wrappingFn;
-            };
-
             static void s_ChannelTaskCallback(struct aws_channel_task *, void *arg, enum aws_task_status status)
             {
                 auto *taskWrapper = reinterpret_cast<TaskWrapper *>(arg);
                 taskWrapper->wrappingFn(static_cast<TaskStatus>(status));
-                Delete(taskWrapper, taskWrapper->allocator);
+                TaskWrapperPool::Release(taskWrapper);
             }
 
             void ChannelHandler::ScheduleTask(std::function<void(TaskStatus)> &&task, std::chrono::nanoseconds run_in)
             {
-                auto *wrapper = New<TaskWrapper>(m_allocator);
+                auto *wrapper = TaskWrapperPool::Acquire(m_taskWrapperPool, m_allocator);
+                if (wrapper == nullptr)
+                {
+                    /* Every task runs exactly once, so one that can't be scheduled is canceled right away */
+                    task(TaskStatus::Canceled);
+                    return;
+                }
                 wrapper->wrappingFn = std::move(task);
-                wrapper->allocator = m_allocator;
                 aws_channel_task_init(
                     &wrapper->task, s_ChannelTaskCallback, wrapper, "cpp-crt-custom-channel-handler-task");
 
@@ -209,9 +339,13 @@ namespace Aws
 
             void ChannelHandler::ScheduleTask(std::function<void(TaskStatus)> &&task)
             {
-                auto *wrapper = New<TaskWrapper>(m_allocator);
+                auto *wrapper = TaskWrapperPool::Acquire(m_taskWrapperPool, m_allocator);
+                if (wrapper == nullptr)
+                {
+                    task(TaskStatus::Canceled);
+                    return;
+                }
                 wrapper->wrappingFn = std::move(task);
-                wrapper->allocator = m_allocator;
                 aws_channel_task_init(
                     &wrapper->task, s_ChannelTaskCallback, wrapper, "cpp-crt-custom-channel-handler-task");
 
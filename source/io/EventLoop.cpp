@@ -0,0 +1,150 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+#include <aws/crt/io/EventLoop.h>
+#include <aws/crt/io/private/EventLoopState.h>
+
+#include <aws/io/event_loop.h>
+
+#include <aws/common/error.h>
+
+namespace Aws
+{
+    namespace Crt
+    {
+        namespace Io
+        {
+            const size_t EventLoopTaskNode::INLINE_CAPACITY;
+
+            /* Upper bound on the task nodes each loop keeps for reuse */
+            static const size_t s_maxFreeTaskNodes = 256;
+
+            void EventLoop::s_OnTaskNode(struct aws_task *task, void *arg, enum aws_task_status status)
+            {
+                (void)task;
+                auto *node = static_cast<EventLoopTaskNode *>(arg);
+                node->invoke(*node, static_cast<TaskStatus>(status));
+                --node->state->pendingTaskCount;
+                ReleaseTaskNode(node);
+            }
+
+            EventLoop::EventLoop() noexcept : m_eventLoop(nullptr), m_state(), m_allocator(nullptr) {}
+
+            EventLoop::EventLoop(
+                struct aws_event_loop *eventLoop,
+                std::shared_ptr<EventLoopState> state,
+                Allocator *allocator) noexcept
+                : m_eventLoop(eventLoop), m_state(std::move(state)), m_allocator(allocator)
+            {
+            }
+
+            bool EventLoop::IsCallersThread() const noexcept
+            {
+                return m_eventLoop != nullptr && aws_event_loop_thread_is_callers_thread(m_eventLoop);
+            }
+
+            uint64_t EventLoop::GetCurrentClockTimeNs() const noexcept
+            {
+                uint64_t now = 0;
+                if (m_eventLoop != nullptr)
+                {
+                    aws_event_loop_current_clock_time(m_eventLoop, &now);
+                }
+
+                return now;
+            }
+
+            EventLoopStatistics EventLoop::GetStatistics() const noexcept
+            {
+                EventLoopStatistics statistics;
+                if (m_eventLoop == nullptr)
+                {
+                    return statistics;
+                }
+
+                statistics.LoadFactor = aws_event_loop_get_load_factor(m_eventLoop);
+                if (m_state)
+                {
+                    statistics.LoopIndex = m_state->loopIndex;
+
+                    std::lock_guard<std::mutex> lock(m_state->lock);
+                    statistics.SchedulerLag = m_state->schedulerLag;
+                    statistics.PendingTaskCount = m_state->pendingTaskCount;
+                    statistics.ScheduledTaskCount = m_state->scheduledTaskCount;
+                }
+
+                return statistics;
+            }
+
+            EventLoopTaskNode *EventLoop::AcquireTaskNode() const noexcept
+            {
+                if (m_eventLoop == nullptr || !m_state)
+                {
+                    aws_raise_error(AWS_ERROR_INVALID_STATE);
+                    return nullptr;
+                }
+
+                EventLoopTaskNode *node = nullptr;
+                {
+                    std::lock_guard<std::mutex> lock(m_state->taskNodeLock);
+                    node = m_state->freeTaskNodes;
+                    if (node != nullptr)
+                    {
+                        m_state->freeTaskNodes = node->nextFree;
+                        --m_state->freeTaskNodeCount;
+                    }
+                }
+
+                if (node == nullptr)
+                {
+                    node = New<EventLoopTaskNode>(m_state->allocator);
+                    if (node == nullptr)
+                    {
+                        return nullptr;
+                    }
+                }
+
+                node->invoke = nullptr;
+                node->allocator = m_state->allocator;
+                node->state = m_state;
+                node->nextFree = nullptr;
+                return node;
+            }
+
+            void EventLoop::ReleaseTaskNode(EventLoopTaskNode *node) noexcept
+            {
+                /* The node doesn't keep its loop's state alive while pooled; the state frees pooled nodes */
+                std::shared_ptr<EventLoopState> state = std::move(node->state);
+                {
+                    std::lock_guard<std::mutex> lock(state->taskNodeLock);
+                    if (state->freeTaskNodeCount < s_maxFreeTaskNodes)
+                    {
+                        node->nextFree = state->freeTaskNodes;
+                        state->freeTaskNodes = node;
+                        ++state->freeTaskNodeCount;
+                        return;
+                    }
+                }
+
+                Delete(node, state->allocator);
+            }
+
+            void EventLoop::SubmitTaskNode(EventLoopTaskNode *node, bool runLater, uint64_t runAtNs) const noexcept
+            {
+                aws_task_init(&node->task, s_OnTaskNode, node, "cpp-crt-event-loop-task");
+                ++m_state->pendingTaskCount;
+                ++m_state->scheduledTaskCount;
+
+                if (runLater)
+                {
+                    aws_event_loop_schedule_task_future(m_eventLoop, &node->task, runAtNs);
+                }
+                else
+                {
+                    aws_event_loop_schedule_task_now(m_eventLoop, &node->task);
+                }
+            }
+        } // namespace Io
+    } // namespace Crt
+} // namespace Aws
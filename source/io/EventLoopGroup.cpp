@@ -3,53 +3,260 @@
  * SPDX-License-Identifier: Apache-2.0.
  */
 #include <aws/crt/io/EventLoopGroup.h>
+#include <aws/crt/io/private/EventLoopState.h>
+
+#include <aws/common/clock.h>
+#include <aws/common/task_scheduler.h>
+#include <aws/io/logging.h>
+
+#include <cerrno>
+
+#include <future>
 #include <iostream>
 
+#if defined(__linux__)
+#    include <sched.h>
+#endif
+
 namespace Aws
 {
     namespace Crt
     {
         namespace Io
         {
+            /* Timer task that records how late the loop ran it, then reschedules itself */
+            struct SchedulerLagProbe
+            {
+                SchedulerLagProbe(
+                    Allocator *allocator,
+                    struct aws_event_loop *eventLoop,
+                    std::shared_ptr<EventLoopState> state,
+                    uint64_t intervalNs) noexcept
+                    : allocator(allocator), eventLoop(eventLoop), state(std::move(state)), intervalNs(intervalNs),
+                      dueTimeNs(0)
+                {
+                    AWS_ZERO_STRUCT(task);
+                }
+
+                void ScheduleNext(uint64_t nowNs) noexcept
+                {
+                    dueTimeNs = nowNs + intervalNs;
+                    aws_task_init(&task, s_onProbe, this, "EventLoopSchedulerLagProbe");
+                    aws_event_loop_schedule_task_future(eventLoop, &task, dueTimeNs);
+                }
+
+                static void s_onProbe(struct aws_task *task, void *arg, enum aws_task_status status)
+                {
+                    (void)task;
+                    auto *probe = static_cast<SchedulerLagProbe *>(arg);
+                    if (status != AWS_TASK_STATUS_RUN_READY || probe->state->probesStopped)
+                    {
+                        Delete(probe, probe->allocator);
+                        return;
+                    }
+
+                    uint64_t now = 0;
+                    aws_event_loop_current_clock_time(probe->eventLoop, &now);
+                    {
+                        std::lock_guard<std::mutex> lock(probe->state->lock);
+                        probe->state->schedulerLag.Record(now > probe->dueTimeNs ? now - probe->dueTimeNs : 0);
+                    }
+
+                    probe->ScheduleNext(now);
+                }
+
+                struct aws_task task;
+                Allocator *allocator;
+                struct aws_event_loop *eventLoop;
+                std::shared_ptr<EventLoopState> state;
+                uint64_t intervalNs;
+                uint64_t dueTimeNs;
+            };
+
+            /* Runs on a loop's thread and restricts that thread to a set of cpus. Deletes itself once run. */
+            struct LoopPinningTask
+            {
+                LoopPinningTask(Allocator *allocator, const Vector<uint16_t> &cpuSet) noexcept
+                    : allocator(allocator), cpuSet(cpuSet)
+                {
+                    AWS_ZERO_STRUCT(task);
+                }
+
+                /* Narrows the thread's current affinity, which already reflects any cpu group, to cpuSet */
+                static int s_pinCurrentThread(const Vector<uint16_t> &cpuSet) noexcept
+                {
+#if defined(__linux__)
+                    cpu_set_t requested;
+                    CPU_ZERO(&requested);
+                    for (uint16_t cpu : cpuSet)
+                    {
+                        if (cpu >= CPU_SETSIZE)
+                        {
+                            return AWS_ERROR_INVALID_ARGUMENT;
+                        }
+                        CPU_SET(cpu, &requested);
+                    }
+
+                    cpu_set_t current;
+                    CPU_ZERO(&current);
+                    if (sched_getaffinity(0, sizeof(current), &current) != 0)
+                    {
+                        return AWS_ERROR_SYS_CALL_FAILURE;
+                    }
+
+                    cpu_set_t cpus;
+                    CPU_AND(&cpus, &requested, &current);
+                    if (CPU_COUNT(&cpus) == 0)
+                    {
+                        return AWS_ERROR_INVALID_ARGUMENT;
+                    }
+
+                    if (sched_setaffinity(0, sizeof(cpus), &cpus) != 0)
+                    {
+                        return errno == EINVAL ? AWS_ERROR_INVALID_ARGUMENT : AWS_ERROR_SYS_CALL_FAILURE;
+                    }
+
+                    return AWS_ERROR_SUCCESS;
+#else
+                    (void)cpuSet;
+                    return AWS_ERROR_PLATFORM_NOT_SUPPORTED;
+#endif
+                }
+
+                static void s_onPin(struct aws_task *task, void *arg, enum aws_task_status status)
+                {
+                    (void)task;
+                    auto *pinning = static_cast<LoopPinningTask *>(arg);
+                    pinning->result.set_value(
+                        status == AWS_TASK_STATUS_RUN_READY ? s_pinCurrentThread(pinning->cpuSet)
+                                                            : AWS_ERROR_INVALID_STATE);
+                    Delete(pinning, pinning->allocator);
+                }
+
+                struct aws_task task;
+                Allocator *allocator;
+                /* Only read before result is set, while the waiting thread keeps it alive */
+                const Vector<uint16_t> &cpuSet;
+                std::promise<int> result;
+            };
+
             EventLoopGroup::EventLoopGroup(uint16_t threadCount, Allocator *allocator) noexcept
-                : m_eventLoopGroup(nullptr), m_lastError(AWS_ERROR_SUCCESS)
+                : m_eventLoopGroup(nullptr), m_lastError(AWS_ERROR_SUCCESS), m_allocator(allocator),
+                  m_lagProbesEnabled(false)
             {
                 m_eventLoopGroup = aws_event_loop_group_new_default(allocator, threadCount, NULL);
                 if (m_eventLoopGroup == nullptr)
                 {
                     m_lastError = aws_last_error();
+                    return;
                 }
+
+                InitLoopStates();
             }
 
             EventLoopGroup::EventLoopGroup(uint16_t cpuGroup, uint16_t threadCount, Allocator *allocator) noexcept
-                : m_eventLoopGroup(nullptr), m_lastError(AWS_ERROR_SUCCESS)
+                : m_eventLoopGroup(nullptr), m_lastError(AWS_ERROR_SUCCESS), m_allocator(allocator),
+                  m_lagProbesEnabled(false)
             {
                 m_eventLoopGroup =
                     aws_event_loop_group_new_default_pinned_to_cpu_group(allocator, threadCount, cpuGroup, NULL);
                 if (m_eventLoopGroup == nullptr)
                 {
                     m_lastError = aws_last_error();
+                    return;
+                }
+
+                InitLoopStates();
+            }
+
+            EventLoopGroup::EventLoopGroup(const EventLoopGroupOptions &options, Allocator *allocator) noexcept
+                : m_eventLoopGroup(nullptr), m_lastError(AWS_ERROR_SUCCESS), m_allocator(allocator),
+                  m_lagProbesEnabled(false)
+            {
+                size_t loopCount = options.Loops.empty() ? options.ThreadCount : options.Loops.size();
+                if (loopCount > UINT16_MAX || (!options.Loops.empty() && options.ThreadCount != 0 &&
+                                               options.ThreadCount != options.Loops.size()))
+                {
+                    m_lastError = AWS_ERROR_INVALID_ARGUMENT;
+                    return;
+                }
+
+                if (options.CpuGroup)
+                {
+                    m_eventLoopGroup = aws_event_loop_group_new_default_pinned_to_cpu_group(
+                        allocator, static_cast<uint16_t>(loopCount), options.CpuGroup.value(), NULL);
+                }
+                else
+                {
+                    m_eventLoopGroup =
+                        aws_event_loop_group_new_default(allocator, static_cast<uint16_t>(loopCount), NULL);
+                }
+
+                if (m_eventLoopGroup == nullptr)
+                {
+                    m_lastError = aws_last_error();
+                    return;
+                }
+
+                if (!InitLoopStates())
+                {
+                    return;
+                }
+
+                for (size_t i = 0; i < options.Loops.size() && i < m_loopAllocators.size(); ++i)
+                {
+                    const EventLoopOptions &loopOptions = options.Loops[i];
+                    if (loopOptions.LoopAllocator != nullptr)
+                    {
+                        m_loopAllocators[i] = loopOptions.LoopAllocator;
+                        m_loopStates[i]->allocator = loopOptions.LoopAllocator;
+                    }
+
+                    if (!loopOptions.CpuSet.empty() && !PinLoop(i, loopOptions.CpuSet))
+                    {
+                        m_lastError = aws_last_error();
+                        aws_event_loop_group_release(m_eventLoopGroup);
+                        m_eventLoopGroup = nullptr;
+                        m_loopStates.clear();
+                        m_loopAllocators.clear();
+                        return;
+                    }
                 }
             }
 
             EventLoopGroup::~EventLoopGroup()
             {
+                StopSchedulerLagProbes();
                 aws_event_loop_group_release(m_eventLoopGroup);
             }
 
             EventLoopGroup::EventLoopGroup(EventLoopGroup &&toMove) noexcept
-                : m_eventLoopGroup(toMove.m_eventLoopGroup), m_lastError(toMove.m_lastError)
+                : m_eventLoopGroup(toMove.m_eventLoopGroup), m_lastError(toMove.m_lastError),
+                  m_allocator(toMove.m_allocator), m_loopStates(std::move(toMove.m_loopStates)),
+                  m_loopAllocators(std::move(toMove.m_loopAllocators)), m_lagProbesEnabled(toMove.m_lagProbesEnabled)
             {
                 toMove.m_lastError = AWS_ERROR_UNKNOWN;
                 toMove.m_eventLoopGroup = nullptr;
+                toMove.m_loopStates.clear();
+                toMove.m_loopAllocators.clear();
+                toMove.m_lagProbesEnabled = false;
             }
 
             EventLoopGroup &EventLoopGroup::operator=(EventLoopGroup &&toMove) noexcept
             {
+                StopSchedulerLagProbes();
+
                 m_eventLoopGroup = toMove.m_eventLoopGroup;
                 m_lastError = toMove.m_lastError;
+                m_allocator = toMove.m_allocator;
+                m_loopStates = std::move(toMove.m_loopStates);
+                m_loopAllocators = std::move(toMove.m_loopAllocators);
+                m_lagProbesEnabled = toMove.m_lagProbesEnabled;
                 toMove.m_lastError = AWS_ERROR_UNKNOWN;
                 toMove.m_eventLoopGroup = nullptr;
+                toMove.m_loopStates.clear();
+                toMove.m_loopAllocators.clear();
+                toMove.m_lagProbesEnabled = false;
 
                 return *this;
             }
@@ -64,6 +271,108 @@ namespace Aws
                 return m_lastError == AWS_ERROR_SUCCESS;
             }
 
+            size_t EventLoopGroup::GetLoopCount() const noexcept
+            {
+                return *this ? aws_event_loop_group_get_loop_count(m_eventLoopGroup) : 0;
+            }
+
+            EventLoop EventLoopGroup::GetLoopAt(size_t index) noexcept
+            {
+                if (index >= m_loopStates.size())
+                {
+                    aws_raise_error(AWS_ERROR_INVALID_INDEX);
+                    return EventLoop();
+                }
+
+                return EventLoop(
+                    aws_event_loop_group_get_loop_at(m_eventLoopGroup, index),
+                    m_loopStates[index],
+                    m_loopAllocators[index]);
+            }
+
+            EventLoop EventLoopGroup::GetNextLoop() noexcept
+            {
+                if (!*this)
+                {
+                    aws_raise_error(AWS_ERROR_INVALID_STATE);
+                    return EventLoop();
+                }
+
+                struct aws_event_loop *eventLoop = aws_event_loop_group_get_next_loop(m_eventLoopGroup);
+                for (size_t i = 0; i < m_loopStates.size(); ++i)
+                {
+                    if (aws_event_loop_group_get_loop_at(m_eventLoopGroup, i) == eventLoop)
+                    {
+                        return EventLoop(eventLoop, m_loopStates[i], m_loopAllocators[i]);
+                    }
+                }
+
+                return EventLoop(eventLoop, nullptr, m_allocator);
+            }
+
+            Vector<EventLoopStatistics> EventLoopGroup::GetStatistics() const
+            {
+                Vector<EventLoopStatistics> statistics;
+                statistics.reserve(m_loopStates.size());
+                for (size_t i = 0; i < m_loopStates.size(); ++i)
+                {
+                    statistics.push_back(
+                        EventLoop(
+                            aws_event_loop_group_get_loop_at(m_eventLoopGroup, i),
+                            m_loopStates[i],
+                            m_loopAllocators[i])
+                            .GetStatistics());
+                }
+
+                return statistics;
+            }
+
+            bool EventLoopGroup::EnableSchedulerLagProbes(uint64_t intervalMs) noexcept
+            {
+                if (!*this || m_lagProbesEnabled)
+                {
+                    aws_raise_error(AWS_ERROR_INVALID_STATE);
+                    return false;
+                }
+
+                if (intervalMs == 0)
+                {
+                    aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+                    return false;
+                }
+
+                /* Every probe is allocated before any is scheduled, so that a failure leaves no probe running */
+                uint64_t intervalNs =
+                    aws_timestamp_convert(intervalMs, AWS_TIMESTAMP_MILLIS, AWS_TIMESTAMP_NANOS, NULL);
+                Vector<SchedulerLagProbe *> probes(StlAllocator<SchedulerLagProbe *>(m_allocator));
+                probes.reserve(m_loopStates.size());
+                for (size_t i = 0; i < m_loopStates.size(); ++i)
+                {
+                    struct aws_event_loop *eventLoop = aws_event_loop_group_get_loop_at(m_eventLoopGroup, i);
+                    auto *probe =
+                        New<SchedulerLagProbe>(m_allocator, m_allocator, eventLoop, m_loopStates[i], intervalNs);
+                    if (probe == nullptr)
+                    {
+                        for (SchedulerLagProbe *allocatedProbe : probes)
+                        {
+                            Delete(allocatedProbe, m_allocator);
+                        }
+                        return false;
+                    }
+                    probes.push_back(probe);
+                }
+
+                m_lagProbesEnabled = true;
+                for (SchedulerLagProbe *probe : probes)
+                {
+                    uint64_t now = 0;
+                    aws_event_loop_current_clock_time(probe->eventLoop, &now);
+                    probe->ScheduleNext(now);
+                }
+
+                return true;
+            }
+
             aws_event_loop_group *EventLoopGroup::GetUnderlyingHandle() noexcept
             {
                 if (*this)
@@ -74,6 +383,68 @@ namespace Aws
                 return nullptr;
             }
 
+            bool EventLoopGroup::InitLoopStates() noexcept
+            {
+                size_t loopCount = aws_event_loop_group_get_loop_count(m_eventLoopGroup);
+                m_loopStates.reserve(loopCount);
+                m_loopAllocators.reserve(loopCount);
+                for (size_t i = 0; i < loopCount; ++i)
+                {
+                    auto state = Aws::Crt::MakeShared<EventLoopState>(m_allocator, i, m_allocator);
+                    if (!state)
+                    {
+                        m_lastError = aws_last_error();
+                        aws_event_loop_group_release(m_eventLoopGroup);
+                        m_eventLoopGroup = nullptr;
+                        m_loopStates.clear();
+                        m_loopAllocators.clear();
+                        return false;
+                    }
+
+                    m_loopStates.push_back(std::move(state));
+                    m_loopAllocators.push_back(m_allocator);
+                }
+
+                return true;
+            }
+
+            bool EventLoopGroup::PinLoop(size_t index, const Vector<uint16_t> &cpuSet) noexcept
+            {
+                auto *pinning = New<LoopPinningTask>(m_allocator, m_allocator, cpuSet);
+                if (pinning == nullptr)
+                {
+                    return false;
+                }
+
+                std::future<int> result = pinning->result.get_future();
+                aws_task_init(&pinning->task, LoopPinningTask::s_onPin, pinning, "EventLoopPinning");
+                aws_event_loop_schedule_task_now(
+                    aws_event_loop_group_get_loop_at(m_eventLoopGroup, index), &pinning->task);
+
+                int errorCode = result.get();
+                if (errorCode != AWS_ERROR_SUCCESS)
+                {
+                    AWS_LOGF_ERROR(
+                        AWS_LS_IO_EVENT_LOOP,
+                        "id=%p: failed to pin event loop %zu to its cpu set with error %s",
+                        (void *)m_eventLoopGroup,
+                        index,
+                        aws_error_debug_str(errorCode));
+                    aws_raise_error(errorCode);
+                    return false;
+                }
+
+                return true;
+            }
+
+            void EventLoopGroup::StopSchedulerLagProbes() noexcept
+            {
+                for (auto &state : m_loopStates)
+                {
+                    state->probesStopped = true;
+                }
+            }
+
         } // namespace Io
 
     } // namespace Crt
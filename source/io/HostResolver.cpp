@@ -6,8 +6,15 @@
 
 #include <aws/crt/io/EventLoopGroup.h>
 
+#include <aws/common/clock.h>
+#include <aws/common/host_utils.h>
 #include <aws/common/string.h>
 #include <aws/crt/Api.h>
+#include <aws/io/logging.h>
+
+#include <algorithm>
+#include <cctype>
+#include <mutex>
 
 namespace Aws
 {
@@ -17,10 +24,196 @@ namespace Aws
         {
             HostResolver::~HostResolver() {}
 
+            /* Upper bound on the keep-warm interval, relative to the cache TTL */
+            static const uint64_t s_keepWarmTtlDivisor = 2;
+
+            /**
+             * @private
+             * Per-host bookkeeping of a DefaultHostResolver, shared with pending resolutions and the keep-warm task
+             * so that they can outlive the resolver object.
+             */
+            struct DefaultHostResolverState
+            {
+                struct HostEntry
+                {
+                    HostResolutionStatistics statistics;
+                    uint64_t lastRequestNs = 0;
+                };
+
+                DefaultHostResolverState(
+                    Allocator *allocator,
+                    struct aws_host_resolver *resolver,
+                    const aws_host_resolution_config &config,
+                    size_t maxHosts)
+                    : allocator(allocator), resolver(resolver), config(config), maxHosts(maxHosts), stopped(false),
+                      keepWarmWindowNs(0), keepWarmIntervalNs(0)
+                {
+                }
+
+                /* Counts a request for host and returns its entry. Must hold lock. */
+                HostEntry &OnRequest(const String &host, uint64_t now)
+                {
+                    auto found = hosts.find(host);
+                    if (found == hosts.end())
+                    {
+                        if (hosts.size() >= maxHosts && !hosts.empty())
+                        {
+                            auto leastRecent = hosts.begin();
+                            for (auto it = hosts.begin(); it != hosts.end(); ++it)
+                            {
+                                if (it->second.lastRequestNs < leastRecent->second.lastRequestNs)
+                                {
+                                    leastRecent = it;
+                                }
+                            }
+                            hosts.erase(leastRecent);
+                        }
+                        found = hosts.emplace(host, HostEntry()).first;
+                    }
+
+                    ++found->second.statistics.RequestCount;
+                    found->second.lastRequestNs = now;
+                    return found->second;
+                }
+
+                Allocator *allocator;
+
+                /* Not referenced by the state: only used while the DefaultHostResolver is alive, i.e. until stopped */
+                struct aws_host_resolver *resolver;
+                aws_host_resolution_config config;
+                size_t maxHosts;
+
+                mutable std::mutex lock;
+                Map<String, HostEntry> hosts;
+                bool stopped;
+
+                EventLoop keepWarmLoop;
+                uint64_t keepWarmWindowNs;
+                uint64_t keepWarmIntervalNs;
+            };
+
+            /**
+             * @private
+             */
+            struct DefaultHostResolveArgs
+            {
+                Allocator *allocator;
+                HostResolver *resolver;
+                OnHostResolved onResolved;
+                aws_string *host;
+                std::shared_ptr<DefaultHostResolverState> state;
+                uint64_t startNs;
+            };
+
+            /* Set while aws_host_resolver_resolve_host() runs, so a callback made from inside it, i.e. one answered
+             * from the cache, can be told apart from one that waited for a resolution */
+            static thread_local DefaultHostResolveArgs *s_resolvingArgs = nullptr;
+
+            static bool s_resolve(
+                struct aws_host_resolver *resolver,
+                const std::shared_ptr<DefaultHostResolverState> &state,
+                DefaultHostResolveArgs *args,
+                aws_on_host_resolved_result_fn *onResolved)
+            {
+                DefaultHostResolveArgs *previous = s_resolvingArgs;
+                s_resolvingArgs = args;
+                bool succeeded =
+                    aws_host_resolver_resolve_host(resolver, args->host, onResolved, &state->config, args) ==
+                    AWS_OP_SUCCESS;
+                s_resolvingArgs = previous;
+                return succeeded;
+            }
+
+            static void s_onKeepWarmResolved(
+                struct aws_host_resolver *,
+                const struct aws_string *,
+                int,
+                const struct aws_array_list *,
+                void *userData)
+            {
+                auto *args = static_cast<DefaultHostResolveArgs *>(userData);
+                aws_string_destroy(args->host);
+                Delete(args, args->allocator);
+            }
+
+            static void s_scheduleKeepWarm(const std::shared_ptr<DefaultHostResolverState> &state, uint64_t now);
+
+            /* Re-resolves the hosts requested within the keep-warm window. Resolving renews the native cache entry, so
+             * it keeps refreshing the host's addresses in the background instead of letting them lapse. */
+            static void s_keepWarm(const std::shared_ptr<DefaultHostResolverState> &state)
+            {
+                uint64_t now = 0;
+                aws_high_res_clock_get_ticks(&now);
+
+                /* Resolutions run without the lock, holding a reference so the resolver can't be released underneath */
+                Vector<String> warmHosts(StlAllocator<String>(state->allocator));
+                struct aws_host_resolver *resolver = nullptr;
+                {
+                    std::lock_guard<std::mutex> lock(state->lock);
+                    if (state->stopped)
+                    {
+                        return;
+                    }
+
+                    for (const auto &host : state->hosts)
+                    {
+                        if (now - host.second.lastRequestNs < state->keepWarmWindowNs)
+                        {
+                            warmHosts.push_back(host.first);
+                        }
+                    }
+                    resolver = aws_host_resolver_acquire(state->resolver);
+                }
+
+                for (const String &host : warmHosts)
+                {
+                    auto *args = New<DefaultHostResolveArgs>(state->allocator);
+                    if (args == nullptr)
+                    {
+                        break;
+                    }
+
+                    args->allocator = state->allocator;
+                    args->resolver = nullptr;
+                    args->host = aws_string_new_from_array(
+                        state->allocator, reinterpret_cast<const uint8_t *>(host.data()), host.length());
+                    args->startNs = now;
+
+                    if (!args->host || !s_resolve(resolver, state, args, s_onKeepWarmResolved))
+                    {
+                        aws_string_destroy(args->host);
+                        Delete(args, state->allocator);
+                        continue;
+                    }
+
+                    std::lock_guard<std::mutex> lock(state->lock);
+                    auto found = state->hosts.find(host);
+                    if (found != state->hosts.end())
+                    {
+                        ++found->second.statistics.KeepWarmCount;
+                    }
+                }
+
+                aws_host_resolver_release(resolver);
+                s_scheduleKeepWarm(state, state->keepWarmLoop.GetCurrentClockTimeNs());
+            }
+
+            static void s_scheduleKeepWarm(const std::shared_ptr<DefaultHostResolverState> &state, uint64_t now)
+            {
+                state->keepWarmLoop.ScheduleAt(
+                    [state](TaskStatus status)
+                    {
+                        if (status == TaskStatus::RunReady)
+                        {
+                            s_keepWarm(state);
+                        }
+                    },
+                    now + state->keepWarmIntervalNs);
+            }
+
             DefaultHostResolver::DefaultHostResolver(
                 EventLoopGroup &elGroup,
-                size_t maxHosts,
-                size_t maxTTL,
+                const DefaultHostResolverOptions &options,
                 Allocator *allocator) noexcept
                 : m_resolver(nullptr), m_allocator(allocator), m_initialized(false)
             {
@@ -28,18 +221,59 @@ namespace Aws
 
                 struct aws_host_resolver_default_options resolver_options;
                 AWS_ZERO_STRUCT(resolver_options);
-                resolver_options.max_entries = maxHosts;
+                resolver_options.max_entries = options.MaxHosts;
                 resolver_options.el_group = elGroup.GetUnderlyingHandle();
 
+                m_config.impl = aws_default_dns_resolve;
+                m_config.impl_data = nullptr;
+                m_config.max_ttl = options.MaxTTL;
+                m_config.resolve_frequency_ns =
+                    aws_timestamp_convert(options.ResolveFrequencyMs, AWS_TIMESTAMP_MILLIS, AWS_TIMESTAMP_NANOS, NULL);
+
                 m_resolver = aws_host_resolver_new_default(allocator, &resolver_options);
-                if (m_resolver != nullptr)
+                if (m_resolver == nullptr)
                 {
-                    m_initialized = true;
+                    return;
                 }
 
-                m_config.impl = aws_default_dns_resolve;
-                m_config.impl_data = nullptr;
-                m_config.max_ttl = maxTTL;
+                m_state = Aws::Crt::MakeShared<DefaultHostResolverState>(
+                    allocator, allocator, m_resolver, m_config, (std::max)(options.MaxHosts, static_cast<size_t>(1)));
+                if (!m_state)
+                {
+                    return;
+                }
+
+                if (options.KeepWarmWindowMs > 0)
+                {
+                    m_state->keepWarmLoop = elGroup.GetNextLoop();
+                    m_state->keepWarmWindowNs = aws_timestamp_convert(
+                        options.KeepWarmWindowMs, AWS_TIMESTAMP_MILLIS, AWS_TIMESTAMP_NANOS, NULL);
+                    m_state->keepWarmIntervalNs = (std::max)(
+                        aws_timestamp_convert(options.MaxTTL, AWS_TIMESTAMP_SECS, AWS_TIMESTAMP_NANOS, NULL) /
+                            s_keepWarmTtlDivisor,
+                        static_cast<uint64_t>(AWS_TIMESTAMP_NANOS));
+                    s_scheduleKeepWarm(m_state, m_state->keepWarmLoop.GetCurrentClockTimeNs());
+                }
+
+                m_initialized = true;
+            }
+
+            DefaultHostResolver::DefaultHostResolver(
+                EventLoopGroup &elGroup,
+                size_t maxHosts,
+                size_t maxTTL,
+                Allocator *allocator) noexcept
+                : DefaultHostResolver(
+                      elGroup,
+                      [maxHosts, maxTTL]()
+                      {
+                          DefaultHostResolverOptions options;
+                          options.MaxHosts = maxHosts;
+                          options.MaxTTL = maxTTL;
+                          return options;
+                      }(),
+                      allocator)
+            {
             }
 
             DefaultHostResolver::DefaultHostResolver(size_t maxHosts, size_t maxTTL, Allocator *allocator) noexcept
@@ -53,21 +287,15 @@ namespace Aws
 
             DefaultHostResolver::~DefaultHostResolver()
             {
+                if (m_state)
+                {
+                    std::lock_guard<std::mutex> lock(m_state->lock);
+                    m_state->stopped = true;
+                }
                 aws_host_resolver_release(m_resolver);
                 m_initialized = false;
             }
 
-            /**
-             * @private
-             */
-            struct DefaultHostResolveArgs
-            {
-                Allocator *allocator;
-                HostResolver *resolver;
-                OnHostResolved onResolved;
-                aws_string *host;
-            };
-
             void DefaultHostResolver::s_onHostResolved(
                 struct aws_host_resolver *,
                 const struct aws_string *hostName,
@@ -77,6 +305,26 @@ namespace Aws
             {
                 DefaultHostResolveArgs *args = static_cast<DefaultHostResolveArgs *>(userData);
 
+                uint64_t now = 0;
+                aws_high_res_clock_get_ticks(&now);
+                bool cacheHit = s_resolvingArgs == args;
+
+                String host(aws_string_c_str(hostName), hostName->len);
+                {
+                    std::lock_guard<std::mutex> lock(args->state->lock);
+                    auto found = args->state->hosts.find(host);
+                    if (found != args->state->hosts.end())
+                    {
+                        HostResolutionStatistics &statistics = found->second.statistics;
+                        ++(cacheHit ? statistics.CacheHitCount : statistics.CacheMissCount);
+                        if (errCode != AWS_ERROR_SUCCESS)
+                        {
+                            ++statistics.FailureCount;
+                        }
+                        statistics.ResolveLatency.Record(now > args->startNs ? now - args->startNs : 0);
+                    }
+                }
+
                 size_t len = hostAddresses ? aws_array_list_length(hostAddresses) : 0;
                 Vector<HostAddress> addresses;
                 addresses.reserve(len);
@@ -88,14 +336,20 @@ namespace Aws
                     addresses.push_back(*address_ptr);
                 }
 
-                String host(aws_string_c_str(hostName), hostName->len);
                 args->onResolved(*args->resolver, addresses, errCode);
+
                 aws_string_destroy(args->host);
                 Delete(args, args->allocator);
             }
 
             bool DefaultHostResolver::ResolveHost(const String &host, const OnHostResolved &onResolved) noexcept
             {
+                if (!m_state)
+                {
+                    aws_raise_error(AWS_ERROR_INVALID_STATE);
+                    return false;
+                }
+
                 DefaultHostResolveArgs *args = New<DefaultHostResolveArgs>(m_allocator);
                 if (!args)
                 {
@@ -107,16 +361,377 @@ namespace Aws
                 args->onResolved = onResolved;
                 args->resolver = this;
                 args->allocator = m_allocator;
+                args->state = m_state;
+                aws_high_res_clock_get_ticks(&args->startNs);
 
-                if (!args->host ||
-                    aws_host_resolver_resolve_host(m_resolver, args->host, s_onHostResolved, &m_config, args))
+                if (!args->host)
                 {
                     Delete(args, m_allocator);
                     return false;
                 }
 
+                {
+                    std::lock_guard<std::mutex> lock(m_state->lock);
+                    m_state->OnRequest(host, args->startNs);
+                }
+
+                if (!s_resolve(m_resolver, m_state, args, s_onHostResolved))
+                {
+                    aws_string_destroy(args->host);
+                    Delete(args, m_allocator);
+                    return false;
+                }
+
                 return true;
             }
+
+            Map<String, HostResolutionStatistics> DefaultHostResolver::GetHostStatistics() const
+            {
+                Map<String, HostResolutionStatistics> statistics;
+                if (m_state)
+                {
+                    std::lock_guard<std::mutex> lock(m_state->lock);
+                    for (const auto &host : m_state->hosts)
+                    {
+                        statistics.emplace(host.first, host.second.statistics);
+                    }
+                }
+
+                return statistics;
+            }
+
+            /**
+             * @private
+             * Native resolver forwarding to a CustomHostResolver.  Owned by the native resolver's ref count, since
+             * bootstraps and connections may keep the native resolver alive after the C++ object is gone.
+             */
+            struct CustomHostResolverBridge
+            {
+                aws_host_resolver resolver;
+                Allocator *allocator;
+
+                /* Recursive, as a resolution completing synchronously may start another one */
+                std::recursive_mutex lock;
+                CustomHostResolver *target;
+            };
+
+            static void s_destroyBridge(struct aws_host_resolver *resolver)
+            {
+                auto *bridge = static_cast<CustomHostResolverBridge *>(resolver->impl);
+                Delete(bridge, bridge->allocator);
+            }
+
+            static void s_onBridgeRefCountZero(void *userData)
+            {
+                s_destroyBridge(static_cast<struct aws_host_resolver *>(userData));
+            }
+
+            static int s_bridgeResolveHost(
+                struct aws_host_resolver *resolver,
+                const struct aws_string *hostName,
+                aws_on_host_resolved_result_fn *res,
+                const struct aws_host_resolution_config *,
+                void *userData)
+            {
+                auto *bridge = static_cast<CustomHostResolverBridge *>(resolver->impl);
+                std::lock_guard<std::recursive_mutex> lock(bridge->lock);
+                if (bridge->target == nullptr)
+                {
+                    return aws_raise_error(AWS_ERROR_INVALID_STATE);
+                }
+
+                String host(aws_string_c_str(hostName), hostName->len);
+                Allocator *allocator = bridge->allocator;
+                auto onResolved = [resolver, allocator, host, res, userData](
+                                      HostResolver &, const Vector<HostAddress> &addresses, int errorCode)
+                {
+                    /* Native callers read addresses through an aws_array_list; view the vector as one */
+                    struct aws_array_list addressList;
+                    AWS_ZERO_STRUCT(addressList);
+                    if (errorCode == AWS_ERROR_SUCCESS && addresses.empty())
+                    {
+                        errorCode = AWS_IO_DNS_NO_ADDRESS_FOR_HOST;
+                    }
+                    else if (errorCode == AWS_ERROR_SUCCESS)
+                    {
+                        aws_array_list_init_static_from_initialized(
+                            &addressList,
+                            const_cast<HostAddress *>(addresses.data()),
+                            addresses.size(),
+                            sizeof(HostAddress));
+                    }
+
+                    struct aws_string *hostString = aws_string_new_from_array(
+                        allocator, reinterpret_cast<const uint8_t *>(host.data()), host.length());
+                    res(resolver,
+                        hostString,
+                        errorCode,
+                        errorCode == AWS_ERROR_SUCCESS ? &addressList : nullptr,
+                        userData);
+                    aws_string_destroy(hostString);
+                };
+
+                return bridge->target->ResolveHost(host, onResolved) ? AWS_OP_SUCCESS : AWS_OP_ERR;
+            }
+
+            static int s_bridgeRecordConnectionFailure(struct aws_host_resolver *, const struct aws_host_address *)
+            {
+                return AWS_OP_SUCCESS;
+            }
+
+            static int s_bridgePurgeCache(struct aws_host_resolver *)
+            {
+                return AWS_OP_SUCCESS;
+            }
+
+            static size_t s_bridgeGetHostAddressCount(
+                struct aws_host_resolver *resolver,
+                const struct aws_string *hostName,
+                uint32_t flags)
+            {
+                auto *bridge = static_cast<CustomHostResolverBridge *>(resolver->impl);
+                std::lock_guard<std::recursive_mutex> lock(bridge->lock);
+                if (bridge->target == nullptr)
+                {
+                    return 0;
+                }
+
+                return bridge->target->GetHostAddressCount(String(aws_string_c_str(hostName), hostName->len), flags);
+            }
+
+            static struct aws_host_resolver_vtable s_makeBridgeVtable()
+            {
+                struct aws_host_resolver_vtable vtable;
+                AWS_ZERO_STRUCT(vtable);
+                vtable.destroy = s_destroyBridge;
+                vtable.resolve_host = s_bridgeResolveHost;
+                vtable.record_connection_failure = s_bridgeRecordConnectionFailure;
+                vtable.purge_cache = s_bridgePurgeCache;
+                vtable.get_host_address_count = s_bridgeGetHostAddressCount;
+                return vtable;
+            }
+
+            static struct aws_host_resolver_vtable s_bridgeVtable = s_makeBridgeVtable();
+
+            CustomHostResolver::CustomHostResolver(Allocator *allocator) noexcept
+                : m_allocator(allocator), m_resolver(nullptr), m_bridge(nullptr)
+            {
+                AWS_ZERO_STRUCT(m_config);
+
+                m_bridge = New<CustomHostResolverBridge>(allocator);
+                if (m_bridge == nullptr)
+                {
+                    return;
+                }
+
+                AWS_ZERO_STRUCT(m_bridge->resolver);
+                m_bridge->resolver.allocator = allocator;
+                m_bridge->resolver.impl = m_bridge;
+                m_bridge->resolver.vtable = &s_bridgeVtable;
+                aws_ref_count_init(&m_bridge->resolver.ref_count, &m_bridge->resolver, s_onBridgeRefCountZero);
+                m_bridge->allocator = allocator;
+                m_bridge->target = this;
+
+                m_resolver = &m_bridge->resolver;
+            }
+
+            CustomHostResolver::~CustomHostResolver()
+            {
+                if (m_bridge != nullptr)
+                {
+                    Detach();
+                    aws_host_resolver_release(m_resolver);
+                }
+            }
+
+            void CustomHostResolver::Detach() noexcept
+            {
+                if (m_bridge != nullptr)
+                {
+                    /* The bridge holds its lock across calls into the target, so this waits them out */
+                    std::lock_guard<std::recursive_mutex> lock(m_bridge->lock);
+                    m_bridge->target = nullptr;
+                }
+            }
+
+            size_t CustomHostResolver::GetHostAddressCount(const String &, uint32_t) noexcept
+            {
+                return 0;
+            }
+
+            StaticHostResolver::StaticHostResolver(Allocator *allocator) noexcept : CustomHostResolver(allocator) {}
+
+            StaticHostResolver::~StaticHostResolver()
+            {
+                Detach();
+
+                for (auto &host : m_addresses)
+                {
+                    for (auto &address : host.second)
+                    {
+                        aws_host_address_clean_up(&address);
+                    }
+                }
+            }
+
+            static String s_toLower(String value)
+            {
+                std::transform(
+                    value.begin(),
+                    value.end(),
+                    value.begin(),
+                    [](char c) { return static_cast<char>(std::tolower(static_cast<unsigned char>(c))); });
+                return value;
+            }
+
+            bool StaticHostResolver::AddAddress(const String &host, const String &address) noexcept
+            {
+                ByteCursor addressCursor = ByteCursorFromArray(
+                    reinterpret_cast<const uint8_t *>(address.data()), address.length());
+
+                HostAddress hostAddress;
+                AWS_ZERO_STRUCT(hostAddress);
+                if (aws_host_utils_is_ipv4(addressCursor))
+                {
+                    hostAddress.record_type = AWS_ADDRESS_RECORD_TYPE_A;
+                }
+                else if (aws_host_utils_is_ipv6(addressCursor, false))
+                {
+                    hostAddress.record_type = AWS_ADDRESS_RECORD_TYPE_AAAA;
+                }
+                else
+                {
+                    aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+                    return false;
+                }
+
+                String key = s_toLower(host);
+                hostAddress.allocator = m_allocator;
+                hostAddress.host = aws_string_new_from_array(
+                    m_allocator, reinterpret_cast<const uint8_t *>(key.data()), key.length());
+                hostAddress.address = aws_string_new_from_cursor(m_allocator, &addressCursor);
+                hostAddress.expiry = UINT64_MAX;
+                if (hostAddress.host == nullptr || hostAddress.address == nullptr)
+                {
+                    aws_host_address_clean_up(&hostAddress);
+                    return false;
+                }
+
+                std::lock_guard<std::mutex> lock(m_lock);
+                m_addresses[key].push_back(hostAddress);
+                return true;
+            }
+
+            bool StaticHostResolver::LoadHostsFile(const char *path) noexcept
+            {
+                ByteBuf contents;
+                if (!ByteBufInitFromFile(contents, m_allocator, path))
+                {
+                    AWS_LOGF_ERROR(
+                        AWS_LS_IO_DNS, "id=%p: failed to read hosts file %s", static_cast<void *>(this), path);
+                    return false;
+                }
+
+                const char *data = reinterpret_cast<const char *>(contents.buffer);
+                String line;
+                for (size_t i = 0; i <= contents.len; ++i)
+                {
+                    if (i < contents.len && data[i] != '\n')
+                    {
+                        line.push_back(data[i]);
+                        continue;
+                    }
+
+                    /* address followed by names, separated by whitespace, up to an optional comment */
+                    Vector<String> fields;
+                    String field;
+                    for (char c : line)
+                    {
+                        if (c == '#')
+                        {
+                            break;
+                        }
+                        if (std::isspace(static_cast<unsigned char>(c)))
+                        {
+                            if (!field.empty())
+                            {
+                                fields.push_back(field);
+                                field.clear();
+                            }
+                            continue;
+                        }
+                        field.push_back(c);
+                    }
+                    if (!field.empty())
+                    {
+                        fields.push_back(field);
+                    }
+                    line.clear();
+
+                    for (size_t name = 1; name < fields.size(); ++name)
+                    {
+                        if (!AddAddress(fields[name], fields[0]))
+                        {
+                            AWS_LOGF_DEBUG(
+                                AWS_LS_IO_DNS,
+                                "id=%p: skipping hosts file entry with invalid address %s",
+                                static_cast<void *>(this),
+                                fields[0].c_str());
+                            break;
+                        }
+                    }
+                }
+
+                aws_byte_buf_clean_up(&contents);
+                return true;
+            }
+
+            bool StaticHostResolver::ResolveHost(const String &host, const OnHostResolved &onResolved) noexcept
+            {
+                Vector<HostAddress> addresses;
+                {
+                    std::lock_guard<std::mutex> lock(m_lock);
+                    auto found = m_addresses.find(s_toLower(host));
+                    if (found != m_addresses.end())
+                    {
+                        /* Entries are never removed before destruction, so shallow copies stay valid */
+                        addresses = found->second;
+                    }
+                }
+
+                int errorCode = AWS_ERROR_SUCCESS;
+                if (addresses.empty())
+                {
+                    errorCode = AWS_IO_DNS_NO_ADDRESS_FOR_HOST;
+                }
+
+                onResolved(*this, addresses, errorCode);
+                return true;
+            }
+
+            size_t StaticHostResolver::GetHostAddressCount(const String &host, uint32_t flags) noexcept
+            {
+                std::lock_guard<std::mutex> lock(m_lock);
+                auto found = m_addresses.find(s_toLower(host));
+                if (found == m_addresses.end())
+                {
+                    return 0;
+                }
+
+                size_t count = 0;
+                for (const HostAddress &address : found->second)
+                {
+                    if ((address.record_type == AWS_ADDRESS_RECORD_TYPE_A &&
+                         (flags & AWS_GET_HOST_ADDRESS_COUNT_RECORD_TYPE_A)) ||
+                        (address.record_type == AWS_ADDRESS_RECORD_TYPE_AAAA &&
+                         (flags & AWS_GET_HOST_ADDRESS_COUNT_RECORD_TYPE_AAAA)))
+                    {
+                        ++count;
+                    }
+                }
+
+                return count;
+            }
         } // namespace Io
     } // namespace Crt
 } // namespace Aws
@@ -7,8 +7,28 @@
 #include <aws/crt/io/Stream.h>
 #include <iostream>
 
+#include <aws/common/file.h>
 #include <aws/io/stream.h>
 
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+#if !defined(_WIN32)
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+#if defined(__linux__)
+#    include <sys/vfs.h>
+#elif defined(__APPLE__)
+#    include <sys/mount.h>
+#    include <sys/param.h>
+#endif
+
 namespace Aws
 {
     namespace Crt
@@ -119,6 +139,39 @@ namespace Aws
                 m_underlying_stream.vtable = &s_vtable;
             }
 
+            bool InputStream::ReadCursor(ByteCursor &cursor, size_t maxLength)
+            {
+                AWS_ZERO_STRUCT(cursor);
+
+                // Same as s_Read: make sure a failure always comes with an error.
+                aws_reset_error();
+
+                if (ReadCursorImpl(cursor, maxLength))
+                {
+                    return true;
+                }
+
+                if (aws_last_error() == 0)
+                {
+                    aws_raise_error(AWS_IO_STREAM_READ_FAILED);
+                }
+
+                return false;
+            }
+
+            void InputStream::ReleaseCursor(const ByteCursor &cursor) noexcept
+            {
+                ReleaseCursorImpl(cursor);
+            }
+
+            bool InputStream::ReadCursorImpl(ByteCursor &, size_t) noexcept
+            {
+                aws_raise_error(AWS_ERROR_UNSUPPORTED_OPERATION);
+                return false;
+            }
+
+            void InputStream::ReleaseCursorImpl(const ByteCursor &) noexcept {}
+
             StdIOStreamInputStream::StdIOStreamInputStream(
                 std::shared_ptr<Aws::Crt::Io::IStream> stream,
                 Aws::Crt::Allocator *allocator) noexcept
@@ -232,6 +285,369 @@ namespace Aws
             {
                 return m_stream->peek();
             }
+
+#if !defined(_WIN32)
+            static void s_raiseFileError(int errorNumber)
+            {
+                switch (errorNumber)
+                {
+                    case ENOENT:
+                    case ENOTDIR:
+                        aws_raise_error(AWS_ERROR_FILE_INVALID_PATH);
+                        break;
+                    case EACCES:
+                    case EPERM:
+                        aws_raise_error(AWS_ERROR_NO_PERMISSION);
+                        break;
+                    case EMFILE:
+                    case ENFILE:
+                        aws_raise_error(AWS_ERROR_MAX_FDS_EXCEEDED);
+                        break;
+                    case ENOMEM:
+                        aws_raise_error(AWS_ERROR_OOM);
+                        break;
+                    default:
+                        aws_raise_error(AWS_ERROR_SYS_CALL_FAILURE);
+                        break;
+                }
+            }
+
+            /* True if the file lives on a network or userspace (FUSE) filesystem, where faulting in mapped pages can
+             * block for as long as a remote round trip and a file changed by another client can raise SIGBUS */
+            static bool s_isOnRemoteFilesystem(int fd)
+            {
+#    if defined(__linux__)
+                struct statfs fsStat;
+                if (fstatfs(fd, &fsStat) != 0)
+                {
+                    return false;
+                }
+
+                switch (static_cast<uint32_t>(fsStat.f_type))
+                {
+                    case 0x6969:     /* NFS_SUPER_MAGIC */
+                    case 0x517B:     /* SMB_SUPER_MAGIC */
+                    case 0xFF534D42: /* CIFS_SUPER_MAGIC */
+                    case 0xFE534D42: /* SMB2_SUPER_MAGIC */
+                    case 0x65735546: /* FUSE_SUPER_MAGIC */
+                    case 0x01021997: /* V9FS_MAGIC */
+                    case 0x00C36400: /* CEPH_SUPER_MAGIC */
+                    case 0x5346414F: /* AFS_SUPER_MAGIC */
+                    case 0x6B414653: /* AFS_FS_MAGIC */
+                    case 0x73757245: /* CODA_SUPER_MAGIC */
+                    case 0x01161970: /* GFS2_MAGIC */
+                    case 0x7461636F: /* OCFS2_SUPER_MAGIC */
+                    case 0x0BD00BD0: /* LUSTRE_SUPER_MAGIC */
+                        return true;
+                    default:
+                        return false;
+                }
+#    elif defined(__APPLE__)
+                struct statfs fsStat;
+                return fstatfs(fd, &fsStat) == 0 && (fsStat.f_flags & MNT_LOCAL) == 0;
+#    else
+                (void)fd;
+                return false;
+#    endif
+            }
+#endif
+
+            struct MmapFileInputStream::Impl
+            {
+                Impl() noexcept = default;
+                Impl(const Impl &) = delete;
+                Impl &operator=(const Impl &) = delete;
+
+                ~Impl()
+                {
+#if !defined(_WIN32)
+                    if (mapping != nullptr)
+                    {
+                        munmap(const_cast<uint8_t *>(mapping), static_cast<size_t>(length));
+                    }
+                    if (fd >= 0)
+                    {
+                        close(fd);
+                    }
+#else
+                    if (file != nullptr)
+                    {
+                        fclose(file);
+                    }
+#endif
+                }
+
+                bool Open(const char *path, FileReadMode mode) noexcept
+                {
+#if !defined(_WIN32)
+                    fd = open(path, O_RDONLY | O_CLOEXEC);
+                    if (fd < 0)
+                    {
+                        s_raiseFileError(errno);
+                        return false;
+                    }
+
+                    struct stat fileStat;
+                    if (fstat(fd, &fileStat) != 0)
+                    {
+                        s_raiseFileError(errno);
+                        return false;
+                    }
+
+                    /* Pipes and devices can't be mapped, read positionally or measured up front */
+                    if (!S_ISREG(fileStat.st_mode))
+                    {
+                        aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+                        return false;
+                    }
+                    length = static_cast<uint64_t>(fileStat.st_size);
+
+                    if (mode == FileReadMode::Auto && s_isOnRemoteFilesystem(fd))
+                    {
+                        mode = FileReadMode::PositionalRead;
+                    }
+
+                    if (mode != FileReadMode::PositionalRead && length > 0 && length <= SIZE_MAX)
+                    {
+                        void *mapped = mmap(nullptr, static_cast<size_t>(length), PROT_READ, MAP_PRIVATE, fd, 0);
+                        if (mapped != MAP_FAILED)
+                        {
+                            mapping = static_cast<const uint8_t *>(mapped);
+                            posix_madvise(mapped, static_cast<size_t>(length), POSIX_MADV_SEQUENTIAL);
+
+                            /* The mapping keeps the file referenced */
+                            close(fd);
+                            fd = -1;
+                            return true;
+                        }
+
+                        if (mode == FileReadMode::Mmap)
+                        {
+                            s_raiseFileError(errno);
+                            return false;
+                        }
+                    }
+                    else if (mode == FileReadMode::Mmap)
+                    {
+                        aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+                        return false;
+                    }
+
+#    if defined(POSIX_FADV_SEQUENTIAL)
+                    posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#    endif
+                    return true;
+#else
+                    if (mode == FileReadMode::Mmap)
+                    {
+                        aws_raise_error(AWS_ERROR_PLATFORM_NOT_SUPPORTED);
+                        return false;
+                    }
+
+                    file = aws_fopen(path, "rb");
+                    if (file == nullptr)
+                    {
+                        return false;
+                    }
+
+                    int64_t fileLength = 0;
+                    if (aws_file_get_length(file, &fileLength) != AWS_OP_SUCCESS)
+                    {
+                        return false;
+                    }
+                    length = static_cast<uint64_t>(fileLength);
+                    return true;
+#endif
+                }
+
+                /* Reads up to count bytes at offset without moving the read position.  Returns the number of bytes
+                 * read, which is less than count only at the end of the file, or -1 on failure. */
+                int64_t ReadAt(uint8_t *dest, size_t count, uint64_t offset) noexcept
+                {
+                    size_t total = 0;
+#if !defined(_WIN32)
+                    while (total < count)
+                    {
+                        ssize_t bytesRead = pread(fd, dest + total, count - total, static_cast<off_t>(offset + total));
+                        if (bytesRead < 0)
+                        {
+                            if (errno == EINTR)
+                            {
+                                continue;
+                            }
+                            s_raiseFileError(errno);
+                            return -1;
+                        }
+                        if (bytesRead == 0)
+                        {
+                            break;
+                        }
+                        total += static_cast<size_t>(bytesRead);
+                    }
+#else
+                    if (aws_fseek(file, static_cast<int64_t>(offset), SEEK_SET) != AWS_OP_SUCCESS)
+                    {
+                        return -1;
+                    }
+                    total = fread(dest, 1, count, file);
+                    if (total < count && ferror(file))
+                    {
+                        aws_raise_error(AWS_IO_STREAM_READ_FAILED);
+                        return -1;
+                    }
+#endif
+                    return static_cast<int64_t>(total);
+                }
+
+                const uint8_t *mapping = nullptr;
+                uint64_t length = 0;
+                uint64_t position = 0;
+#if !defined(_WIN32)
+                int fd = -1;
+#else
+                FILE *file = nullptr;
+#endif
+            };
+
+            MmapFileInputStream::MmapFileInputStream(const char *path, FileReadMode mode, Allocator *allocator) noexcept
+                : InputStream(allocator),
+                  m_impl(New<Impl>(allocator), [allocator](Impl *impl) { Delete(impl, allocator); })
+            {
+                if (m_impl && !m_impl->Open(path, mode))
+                {
+                    m_impl = nullptr;
+                }
+            }
+
+            MmapFileInputStream::~MmapFileInputStream() = default;
+
+            bool MmapFileInputStream::IsValid() const noexcept
+            {
+                return m_impl != nullptr;
+            }
+
+            bool MmapFileInputStream::IsMapped() const noexcept
+            {
+                return m_impl && m_impl->mapping != nullptr;
+            }
+
+            bool MmapFileInputStream::ReadImpl(ByteBuf &buffer) noexcept
+            {
+                if (!m_impl)
+                {
+                    aws_raise_error(AWS_ERROR_INVALID_STATE);
+                    return false;
+                }
+
+                uint64_t remaining = m_impl->length - m_impl->position;
+                size_t count =
+                    static_cast<size_t>((std::min)(static_cast<uint64_t>(buffer.capacity - buffer.len), remaining));
+                if (m_impl->mapping != nullptr)
+                {
+                    memcpy(buffer.buffer + buffer.len, m_impl->mapping + m_impl->position, count);
+                    buffer.len += count;
+                    m_impl->position += count;
+                    return true;
+                }
+
+                int64_t bytesRead = m_impl->ReadAt(buffer.buffer + buffer.len, count, m_impl->position);
+                if (bytesRead < 0)
+                {
+                    return false;
+                }
+
+                buffer.len += static_cast<size_t>(bytesRead);
+                m_impl->position += static_cast<uint64_t>(bytesRead);
+                if (static_cast<size_t>(bytesRead) < count)
+                {
+                    /* The file was truncated since it was opened */
+                    m_impl->length = m_impl->position;
+                }
+
+                return true;
+            }
+
+            bool MmapFileInputStream::ReadSomeImpl(ByteBuf &buffer) noexcept
+            {
+                return ReadImpl(buffer);
+            }
+
+            StreamStatus MmapFileInputStream::GetStatusImpl() const noexcept
+            {
+                StreamStatus status;
+                status.is_valid = m_impl != nullptr;
+                status.is_end_of_stream = !m_impl || m_impl->position >= m_impl->length;
+                return status;
+            }
+
+            int64_t MmapFileInputStream::GetLengthImpl() const noexcept
+            {
+                return m_impl ? static_cast<int64_t>(m_impl->length) : -1;
+            }
+
+            bool MmapFileInputStream::SeekImpl(int64_t offset, StreamSeekBasis seekBasis) noexcept
+            {
+                if (!m_impl)
+                {
+                    aws_raise_error(AWS_ERROR_INVALID_STATE);
+                    return false;
+                }
+
+                int64_t length = static_cast<int64_t>(m_impl->length);
+                int64_t position = 0;
+                switch (seekBasis)
+                {
+                    case StreamSeekBasis::Begin:
+                        position = offset;
+                        break;
+                    case StreamSeekBasis::End:
+                        position = length + offset;
+                        break;
+                    default:
+                        aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+                        return false;
+                }
+
+                if (position < 0 || position > length)
+                {
+                    aws_raise_error(AWS_IO_STREAM_INVALID_SEEK_POSITION);
+                    return false;
+                }
+
+                m_impl->position = static_cast<uint64_t>(position);
+                return true;
+            }
+
+            int64_t MmapFileInputStream::PeekImpl() const noexcept
+            {
+                if (!m_impl || m_impl->position >= m_impl->length)
+                {
+                    return EOF;
+                }
+
+                if (m_impl->mapping != nullptr)
+                {
+                    return m_impl->mapping[m_impl->position];
+                }
+
+                uint8_t next = 0;
+                return m_impl->ReadAt(&next, 1, m_impl->position) == 1 ? next : EOF;
+            }
+
+            bool MmapFileInputStream::ReadCursorImpl(ByteCursor &cursor, size_t maxLength) noexcept
+            {
+                if (!m_impl || m_impl->mapping == nullptr)
+                {
+                    /* Positional reads have no memory of their own to lend */
+                    return InputStream::ReadCursorImpl(cursor, maxLength);
+                }
+
+                uint64_t remaining = m_impl->length - m_impl->position;
+                size_t count = static_cast<size_t>((std::min)(static_cast<uint64_t>(maxLength), remaining));
+                cursor = ByteCursorFromArray(m_impl->mapping + m_impl->position, count);
+                m_impl->position += count;
+                return true;
+            }
         } // namespace Io
     } // namespace Crt
 } // namespace Aws
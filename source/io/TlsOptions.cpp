@@ -8,9 +8,13 @@
 #include <aws/crt/io/private/TlsMetrics.h>
 
 #include <aws/crt/Api.h>
+#include <aws/io/channel.h>
 #include <aws/io/logging.h>
+#include <aws/io/statistics.h>
 #include <aws/io/tls_channel_handler.h>
 
+#include <mutex>
+
 namespace Aws
 {
     namespace Crt
@@ -328,6 +332,9 @@ namespace Aws
                     aws_tls_connection_options_clean_up(&m_tls_connection_options);
                     m_isInit = false;
                 }
+
+                /* Released only once the native options that report to it are gone */
+                m_handshakeMetrics = nullptr;
             }
 
             TlsConnectionOptions::TlsConnectionOptions(const TlsConnectionOptions &options) noexcept
@@ -347,6 +354,7 @@ namespace Aws
                     if (!aws_tls_connection_options_copy(&m_tls_connection_options, &options.m_tls_connection_options))
                     {
                         m_isInit = true;
+                        m_handshakeMetrics = options.m_handshakeMetrics;
                     }
                     else
                     {
@@ -365,6 +373,7 @@ namespace Aws
                     }
 
                     m_isInit = false;
+                    m_handshakeMetrics = nullptr;
                     m_metricsCertificateSource = CertificateSource::None;
                     m_metricsTlsVersion = AWS_IO_TLS_VER_SYS_DEFAULTS;
                     m_metricsCipherPref = AWS_IO_TLS_CIPHER_PREF_SYSTEM_DEFAULT;
@@ -380,6 +389,7 @@ namespace Aws
                                 &m_tls_connection_options, &options.m_tls_connection_options))
                         {
                             m_isInit = true;
+                            m_handshakeMetrics = options.m_handshakeMetrics;
                         }
                         else
                         {
@@ -401,6 +411,7 @@ namespace Aws
                 {
                     m_tls_connection_options = options.m_tls_connection_options;
                     m_allocator = options.m_allocator;
+                    m_handshakeMetrics = std::move(options.m_handshakeMetrics);
                     AWS_ZERO_STRUCT(options.m_tls_connection_options);
                     options.m_isInit = false;
                     options.m_metricsCertificateSource = CertificateSource::None;
@@ -419,6 +430,7 @@ namespace Aws
                     }
 
                     m_isInit = false;
+                    m_handshakeMetrics = nullptr;
                     m_metricsCertificateSource = CertificateSource::None;
                     m_metricsTlsVersion = AWS_IO_TLS_VER_SYS_DEFAULTS;
                     m_metricsCipherPref = AWS_IO_TLS_CIPHER_PREF_SYSTEM_DEFAULT;
@@ -426,6 +438,7 @@ namespace Aws
                     if (options.m_isInit)
                     {
                         m_tls_connection_options = options.m_tls_connection_options;
+                        m_handshakeMetrics = std::move(options.m_handshakeMetrics);
                         AWS_ZERO_STRUCT(options.m_tls_connection_options);
                         m_isInit = true;
                         m_allocator = options.m_allocator;
@@ -476,6 +489,107 @@ namespace Aws
                 return true;
             }
 
+            /**
+             * @private
+             * Handshake statistics and observer shared by a TlsContext and its copies, and passed as user_data to the
+             * negotiation callback of the connections created from them.  Every TlsConnectionOptions that installs
+             * the callback holds a reference, so handshakes can still be reported after every copy of the context is
+             * gone.
+             */
+            struct TlsHandshakeMetricsState
+            {
+                bool IsObserved() noexcept
+                {
+                    std::lock_guard<std::mutex> guard(lock);
+                    return statisticsEnabled || onHandshakeCompleted;
+                }
+
+                std::mutex lock;
+                bool statisticsEnabled = false;
+                TlsHandshakeStatistics statistics;
+                OnTlsHandshakeCompleted onHandshakeCompleted;
+            };
+
+            /* Handshake duration from the statistics the TLS handler gathers, or 0 if it doesn't report them */
+            static uint64_t s_handshakeDurationNs(struct aws_channel_handler *handler)
+            {
+                if (handler->vtable->gather_statistics == nullptr)
+                {
+                    return 0;
+                }
+
+                void *storage[4];
+                struct aws_array_list statistics;
+                aws_array_list_init_static(&statistics, storage, AWS_ARRAY_SIZE(storage), sizeof(void *));
+                handler->vtable->gather_statistics(handler, &statistics);
+
+                for (size_t i = 0; i < aws_array_list_length(&statistics); ++i)
+                {
+                    struct aws_crt_statistics_base *base = nullptr;
+                    aws_array_list_get_at(&statistics, &base, i);
+                    if (base->category != AWSCRT_STAT_CAT_TLS)
+                    {
+                        continue;
+                    }
+
+                    auto *tlsStatistics = reinterpret_cast<struct aws_crt_statistics_tls *>(base);
+                    if (tlsStatistics->handshake_start_ns != 0 &&
+                        tlsStatistics->handshake_end_ns >= tlsStatistics->handshake_start_ns)
+                    {
+                        return tlsStatistics->handshake_end_ns - tlsStatistics->handshake_start_ns;
+                    }
+                }
+
+                return 0;
+            }
+
+            static void s_onTlsNegotiationResult(
+                struct aws_channel_handler *handler,
+                struct aws_channel_slot *,
+                int errorCode,
+                void *userData)
+            {
+                auto *state = static_cast<TlsHandshakeMetricsState *>(userData);
+
+                TlsHandshakeMetrics metrics;
+                metrics.ErrorCode = errorCode;
+                metrics.HandshakeDurationNs = s_handshakeDurationNs(handler);
+                if (errorCode == AWS_ERROR_SUCCESS)
+                {
+                    struct aws_byte_buf protocol = aws_tls_handler_protocol(handler);
+                    metrics.NegotiatedProtocol.assign(reinterpret_cast<const char *>(protocol.buffer), protocol.len);
+                }
+
+                OnTlsHandshakeCompleted onHandshakeCompleted;
+                {
+                    std::lock_guard<std::mutex> lock(state->lock);
+                    if (state->statisticsEnabled)
+                    {
+                        TlsHandshakeStatistics &statistics = state->statistics;
+                        if (errorCode == AWS_ERROR_SUCCESS)
+                        {
+                            ++statistics.SuccessCount;
+                            ++statistics.NegotiatedProtocolCounts[metrics.NegotiatedProtocol];
+                        }
+                        else
+                        {
+                            ++statistics.FailureCount;
+                        }
+                        if (metrics.HandshakeDurationNs > 0)
+                        {
+                            statistics.HandshakeLatency.Record(metrics.HandshakeDurationNs);
+                        }
+                    }
+
+                    onHandshakeCompleted = state->onHandshakeCompleted;
+                }
+
+                if (onHandshakeCompleted)
+                {
+                    onHandshakeCompleted(metrics);
+                }
+            }
+
             TlsContext::TlsContext() noexcept
                 : m_ctx(nullptr), m_initializationError(AWS_ERROR_SUCCESS),
                   m_metricsCertificateSource(CertificateSource::None), m_metricsTlsVersion(AWS_IO_TLS_VER_SYS_DEFAULTS),
@@ -545,6 +659,12 @@ namespace Aws
                     m_initializationError = Aws::Crt::LastErrorOrUnknown();
                 }
 #endif // BYO_CRYPTO
+
+                if (m_ctx)
+                {
+                    /* Without it, connections simply aren't observed */
+                    m_handshakeMetrics = MakeShared<TlsHandshakeMetricsState>(allocator);
+                }
             }
 
             TlsConnectionOptions TlsContext::NewConnectionOptions() const noexcept
@@ -556,8 +676,46 @@ namespace Aws
                     return TlsConnectionOptions();
                 }
 
-                return TlsConnectionOptions(
+                TlsConnectionOptions connectionOptions(
                     m_ctx.get(), m_ctx->alloc, m_metricsCertificateSource, m_metricsTlsVersion, m_metricsCipherPref);
+                if (m_handshakeMetrics && m_handshakeMetrics->IsObserved())
+                {
+                    /* Bootstraps chain their own negotiation handling in front of this callback */
+                    connectionOptions.m_tls_connection_options.on_negotiation_result = s_onTlsNegotiationResult;
+                    connectionOptions.m_tls_connection_options.user_data = m_handshakeMetrics.get();
+                    connectionOptions.m_handshakeMetrics = m_handshakeMetrics;
+                }
+
+                return connectionOptions;
+            }
+
+            void TlsContext::SetOnHandshakeCompleted(OnTlsHandshakeCompleted onHandshakeCompleted) noexcept
+            {
+                if (m_handshakeMetrics)
+                {
+                    std::lock_guard<std::mutex> lock(m_handshakeMetrics->lock);
+                    m_handshakeMetrics->onHandshakeCompleted = std::move(onHandshakeCompleted);
+                }
+            }
+
+            void TlsContext::EnableHandshakeStatistics() noexcept
+            {
+                if (m_handshakeMetrics)
+                {
+                    std::lock_guard<std::mutex> lock(m_handshakeMetrics->lock);
+                    m_handshakeMetrics->statisticsEnabled = true;
+                }
+            }
+
+            TlsHandshakeStatistics TlsContext::GetHandshakeStatistics() const noexcept
+            {
+                if (!m_handshakeMetrics)
+                {
+                    return TlsHandshakeStatistics();
+                }
+
+                std::lock_guard<std::mutex> lock(m_handshakeMetrics->lock);
+                return m_handshakeMetrics->statistics;
             }
 
             TlsChannelHandler::TlsChannelHandler(
@@ -106,14 +106,14 @@ namespace Aws
          *****************************************************/
 
         Mqtt5ClientBuilder::Mqtt5ClientBuilder(Crt::Allocator *allocator) noexcept
-            : m_allocator(allocator), m_port(0), m_lastError(0), m_enableMetricsCollection(true),
+            : m_allocator(allocator), m_port(0), m_bootstrap(nullptr), m_lastError(0), m_enableMetricsCollection(true),
               m_sdkName(Crt::Mqtt::IoTSDKMetricsEncoder::DEFAULT_METRICS_LIBRARY_NAME)
         {
             m_options = new Crt::Mqtt5::Mqtt5ClientOptions(allocator);
         }
 
         Mqtt5ClientBuilder::Mqtt5ClientBuilder(int error, Crt::Allocator *allocator) noexcept
-            : m_allocator(allocator), m_options(nullptr), m_lastError(error)
+            : m_allocator(allocator), m_options(nullptr), m_bootstrap(nullptr), m_lastError(error)
         {
         }
 
@@ -320,6 +320,7 @@ namespace Aws
 
         Mqtt5ClientBuilder &Mqtt5ClientBuilder::WithBootstrap(Crt::Io::ClientBootstrap *bootStrap) noexcept
         {
+            m_bootstrap = bootStrap;
             m_options->WithBootstrap(bootStrap);
             return *this;
         }
@@ -439,6 +440,19 @@ namespace Aws
             return WithAckTimeoutSec(ackTimeoutSec);
         }
 
+        Mqtt5ClientBuilder &Mqtt5ClientBuilder::WithRttEstimationEnabled(bool enabled) noexcept
+        {
+            m_options->WithRttEstimationEnabled(enabled);
+            return *this;
+        }
+
+        Mqtt5ClientBuilder &Mqtt5ClientBuilder::WithTimeoutsFromRttEstimate(
+            const Crt::Mqtt5::Mqtt5ClientOperationStatistics &statistics) noexcept
+        {
+            m_options->WithTimeoutsFromRttEstimate(statistics);
+            return *this;
+        }
+
         Mqtt5ClientBuilder &Mqtt5ClientBuilder::WithSdkName(const Crt::String &sdkName)
         {
             m_sdkName = sdkName;
@@ -454,6 +468,7 @@ namespace Aws
         Mqtt5ClientBuilder &Mqtt5ClientBuilder::WithClientConnectionSuccessCallback(
             OnConnectionSuccessHandler callback) noexcept
         {
+            m_onConnectionSuccess = callback;
             m_options->WithClientConnectionSuccessCallback(std::move(callback));
             return *this;
         }
@@ -461,6 +476,7 @@ namespace Aws
         Mqtt5ClientBuilder &Mqtt5ClientBuilder::WithClientConnectionFailureCallback(
             OnConnectionFailureHandler callback) noexcept
         {
+            m_onConnectionFailure = callback;
             m_options->WithClientConnectionFailureCallback(std::move(callback));
             return *this;
         }
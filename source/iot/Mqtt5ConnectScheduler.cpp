@@ -0,0 +1,495 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/crt/Api.h>
+#include <aws/iot/Mqtt5ConnectScheduler.h>
+
+#include <aws/common/clock.h>
+#include <aws/common/device_random.h>
+#include <aws/io/channel_bootstrap.h>
+#include <aws/io/event_loop.h>
+
+#include <algorithm>
+#include <mutex>
+
+#if !BYO_CRYPTO
+
+namespace Aws
+{
+    namespace Iot
+    {
+        Mqtt5ConnectSchedulerOptions::Mqtt5ConnectSchedulerOptions() noexcept
+            : m_connectsPerSecond(100.0), m_burstSize(1), m_maxStartJitterMs(0)
+        {
+        }
+
+        Mqtt5ConnectSchedulerOptions &Mqtt5ConnectSchedulerOptions::WithConnectsPerSecond(
+            double connectsPerSecond) noexcept
+        {
+            m_connectsPerSecond = connectsPerSecond > 0.0 ? connectsPerSecond : 0.0;
+            return *this;
+        }
+
+        Mqtt5ConnectSchedulerOptions &Mqtt5ConnectSchedulerOptions::WithBurstSize(uint32_t burstSize) noexcept
+        {
+            m_burstSize = burstSize > 0 ? burstSize : 1;
+            return *this;
+        }
+
+        Mqtt5ConnectSchedulerOptions &Mqtt5ConnectSchedulerOptions::WithMaxStartJitterMs(
+            uint32_t maxStartJitterMs) noexcept
+        {
+            m_maxStartJitterMs = maxStartJitterMs;
+            return *this;
+        }
+
+        Mqtt5ConnectSchedulerOptions &Mqtt5ConnectSchedulerOptions::WithBootstraps(
+            Crt::Vector<Crt::Io::ClientBootstrap *> bootstraps) noexcept
+        {
+            m_bootstraps = std::move(bootstraps);
+            return *this;
+        }
+
+        Mqtt5ConnectSchedulerOptions &Mqtt5ConnectSchedulerOptions::WithAllClientsConnectedCallback(
+            OnAllClientsConnectedHandler callback) noexcept
+        {
+            m_onAllClientsConnected = std::move(callback);
+            return *this;
+        }
+
+        /*
+         * Shared between the scheduler, its pacing task and the lifecycle callbacks of every client it built.  The
+         * callbacks only hold weak references so a client outliving the scheduler is harmless.
+         */
+        class Mqtt5ConnectSchedulerState final : public std::enable_shared_from_this<Mqtt5ConnectSchedulerState>
+        {
+          public:
+            Mqtt5ConnectSchedulerState(const Mqtt5ConnectSchedulerOptions &options) noexcept
+                : m_connectsPerSecond(options.m_connectsPerSecond), m_burstSize(options.m_burstSize),
+                  m_maxStartJitterMs(options.m_maxStartJitterMs),
+                  m_onAllClientsConnected(options.m_onAllClientsConnected), m_eventLoop(nullptr), m_started(false),
+                  m_shutdown(false), m_nextToStart(0), m_tokens(0.0), m_startTimeNs(0), m_lastRefillNs(0)
+            {
+                AWS_ZERO_STRUCT(m_task);
+            }
+
+            size_t AddClient(const std::shared_ptr<Crt::Mqtt5::Mqtt5Client> &client)
+            {
+                std::lock_guard<std::mutex> lock(m_lock);
+                ScheduledClient scheduled;
+                scheduled.client = client;
+                scheduled.startOffsetNs = s_drawStartOffsetNs(m_maxStartJitterMs);
+                m_clients.push_back(std::move(scheduled));
+                m_statistics.clientCount = m_clients.size();
+
+                return m_clients.size() - 1;
+            }
+
+            bool Start(struct aws_event_loop *eventLoop)
+            {
+                bool allConnected = false;
+                Mqtt5ConnectSchedulerStatistics statistics;
+                {
+                    std::lock_guard<std::mutex> lock(m_lock);
+                    if (m_started)
+                    {
+                        aws_raise_error(AWS_ERROR_INVALID_STATE);
+                        return false;
+                    }
+
+                    m_started = true;
+                    m_eventLoop = eventLoop;
+                    aws_high_res_clock_get_ticks(&m_startTimeNs);
+                    m_lastRefillNs = m_startTimeNs;
+                    m_tokens = static_cast<double>(m_burstSize);
+
+                    m_startOrder.reserve(m_clients.size());
+                    for (size_t i = 0; i < m_clients.size(); ++i)
+                    {
+                        m_startOrder.push_back(i);
+                    }
+                    std::stable_sort(
+                        m_startOrder.begin(),
+                        m_startOrder.end(),
+                        [this](size_t lhs, size_t rhs)
+                        { return m_clients[lhs].startOffsetNs < m_clients[rhs].startOffsetNs; });
+
+                    allConnected = CheckAllConnected(m_startTimeNs);
+                    statistics = m_statistics;
+
+                    if (!m_startOrder.empty())
+                    {
+                        aws_task_init(&m_task, s_onPacingTask, this, "Mqtt5ConnectSchedulerPacing");
+                        m_pendingTaskRef = shared_from_this();
+                        aws_event_loop_schedule_task_now(m_eventLoop, &m_task);
+                    }
+                }
+
+                if (allConnected && m_onAllClientsConnected)
+                {
+                    m_onAllClientsConnected(statistics);
+                }
+
+                return true;
+            }
+
+            void Shutdown()
+            {
+                std::lock_guard<std::mutex> lock(m_lock);
+                m_shutdown = true;
+            }
+
+            void OnClientConnectionSuccess(size_t index)
+            {
+                bool allConnected = false;
+                Mqtt5ConnectSchedulerStatistics statistics;
+                {
+                    std::lock_guard<std::mutex> lock(m_lock);
+                    ScheduledClient &scheduled = m_clients[index];
+                    if (scheduled.connected)
+                    {
+                        return;
+                    }
+
+                    scheduled.connected = true;
+                    ++m_statistics.connectedClientCount;
+
+                    uint64_t now = 0;
+                    aws_high_res_clock_get_ticks(&now);
+                    allConnected = CheckAllConnected(now);
+                    statistics = m_statistics;
+                }
+
+                if (allConnected && m_onAllClientsConnected)
+                {
+                    m_onAllClientsConnected(statistics);
+                }
+            }
+
+            void OnClientConnectionFailure()
+            {
+                std::lock_guard<std::mutex> lock(m_lock);
+                ++m_statistics.connectionFailureCount;
+            }
+
+            Mqtt5ConnectSchedulerStatistics GetStatistics()
+            {
+                std::lock_guard<std::mutex> lock(m_lock);
+                return m_statistics;
+            }
+
+            bool IsStarted()
+            {
+                std::lock_guard<std::mutex> lock(m_lock);
+                return m_started;
+            }
+
+          private:
+            struct ScheduledClient
+            {
+                ScheduledClient() : startOffsetNs(0), connected(false) {}
+
+                std::weak_ptr<Crt::Mqtt5::Mqtt5Client> client;
+                uint64_t startOffsetNs;
+                bool connected;
+            };
+
+            static uint64_t s_drawStartOffsetNs(uint32_t maxStartJitterMs)
+            {
+                if (maxStartJitterMs == 0)
+                {
+                    return 0;
+                }
+
+                uint64_t random = 0;
+                if (aws_device_random_u64(&random) != AWS_OP_SUCCESS)
+                {
+                    return 0;
+                }
+
+                uint64_t jitterMs = random % (static_cast<uint64_t>(maxStartJitterMs) + 1);
+                return aws_timestamp_convert(jitterMs, AWS_TIMESTAMP_MILLIS, AWS_TIMESTAMP_NANOS, NULL);
+            }
+
+            /* Must be called with the lock held. */
+            bool CheckAllConnected(uint64_t now)
+            {
+                if (!m_started || m_statistics.timeToAllConnectedMs.has_value() ||
+                    m_statistics.connectedClientCount < m_clients.size())
+                {
+                    return false;
+                }
+
+                m_statistics.timeToAllConnectedMs =
+                    aws_timestamp_convert(now - m_startTimeNs, AWS_TIMESTAMP_NANOS, AWS_TIMESTAMP_MILLIS, NULL);
+                return true;
+            }
+
+            /* Must be called with the lock held. */
+            void RefillTokens(uint64_t now)
+            {
+                if (m_connectsPerSecond <= 0.0)
+                {
+                    return;
+                }
+
+                double elapsedSec =
+                    static_cast<double>(now - m_lastRefillNs) / static_cast<double>(AWS_TIMESTAMP_NANOS);
+                m_tokens = (std::min)(static_cast<double>(m_burstSize), m_tokens + elapsedSec * m_connectsPerSecond);
+                m_lastRefillNs = now;
+            }
+
+            static void s_onPacingTask(struct aws_task *, void *arg, enum aws_task_status status)
+            {
+                auto *state = static_cast<Mqtt5ConnectSchedulerState *>(arg);
+                state->OnPacingTask(status);
+            }
+
+            void OnPacingTask(enum aws_task_status status)
+            {
+                Crt::Vector<std::shared_ptr<Crt::Mqtt5::Mqtt5Client>> toStart;
+                std::shared_ptr<Mqtt5ConnectSchedulerState> keepAlive;
+                {
+                    std::lock_guard<std::mutex> lock(m_lock);
+                    keepAlive = std::move(m_pendingTaskRef);
+
+                    if (status != AWS_TASK_STATUS_RUN_READY || m_shutdown)
+                    {
+                        return;
+                    }
+
+                    uint64_t now = 0;
+                    aws_high_res_clock_get_ticks(&now);
+                    uint64_t elapsedNs = now - m_startTimeNs;
+                    RefillTokens(now);
+
+                    bool paced = m_connectsPerSecond > 0.0;
+                    while (m_nextToStart < m_startOrder.size())
+                    {
+                        ScheduledClient &scheduled = m_clients[m_startOrder[m_nextToStart]];
+                        if (scheduled.startOffsetNs > elapsedNs || (paced && m_tokens < 1.0))
+                        {
+                            break;
+                        }
+
+                        if (paced)
+                        {
+                            m_tokens -= 1.0;
+                        }
+                        ++m_nextToStart;
+
+                        auto client = scheduled.client.lock();
+                        if (client)
+                        {
+                            toStart.push_back(std::move(client));
+                        }
+                    }
+
+                    if (m_nextToStart < m_startOrder.size())
+                    {
+                        uint64_t delayNs = 0;
+                        uint64_t startOffsetNs = m_clients[m_startOrder[m_nextToStart]].startOffsetNs;
+                        if (startOffsetNs > elapsedNs)
+                        {
+                            delayNs = startOffsetNs - elapsedNs;
+                        }
+                        if (paced && m_tokens < 1.0)
+                        {
+                            auto tokenDelayNs = static_cast<uint64_t>(
+                                (1.0 - m_tokens) / m_connectsPerSecond * static_cast<double>(AWS_TIMESTAMP_NANOS));
+                            delayNs = (std::max)(delayNs, tokenDelayNs);
+                        }
+
+                        uint64_t loopNow = 0;
+                        aws_event_loop_current_clock_time(m_eventLoop, &loopNow);
+                        aws_task_init(&m_task, s_onPacingTask, this, "Mqtt5ConnectSchedulerPacing");
+                        m_pendingTaskRef = std::move(keepAlive);
+                        aws_event_loop_schedule_task_future(m_eventLoop, &m_task, loopNow + delayNs);
+                    }
+
+                    m_statistics.startedClientCount += toStart.size();
+                }
+
+                for (auto &client : toStart)
+                {
+                    if (!client->Start())
+                    {
+                        AWS_LOGF_ERROR(
+                            AWS_LS_MQTT5_GENERAL,
+                            "Mqtt5ConnectScheduler failed to start client with error %s",
+                            aws_error_debug_str(client->LastError()));
+                    }
+                }
+            }
+
+            std::mutex m_lock;
+
+            double m_connectsPerSecond;
+            uint32_t m_burstSize;
+            uint32_t m_maxStartJitterMs;
+            OnAllClientsConnectedHandler m_onAllClientsConnected;
+
+            Crt::Vector<ScheduledClient> m_clients;
+            Crt::Vector<size_t> m_startOrder;
+            Mqtt5ConnectSchedulerStatistics m_statistics;
+
+            struct aws_event_loop *m_eventLoop;
+            struct aws_task m_task;
+
+            /* Keeps the state alive while the pacing task is pending on the event loop */
+            std::shared_ptr<Mqtt5ConnectSchedulerState> m_pendingTaskRef;
+
+            bool m_started;
+            bool m_shutdown;
+            size_t m_nextToStart;
+            double m_tokens;
+            uint64_t m_startTimeNs;
+            uint64_t m_lastRefillNs;
+        };
+
+        std::shared_ptr<Mqtt5ConnectScheduler> Mqtt5ConnectScheduler::NewMqtt5ConnectScheduler(
+            const Mqtt5ConnectSchedulerOptions &options,
+            Crt::Allocator *allocator) noexcept
+        {
+            for (auto *bootstrap : options.m_bootstraps)
+            {
+                if (bootstrap == nullptr || !*bootstrap)
+                {
+                    aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+                    return nullptr;
+                }
+            }
+
+            auto *toSeat =
+                reinterpret_cast<Mqtt5ConnectScheduler *>(aws_mem_acquire(allocator, sizeof(Mqtt5ConnectScheduler)));
+            toSeat = new (toSeat) Mqtt5ConnectScheduler(options, allocator);
+            return std::shared_ptr<Mqtt5ConnectScheduler>(
+                toSeat, [allocator](Mqtt5ConnectScheduler *scheduler) { Crt::Delete(scheduler, allocator); });
+        }
+
+        Mqtt5ConnectScheduler::Mqtt5ConnectScheduler(
+            const Mqtt5ConnectSchedulerOptions &options,
+            Crt::Allocator *allocator) noexcept
+            : m_allocator(allocator), m_bootstraps(options.m_bootstraps),
+              m_bootstrapClientCounts(options.m_bootstraps.size(), 0), m_lastError(AWS_ERROR_SUCCESS)
+        {
+            m_state = Crt::MakeShared<Mqtt5ConnectSchedulerState>(allocator, options);
+        }
+
+        Mqtt5ConnectScheduler::~Mqtt5ConnectScheduler()
+        {
+            m_state->Shutdown();
+        }
+
+        std::shared_ptr<Crt::Mqtt5::Mqtt5Client> Mqtt5ConnectScheduler::Build(Mqtt5ClientBuilder &builder) noexcept
+        {
+            if (!builder)
+            {
+                m_lastError = builder.LastError();
+                return nullptr;
+            }
+
+            if (m_state->IsStarted())
+            {
+                m_lastError = AWS_ERROR_INVALID_STATE;
+                return nullptr;
+            }
+
+            /*
+             * The bootstrap and lifecycle callbacks are bound when the client is created, so override them on the
+             * builder's options for the duration of this build only, then restore the user's values.  The builder
+             * itself is left as the user configured it and can be reused.
+             */
+            size_t bootstrapIndex = m_bootstraps.size();
+            if (!m_bootstraps.empty())
+            {
+                auto leastLoaded = std::min_element(m_bootstrapClientCounts.begin(), m_bootstrapClientCounts.end());
+                bootstrapIndex = static_cast<size_t>(leastLoaded - m_bootstrapClientCounts.begin());
+                builder.m_options->WithBootstrap(m_bootstraps[bootstrapIndex]);
+            }
+
+            OnConnectionSuccessHandler userOnConnectionSuccess = builder.m_onConnectionSuccess;
+            OnConnectionFailureHandler userOnConnectionFailure = builder.m_onConnectionFailure;
+
+            std::weak_ptr<Mqtt5ConnectSchedulerState> weakState = m_state;
+            std::shared_ptr<size_t> clientIndex = Crt::MakeShared<size_t>(m_allocator, 0);
+
+            builder.m_options->WithClientConnectionSuccessCallback(
+                [weakState, clientIndex, userOnConnectionSuccess](const OnConnectionSuccessEventData &eventData)
+                {
+                    if (auto state = weakState.lock())
+                    {
+                        state->OnClientConnectionSuccess(*clientIndex);
+                    }
+                    if (userOnConnectionSuccess)
+                    {
+                        userOnConnectionSuccess(eventData);
+                    }
+                });
+            builder.m_options->WithClientConnectionFailureCallback(
+                [weakState, userOnConnectionFailure](const OnConnectionFailureEventData &eventData)
+                {
+                    if (auto state = weakState.lock())
+                    {
+                        state->OnClientConnectionFailure();
+                    }
+                    if (userOnConnectionFailure)
+                    {
+                        userOnConnectionFailure(eventData);
+                    }
+                });
+
+            auto client = builder.Build();
+
+            builder.m_options->WithBootstrap(builder.m_bootstrap);
+            builder.m_options->WithClientConnectionSuccessCallback(std::move(userOnConnectionSuccess));
+            builder.m_options->WithClientConnectionFailureCallback(std::move(userOnConnectionFailure));
+
+            if (!client || !*client)
+            {
+                m_lastError = client ? client->LastError() : aws_last_error();
+                return nullptr;
+            }
+
+            if (bootstrapIndex < m_bootstrapClientCounts.size())
+            {
+                ++m_bootstrapClientCounts[bootstrapIndex];
+            }
+
+            *clientIndex = m_state->AddClient(client);
+
+            return client;
+        }
+
+        bool Mqtt5ConnectScheduler::Start() noexcept
+        {
+            Crt::Io::ClientBootstrap *bootstrap =
+                m_bootstraps.empty() ? Crt::ApiHandle::GetOrCreateStaticDefaultClientBootstrap() : m_bootstraps[0];
+            if (bootstrap == nullptr || !*bootstrap)
+            {
+                m_lastError = AWS_ERROR_INVALID_STATE;
+                return false;
+            }
+
+            struct aws_event_loop *eventLoop =
+                aws_event_loop_group_get_next_loop(bootstrap->GetUnderlyingHandle()->event_loop_group);
+            if (!m_state->Start(eventLoop))
+            {
+                m_lastError = aws_last_error();
+                return false;
+            }
+
+            return true;
+        }
+
+        Mqtt5ConnectSchedulerStatistics Mqtt5ConnectScheduler::GetStatistics() const noexcept
+        {
+            return m_state->GetStatistics();
+        }
+
+    } // namespace Iot
+} // namespace Aws
+
+#endif // !BYO_CRYPTO
@@ -8,9 +8,14 @@
 #include <aws/crt/mqtt/Mqtt5Client.h>
 #include <aws/crt/mqtt/MqttConnection.h>
 
+#include <aws/common/clock.h>
 #include <aws/common/ref_count.h>
 #include <aws/common/rw_lock.h>
 
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+
 namespace Aws
 {
     namespace Iot
@@ -71,13 +76,283 @@ namespace Aws
                 bool m_taken;
             };
 
+            /* Operations tracked individually by RequestResponseMetricsTracker before the rest are counted under "#" */
+            static const size_t s_maxOperationMetricsKeys = 64;
+
+            /*
+             * Bookkeeping behind IMqttRequestResponseClient::GetMetrics().  Requests and streams register with the
+             * tracker from user threads and complete from the protocol client's event loop, so all state is guarded
+             * by a single lock.
+             */
+            class RequestResponseMetricsTracker
+            {
+              public:
+                explicit RequestResponseMetricsTracker(const RequestResponseClientOptions &options)
+                    : m_maxRequestResponseSubscriptions(options.GetMaxRequestResponseSubscriptions()),
+                      m_maxStreamingSubscriptions(options.GetMaxStreamingSubscriptions()), m_nextRequestId(1),
+                      m_duplicateCorrelationTokenCount(0), m_coalescedRequestCount(0), m_completedRequestCount(0),
+                      m_timeoutCount(0)
+                {
+                }
+
+                uint64_t OnRequestSubmitted(const aws_mqtt_request_operation_options &requestOptions)
+                {
+                    InFlightRequest request;
+                    request.operationKey = s_operationKey(requestOptions.publish_topic);
+                    if (requestOptions.correlation_token.len > 0)
+                    {
+                        request.correlationToken = s_toString(requestOptions.correlation_token);
+                    }
+                    request.subscriptionTopicFilters.reserve(requestOptions.subscription_topic_filter_count);
+                    for (size_t i = 0; i < requestOptions.subscription_topic_filter_count; ++i)
+                    {
+                        request.subscriptionTopicFilters.push_back(
+                            s_toString(requestOptions.subscription_topic_filters[i]));
+                    }
+                    aws_high_res_clock_get_ticks(&request.submitTimestampNs);
+
+                    std::lock_guard<std::mutex> lock(m_lock);
+                    uint64_t requestId = m_nextRequestId++;
+
+                    /* Past the cap, requests to topics not seen before are counted together */
+                    if (m_operations.size() >= s_maxOperationMetricsKeys &&
+                        m_operations.find(request.operationKey) == m_operations.end())
+                    {
+                        request.operationKey = "#";
+                    }
+                    ++m_operations[request.operationKey].submittedCount;
+                    for (const auto &topicFilter : request.subscriptionTopicFilters)
+                    {
+                        ++m_requestResponseSubscriptionRefCounts[topicFilter];
+                    }
+                    if (!request.correlationToken.empty())
+                    {
+                        if (m_correlationTokenIndex.find(request.correlationToken) != m_correlationTokenIndex.end())
+                        {
+                            ++m_duplicateCorrelationTokenCount;
+                        }
+                        m_correlationTokenIndex[request.correlationToken] = requestId;
+                    }
+
+                    m_inFlightRequests.emplace(requestId, std::move(request));
+
+                    return requestId;
+                }
+
+                void OnRequestSubmitFailed(uint64_t requestId)
+                {
+                    std::lock_guard<std::mutex> lock(m_lock);
+                    auto iter = m_inFlightRequests.find(requestId);
+                    if (iter == m_inFlightRequests.end())
+                    {
+                        return;
+                    }
+
+                    /* Don't leave an entry behind for an operation that was never actually submitted */
+                    auto operationIter = m_operations.find(iter->second.operationKey);
+                    if (operationIter != m_operations.end() && --operationIter->second.submittedCount == 0 &&
+                        operationIter->second.latency.GetSampleCount() == 0)
+                    {
+                        m_operations.erase(operationIter);
+                    }
+                    RemoveInFlightRequest(iter);
+                }
+
+                void OnRequestCompleted(uint64_t requestId, int errorCode)
+                {
+                    uint64_t now = 0;
+                    aws_high_res_clock_get_ticks(&now);
+
+                    std::lock_guard<std::mutex> lock(m_lock);
+                    auto iter = m_inFlightRequests.find(requestId);
+                    if (iter == m_inFlightRequests.end())
+                    {
+                        return;
+                    }
+
+                    RequestResponseOperationMetrics &operation = m_operations[iter->second.operationKey];
+                    operation.latency.Record(now - iter->second.submitTimestampNs);
+                    ++m_completedRequestCount;
+                    if (errorCode == AWS_ERROR_SUCCESS)
+                    {
+                        ++operation.successCount;
+                    }
+                    else
+                    {
+                        ++operation.failureCount;
+                        if (errorCode == AWS_ERROR_MQTT_REQUEST_RESPONSE_TIMEOUT)
+                        {
+                            ++operation.timeoutCount;
+                            ++m_timeoutCount;
+                        }
+                    }
+
+                    RemoveInFlightRequest(iter);
+                }
+
+                void OnRequestCoalesced()
+                {
+                    std::lock_guard<std::mutex> lock(m_lock);
+                    ++m_coalescedRequestCount;
+                }
+
+                void OnStreamOpened(const Aws::Crt::String &topicFilter)
+                {
+                    std::lock_guard<std::mutex> lock(m_lock);
+                    ++m_streamingSubscriptionRefCounts[topicFilter];
+                }
+
+                void OnStreamClosed(const Aws::Crt::String &topicFilter)
+                {
+                    std::lock_guard<std::mutex> lock(m_lock);
+                    s_releaseRef(m_streamingSubscriptionRefCounts, topicFilter);
+                }
+
+                RequestResponseClientMetrics GetMetrics()
+                {
+                    uint64_t now = 0;
+                    aws_high_res_clock_get_ticks(&now);
+
+                    RequestResponseClientMetrics metrics;
+                    std::lock_guard<std::mutex> lock(m_lock);
+
+                    metrics.inFlightRequestCount = m_inFlightRequests.size();
+                    metrics.inFlightCorrelatedRequestCount = m_correlationTokenIndex.size();
+                    metrics.duplicateCorrelationTokenCount = m_duplicateCorrelationTokenCount;
+                    metrics.coalescedRequestCount = m_coalescedRequestCount;
+                    for (const auto &entry : m_inFlightRequests)
+                    {
+                        uint64_t ageMs = aws_timestamp_convert(
+                            now - entry.second.submitTimestampNs, AWS_TIMESTAMP_NANOS, AWS_TIMESTAMP_MILLIS, NULL);
+                        if (ageMs > metrics.oldestInFlightRequestAgeMs)
+                        {
+                            metrics.oldestInFlightRequestAgeMs = ageMs;
+                        }
+                    }
+
+                    metrics.completedRequestCount = m_completedRequestCount;
+                    metrics.timeoutCount = m_timeoutCount;
+
+                    metrics.maxRequestResponseSubscriptions = m_maxRequestResponseSubscriptions;
+                    metrics.requestResponseSubscriptionsInUse = static_cast<uint32_t>(
+                        (std::min)(m_requestResponseSubscriptionRefCounts.size(),
+                                   static_cast<size_t>(m_maxRequestResponseSubscriptions)));
+                    metrics.maxStreamingSubscriptions = m_maxStreamingSubscriptions;
+                    metrics.streamingSubscriptionsInUse =
+                        static_cast<uint32_t>(m_streamingSubscriptionRefCounts.size());
+
+                    metrics.operations = m_operations;
+
+                    return metrics;
+                }
+
+              private:
+                struct InFlightRequest
+                {
+                    InFlightRequest() : submitTimestampNs(0) {}
+
+                    Aws::Crt::String operationKey;
+                    Aws::Crt::String correlationToken;
+                    Aws::Crt::Vector<Aws::Crt::String> subscriptionTopicFilters;
+                    uint64_t submitTimestampNs;
+                };
+
+                using InFlightRequestMap = Aws::Crt::Map<uint64_t, InFlightRequest>;
+                using RefCountMap = Aws::Crt::Map<Aws::Crt::String, uint32_t>;
+
+                static Aws::Crt::String s_toString(Aws::Crt::ByteCursor cursor)
+                {
+                    return Aws::Crt::String(reinterpret_cast<const char *>(cursor.ptr), cursor.len);
+                }
+
+                /*
+                 * Key of the operation a publish topic belongs to: the topic with the identifiers in AWS IoT thing
+                 * topics (thing names, named shadow names and job ids) replaced by "+", so that a fleet of things
+                 * shares one entry per operation.
+                 */
+                static Aws::Crt::String s_operationKey(Aws::Crt::ByteCursor topic)
+                {
+                    Aws::Crt::Vector<Aws::Crt::String> levels;
+                    Aws::Crt::ByteCursor level;
+                    AWS_ZERO_STRUCT(level);
+                    while (aws_byte_cursor_next_split(&topic, '/', &level))
+                    {
+                        levels.push_back(s_toString(level));
+                    }
+
+                    bool isThingTopic = levels.size() > 2 && levels[0] == "$aws" && levels[1] == "things";
+                    Aws::Crt::String key;
+                    for (size_t i = 0; i < levels.size(); ++i)
+                    {
+                        bool isIdentifier = isThingTopic &&
+                                            (i == 2 || (levels[i - 1] == "name" && levels[i - 2] == "shadow") ||
+                                             (levels[i - 1] == "jobs" && i + 1 < levels.size()));
+                        if (i > 0)
+                        {
+                            key.push_back('/');
+                        }
+                        key.append(isIdentifier ? "+" : levels[i]);
+                    }
+
+                    return key;
+                }
+
+                static void s_releaseRef(RefCountMap &refCounts, const Aws::Crt::String &key)
+                {
+                    auto iter = refCounts.find(key);
+                    if (iter != refCounts.end() && --iter->second == 0)
+                    {
+                        refCounts.erase(iter);
+                    }
+                }
+
+                /* Must be called with the lock held. */
+                void RemoveInFlightRequest(InFlightRequestMap::iterator iter)
+                {
+                    const InFlightRequest &request = iter->second;
+                    for (const auto &topicFilter : request.subscriptionTopicFilters)
+                    {
+                        s_releaseRef(m_requestResponseSubscriptionRefCounts, topicFilter);
+                    }
+
+                    if (!request.correlationToken.empty())
+                    {
+                        auto tokenIter = m_correlationTokenIndex.find(request.correlationToken);
+                        if (tokenIter != m_correlationTokenIndex.end() && tokenIter->second == iter->first)
+                        {
+                            m_correlationTokenIndex.erase(tokenIter);
+                        }
+                    }
+
+                    m_inFlightRequests.erase(iter);
+                }
+
+                std::mutex m_lock;
+
+                uint32_t m_maxRequestResponseSubscriptions;
+                uint32_t m_maxStreamingSubscriptions;
+
+                uint64_t m_nextRequestId;
+                InFlightRequestMap m_inFlightRequests;
+                Aws::Crt::Map<Aws::Crt::String, uint64_t> m_correlationTokenIndex;
+                RefCountMap m_requestResponseSubscriptionRefCounts;
+                RefCountMap m_streamingSubscriptionRefCounts;
+                Aws::Crt::Map<Aws::Crt::String, RequestResponseOperationMetrics> m_operations;
+
+                uint64_t m_duplicateCorrelationTokenCount;
+                uint64_t m_coalescedRequestCount;
+                uint64_t m_completedRequestCount;
+                uint64_t m_timeoutCount;
+            };
+
             class StreamingOperationImpl
             {
               public:
                 StreamingOperationImpl(
                     struct aws_mqtt_rr_client_operation *stream,
                     const StreamingOperationOptionsInternal &options,
-                    struct aws_event_loop *protocolLoop);
+                    struct aws_event_loop *protocolLoop,
+                    const std::shared_ptr<RequestResponseMetricsTracker> &metrics);
                 virtual ~StreamingOperationImpl();
 
                 void Open();
@@ -105,6 +380,13 @@ namespace Aws
                 struct aws_rw_lock m_lock;
 
                 bool m_closed;
+
+                std::shared_ptr<RequestResponseMetricsTracker> m_metrics;
+
+                Aws::Crt::String m_metricsTopicFilter;
+
+                /* Open() only holds the read lock, so concurrent calls settle who counts the open with an exchange */
+                std::atomic<bool> m_opened;
             };
 
             struct StreamingOperationImplHandle
@@ -119,10 +401,18 @@ namespace Aws
             StreamingOperationImpl::StreamingOperationImpl(
                 struct aws_mqtt_rr_client_operation *stream,
                 const StreamingOperationOptionsInternal &options,
-                struct aws_event_loop *protocolLoop)
-                : m_config(options), m_stream(stream), m_protocolLoop(protocolLoop), m_lock(), m_closed(false)
+                struct aws_event_loop *protocolLoop,
+                const std::shared_ptr<RequestResponseMetricsTracker> &metrics)
+                : m_config(options), m_stream(stream), m_protocolLoop(protocolLoop), m_lock(), m_closed(false),
+                  m_metrics(metrics), m_opened(false)
             {
                 aws_rw_lock_init(&m_lock);
+                if (m_metrics)
+                {
+                    m_metricsTopicFilter = Aws::Crt::String(
+                        reinterpret_cast<const char *>(options.subscriptionTopicFilter.ptr),
+                        options.subscriptionTopicFilter.len);
+                }
             }
 
             StreamingOperationImpl::~StreamingOperationImpl()
@@ -138,9 +428,10 @@ namespace Aws
                 {
                     StreamReadLock rlock(&m_lock);
 
-                    if (!m_closed)
+                    if (!m_closed && aws_mqtt_rr_client_operation_activate(m_stream) == AWS_OP_SUCCESS && m_metrics &&
+                        !m_opened.exchange(true))
                     {
-                        aws_mqtt_rr_client_operation_activate(m_stream);
+                        m_metrics->OnStreamOpened(m_metricsTopicFilter);
                     }
                 }
             }
@@ -163,6 +454,11 @@ namespace Aws
                 if (nullptr != toRelease)
                 {
                     aws_mqtt_rr_client_operation_release(toRelease);
+
+                    if (m_metrics && m_opened)
+                    {
+                        m_metrics->OnStreamClosed(m_metricsTopicFilter);
+                    }
                 }
             }
 
@@ -242,7 +538,8 @@ namespace Aws
                 static std::shared_ptr<IStreamingOperation> Create(
                     Aws::Crt::Allocator *allocator,
                     const StreamingOperationOptionsInternal &options,
-                    struct aws_mqtt_request_response_client *client);
+                    struct aws_mqtt_request_response_client *client,
+                    const std::shared_ptr<RequestResponseMetricsTracker> &metrics);
 
                 explicit StreamingOperation(const std::shared_ptr<StreamingOperationImpl> &impl);
                 virtual ~StreamingOperation();
@@ -260,7 +557,8 @@ namespace Aws
             std::shared_ptr<IStreamingOperation> StreamingOperation::Create(
                 Aws::Crt::Allocator *allocator,
                 const StreamingOperationOptionsInternal &options,
-                struct aws_mqtt_request_response_client *client)
+                struct aws_mqtt_request_response_client *client,
+                const std::shared_ptr<RequestResponseMetricsTracker> &metrics)
             {
                 auto *implHandle = Aws::Crt::New<StreamingOperationImplHandle>(allocator);
 
@@ -281,7 +579,7 @@ namespace Aws
                 }
 
                 auto impl = Aws::Crt::MakeShared<StreamingOperationImpl>(
-                    allocator, stream, options, aws_mqtt_request_response_client_get_event_loop(client));
+                    allocator, stream, options, aws_mqtt_request_response_client_get_event_loop(client), metrics);
                 auto streamingOperation = Aws::Crt::MakeShared<StreamingOperation>(allocator, impl);
 
                 implHandle->m_allocator = allocator;
@@ -302,29 +600,111 @@ namespace Aws
 
             //////////////////////////////////////////////////////////
 
+            class RequestCoalescer;
+
             struct IncompleteRequest
             {
-                IncompleteRequest() : m_allocator(nullptr), m_handler() {}
+                IncompleteRequest() : m_allocator(nullptr), m_handler(), m_metricsRequestId(0) {}
 
                 struct aws_allocator *m_allocator;
 
                 UnmodeledResultHandler m_handler;
+
+                std::shared_ptr<RequestResponseMetricsTracker> m_metrics;
+
+                uint64_t m_metricsRequestId;
+
+                std::shared_ptr<RequestCoalescer> m_coalescer;
+
+                Aws::Crt::String m_coalescingKey;
+
+                /* Handlers of identical requests that were coalesced into this one; guarded by the coalescer's lock */
+                Aws::Crt::Vector<UnmodeledResultHandler> m_coalescedHandlers;
+            };
+
+            /*
+             * Index of in-flight requests by publish topic and payload, used to coalesce identical requests.  Entries
+             * are added on submission and removed on completion, from the protocol client's event loop.
+             */
+            class RequestCoalescer
+            {
+              public:
+                static Aws::Crt::String s_makeKey(const aws_mqtt_request_operation_options &requestOptions)
+                {
+                    /* MQTT topics cannot contain a null character, so it is a safe separator */
+                    Aws::Crt::String key(
+                        reinterpret_cast<const char *>(requestOptions.publish_topic.ptr),
+                        requestOptions.publish_topic.len);
+                    key.push_back('\0');
+                    key.append(
+                        reinterpret_cast<const char *>(requestOptions.serialized_request.ptr),
+                        requestOptions.serialized_request.len);
+
+                    return key;
+                }
+
+                std::mutex &GetLock() { return m_lock; }
+
+                /* Must be called with the lock held. */
+                IncompleteRequest *Find(const Aws::Crt::String &key) const
+                {
+                    auto iter = m_inFlightRequests.find(key);
+                    return iter != m_inFlightRequests.end() ? iter->second : nullptr;
+                }
+
+                /* Must be called with the lock held. */
+                void Add(IncompleteRequest *request) { m_inFlightRequests[request->m_coalescingKey] = request; }
+
+                /*
+                 * Removes a request from the index and returns the handlers that were coalesced into it.  After this
+                 * no further handlers can be attached.
+                 */
+                Aws::Crt::Vector<UnmodeledResultHandler> Remove(IncompleteRequest *request)
+                {
+                    std::lock_guard<std::mutex> lock(m_lock);
+                    auto iter = m_inFlightRequests.find(request->m_coalescingKey);
+                    if (iter != m_inFlightRequests.end() && iter->second == request)
+                    {
+                        m_inFlightRequests.erase(iter);
+                    }
+
+                    return std::move(request->m_coalescedHandlers);
+                }
+
+              private:
+                std::mutex m_lock;
+
+                Aws::Crt::Map<Aws::Crt::String, IncompleteRequest *> m_inFlightRequests;
             };
 
-            static void s_completeRequestWithError(struct IncompleteRequest *incompleteRequest, int errorCode)
+            static void s_completeRequestWithError(
+                struct IncompleteRequest *incompleteRequest,
+                Aws::Crt::Vector<UnmodeledResultHandler> &coalescedHandlers,
+                int errorCode)
             {
+                for (auto &handler : coalescedHandlers)
+                {
+                    handler(UnmodeledResult(errorCode));
+                }
+
                 UnmodeledResult result(errorCode);
                 incompleteRequest->m_handler(std::move(result));
             }
 
             static void s_completeRequestWithSuccess(
                 struct IncompleteRequest *incompleteRequest,
+                Aws::Crt::Vector<UnmodeledResultHandler> &coalescedHandlers,
                 const struct aws_mqtt_rr_incoming_publish_event *publish_event)
             {
                 UnmodeledResponse response;
                 response.WithTopic(publish_event->topic);
                 response.WithPayload(publish_event->payload);
 
+                for (auto &handler : coalescedHandlers)
+                {
+                    handler(UnmodeledResult(response));
+                }
+
                 UnmodeledResult result(response);
                 incompleteRequest->m_handler(std::move(result));
             }
@@ -336,13 +716,24 @@ namespace Aws
             {
                 auto *incompleteRequest = static_cast<IncompleteRequest *>(user_data);
 
+                if (incompleteRequest->m_metrics)
+                {
+                    incompleteRequest->m_metrics->OnRequestCompleted(incompleteRequest->m_metricsRequestId, error_code);
+                }
+
+                Aws::Crt::Vector<UnmodeledResultHandler> coalescedHandlers;
+                if (incompleteRequest->m_coalescer)
+                {
+                    coalescedHandlers = incompleteRequest->m_coalescer->Remove(incompleteRequest);
+                }
+
                 if (error_code != AWS_ERROR_SUCCESS)
                 {
-                    s_completeRequestWithError(incompleteRequest, error_code);
+                    s_completeRequestWithError(incompleteRequest, coalescedHandlers, error_code);
                 }
                 else
                 {
-                    s_completeRequestWithSuccess(incompleteRequest, publish_event);
+                    s_completeRequestWithSuccess(incompleteRequest, coalescedHandlers, publish_event);
                 }
 
                 Aws::Crt::Delete(incompleteRequest, incompleteRequest->m_allocator);
@@ -351,7 +742,9 @@ namespace Aws
             class MqttRequestResponseClientImpl
             {
               public:
-                explicit MqttRequestResponseClientImpl(Aws::Crt::Allocator *allocator) noexcept;
+                MqttRequestResponseClientImpl(
+                    Aws::Crt::Allocator *allocator,
+                    const RequestResponseClientOptions &options) noexcept;
                 ~MqttRequestResponseClientImpl();
 
                 void SeatClient(struct aws_mqtt_request_response_client *client);
@@ -364,17 +757,38 @@ namespace Aws
 
                 std::shared_ptr<IStreamingOperation> CreateStream(const StreamingOperationOptionsInternal &options);
 
+                RequestResponseClientMetrics GetMetrics() const;
+
                 Aws::Crt::Allocator *GetAllocator() const { return m_allocator; }
 
               private:
+                int SubmitRequestInternal(
+                    const aws_mqtt_request_operation_options &requestOptions,
+                    IncompleteRequest *incompleteRequest) noexcept;
+
                 Aws::Crt::Allocator *m_allocator;
 
                 struct aws_mqtt_request_response_client *m_client;
+
+                std::shared_ptr<RequestResponseMetricsTracker> m_metrics;
+
+                std::shared_ptr<RequestCoalescer> m_coalescer;
             };
 
-            MqttRequestResponseClientImpl::MqttRequestResponseClientImpl(Aws::Crt::Allocator *allocator) noexcept
+            MqttRequestResponseClientImpl::MqttRequestResponseClientImpl(
+                Aws::Crt::Allocator *allocator,
+                const RequestResponseClientOptions &options) noexcept
                 : m_allocator(allocator), m_client(nullptr)
             {
+                if (options.GetOperationMetricsEnabled())
+                {
+                    m_metrics = Aws::Crt::MakeShared<RequestResponseMetricsTracker>(allocator, options);
+                }
+
+                if (options.GetRequestCoalescingEnabled())
+                {
+                    m_coalescer = Aws::Crt::MakeShared<RequestCoalescer>(allocator);
+                }
             }
 
             MqttRequestResponseClientImpl::~MqttRequestResponseClientImpl()
@@ -402,6 +816,51 @@ namespace Aws
                 incompleteRequest->m_allocator = m_allocator;
                 incompleteRequest->m_handler = std::move(resultHandler);
 
+                if (!m_coalescer)
+                {
+                    return SubmitRequestInternal(requestOptions, incompleteRequest);
+                }
+
+                incompleteRequest->m_coalescingKey = RequestCoalescer::s_makeKey(requestOptions);
+
+                /*
+                 * Submission only queues the request for the event loop, so holding the lock across it cannot deadlock
+                 * against completion and guarantees a request is indexed before anything can be coalesced into it.
+                 */
+                std::lock_guard<std::mutex> lock(m_coalescer->GetLock());
+                IncompleteRequest *inFlightRequest = m_coalescer->Find(incompleteRequest->m_coalescingKey);
+                if (inFlightRequest != nullptr)
+                {
+                    inFlightRequest->m_coalescedHandlers.push_back(std::move(incompleteRequest->m_handler));
+                    Aws::Crt::Delete(incompleteRequest, m_allocator);
+                    if (m_metrics)
+                    {
+                        m_metrics->OnRequestCoalesced();
+                    }
+
+                    return AWS_OP_SUCCESS;
+                }
+
+                incompleteRequest->m_coalescer = m_coalescer;
+                int result = SubmitRequestInternal(requestOptions, incompleteRequest);
+                if (result == AWS_OP_SUCCESS)
+                {
+                    m_coalescer->Add(incompleteRequest);
+                }
+
+                return result;
+            }
+
+            int MqttRequestResponseClientImpl::SubmitRequestInternal(
+                const aws_mqtt_request_operation_options &requestOptions,
+                IncompleteRequest *incompleteRequest) noexcept
+            {
+                if (m_metrics)
+                {
+                    incompleteRequest->m_metrics = m_metrics;
+                    incompleteRequest->m_metricsRequestId = m_metrics->OnRequestSubmitted(requestOptions);
+                }
+
                 struct aws_mqtt_request_operation_options rawOptions = requestOptions;
                 rawOptions.completion_callback = s_onRequestComplete;
                 rawOptions.user_data = incompleteRequest;
@@ -409,6 +868,10 @@ namespace Aws
                 int result = aws_mqtt_request_response_client_submit_request(m_client, &rawOptions);
                 if (result != AWS_OP_SUCCESS)
                 {
+                    if (m_metrics)
+                    {
+                        m_metrics->OnRequestSubmitFailed(incompleteRequest->m_metricsRequestId);
+                    }
                     Aws::Crt::Delete(incompleteRequest, incompleteRequest->m_allocator);
                 }
 
@@ -418,7 +881,17 @@ namespace Aws
             std::shared_ptr<IStreamingOperation> MqttRequestResponseClientImpl::CreateStream(
                 const StreamingOperationOptionsInternal &options)
             {
-                return StreamingOperation::Create(m_allocator, options, m_client);
+                return StreamingOperation::Create(m_allocator, options, m_client, m_metrics);
+            }
+
+            RequestResponseClientMetrics MqttRequestResponseClientImpl::GetMetrics() const
+            {
+                if (!m_metrics)
+                {
+                    return RequestResponseClientMetrics();
+                }
+
+                return m_metrics->GetMetrics();
             }
 
             //////////////////////////////////////////////////////////
@@ -443,6 +916,8 @@ namespace Aws
                 std::shared_ptr<IStreamingOperation> CreateStream(
                     const StreamingOperationOptionsInternal &options) override;
 
+                RequestResponseClientMetrics GetMetrics() const override;
+
               private:
                 MqttRequestResponseClientImpl *m_impl;
             };
@@ -460,6 +935,11 @@ namespace Aws
                 return m_impl->CreateStream(options);
             }
 
+            RequestResponseClientMetrics MqttRequestResponseClient::GetMetrics() const
+            {
+                return m_impl->GetMetrics();
+            }
+
             MqttRequestResponseClient::MqttRequestResponseClient(MqttRequestResponseClientImpl *impl) : m_impl(impl) {}
 
             MqttRequestResponseClient::~MqttRequestResponseClient()
@@ -472,7 +952,7 @@ namespace Aws
                 const RequestResponseClientOptions &options,
                 Aws::Crt::Allocator *allocator)
             {
-                auto *clientImpl = Aws::Crt::New<MqttRequestResponseClientImpl>(allocator, allocator);
+                auto *clientImpl = Aws::Crt::New<MqttRequestResponseClientImpl>(allocator, allocator, options);
 
                 struct aws_mqtt_request_response_client_options rrClientOptions;
                 AWS_ZERO_STRUCT(rrClientOptions);
@@ -501,7 +981,7 @@ namespace Aws
                 const RequestResponseClientOptions &options,
                 Aws::Crt::Allocator *allocator)
             {
-                auto *clientImpl = Aws::Crt::New<MqttRequestResponseClientImpl>(allocator, allocator);
+                auto *clientImpl = Aws::Crt::New<MqttRequestResponseClientImpl>(allocator, allocator, options);
 
                 struct aws_mqtt_request_response_client_options rrClientOptions;
                 AWS_ZERO_STRUCT(rrClientOptions);
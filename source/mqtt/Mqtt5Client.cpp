@@ -176,6 +176,7 @@ namespace Aws
             const Mqtt5ClientOperationStatistics &Mqtt5Client::GetOperationStatistics() noexcept
             {
                 aws_mqtt5_client_operation_statistics m_operationStatisticsNative = {0, 0, 0, 0};
+                m_operationStatistics = Mqtt5ClientOperationStatistics();
                 if (m_client_core != nullptr)
                 {
                     aws_mqtt5_client_get_stats(m_client_core->m_client, &m_operationStatisticsNative);
@@ -185,6 +186,7 @@ namespace Aws
                         m_operationStatisticsNative.incomplete_operation_size;
                     m_operationStatistics.unackedOperationCount = m_operationStatisticsNative.unacked_operation_count;
                     m_operationStatistics.unackedOperationSize = m_operationStatisticsNative.unacked_operation_size;
+                    m_client_core->GetRttStatistics(m_operationStatistics);
                 }
                 return m_operationStatistics;
             }
@@ -208,7 +210,8 @@ namespace Aws
                   m_extendedValidationAndFlowControlOptions(AWS_MQTT5_EVAFCO_AWS_IOT_CORE_DEFAULTS),
                   m_offlineQueueBehavior(AWS_MQTT5_COQBT_DEFAULT),
                   m_reconnectionOptions({AWS_EXPONENTIAL_BACKOFF_JITTER_DEFAULT, 0, 0, 0}), m_pingTimeoutMs(0),
-                  m_connackTimeoutMs(0), m_ackTimeoutSec(0), m_enableMetrics(true), m_allocator(allocator)
+                  m_connackTimeoutMs(0), m_ackTimeoutSec(0), m_rttEstimationEnabled(false), m_enableMetrics(true),
+                  m_allocator(allocator)
             {
                 AWS_ZERO_STRUCT(m_metricsStorage);
                 m_socketOptions.SetSocketType(Io::SocketType::Stream);
@@ -399,6 +402,24 @@ namespace Aws
                 return *this;
             }
 
+            Mqtt5ClientOptions &Mqtt5ClientOptions::WithRttEstimationEnabled(bool enabled) noexcept
+            {
+                m_rttEstimationEnabled = enabled;
+                return *this;
+            }
+
+            Mqtt5ClientOptions &Mqtt5ClientOptions::WithTimeoutsFromRttEstimate(
+                const Mqtt5ClientOperationStatistics &statistics) noexcept
+            {
+                if (statistics.rttSampleCount > 0)
+                {
+                    m_ackTimeoutSec = statistics.derivedAckTimeoutSec;
+                    m_pingTimeoutMs = Mqtt5RttEstimator::s_clampPingTimeoutMs(
+                        statistics.derivedPingTimeoutMs, m_packetConnectViewStorage.keep_alive_interval_seconds);
+                }
+                return *this;
+            }
+
             Mqtt5ClientOptions &Mqtt5ClientOptions::WithWebsocketHandshakeTransformCallback(
                 OnWebSocketHandshakeIntercept callback) noexcept
             {
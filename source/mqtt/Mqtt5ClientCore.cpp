@@ -14,6 +14,9 @@
 #include <aws/crt/StlAllocator.h>
 #include <aws/crt/http/HttpRequestResponse.h>
 
+#include <aws/common/clock.h>
+#include <aws/common/math.h>
+
 #include <thread>
 
 namespace Aws
@@ -49,30 +52,162 @@ namespace Aws
 
             struct PubAckCallbackData : public std::enable_shared_from_this<PubAckCallbackData>
             {
-                PubAckCallbackData(Allocator *alloc = ApiAllocator()) : clientCore(nullptr), allocator(alloc) {}
+                PubAckCallbackData(Allocator *alloc = ApiAllocator())
+                    : clientCore(nullptr), allocator(alloc), submitTimestampNs(0), connectionId(0)
+                {
+                }
 
                 Mqtt5ClientCore *clientCore;
                 OnPublishCompletionHandler onPublishCompletion;
                 Allocator *allocator;
+                uint64_t submitTimestampNs;
+                uint64_t connectionId;
             };
 
             struct SubAckCallbackData
             {
-                SubAckCallbackData(Allocator *alloc = ApiAllocator()) : clientCore(nullptr), allocator(alloc) {}
+                SubAckCallbackData(Allocator *alloc = ApiAllocator())
+                    : clientCore(nullptr), allocator(alloc), submitTimestampNs(0), connectionId(0)
+                {
+                }
 
                 Mqtt5ClientCore *clientCore;
                 OnSubscribeCompletionHandler onSubscribeCompletion;
                 Allocator *allocator;
+                uint64_t submitTimestampNs;
+                uint64_t connectionId;
             };
 
             struct UnSubAckCallbackData
             {
-                UnSubAckCallbackData(Allocator *alloc = ApiAllocator()) : clientCore(nullptr), allocator(alloc) {}
+                UnSubAckCallbackData(Allocator *alloc = ApiAllocator())
+                    : clientCore(nullptr), allocator(alloc), submitTimestampNs(0), connectionId(0)
+                {
+                }
                 Mqtt5ClientCore *clientCore;
                 OnUnsubscribeCompletionHandler onUnsubscribeCompletion;
                 Allocator *allocator;
+                uint64_t submitTimestampNs;
+                uint64_t connectionId;
             };
 
+            /*
+             * RFC 6298 gains: SRTT moves 1/8 of the way towards each sample, RTTVAR 1/4 of the way towards each
+             * sample's deviation from SRTT.
+             */
+            static const uint64_t s_rttAlphaShift = 3;
+            static const uint64_t s_rttBetaShift = 2;
+
+            /* Neither derived timeout goes below one second, the granularity of the native ack timeout */
+            static const uint64_t s_minDerivedTimeoutMs = 1000;
+
+            Mqtt5RttEstimator::Mqtt5RttEstimator(uint16_t keepAliveIntervalSec) noexcept
+                : m_keepAliveIntervalSec(keepAliveIntervalSec), m_connectionId(0), m_connected(false),
+                  m_sampleCount(0), m_smoothedRttNs(0), m_rttVariationNs(0)
+            {
+            }
+
+            void Mqtt5RttEstimator::OnConnectionSuccess() noexcept
+            {
+                std::lock_guard<std::mutex> lock(m_lock);
+                ++m_connectionId;
+                m_connected = true;
+            }
+
+            void Mqtt5RttEstimator::OnDisconnection() noexcept
+            {
+                std::lock_guard<std::mutex> lock(m_lock);
+                m_connected = false;
+            }
+
+            uint64_t Mqtt5RttEstimator::GetConnectionId() const noexcept
+            {
+                std::lock_guard<std::mutex> lock(m_lock);
+                return m_connected ? m_connectionId : 0;
+            }
+
+            uint32_t Mqtt5RttEstimator::s_clampPingTimeoutMs(
+                uint32_t pingTimeoutMs,
+                uint16_t keepAliveIntervalSec) noexcept
+            {
+                uint32_t keepAliveMs = static_cast<uint32_t>(keepAliveIntervalSec) * 1000;
+                if (keepAliveMs > 0 && pingTimeoutMs >= keepAliveMs)
+                {
+                    return keepAliveMs - 1;
+                }
+
+                return pingTimeoutMs;
+            }
+
+            void Mqtt5RttEstimator::AddSample(uint64_t rttNs, uint64_t connectionId) noexcept
+            {
+                std::lock_guard<std::mutex> lock(m_lock);
+                if (!m_connected || connectionId != m_connectionId)
+                {
+                    return;
+                }
+
+                if (m_sampleCount == 0)
+                {
+                    m_smoothedRttNs = rttNs;
+                    m_rttVariationNs = rttNs / 2;
+                }
+                else
+                {
+                    uint64_t deviation = rttNs > m_smoothedRttNs ? rttNs - m_smoothedRttNs : m_smoothedRttNs - rttNs;
+                    m_rttVariationNs = m_rttVariationNs - (m_rttVariationNs >> s_rttBetaShift) +
+                                       (deviation >> s_rttBetaShift);
+                    m_smoothedRttNs =
+                        m_smoothedRttNs - (m_smoothedRttNs >> s_rttAlphaShift) + (rttNs >> s_rttAlphaShift);
+                }
+                ++m_sampleCount;
+            }
+
+            void Mqtt5RttEstimator::GetStatistics(Mqtt5ClientOperationStatistics &statistics) const noexcept
+            {
+                std::lock_guard<std::mutex> lock(m_lock);
+                statistics.rttSampleCount = m_sampleCount;
+                statistics.smoothedRttMs =
+                    aws_timestamp_convert(m_smoothedRttNs, AWS_TIMESTAMP_NANOS, AWS_TIMESTAMP_MILLIS, NULL);
+                statistics.rttVariationMs =
+                    aws_timestamp_convert(m_rttVariationNs, AWS_TIMESTAMP_NANOS, AWS_TIMESTAMP_MILLIS, NULL);
+                if (m_sampleCount == 0)
+                {
+                    statistics.derivedAckTimeoutSec = 0;
+                    statistics.derivedPingTimeoutMs = 0;
+                    return;
+                }
+
+                /* RTO = SRTT + 4 * RTTVAR */
+                uint64_t timeoutMs = aws_add_u64_saturating(
+                    statistics.smoothedRttMs, aws_mul_u64_saturating(statistics.rttVariationMs, 4));
+                if (timeoutMs < s_minDerivedTimeoutMs)
+                {
+                    timeoutMs = s_minDerivedTimeoutMs;
+                }
+                if (timeoutMs > UINT32_MAX)
+                {
+                    timeoutMs = UINT32_MAX;
+                }
+
+                statistics.derivedPingTimeoutMs =
+                    s_clampPingTimeoutMs(static_cast<uint32_t>(timeoutMs), m_keepAliveIntervalSec);
+                statistics.derivedAckTimeoutSec = static_cast<uint32_t>((timeoutMs + 999) / 1000);
+            }
+
+            static void s_recordRttSample(
+                Mqtt5ClientCore *clientCore,
+                uint64_t submitTimestampNs,
+                uint64_t connectionId)
+            {
+                uint64_t now = 0;
+                aws_high_res_clock_get_ticks(&now);
+                if (now > submitTimestampNs)
+                {
+                    clientCore->RecordRttSample(now - submitTimestampNs, connectionId);
+                }
+            }
+
             /**
              * Callable object stored in PublishReceivedEventData::acquirePublishAcknowledgement.
              *
@@ -163,6 +298,10 @@ namespace Aws
 
                     case AWS_MQTT5_CLET_CONNECTION_SUCCESS:
                         AWS_LOGF_INFO(AWS_LS_MQTT5_CLIENT, "Lifecycle event: Connection Success!");
+                        if (client_core->m_rttEstimator)
+                        {
+                            client_core->m_rttEstimator->OnConnectionSuccess();
+                        }
                         if (client_core->onConnectionSuccess != nullptr)
                         {
                             OnConnectionSuccessEventData eventData;
@@ -192,6 +331,10 @@ namespace Aws
                             "  Error Code: %d(%s)",
                             event->error_code,
                             aws_error_debug_str(event->error_code));
+                        if (client_core->m_rttEstimator)
+                        {
+                            client_core->m_rttEstimator->OnDisconnection();
+                        }
                         if (client_core->onDisconnection != nullptr)
                         {
                             OnDisconnectionEventData eventData;
@@ -331,6 +474,14 @@ namespace Aws
                 AWS_ASSERT(callbackData != nullptr);
                 AWS_ASSERT(callbackData->clientCore != nullptr);
 
+                /* QoS 0 publishes complete when written and carry no round-trip information */
+                if (callbackData->submitTimestampNs != 0 && error_code == AWS_ERROR_SUCCESS &&
+                    packet_type == AWS_MQTT5_PT_PUBACK)
+                {
+                    s_recordRttSample(
+                        callbackData->clientCore, callbackData->submitTimestampNs, callbackData->connectionId);
+                }
+
                 /* callback not set */
                 if (callbackData->onPublishCompletion == nullptr)
                 {
@@ -445,6 +596,12 @@ namespace Aws
                 AWS_ASSERT(callbackData != nullptr);
                 AWS_ASSERT(callbackData->clientCore != nullptr);
 
+                if (callbackData->submitTimestampNs != 0 && error_code == AWS_ERROR_SUCCESS && suback != nullptr)
+                {
+                    s_recordRttSample(
+                        callbackData->clientCore, callbackData->submitTimestampNs, callbackData->connectionId);
+                }
+
                 /* callback not set */
                 if (callbackData->onSubscribeCompletion == NULL)
                 {
@@ -495,6 +652,12 @@ namespace Aws
                 AWS_ASSERT(callbackData != nullptr);
                 AWS_ASSERT(callbackData->clientCore != nullptr);
 
+                if (callbackData->submitTimestampNs != 0 && error_code == AWS_ERROR_SUCCESS && unsuback != nullptr)
+                {
+                    s_recordRttSample(
+                        callbackData->clientCore, callbackData->submitTimestampNs, callbackData->connectionId);
+                }
+
                 /* callback not set */
                 if (callbackData->onUnsubscribeCompletion == NULL)
                 {
@@ -589,6 +752,14 @@ namespace Aws
                 clientOptions.client_termination_handler = &Mqtt5ClientCore::s_clientTerminationCompletion;
                 clientOptions.client_termination_handler_user_data = this;
 
+                if (options.m_rttEstimationEnabled)
+                {
+                    uint16_t keepAliveIntervalSec = clientOptions.connect_options->keep_alive_interval_seconds;
+                    m_rttEstimator = ScopedResource<Mqtt5RttEstimator>(
+                        Crt::New<Mqtt5RttEstimator>(allocator, keepAliveIntervalSec),
+                        [allocator](Mqtt5RttEstimator *estimator) { Crt::Delete(estimator, allocator); });
+                }
+
                 m_client = aws_mqtt5_client_new(allocator, &clientOptions);
 
                 m_mqtt5to3AdapterOptions = Mqtt5to3AdapterOptions::NewMqtt5to3AdapterOptions(options);
@@ -634,6 +805,43 @@ namespace Aws
                 return aws_last_error();
             }
 
+            uint64_t Mqtt5ClientCore::BeginRttSample() noexcept
+            {
+                if (!m_rttEstimator)
+                {
+                    return 0;
+                }
+
+                /*
+                 * Operations queued ahead of this one, or held back by flow control, are incomplete but not yet
+                 * unacked.  Their wait until written would be counted as round-trip time, so skip the sample.
+                 */
+                aws_mqtt5_client_operation_statistics statistics = {0, 0, 0, 0};
+                aws_mqtt5_client_get_stats(m_client, &statistics);
+                if (statistics.incomplete_operation_count > statistics.unacked_operation_count)
+                {
+                    return 0;
+                }
+
+                return m_rttEstimator->GetConnectionId();
+            }
+
+            void Mqtt5ClientCore::RecordRttSample(uint64_t rttNs, uint64_t connectionId) noexcept
+            {
+                if (m_rttEstimator)
+                {
+                    m_rttEstimator->AddSample(rttNs, connectionId);
+                }
+            }
+
+            void Mqtt5ClientCore::GetRttStatistics(Mqtt5ClientOperationStatistics &statistics) const noexcept
+            {
+                if (m_rttEstimator)
+                {
+                    m_rttEstimator->GetStatistics(statistics);
+                }
+            }
+
             bool Mqtt5ClientCore::Publish(
                 std::shared_ptr<PublishPacket> publishOptions,
                 OnPublishCompletionHandler onPublishCompletionCallback) noexcept
@@ -651,6 +859,11 @@ namespace Aws
                 pubCallbackData->clientCore = this;
                 pubCallbackData->allocator = m_allocator;
                 pubCallbackData->onPublishCompletion = onPublishCompletionCallback;
+                pubCallbackData->connectionId = BeginRttSample();
+                if (pubCallbackData->connectionId != 0)
+                {
+                    aws_high_res_clock_get_ticks(&pubCallbackData->submitTimestampNs);
+                }
 
                 aws_mqtt5_publish_completion_options options{};
 
@@ -685,6 +898,11 @@ namespace Aws
                 subCallbackData->clientCore = this;
                 subCallbackData->allocator = m_allocator;
                 subCallbackData->onSubscribeCompletion = onSubscribeCompletionCallback;
+                subCallbackData->connectionId = BeginRttSample();
+                if (subCallbackData->connectionId != 0)
+                {
+                    aws_high_res_clock_get_ticks(&subCallbackData->submitTimestampNs);
+                }
 
                 aws_mqtt5_subscribe_completion_options options{};
 
@@ -718,6 +936,11 @@ namespace Aws
                 unSubCallbackData->clientCore = this;
                 unSubCallbackData->allocator = m_allocator;
                 unSubCallbackData->onUnsubscribeCompletion = onUnsubscribeCompletionCallback;
+                unSubCallbackData->connectionId = BeginRttSample();
+                if (unSubCallbackData->connectionId != 0)
+                {
+                    aws_high_res_clock_get_ticks(&unSubCallbackData->submitTimestampNs);
+                }
 
                 aws_mqtt5_unsubscribe_completion_options options{};
 
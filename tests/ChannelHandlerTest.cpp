@@ -4,8 +4,14 @@
  */
 #include <aws/crt/Api.h>
 #include <aws/crt/io/ChannelHandler.h>
+#include <aws/crt/io/EventLoopGroup.h>
+#include <aws/io/channel.h>
 #include <aws/testing/aws_test_harness.h>
 
+#include <chrono>
+#include <functional>
+#include <future>
+#include <memory>
 #include <utility>
 
 class ChannelHandlerMock : public Aws::Crt::Io::ChannelHandler
@@ -104,3 +110,241 @@ static int s_TestChannelHandlerInterop(struct aws_allocator *allocator, void *)
 }
 
 AWS_TEST_CASE(ChannelHandlerInterop, s_TestChannelHandlerInterop)
+
+/* Handler for a real channel: releases what it receives and completes shutdown, and exposes the protected helpers */
+class ChannelHandlerSlotMock : public Aws::Crt::Io::ChannelHandler
+{
+  public:
+    ChannelHandlerSlotMock(Aws::Crt::Allocator *allocator, size_t initialWindowSize)
+        : Aws::Crt::Io::ChannelHandler(allocator), ReceivedReadMessages(0), m_initialWindowSize(initialWindowSize)
+    {
+    }
+
+    int ProcessReadMessage(struct aws_io_message *message) override
+    {
+        ++ReceivedReadMessages;
+        aws_mem_release(message->allocator, message);
+        return AWS_OP_SUCCESS;
+    }
+
+    int ProcessWriteMessage(struct aws_io_message *message) override
+    {
+        aws_mem_release(message->allocator, message);
+        return AWS_OP_SUCCESS;
+    }
+
+    int IncrementReadWindow(size_t) override { return AWS_OP_SUCCESS; }
+
+    void ProcessShutdown(Aws::Crt::Io::ChannelDirection dir, int errorCode, bool freeScarceResourcesImmediately)
+        override
+    {
+        OnShutdownComplete(dir, errorCode, freeScarceResourcesImmediately);
+    }
+
+    size_t InitialWindowSize() override { return m_initialWindowSize; }
+
+    size_t MessageOverhead() override { return 0; }
+
+    using Aws::Crt::Io::ChannelHandler::AcquireMessagesFromPool;
+    using Aws::Crt::Io::ChannelHandler::SendMessages;
+
+    /* Runs fn on the channel's thread and waits for it */
+    void RunOnChannelThread(const std::function<void()> &fn)
+    {
+        std::promise<void> ran;
+        ScheduleTask(
+            [&](Aws::Crt::Io::TaskStatus)
+            {
+                fn();
+                ran.set_value();
+            });
+        ran.get_future().wait();
+    }
+
+    size_t ReceivedReadMessages;
+
+  private:
+    size_t m_initialWindowSize;
+};
+
+/* A channel with two handlers: `first`, and `second` to its right with a read window of secondWindowSize */
+struct ChannelHandlerTestChannel
+{
+    ChannelHandlerTestChannel(Aws::Crt::Allocator *allocator, size_t secondWindowSize)
+        : first(Aws::Crt::MakeShared<ChannelHandlerSlotMock>(allocator, allocator, 1024)),
+          second(Aws::Crt::MakeShared<ChannelHandlerSlotMock>(allocator, allocator, secondWindowSize)),
+          channel(nullptr)
+    {
+    }
+
+    static void s_onSetupCompleted(struct aws_channel *channel, int errorCode, void *userData)
+    {
+        auto *testChannel = static_cast<ChannelHandlerTestChannel *>(userData);
+        if (errorCode == AWS_ERROR_SUCCESS)
+        {
+            struct aws_channel_slot *firstSlot = aws_channel_slot_new(channel);
+            aws_channel_slot_set_handler(firstSlot, testChannel->first->SeatForCInterop(testChannel->first));
+            struct aws_channel_slot *secondSlot = aws_channel_slot_new(channel);
+            aws_channel_slot_insert_right(firstSlot, secondSlot);
+            aws_channel_slot_set_handler(secondSlot, testChannel->second->SeatForCInterop(testChannel->second));
+        }
+        testChannel->setupResult.set_value(errorCode);
+    }
+
+    static void s_onShutdownCompleted(struct aws_channel *, int, void *userData)
+    {
+        static_cast<ChannelHandlerTestChannel *>(userData)->shutdownResult.set_value();
+    }
+
+    int Setup(Aws::Crt::Allocator *allocator, Aws::Crt::Io::EventLoopGroup &eventLoopGroup)
+    {
+        struct aws_channel_options options;
+        AWS_ZERO_STRUCT(options);
+        options.on_setup_completed = s_onSetupCompleted;
+        options.setup_user_data = this;
+        options.on_shutdown_completed = s_onShutdownCompleted;
+        options.shutdown_user_data = this;
+        options.event_loop = eventLoopGroup.GetLoopAt(0).GetUnderlyingHandle();
+
+        channel = aws_channel_new(allocator, &options);
+        ASSERT_NOT_NULL(channel);
+        ASSERT_INT_EQUALS(AWS_ERROR_SUCCESS, setupResult.get_future().get());
+        return AWS_OP_SUCCESS;
+    }
+
+    /* Shuts the channel down and destroys it, which destroys the handlers once nothing else refers to them */
+    void ShutdownAndDestroy()
+    {
+        aws_channel_shutdown(channel, AWS_ERROR_SUCCESS);
+        shutdownResult.get_future().wait();
+        first = nullptr;
+        second = nullptr;
+        aws_channel_destroy(channel);
+    }
+
+    std::shared_ptr<ChannelHandlerSlotMock> first;
+    std::shared_ptr<ChannelHandlerSlotMock> second;
+    struct aws_channel *channel;
+    std::promise<int> setupResult;
+    std::promise<void> shutdownResult;
+};
+
+/* once a few tasks have run, scheduling more reuses their wrappers instead of allocating */
+static int s_TestChannelHandlerTaskWrapperReuse(struct aws_allocator *allocator, void *)
+{
+    {
+        Aws::Crt::ApiHandle apiHandle(allocator);
+        struct aws_allocator *tracer = aws_mem_tracer_new(allocator, nullptr, AWS_MEMTRACE_BYTES, 0);
+        ASSERT_NOT_NULL(tracer);
+
+        /* The channel, and with it the handlers, are only certain to be gone once the loop has stopped */
+        {
+            Aws::Crt::Io::EventLoopGroup eventLoopGroup(1, allocator);
+            ASSERT_TRUE(eventLoopGroup);
+
+            ChannelHandlerTestChannel testChannel(tracer, 1024);
+            ASSERT_SUCCESS(testChannel.Setup(allocator, eventLoopGroup));
+
+            auto runTasks = [&](size_t count)
+            {
+                for (size_t i = 0; i < count; ++i)
+                {
+                    testChannel.first->RunOnChannelThread([]() {});
+                }
+            };
+
+            runTasks(4);
+            size_t warmAllocations = aws_mem_tracer_count(tracer);
+            runTasks(100);
+            ASSERT_UINT_EQUALS(warmAllocations, aws_mem_tracer_count(tracer));
+
+            testChannel.ShutdownAndDestroy();
+        }
+        ASSERT_UINT_EQUALS(0, aws_mem_tracer_count(tracer));
+        aws_mem_tracer_destroy(tracer);
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(ChannelHandlerTaskWrapperReuse, s_TestChannelHandlerTaskWrapperReuse)
+
+/* a task still pending at shutdown runs canceled, and its wrapper is freed along with the handler's pool */
+static int s_TestChannelHandlerTaskCanceledOnShutdown(struct aws_allocator *allocator, void *)
+{
+    {
+        Aws::Crt::ApiHandle apiHandle(allocator);
+        struct aws_allocator *tracer = aws_mem_tracer_new(allocator, nullptr, AWS_MEMTRACE_BYTES, 0);
+        ASSERT_NOT_NULL(tracer);
+
+        std::weak_ptr<ChannelHandlerSlotMock> handler;
+        {
+            Aws::Crt::Io::EventLoopGroup eventLoopGroup(1, allocator);
+            ASSERT_TRUE(eventLoopGroup);
+
+            ChannelHandlerTestChannel testChannel(tracer, 1024);
+            ASSERT_SUCCESS(testChannel.Setup(allocator, eventLoopGroup));
+
+            handler = testChannel.first;
+            std::promise<Aws::Crt::Io::TaskStatus> delayedStatus;
+            testChannel.first->ScheduleTask(
+                [&delayedStatus](Aws::Crt::Io::TaskStatus status) { delayedStatus.set_value(status); },
+                std::chrono::hours(1));
+
+            testChannel.ShutdownAndDestroy();
+            ASSERT_TRUE(Aws::Crt::Io::TaskStatus::Canceled == delayedStatus.get_future().get());
+        }
+        ASSERT_TRUE(handler.expired());
+        ASSERT_UINT_EQUALS(0, aws_mem_tracer_count(tracer));
+        aws_mem_tracer_destroy(tracer);
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(ChannelHandlerTaskCanceledOnShutdown, s_TestChannelHandlerTaskCanceledOnShutdown)
+
+/* messages acquired in a batch, and a batch send that stops at the first message the next handler can't take */
+static int s_TestChannelHandlerMessageBatches(struct aws_allocator *allocator, void *)
+{
+    {
+        Aws::Crt::ApiHandle apiHandle(allocator);
+        Aws::Crt::Io::EventLoopGroup eventLoopGroup(1, allocator);
+        ASSERT_TRUE(eventLoopGroup);
+
+        /* room for two of the 4-byte messages below, not three */
+        ChannelHandlerTestChannel testChannel(allocator, 10);
+        ASSERT_SUCCESS(testChannel.Setup(allocator, eventLoopGroup));
+
+        size_t acquired = 0;
+        bool sentAll = true;
+        Aws::Crt::Vector<struct aws_io_message *> messages;
+        testChannel.first->RunOnChannelThread(
+            [&]()
+            {
+                acquired = testChannel.first->AcquireMessagesFromPool(
+                    Aws::Crt::Io::MessageType::ApplicationData, 16, 3, messages);
+                for (struct aws_io_message *message : messages)
+                {
+                    aws_byte_buf_write_from_whole_cursor(&message->message_data, aws_byte_cursor_from_c_str("data"));
+                }
+
+                sentAll = testChannel.first->SendMessages(messages, Aws::Crt::Io::ChannelDirection::Read);
+            });
+
+        ASSERT_UINT_EQUALS(3, acquired);
+        ASSERT_FALSE(sentAll);
+        ASSERT_UINT_EQUALS(2, testChannel.second->ReceivedReadMessages);
+
+        /* the rejected message is left for the caller to release */
+        ASSERT_UINT_EQUALS(1, messages.size());
+        ASSERT_UINT_EQUALS(4, messages[0]->message_data.len);
+        aws_mem_release(messages[0]->allocator, messages[0]);
+
+        testChannel.ShutdownAndDestroy();
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(ChannelHandlerMessageBatches, s_TestChannelHandlerMessageBatches)
@@ -5,8 +5,17 @@
 #include <aws/crt/Api.h>
 #include <aws/testing/aws_test_harness.h>
 
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <thread>
 #include <utility>
 
+#if defined(__linux__)
+#    include <sched.h>
+#endif
+
 static int s_TestEventLoopResourceSafety(struct aws_allocator *allocator, void *ctx)
 {
     (void)ctx;
@@ -30,3 +39,224 @@ static int s_TestEventLoopResourceSafety(struct aws_allocator *allocator, void *
 }
 
 AWS_TEST_CASE(EventLoopResourceSafety, s_TestEventLoopResourceSafety)
+
+static int s_TestEventLoopGroupIntrospection(struct aws_allocator *allocator, void *ctx)
+{
+    (void)ctx;
+
+    {
+        Aws::Crt::ApiHandle handle;
+
+        Aws::Crt::Io::EventLoopGroup eventLoopGroup(2, allocator);
+        ASSERT_TRUE(eventLoopGroup);
+        ASSERT_UINT_EQUALS(2, eventLoopGroup.GetLoopCount());
+
+        Aws::Crt::Io::EventLoop first = eventLoopGroup.GetLoopAt(0);
+        Aws::Crt::Io::EventLoop second = eventLoopGroup.GetLoopAt(1);
+        ASSERT_TRUE(first);
+        ASSERT_TRUE(second);
+        ASSERT_TRUE(first.GetUnderlyingHandle() != second.GetUnderlyingHandle());
+        ASSERT_FALSE(first.IsCallersThread());
+        ASSERT_FALSE(eventLoopGroup.GetLoopAt(2));
+
+        Aws::Crt::Io::EventLoop next = eventLoopGroup.GetNextLoop();
+        ASSERT_TRUE(next);
+        ASSERT_TRUE(
+            next.GetUnderlyingHandle() == first.GetUnderlyingHandle() ||
+            next.GetUnderlyingHandle() == second.GetUnderlyingHandle());
+
+        /* A zero interval is rejected without enabling probes */
+        ASSERT_FALSE(eventLoopGroup.EnableSchedulerLagProbes(0));
+        ASSERT_INT_EQUALS(AWS_ERROR_INVALID_ARGUMENT, aws_last_error());
+
+        ASSERT_TRUE(eventLoopGroup.EnableSchedulerLagProbes(1));
+        ASSERT_FALSE(eventLoopGroup.EnableSchedulerLagProbes(1));
+        ASSERT_INT_EQUALS(AWS_ERROR_INVALID_STATE, aws_last_error());
+
+        /* Wait until every loop has run a few probes */
+        bool probed = false;
+        for (int attempt = 0; attempt < 500 && !probed; ++attempt)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            probed = true;
+            for (const auto &statistics : eventLoopGroup.GetStatistics())
+            {
+                probed = probed && statistics.SchedulerLag.GetSampleCount() >= 3;
+            }
+        }
+        ASSERT_TRUE(probed);
+
+        auto statistics = eventLoopGroup.GetStatistics();
+        ASSERT_UINT_EQUALS(2, statistics.size());
+        ASSERT_UINT_EQUALS(0, statistics[0].LoopIndex);
+        ASSERT_UINT_EQUALS(1, statistics[1].LoopIndex);
+        ASSERT_UINT_EQUALS(1, second.GetStatistics().LoopIndex);
+    }
+
+    return AWS_ERROR_SUCCESS;
+}
+
+AWS_TEST_CASE(EventLoopGroupIntrospection, s_TestEventLoopGroupIntrospection)
+
+static int s_TestEventLoopGroupPerLoopOptions(struct aws_allocator *allocator, void *ctx)
+{
+    (void)ctx;
+
+    {
+        Aws::Crt::ApiHandle handle;
+
+        Aws::Crt::Io::EventLoopGroupOptions options;
+        options.Loops.resize(2);
+        options.Loops[1].LoopAllocator = aws_default_allocator();
+#if defined(__linux__)
+        cpu_set_t allowed;
+        CPU_ZERO(&allowed);
+        ASSERT_SUCCESS(sched_getaffinity(0, sizeof(allowed), &allowed));
+        for (uint16_t cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+        {
+            if (CPU_ISSET(cpu, &allowed))
+            {
+                options.Loops[0].CpuSet.push_back(cpu);
+                break;
+            }
+        }
+#endif
+
+        Aws::Crt::Io::EventLoopGroup eventLoopGroup(options, allocator);
+        ASSERT_TRUE(eventLoopGroup);
+        ASSERT_UINT_EQUALS(2, eventLoopGroup.GetLoopCount());
+        ASSERT_PTR_EQUALS(allocator, eventLoopGroup.GetLoopAt(0).GetAllocator());
+        ASSERT_PTR_EQUALS(aws_default_allocator(), eventLoopGroup.GetLoopAt(1).GetAllocator());
+
+#if defined(__linux__)
+        /* The pinned loop's thread runs on exactly its cpu, the other keeps the affinity it was created with */
+        for (size_t loopIndex = 0; loopIndex < 2; ++loopIndex)
+        {
+            std::promise<cpu_set_t> affinityPromise;
+            ASSERT_TRUE(eventLoopGroup.GetLoopAt(loopIndex).Schedule(
+                [&affinityPromise](Aws::Crt::Io::TaskStatus)
+                {
+                    cpu_set_t affinity;
+                    CPU_ZERO(&affinity);
+                    sched_getaffinity(0, sizeof(affinity), &affinity);
+                    affinityPromise.set_value(affinity);
+                }));
+            cpu_set_t affinity = affinityPromise.get_future().get();
+
+            if (loopIndex == 0)
+            {
+                cpu_set_t expected;
+                CPU_ZERO(&expected);
+                CPU_SET(options.Loops[0].CpuSet[0], &expected);
+                ASSERT_TRUE(CPU_EQUAL(&expected, &affinity));
+            }
+            else
+            {
+                ASSERT_TRUE(CPU_EQUAL(&allowed, &affinity));
+            }
+        }
+#endif
+
+        /* Loop count disagreeing with the per-loop settings */
+        options.ThreadCount = 3;
+        Aws::Crt::Io::EventLoopGroup mismatched(options, allocator);
+        ASSERT_FALSE(mismatched);
+        ASSERT_INT_EQUALS(AWS_ERROR_INVALID_ARGUMENT, mismatched.LastError());
+
+#if defined(__linux__)
+        /* A cpu the thread isn't allowed on leaves nothing to run on */
+        for (uint16_t cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+        {
+            if (!CPU_ISSET(cpu, &allowed))
+            {
+                options.ThreadCount = 0;
+                options.Loops[1].CpuSet.push_back(cpu);
+                Aws::Crt::Io::EventLoopGroup disjoint(options, allocator);
+                ASSERT_FALSE(disjoint);
+                ASSERT_INT_EQUALS(AWS_ERROR_INVALID_ARGUMENT, disjoint.LastError());
+                options.Loops[1].CpuSet.clear();
+                break;
+            }
+        }
+#endif
+
+        /* A cpu that can't exist */
+        options.ThreadCount = 0;
+        options.Loops[1].CpuSet.push_back(UINT16_MAX);
+        Aws::Crt::Io::EventLoopGroup unpinnable(options, allocator);
+        ASSERT_FALSE(unpinnable);
+        ASSERT_NULL(unpinnable.GetUnderlyingHandle());
+        ASSERT_UINT_EQUALS(0, unpinnable.GetLoopCount());
+#if defined(__linux__)
+        ASSERT_INT_EQUALS(AWS_ERROR_INVALID_ARGUMENT, unpinnable.LastError());
+#else
+        ASSERT_INT_EQUALS(AWS_ERROR_PLATFORM_NOT_SUPPORTED, unpinnable.LastError());
+#endif
+    }
+
+    return AWS_ERROR_SUCCESS;
+}
+
+AWS_TEST_CASE(EventLoopGroupPerLoopOptions, s_TestEventLoopGroupPerLoopOptions)
+
+static int s_TestEventLoopSchedule(struct aws_allocator *allocator, void *ctx)
+{
+    (void)ctx;
+
+    {
+        Aws::Crt::ApiHandle handle;
+
+        Aws::Crt::Io::EventLoopGroup eventLoopGroup(1, allocator);
+        ASSERT_TRUE(eventLoopGroup);
+        Aws::Crt::Io::EventLoop eventLoop = eventLoopGroup.GetLoopAt(0);
+
+        std::mutex lock;
+        std::condition_variable signal;
+        size_t ranOnLoop = 0;
+        auto onRun = [&](Aws::Crt::Io::TaskStatus status)
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            if (status == Aws::Crt::Io::TaskStatus::RunReady && eventLoop.IsCallersThread())
+            {
+                ++ranOnLoop;
+            }
+            signal.notify_one();
+        };
+
+        /* Small callables are stored inline; one too large for a task node is allocated separately */
+        struct LargeTask
+        {
+            uint8_t padding[2 * Aws::Crt::Io::EventLoopTaskNode::INLINE_CAPACITY];
+            std::function<void(Aws::Crt::Io::TaskStatus)> onRun;
+            void operator()(Aws::Crt::Io::TaskStatus status) { onRun(status); }
+        };
+        LargeTask largeTask;
+        largeTask.onRun = onRun;
+
+        const size_t taskCount = 100;
+        for (size_t i = 0; i < taskCount; ++i)
+        {
+            ASSERT_TRUE(eventLoop.Schedule(onRun));
+        }
+        ASSERT_TRUE(eventLoop.Schedule(largeTask));
+        ASSERT_TRUE(eventLoop.ScheduleAt(onRun, eventLoop.GetCurrentClockTimeNs() + 1000000));
+
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            ASSERT_TRUE(signal.wait_for(
+                guard, std::chrono::seconds(10), [&]() { return ranOnLoop == taskCount + 2; }));
+        }
+
+        auto statistics = eventLoop.GetStatistics();
+        ASSERT_UINT_EQUALS(taskCount + 2, statistics.ScheduledTaskCount);
+
+        /* An empty handle can't schedule */
+        Aws::Crt::Io::EventLoop empty;
+        ASSERT_FALSE(empty.Schedule(onRun));
+        ASSERT_INT_EQUALS(AWS_ERROR_INVALID_STATE, aws_last_error());
+    }
+
+    return AWS_ERROR_SUCCESS;
+}
+
+AWS_TEST_CASE(EventLoopSchedule, s_TestEventLoopSchedule)
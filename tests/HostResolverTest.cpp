@@ -2,13 +2,19 @@
  * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
  * SPDX-License-Identifier: Apache-2.0.
  */
+#include "LocalHttpServer.h"
 #include <aws/crt/Api.h>
 #include <aws/crt/Types.h>
+#include <aws/crt/http/HttpConnection.h>
+#include <aws/crt/io/Bootstrap.h>
 #include <aws/crt/io/HostResolver.h>
 #include <aws/testing/aws_test_harness.h>
 
+#include <chrono>
 #include <condition_variable>
+#include <memory>
 #include <mutex>
+#include <thread>
 
 static int s_TestDefaultResolution(struct aws_allocator *allocator, void *)
 {
@@ -52,3 +58,261 @@ static int s_TestDefaultResolution(struct aws_allocator *allocator, void *)
 }
 
 AWS_TEST_CASE(DefaultResolution, s_TestDefaultResolution)
+
+static int s_TestDefaultResolutionStatistics(struct aws_allocator *allocator, void *)
+{
+    {
+        Aws::Crt::ApiHandle apiHandle(allocator);
+
+        Aws::Crt::Io::EventLoopGroup eventLoopGroup(0, allocator);
+        ASSERT_TRUE(eventLoopGroup);
+
+        Aws::Crt::Io::DefaultHostResolverOptions options;
+        options.MaxHosts = 8;
+        options.MaxTTL = 5;
+        options.KeepWarmWindowMs = 60000;
+        Aws::Crt::Io::DefaultHostResolver defaultHostResolver(eventLoopGroup, options, allocator);
+        ASSERT_TRUE(defaultHostResolver);
+
+        std::condition_variable semaphore;
+        std::mutex semaphoreLock;
+        size_t resolvedCount = 0;
+        int error = 0;
+
+        auto onHostResolved = [&](Aws::Crt::Io::HostResolver &,
+                                  const Aws::Crt::Vector<Aws::Crt::Io::HostAddress> &,
+                                  int errorCode)
+        {
+            std::lock_guard<std::mutex> lock(semaphoreLock);
+            ++resolvedCount;
+            error = errorCode;
+            semaphore.notify_one();
+        };
+
+        /* The first resolution has to wait; the second is answered from the cache */
+        for (size_t i = 1; i <= 2; ++i)
+        {
+            ASSERT_TRUE(defaultHostResolver.ResolveHost("localhost", onHostResolved));
+            std::unique_lock<std::mutex> lock(semaphoreLock);
+            semaphore.wait(lock, [&]() { return resolvedCount == i; });
+            ASSERT_SUCCESS(error);
+        }
+
+        auto statistics = defaultHostResolver.GetHostStatistics();
+        ASSERT_UINT_EQUALS(1, statistics.size());
+        const Aws::Crt::Io::HostResolutionStatistics &localhost = statistics["localhost"];
+        ASSERT_UINT_EQUALS(2, localhost.RequestCount);
+        ASSERT_UINT_EQUALS(1, localhost.CacheMissCount);
+        ASSERT_UINT_EQUALS(1, localhost.CacheHitCount);
+        ASSERT_UINT_EQUALS(0, localhost.FailureCount);
+        ASSERT_UINT_EQUALS(2, localhost.ResolveLatency.GetSampleCount());
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(DefaultResolutionStatistics, s_TestDefaultResolutionStatistics)
+
+static int s_TestDefaultResolutionKeepWarm(struct aws_allocator *allocator, void *)
+{
+    {
+        Aws::Crt::ApiHandle apiHandle(allocator);
+
+        Aws::Crt::Io::EventLoopGroup eventLoopGroup(0, allocator);
+        ASSERT_TRUE(eventLoopGroup);
+
+        /* A 1 second ttl makes the keep-warm pass run every second */
+        Aws::Crt::Io::DefaultHostResolverOptions options;
+        options.MaxHosts = 8;
+        options.MaxTTL = 1;
+        options.KeepWarmWindowMs = 60000;
+        Aws::Crt::Io::DefaultHostResolver defaultHostResolver(eventLoopGroup, options, allocator);
+        ASSERT_TRUE(defaultHostResolver);
+
+        std::condition_variable semaphore;
+        std::mutex semaphoreLock;
+        bool resolved = false;
+        int error = 0;
+
+        ASSERT_TRUE(defaultHostResolver.ResolveHost(
+            "localhost",
+            [&](Aws::Crt::Io::HostResolver &, const Aws::Crt::Vector<Aws::Crt::Io::HostAddress> &, int errorCode)
+            {
+                std::lock_guard<std::mutex> lock(semaphoreLock);
+                resolved = true;
+                error = errorCode;
+                semaphore.notify_one();
+            }));
+        {
+            std::unique_lock<std::mutex> lock(semaphoreLock);
+            semaphore.wait(lock, [&]() { return resolved; });
+            ASSERT_SUCCESS(error);
+        }
+
+        /* The recently requested host is re-resolved in the background without further requests */
+        uint64_t keepWarmCount = 0;
+        for (int attempt = 0; attempt < 100 && keepWarmCount < 2; ++attempt)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            keepWarmCount = defaultHostResolver.GetHostStatistics()["localhost"].KeepWarmCount;
+        }
+        ASSERT_TRUE(keepWarmCount >= 2);
+
+        auto statistics = defaultHostResolver.GetHostStatistics();
+        ASSERT_UINT_EQUALS(1, statistics["localhost"].RequestCount);
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(DefaultResolutionKeepWarm, s_TestDefaultResolutionKeepWarm)
+
+static void s_onStaticHostResolved(
+    struct aws_host_resolver *,
+    const struct aws_string *,
+    int errorCode,
+    const struct aws_array_list *hostAddresses,
+    void *userData)
+{
+    size_t *addressCount = static_cast<size_t *>(userData);
+    *addressCount = errorCode == AWS_ERROR_SUCCESS ? aws_array_list_length(hostAddresses) : 0;
+}
+
+static int s_TestStaticResolution(struct aws_allocator *allocator, void *)
+{
+    {
+        Aws::Crt::ApiHandle apiHandle(allocator);
+
+        Aws::Crt::Io::StaticHostResolver staticHostResolver(allocator);
+        ASSERT_TRUE(staticHostResolver);
+        ASSERT_NOT_NULL(staticHostResolver.GetUnderlyingHandle());
+
+        ASSERT_TRUE(staticHostResolver.AddAddress("example.com", "192.0.2.1"));
+        ASSERT_TRUE(staticHostResolver.AddAddress("Example.COM", "2001:db8::1"));
+        ASSERT_FALSE(staticHostResolver.AddAddress("example.com", "not-an-address"));
+        ASSERT_INT_EQUALS(AWS_ERROR_INVALID_ARGUMENT, aws_last_error());
+
+        /* Answers are synchronous */
+        Aws::Crt::Vector<aws_address_record_type> recordTypes;
+        int error = AWS_OP_ERR;
+        auto onHostResolved = [&](Aws::Crt::Io::HostResolver &,
+                                  const Aws::Crt::Vector<Aws::Crt::Io::HostAddress> &addresses,
+                                  int errorCode)
+        {
+            error = errorCode;
+            recordTypes.clear();
+            for (const auto &address : addresses)
+            {
+                recordTypes.push_back(address.record_type);
+            }
+        };
+
+        ASSERT_TRUE(staticHostResolver.ResolveHost("EXAMPLE.com", onHostResolved));
+        ASSERT_SUCCESS(error);
+        ASSERT_UINT_EQUALS(2, recordTypes.size());
+        ASSERT_INT_EQUALS(AWS_ADDRESS_RECORD_TYPE_A, recordTypes[0]);
+        ASSERT_INT_EQUALS(AWS_ADDRESS_RECORD_TYPE_AAAA, recordTypes[1]);
+
+        ASSERT_TRUE(staticHostResolver.ResolveHost("unknown.example.com", onHostResolved));
+        ASSERT_INT_EQUALS(AWS_IO_DNS_NO_ADDRESS_FOR_HOST, error);
+
+        /* Native users, such as ClientBootstrap, resolve through the underlying handle */
+        struct aws_string *host = aws_string_new_from_c_str(allocator, "example.com");
+        size_t addressCount = 0;
+        ASSERT_SUCCESS(aws_host_resolver_resolve_host(
+            staticHostResolver.GetUnderlyingHandle(),
+            host,
+            s_onStaticHostResolved,
+            staticHostResolver.GetConfig(),
+            &addressCount));
+        ASSERT_UINT_EQUALS(2, addressCount);
+
+        /* ...and count addresses through it too */
+        ASSERT_TRUE(staticHostResolver.AddAddress("example.com", "2001:db8::2"));
+        struct aws_host_resolver *nativeResolver = staticHostResolver.GetUnderlyingHandle();
+        const uint32_t countA = AWS_GET_HOST_ADDRESS_COUNT_RECORD_TYPE_A;
+        const uint32_t countAAAA = AWS_GET_HOST_ADDRESS_COUNT_RECORD_TYPE_AAAA;
+        ASSERT_UINT_EQUALS(1, aws_host_resolver_get_host_address_count(nativeResolver, host, countA));
+        ASSERT_UINT_EQUALS(2, aws_host_resolver_get_host_address_count(nativeResolver, host, countAAAA));
+        ASSERT_UINT_EQUALS(3, aws_host_resolver_get_host_address_count(nativeResolver, host, countA | countAAAA));
+        ASSERT_UINT_EQUALS(3, staticHostResolver.GetHostAddressCount("EXAMPLE.COM", countA | countAAAA));
+        ASSERT_UINT_EQUALS(0, staticHostResolver.GetHostAddressCount("unknown.example.com", countA));
+        aws_string_destroy(host);
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(StaticResolution, s_TestStaticResolution)
+
+/*
+ * Connects through a ClientBootstrap whose resolver is a StaticHostResolver.  The bootstrap keeps the native resolver
+ * alive after the StaticHostResolver is destroyed; connecting then must fail cleanly rather than call into it.
+ */
+static int s_TestStaticResolutionThroughBootstrap(struct aws_allocator *allocator, void *)
+{
+    {
+        Aws::Crt::ApiHandle apiHandle(allocator);
+
+        Aws::Crt::Io::EventLoopGroup eventLoopGroup(1, allocator);
+        ASSERT_TRUE(eventLoopGroup);
+
+        auto staticHostResolver = Aws::Crt::MakeShared<Aws::Crt::Io::StaticHostResolver>(allocator, allocator);
+        ASSERT_TRUE(*staticHostResolver);
+        ASSERT_TRUE(staticHostResolver->AddAddress("static.test", "127.0.0.1"));
+
+        Aws::Crt::Io::ClientBootstrap clientBootstrap(eventLoopGroup, *staticHostResolver, allocator);
+        ASSERT_TRUE(clientBootstrap);
+        clientBootstrap.EnableBlockingShutdown();
+
+        LocalHttpServer server(allocator, eventLoopGroup);
+        ASSERT_TRUE(server.Start());
+
+        std::mutex lock;
+        std::condition_variable signal;
+        std::shared_ptr<Aws::Crt::Http::HttpClientConnection> connection;
+        int setupErrorCode = AWS_ERROR_SUCCESS;
+        bool setupDone = false;
+
+        Aws::Crt::Http::HttpClientConnectionOptions connectionOptions;
+        connectionOptions.Bootstrap = &clientBootstrap;
+        connectionOptions.HostName = "static.test";
+        connectionOptions.Port = server.GetPort();
+        connectionOptions.OnConnectionSetupCallback =
+            [&](const std::shared_ptr<Aws::Crt::Http::HttpClientConnection> &newConnection, int errorCode)
+        {
+            std::lock_guard<std::mutex> lockGuard(lock);
+            connection = newConnection;
+            setupErrorCode = errorCode;
+            setupDone = true;
+            signal.notify_one();
+        };
+        connectionOptions.OnConnectionShutdownCallback = [](Aws::Crt::Http::HttpClientConnection &, int) {};
+
+        {
+            std::unique_lock<std::mutex> uniqueLock(lock);
+            ASSERT_TRUE(Aws::Crt::Http::HttpClientConnection::CreateConnection(connectionOptions, allocator));
+            signal.wait(uniqueLock, [&]() { return setupDone; });
+            ASSERT_SUCCESS(setupErrorCode);
+            ASSERT_TRUE(connection);
+            connection->Close();
+            connection.reset();
+            setupDone = false;
+        }
+
+        staticHostResolver.reset();
+
+        /* Resolution may fail synchronously or through the setup callback */
+        std::unique_lock<std::mutex> uniqueLock(lock);
+        if (Aws::Crt::Http::HttpClientConnection::CreateConnection(connectionOptions, allocator))
+        {
+            signal.wait(uniqueLock, [&]() { return setupDone; });
+            ASSERT_FALSE(setupErrorCode == AWS_ERROR_SUCCESS);
+            ASSERT_FALSE(connection);
+        }
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(StaticResolutionThroughBootstrap, s_TestStaticResolutionThroughBootstrap)
@@ -0,0 +1,147 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/crt/Api.h>
+#include <aws/crt/http/Http2StreamManager.h>
+#include <aws/crt/http/HttpRequestResponse.h>
+#include <aws/crt/io/Uri.h>
+
+#include <aws/testing/aws_test_harness.h>
+#if defined(_WIN32)
+// aws_test_harness.h includes Windows.h, which is an abomination.
+// undef macros with clashing names...
+#    undef InitiateShutdown
+#endif
+
+#include <condition_variable>
+#include <mutex>
+
+using namespace Aws::Crt;
+
+#if !BYO_CRYPTO
+
+/* multiplex a batch of GETs over at most two h2 connections and make sure every one completes with a 200 */
+static int s_TestHttp2StreamManagerMultiplexedGets(struct aws_allocator *allocator, void *ctx)
+{
+    (void)ctx;
+    {
+        Aws::Crt::ApiHandle apiHandle(allocator);
+
+        Aws::Crt::Io::TlsContextOptions tlsCtxOptions = Aws::Crt::Io::TlsContextOptions::InitDefaultClient();
+        Aws::Crt::Io::TlsContext tlsContext(tlsCtxOptions, Aws::Crt::Io::TlsMode::CLIENT, allocator);
+        ASSERT_TRUE(tlsContext);
+
+        ByteCursor cursor = ByteCursorFromCString("https://d1cz66xoahf9cl.cloudfront.net/http_test_doc.txt");
+        Io::Uri uri(cursor, allocator);
+        auto hostName = uri.GetHostName();
+
+        Aws::Crt::Io::TlsConnectionOptions tlsConnectionOptions = tlsContext.NewConnectionOptions();
+        tlsConnectionOptions.SetServerName(hostName);
+        tlsConnectionOptions.SetAlpnList("h2");
+
+        Aws::Crt::Io::SocketOptions socketOptions;
+        socketOptions.SetConnectTimeoutMs(10000);
+
+        Aws::Crt::Io::EventLoopGroup eventLoopGroup(1, allocator);
+        ASSERT_TRUE(eventLoopGroup);
+
+        Aws::Crt::Io::DefaultHostResolver defaultHostResolver(eventLoopGroup, 8, 30, allocator);
+        ASSERT_TRUE(defaultHostResolver);
+
+        Aws::Crt::Io::ClientBootstrap clientBootstrap(eventLoopGroup, defaultHostResolver, allocator);
+        ASSERT_TRUE(clientBootstrap);
+        clientBootstrap.EnableBlockingShutdown();
+
+        Http::Http2StreamManagerOptions streamManagerOptions;
+        streamManagerOptions.ConnectionOptions.Bootstrap = &clientBootstrap;
+        streamManagerOptions.ConnectionOptions.SocketOptions = socketOptions;
+        streamManagerOptions.ConnectionOptions.TlsOptions = tlsConnectionOptions;
+        streamManagerOptions.ConnectionOptions.HostName = String((const char *)hostName.ptr, hostName.len);
+        streamManagerOptions.ConnectionOptions.Port = 443;
+        streamManagerOptions.MaxConnections = 2;
+        streamManagerOptions.IdealConcurrentStreamsPerConnection = 5;
+        streamManagerOptions.MaxConcurrentStreamsPerConnection = 10;
+        streamManagerOptions.EnableBlockingShutdown = true;
+
+        auto streamManager = Http::Http2StreamManager::NewStreamManager(streamManagerOptions, allocator);
+        ASSERT_TRUE(streamManager);
+
+        Http::HttpRequest request(allocator);
+        request.SetMethod(ByteCursorFromCString("GET"));
+        request.SetPath(uri.GetPathAndQuery());
+        Http::HttpHeader hostHeader;
+        hostHeader.name = ByteCursorFromCString("host");
+        hostHeader.value = hostName;
+        request.AddHeader(hostHeader);
+
+        std::condition_variable semaphore;
+        std::mutex semaphoreLock;
+        const size_t totalStreams = 20;
+        size_t streamsCompleted = 0;
+        size_t streamsFailed = 0;
+        size_t successfulResponses = 0;
+        size_t http2Streams = 0;
+        Vector<std::shared_ptr<Http::HttpClientStream>> streams;
+
+        Http::HttpRequestOptions requestOptions;
+        requestOptions.request = &request;
+        requestOptions.onIncomingHeaders =
+            [](Http::HttpStream &, enum aws_http_header_block, const Http::HttpHeader *, std::size_t) {};
+        requestOptions.onStreamComplete = [&](Http::HttpStream &stream, int errorCode)
+        {
+            {
+                std::lock_guard<std::mutex> lockGuard(semaphoreLock);
+                if (!errorCode && stream.GetResponseStatusCode() == 200)
+                {
+                    ++successfulResponses;
+                }
+                ++streamsCompleted;
+            }
+            semaphore.notify_one();
+        };
+
+        auto onStreamAcquired = [&](std::shared_ptr<Http::HttpClientStream> stream, int errorCode)
+        {
+            {
+                std::lock_guard<std::mutex> lockGuard(semaphoreLock);
+                if (errorCode)
+                {
+                    ++streamsFailed;
+                }
+                else
+                {
+                    if (stream->GetConnection().GetVersion() == Http::HttpVersion::Http2)
+                    {
+                        ++http2Streams;
+                    }
+                    streams.push_back(std::move(stream));
+                }
+            }
+            semaphore.notify_one();
+        };
+
+        for (size_t i = 0; i < totalStreams; ++i)
+        {
+            ASSERT_TRUE(streamManager->AcquireStream(requestOptions, onStreamAcquired));
+        }
+
+        {
+            std::unique_lock<std::mutex> uniqueLock(semaphoreLock);
+            semaphore.wait(uniqueLock, [&]() { return streamsCompleted + streamsFailed == totalStreams; });
+            ASSERT_UINT_EQUALS(0, streamsFailed);
+            ASSERT_UINT_EQUALS(totalStreams, successfulResponses);
+            ASSERT_UINT_EQUALS(totalStreams, http2Streams);
+        }
+
+        streams.clear();
+        streamManager->InitiateShutdown().get();
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(Http2StreamManagerMultiplexedGets, s_TestHttp2StreamManagerMultiplexedGets)
+
+#endif // !BYO_CRYPTO
@@ -3,13 +3,17 @@
  * SPDX-License-Identifier: Apache-2.0.
  */
 
+#include <aws/common/clock.h>
 #include <aws/common/environment.h>
+#include <aws/common/thread.h>
 
 #include <aws/crt/Api.h>
 #include <aws/crt/crypto/Hash.h>
 #include <aws/crt/http/HttpConnectionManager.h>
 #include <aws/crt/io/Uri.h>
 
+#include "LocalHttpServer.h"
+
 #include <aws/testing/aws_test_harness.h>
 #if defined(_WIN32)
 // aws_test_harness.h includes Windows.h, which is an abomination.
@@ -18,6 +22,7 @@
 #endif
 
 #include <condition_variable>
+#include <future>
 #include <mutex>
 
 using namespace Aws::Crt;
@@ -447,4 +452,510 @@ AWS_TEST_CASE(
     HttpClientConnectionWithPendingAcquisitionsAndClosedConnections,
     s_TestHttpClientConnectionWithPendingAcquisitionsAndClosedConnections)
 
+/* hold the only connection, overflow the pending queue, and make sure the overflow fails fast and shows in metrics. */
+static int s_TestHttpClientConnectionManagerMaxPendingAcquisitionsAndMetrics(struct aws_allocator *allocator, void *ctx)
+{
+    (void)ctx;
+    {
+        Aws::Crt::ApiHandle apiHandle(allocator);
+
+        Aws::Crt::Io::TlsContextOptions tlsCtxOptions = Aws::Crt::Io::TlsContextOptions::InitDefaultClient();
+
+        Aws::Crt::Io::TlsContext tlsContext(tlsCtxOptions, Aws::Crt::Io::TlsMode::CLIENT, allocator);
+        ASSERT_TRUE(tlsContext);
+
+        Aws::Crt::Io::TlsConnectionOptions tlsConnectionOptions = tlsContext.NewConnectionOptions();
+
+        ByteCursor cursor = ByteCursorFromCString("https://s3.amazonaws.com");
+        Io::Uri uri(cursor, allocator);
+
+        auto hostName = uri.GetHostName();
+        tlsConnectionOptions.SetServerName(hostName);
+
+        Aws::Crt::Io::SocketOptions socketOptions;
+        socketOptions.SetConnectTimeoutMs(10000);
+
+        Aws::Crt::Io::EventLoopGroup eventLoopGroup(1, allocator);
+        ASSERT_TRUE(eventLoopGroup);
+
+        Aws::Crt::Io::DefaultHostResolver defaultHostResolver(eventLoopGroup, 8, 30, allocator);
+        ASSERT_TRUE(defaultHostResolver);
+
+        Io::ClientBootstrap clientBootstrap(eventLoopGroup, defaultHostResolver, allocator);
+        ASSERT_TRUE(clientBootstrap);
+        clientBootstrap.EnableBlockingShutdown();
+
+        std::condition_variable semaphore;
+        std::mutex semaphoreLock;
+        Vector<std::shared_ptr<Http::HttpClientConnection>> connections;
+        size_t connectionsFailed = 0;
+        size_t pendingLimitFailures = 0;
+
+        Http::HttpClientConnectionOptions connectionOptions;
+        connectionOptions.Bootstrap = &clientBootstrap;
+        connectionOptions.SocketOptions = socketOptions;
+        connectionOptions.TlsOptions = tlsConnectionOptions;
+        connectionOptions.HostName = String((const char *)hostName.ptr, hostName.len);
+        connectionOptions.Port = 443;
+
+        Http::HttpClientConnectionManagerOptions connectionManagerOptions;
+        connectionManagerOptions.ConnectionOptions = connectionOptions;
+        connectionManagerOptions.MaxConnections = 1;
+        connectionManagerOptions.MaxPendingConnectionAcquisitions = 1;
+        connectionManagerOptions.MaxConnectionIdleTimeMs = 60000;
+        connectionManagerOptions.MaxConnectionLifetimeMs = 1;
+        connectionManagerOptions.EnableBlockingShutdown = true;
+
+        auto connectionManager =
+            Http::HttpClientConnectionManager::NewClientConnectionManager(connectionManagerOptions, allocator);
+        ASSERT_TRUE(connectionManager);
+
+        auto onConnectionAvailable = [&](std::shared_ptr<Http::HttpClientConnection> newConnection, int errorCode)
+        {
+            {
+                std::lock_guard<std::mutex> lockGuard(semaphoreLock);
+                if (!errorCode)
+                {
+                    connections.push_back(newConnection);
+                }
+                else
+                {
+                    connectionsFailed++;
+                    if (errorCode == AWS_ERROR_HTTP_CONNECTION_MANAGER_MAX_PENDING_ACQUISITIONS_EXCEEDED)
+                    {
+                        pendingLimitFailures++;
+                    }
+                }
+            }
+            semaphore.notify_one();
+        };
+
+        ASSERT_TRUE(connectionManager->AcquireConnection(onConnectionAvailable));
+        {
+            std::unique_lock<std::mutex> uniqueLock(semaphoreLock);
+            semaphore.wait(uniqueLock, [&]() { return connections.size() + connectionsFailed == 1; });
+            ASSERT_UINT_EQUALS(1, connections.size());
+        }
+
+        /* one acquisition queues behind the leased connection, the other two exceed the pending limit */
+        for (size_t i = 0; i < 3; ++i)
+        {
+            ASSERT_TRUE(connectionManager->AcquireConnection(onConnectionAvailable));
+        }
+
+        {
+            std::unique_lock<std::mutex> uniqueLock(semaphoreLock);
+            semaphore.wait(uniqueLock, [&]() { return connectionsFailed == 2; });
+            ASSERT_UINT_EQUALS(2, pendingLimitFailures);
+        }
+
+        auto metrics = connectionManager->GetMetrics();
+        ASSERT_UINT_EQUALS(1, metrics.LeasedConnections);
+        ASSERT_UINT_EQUALS(1, metrics.PendingAcquisitions);
+        ASSERT_UINT_EQUALS(2, metrics.FailedAcquisitions);
+        ASSERT_UINT_EQUALS(3, metrics.AcquisitionWaitTime.GetSampleCount());
+
+        /* the released connection has outlived its 1ms lifetime, so the queued acquisition gets a new one */
+        aws_thread_current_sleep(aws_timestamp_convert(5, AWS_TIMESTAMP_MILLIS, AWS_TIMESTAMP_NANOS, NULL));
+        std::shared_ptr<Http::HttpClientConnection> firstConnection;
+        {
+            std::lock_guard<std::mutex> lockGuard(semaphoreLock);
+            firstConnection = connections.front();
+            connections.clear();
+        }
+        firstConnection.reset();
+
+        {
+            std::unique_lock<std::mutex> uniqueLock(semaphoreLock);
+            semaphore.wait(uniqueLock, [&]() { return connections.size() + connectionsFailed == 3; });
+            ASSERT_UINT_EQUALS(1, connections.size());
+            connections.clear();
+        }
+
+        metrics = connectionManager->GetMetrics();
+        ASSERT_UINT_EQUALS(0, metrics.PendingAcquisitions);
+        ASSERT_UINT_EQUALS(4, metrics.AcquisitionWaitTime.GetSampleCount());
+
+        connectionManager->InitiateShutdown().get();
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(
+    HttpClientConnectionManagerMaxPendingAcquisitionsAndMetrics,
+    s_TestHttpClientConnectionManagerMaxPendingAcquisitionsAndMetrics)
+
+/* Polls the manager's metrics until the pool holds `expected` connections, or gives up after 10 seconds */
+static bool s_waitForPoolSize(Http::HttpClientConnectionManager &connectionManager, size_t expected)
+{
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        auto metrics = connectionManager.GetMetrics();
+        if (metrics.AvailableConnections + metrics.LeasedConnections == expected)
+        {
+            return true;
+        }
+
+        aws_thread_current_sleep(aws_timestamp_convert(10, AWS_TIMESTAMP_MILLIS, AWS_TIMESTAMP_NANOS, NULL));
+    }
+
+    return false;
+}
+
+/* warm the pool, lease one of the warm connections, then warm it again up to the (capped) target. */
+static int s_TestHttpClientConnectionManagerPrewarm(struct aws_allocator *allocator, void *ctx)
+{
+    (void)ctx;
+    {
+        Aws::Crt::ApiHandle apiHandle(allocator);
+
+        Aws::Crt::Io::TlsContextOptions tlsCtxOptions = Aws::Crt::Io::TlsContextOptions::InitDefaultClient();
+
+        Aws::Crt::Io::TlsContext tlsContext(tlsCtxOptions, Aws::Crt::Io::TlsMode::CLIENT, allocator);
+        ASSERT_TRUE(tlsContext);
+
+        Aws::Crt::Io::TlsConnectionOptions tlsConnectionOptions = tlsContext.NewConnectionOptions();
+
+        ByteCursor cursor = ByteCursorFromCString("https://s3.amazonaws.com");
+        Io::Uri uri(cursor, allocator);
+
+        auto hostName = uri.GetHostName();
+        tlsConnectionOptions.SetServerName(hostName);
+
+        Aws::Crt::Io::SocketOptions socketOptions;
+        socketOptions.SetConnectTimeoutMs(10000);
+
+        Aws::Crt::Io::EventLoopGroup eventLoopGroup(1, allocator);
+        ASSERT_TRUE(eventLoopGroup);
+
+        Aws::Crt::Io::DefaultHostResolver defaultHostResolver(eventLoopGroup, 8, 30, allocator);
+        ASSERT_TRUE(defaultHostResolver);
+
+        Io::ClientBootstrap clientBootstrap(eventLoopGroup, defaultHostResolver, allocator);
+        ASSERT_TRUE(clientBootstrap);
+        clientBootstrap.EnableBlockingShutdown();
+
+        Http::HttpClientConnectionOptions connectionOptions;
+        connectionOptions.Bootstrap = &clientBootstrap;
+        connectionOptions.SocketOptions = socketOptions;
+        connectionOptions.TlsOptions = tlsConnectionOptions;
+        connectionOptions.HostName = String((const char *)hostName.ptr, hostName.len);
+        connectionOptions.Port = 443;
+
+        Http::HttpClientConnectionManagerOptions connectionManagerOptions;
+        connectionManagerOptions.ConnectionOptions = connectionOptions;
+        connectionManagerOptions.MaxConnections = 3;
+        connectionManagerOptions.EnableBlockingShutdown = true;
+
+        auto connectionManager =
+            Http::HttpClientConnectionManager::NewClientConnectionManager(connectionManagerOptions, allocator);
+        ASSERT_TRUE(connectionManager);
+
+        /* an acquisition may be served by a connection another one opened, whose own connection then lands in
+         * the pool just after prewarming finishes */
+        ASSERT_UINT_EQUALS(2, connectionManager->Prewarm(2).get());
+        ASSERT_TRUE(s_waitForPoolSize(*connectionManager, 2));
+        auto metrics = connectionManager->GetMetrics();
+        ASSERT_UINT_EQUALS(2, metrics.AvailableConnections);
+        ASSERT_UINT_EQUALS(0, metrics.LeasedConnections);
+
+        std::promise<std::shared_ptr<Http::HttpClientConnection>> leasedPromise;
+        ASSERT_TRUE(connectionManager->AcquireConnection(
+            [&leasedPromise](std::shared_ptr<Http::HttpClientConnection> connection, int)
+            { leasedPromise.set_value(std::move(connection)); }));
+        std::shared_ptr<Http::HttpClientConnection> leased = leasedPromise.get_future().get();
+        ASSERT_NOT_NULL(leased.get());
+
+        /* prewarming counts the leased connection and stops at MaxConnections */
+        ASSERT_UINT_EQUALS(2, connectionManager->Prewarm(10).get());
+        ASSERT_TRUE(s_waitForPoolSize(*connectionManager, 3));
+        metrics = connectionManager->GetMetrics();
+        ASSERT_UINT_EQUALS(2, metrics.AvailableConnections);
+        ASSERT_UINT_EQUALS(1, metrics.LeasedConnections);
+
+        /* the pool already holds enough connections */
+        ASSERT_UINT_EQUALS(0, connectionManager->Prewarm(1).get());
+
+        leased.reset();
+        connectionManager->InitiateShutdown().get();
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(HttpClientConnectionManagerPrewarm, s_TestHttpClientConnectionManagerPrewarm)
+
+/* the pool is filled on creation, refilled after a connection is closed, and overlapping prewarms don't overshoot. */
+static int s_TestHttpClientConnectionManagerMinConnections(struct aws_allocator *allocator, void *ctx)
+{
+    (void)ctx;
+    {
+        Aws::Crt::ApiHandle apiHandle(allocator);
+
+        Aws::Crt::Io::TlsContextOptions tlsCtxOptions = Aws::Crt::Io::TlsContextOptions::InitDefaultClient();
+
+        Aws::Crt::Io::TlsContext tlsContext(tlsCtxOptions, Aws::Crt::Io::TlsMode::CLIENT, allocator);
+        ASSERT_TRUE(tlsContext);
+
+        Aws::Crt::Io::TlsConnectionOptions tlsConnectionOptions = tlsContext.NewConnectionOptions();
+
+        ByteCursor cursor = ByteCursorFromCString("https://s3.amazonaws.com");
+        Io::Uri uri(cursor, allocator);
+
+        auto hostName = uri.GetHostName();
+        tlsConnectionOptions.SetServerName(hostName);
+
+        Aws::Crt::Io::SocketOptions socketOptions;
+        socketOptions.SetConnectTimeoutMs(10000);
+
+        Aws::Crt::Io::EventLoopGroup eventLoopGroup(1, allocator);
+        ASSERT_TRUE(eventLoopGroup);
+
+        Aws::Crt::Io::DefaultHostResolver defaultHostResolver(eventLoopGroup, 8, 30, allocator);
+        ASSERT_TRUE(defaultHostResolver);
+
+        Io::ClientBootstrap clientBootstrap(eventLoopGroup, defaultHostResolver, allocator);
+        ASSERT_TRUE(clientBootstrap);
+        clientBootstrap.EnableBlockingShutdown();
+
+        Http::HttpClientConnectionOptions connectionOptions;
+        connectionOptions.Bootstrap = &clientBootstrap;
+        connectionOptions.SocketOptions = socketOptions;
+        connectionOptions.TlsOptions = tlsConnectionOptions;
+        connectionOptions.HostName = String((const char *)hostName.ptr, hostName.len);
+        connectionOptions.Port = 443;
+
+        Http::HttpClientConnectionManagerOptions connectionManagerOptions;
+        connectionManagerOptions.ConnectionOptions = connectionOptions;
+        connectionManagerOptions.MaxConnections = 3;
+        connectionManagerOptions.MinConnections = 2;
+        connectionManagerOptions.EnableBlockingShutdown = true;
+
+        auto connectionManager =
+            Http::HttpClientConnectionManager::NewClientConnectionManager(connectionManagerOptions, allocator);
+        ASSERT_TRUE(connectionManager);
+        ASSERT_TRUE(s_waitForPoolSize(*connectionManager, 2));
+
+        /* a closed connection is dropped from the pool on release, and replaced */
+        std::promise<std::shared_ptr<Http::HttpClientConnection>> leasedPromise;
+        ASSERT_TRUE(connectionManager->AcquireConnection(
+            [&leasedPromise](std::shared_ptr<Http::HttpClientConnection> connection, int)
+            { leasedPromise.set_value(std::move(connection)); }));
+        std::shared_ptr<Http::HttpClientConnection> leased = leasedPromise.get_future().get();
+        ASSERT_NOT_NULL(leased.get());
+        leased->Close();
+        while (leased->IsOpen())
+        {
+            aws_thread_current_sleep(aws_timestamp_convert(1, AWS_TIMESTAMP_MILLIS, AWS_TIMESTAMP_NANOS, NULL));
+        }
+        leased.reset();
+        ASSERT_TRUE(s_waitForPoolSize(*connectionManager, 2));
+
+        /* the second prewarm only asks for what the first hasn't, so between them they stay within MaxConnections */
+        std::future<size_t> first = connectionManager->Prewarm(3);
+        std::future<size_t> second = connectionManager->Prewarm(3);
+        ASSERT_TRUE(first.get() + second.get() <= 3);
+        auto metrics = connectionManager->GetMetrics();
+        ASSERT_UINT_EQUALS(3, metrics.AvailableConnections);
+        ASSERT_UINT_EQUALS(0, metrics.LeasedConnections);
+
+        connectionManager->InitiateShutdown().get();
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(HttpClientConnectionManagerMinConnections, s_TestHttpClientConnectionManagerMinConnections)
+
+/* requests on a manager with EnableRequestTimingMetrics set land in its request histograms, and nowhere otherwise */
+static int s_TestHttpClientConnectionManagerRequestTimingMetrics(struct aws_allocator *allocator, void *ctx)
+{
+    (void)ctx;
+    {
+        Aws::Crt::ApiHandle apiHandle(allocator);
+
+        Aws::Crt::Io::EventLoopGroup eventLoopGroup(1, allocator);
+        ASSERT_TRUE(eventLoopGroup);
+
+        Aws::Crt::Io::DefaultHostResolver defaultHostResolver(eventLoopGroup, 8, 30, allocator);
+        ASSERT_TRUE(defaultHostResolver);
+
+        Io::ClientBootstrap clientBootstrap(eventLoopGroup, defaultHostResolver, allocator);
+        ASSERT_TRUE(clientBootstrap);
+        clientBootstrap.EnableBlockingShutdown();
+
+        LocalHttpServer server(allocator, eventLoopGroup);
+        server.ResponseBody = "timed response body";
+        ASSERT_TRUE(server.Start());
+
+        const size_t requestCount = 3;
+
+        for (bool enableRequestTimingMetrics : {true, false})
+        {
+            Http::HttpClientConnectionOptions connectionOptions;
+            connectionOptions.Bootstrap = &clientBootstrap;
+            connectionOptions.HostName = "127.0.0.1";
+            connectionOptions.Port = server.GetPort();
+
+            Http::HttpClientConnectionManagerOptions connectionManagerOptions;
+            connectionManagerOptions.ConnectionOptions = connectionOptions;
+            connectionManagerOptions.MaxConnections = 1;
+            connectionManagerOptions.EnableRequestTimingMetrics = enableRequestTimingMetrics;
+            connectionManagerOptions.EnableBlockingShutdown = true;
+
+            auto connectionManager =
+                Http::HttpClientConnectionManager::NewClientConnectionManager(connectionManagerOptions, allocator);
+            ASSERT_TRUE(connectionManager);
+
+            for (size_t i = 0; i < requestCount; ++i)
+            {
+                std::promise<std::shared_ptr<Http::HttpClientConnection>> connectionPromise;
+                ASSERT_TRUE(connectionManager->AcquireConnection(
+                    [&connectionPromise](std::shared_ptr<Http::HttpClientConnection> connection, int)
+                    { connectionPromise.set_value(std::move(connection)); }));
+                std::shared_ptr<Http::HttpClientConnection> connection = connectionPromise.get_future().get();
+                ASSERT_NOT_NULL(connection.get());
+
+                Http::HttpRequest request;
+                request.SetMethod(ByteCursorFromCString("GET"));
+                request.SetPath(ByteCursorFromCString("/"));
+                Http::HttpHeader hostHeader;
+                hostHeader.name = ByteCursorFromCString("host");
+                hostHeader.value = ByteCursorFromCString("127.0.0.1");
+                request.AddHeader(hostHeader);
+
+                std::promise<int> completedPromise;
+                Http::HttpStreamTimings timings;
+                Http::HttpRequestOptions requestOptions;
+                requestOptions.request = &request;
+                requestOptions.onIncomingHeaders =
+                    [](Http::HttpStream &, enum aws_http_header_block, const Http::HttpHeader *, std::size_t) {};
+                requestOptions.onStreamComplete = [&](Http::HttpStream &stream, int errorCode)
+                {
+                    timings = stream.GetTimings();
+                    completedPromise.set_value(errorCode);
+                };
+
+                auto stream = connection->NewClientStream(requestOptions);
+                ASSERT_TRUE(stream);
+                ASSERT_TRUE(stream->Activate());
+                ASSERT_INT_EQUALS(AWS_ERROR_SUCCESS, completedPromise.get_future().get());
+
+                /* the stream saw every phase, in order, on a connection from the manager */
+                ASSERT_TRUE(timings.Connection.AcquireStartNs > 0);
+                ASSERT_TRUE(timings.Connection.AcquireStartNs <= timings.Connection.AcquiredNs);
+                ASSERT_TRUE(timings.Connection.AcquiredNs <= timings.ActivatedNs);
+                ASSERT_TRUE(timings.ActivatedNs <= timings.SendStartNs);
+                ASSERT_TRUE(timings.SendStartNs <= timings.SendEndNs);
+                ASSERT_TRUE(timings.GetTimeToFirstByteNs() > 0);
+                ASSERT_TRUE(timings.ReceiveStartNs <= timings.ResponseHeadersEndNs);
+                ASSERT_TRUE(timings.ResponseHeadersEndNs <= timings.ReceiveEndNs);
+                ASSERT_TRUE(timings.ReceiveEndNs <= timings.CompletedNs);
+                ASSERT_TRUE(timings.GetTotalTimeNs() >= timings.GetTimeToFirstByteNs());
+            }
+
+            auto metrics = connectionManager->GetMetrics();
+            uint64_t expectedSamples = enableRequestTimingMetrics ? requestCount : 0;
+            ASSERT_UINT_EQUALS(expectedSamples, metrics.RequestTimeToFirstByte.GetSampleCount());
+            ASSERT_UINT_EQUALS(expectedSamples, metrics.RequestTotalTime.GetSampleCount());
+            if (enableRequestTimingMetrics)
+            {
+                ASSERT_TRUE(metrics.RequestTimeToFirstByte.GetMinNs() > 0);
+                ASSERT_TRUE(metrics.RequestTotalTime.GetMaxNs() >= metrics.RequestTimeToFirstByte.GetMaxNs());
+            }
+
+            connectionManager->InitiateShutdown().get();
+        }
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(HttpClientConnectionManagerRequestTimingMetrics, s_TestHttpClientConnectionManagerRequestTimingMetrics)
+
+/* pooled streams stay with the underlying connection, so each acquisition of it reuses the same stream */
+static int s_TestHttpClientConnectionManagerPooledStreamsOutliveLease(struct aws_allocator *allocator, void *ctx)
+{
+    (void)ctx;
+    {
+        Aws::Crt::ApiHandle apiHandle(allocator);
+
+        Aws::Crt::Io::EventLoopGroup eventLoopGroup(1, allocator);
+        ASSERT_TRUE(eventLoopGroup);
+
+        Aws::Crt::Io::DefaultHostResolver defaultHostResolver(eventLoopGroup, 8, 30, allocator);
+        ASSERT_TRUE(defaultHostResolver);
+
+        Io::ClientBootstrap clientBootstrap(eventLoopGroup, defaultHostResolver, allocator);
+        ASSERT_TRUE(clientBootstrap);
+        clientBootstrap.EnableBlockingShutdown();
+
+        LocalHttpServer server(allocator, eventLoopGroup);
+        server.ResponseBody = "pooled response body";
+        ASSERT_TRUE(server.Start());
+
+        Http::HttpClientConnectionOptions connectionOptions;
+        connectionOptions.Bootstrap = &clientBootstrap;
+        connectionOptions.HostName = "127.0.0.1";
+        connectionOptions.Port = server.GetPort();
+
+        Http::HttpClientConnectionManagerOptions connectionManagerOptions;
+        connectionManagerOptions.ConnectionOptions = connectionOptions;
+        connectionManagerOptions.MaxConnections = 1;
+        connectionManagerOptions.EnableBlockingShutdown = true;
+
+        auto connectionManager =
+            Http::HttpClientConnectionManager::NewClientConnectionManager(connectionManagerOptions, allocator);
+        ASSERT_TRUE(connectionManager);
+
+        Http::HttpRequest request;
+        request.SetMethod(ByteCursorFromCString("GET"));
+        request.SetPath(ByteCursorFromCString("/"));
+        Http::HttpHeader hostHeader;
+        hostHeader.name = ByteCursorFromCString("host");
+        hostHeader.value = ByteCursorFromCString("127.0.0.1");
+        request.AddHeader(hostHeader);
+
+        Http::HttpClientStream *firstStream = nullptr;
+        for (size_t i = 0; i < 3; ++i)
+        {
+            std::promise<std::shared_ptr<Http::HttpClientConnection>> connectionPromise;
+            ASSERT_TRUE(connectionManager->AcquireConnection(
+                [&connectionPromise](std::shared_ptr<Http::HttpClientConnection> connection, int)
+                { connectionPromise.set_value(std::move(connection)); }));
+            std::shared_ptr<Http::HttpClientConnection> connection = connectionPromise.get_future().get();
+            ASSERT_NOT_NULL(connection.get());
+
+            std::promise<int> completedPromise;
+            Http::HttpRequestOptions requestOptions;
+            requestOptions.request = &request;
+            requestOptions.onIncomingHeaders =
+                [](Http::HttpStream &, enum aws_http_header_block, const Http::HttpHeader *, std::size_t) {};
+            requestOptions.onStreamComplete = [&completedPromise](Http::HttpStream &, int errorCode)
+            { completedPromise.set_value(errorCode); };
+
+            Http::HttpClientStream *stream = connection->NewPooledClientStream(std::move(requestOptions));
+            ASSERT_NOT_NULL(stream);
+            if (firstStream == nullptr)
+            {
+                firstStream = stream;
+            }
+
+            /* the only connection's stream went back to its pool before the connection went back to the manager */
+            ASSERT_PTR_EQUALS(firstStream, stream);
+            ASSERT_TRUE(stream->Activate());
+            ASSERT_INT_EQUALS(AWS_ERROR_SUCCESS, completedPromise.get_future().get());
+        }
+
+        connectionManager->InitiateShutdown().get();
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(
+    HttpClientConnectionManagerPooledStreamsOutliveLease,
+    s_TestHttpClientConnectionManagerPooledStreamsOutliveLease)
+
 #endif // !BYO_CRYPTO
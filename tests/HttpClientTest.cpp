@@ -8,13 +8,18 @@
 #include <aws/crt/http/HttpRequestResponse.h>
 #include <aws/crt/io/Uri.h>
 
+#include "LocalHttpServer.h"
+
 #include <aws/io/event_loop.h>
 #include <aws/testing/aws_test_harness.h>
 
+#include <algorithm>
+#include <chrono>
 #include <condition_variable>
 #include <fstream>
 #include <iostream>
 #include <mutex>
+#include <thread>
 
 using namespace Aws::Crt;
 
@@ -225,6 +230,170 @@ static int s_TestHttpDownloadNoBackPressureHTTP2(struct aws_allocator *allocator
 
 AWS_TEST_CASE(HttpDownloadNoBackPressureHTTP2, s_TestHttpDownloadNoBackPressureHTTP2)
 
+/* download through a small read window that only opens as body chunks are released off the event loop thread */
+static int s_TestHttpDownloadBodyChunksWithBackPressure(struct aws_allocator *allocator, void *ctx)
+{
+    (void)ctx;
+    int result = AWS_OP_ERR;
+
+    {
+        Aws::Crt::ApiHandle apiHandle(allocator);
+        Aws::Crt::Io::TlsContextOptions tlsCtxOptions = Aws::Crt::Io::TlsContextOptions::InitDefaultClient();
+        Aws::Crt::Io::TlsContext tlsContext(tlsCtxOptions, Aws::Crt::Io::TlsMode::CLIENT, allocator);
+        ASSERT_TRUE(tlsContext);
+
+        Aws::Crt::Io::TlsConnectionOptions tlsConnectionOptions = tlsContext.NewConnectionOptions();
+
+        ByteCursor urlCursor = ByteCursorFromCString("https://aws-crt-test-stuff.s3.amazonaws.com/http_test_doc.txt");
+        Io::Uri uri(urlCursor, allocator);
+
+        auto hostName = uri.GetHostName();
+        tlsConnectionOptions.SetServerName(hostName);
+
+        Aws::Crt::Io::SocketOptions socketOptions;
+        socketOptions.SetConnectTimeoutMs(5000);
+
+        Aws::Crt::Io::EventLoopGroup eventLoopGroup(0, allocator);
+        ASSERT_TRUE(eventLoopGroup);
+
+        Aws::Crt::Io::DefaultHostResolver defaultHostResolver(eventLoopGroup, 8, 30, allocator);
+        ASSERT_TRUE(defaultHostResolver);
+
+        Aws::Crt::Io::ClientBootstrap clientBootstrap(eventLoopGroup, defaultHostResolver, allocator);
+        ASSERT_TRUE(clientBootstrap);
+        clientBootstrap.EnableBlockingShutdown();
+
+        std::shared_ptr<Http::HttpClientConnection> connection(nullptr);
+        bool connectionShutdown = false;
+        bool streamCompleted = false;
+        int streamError = AWS_ERROR_SUCCESS;
+        Vector<std::shared_ptr<const Http::HttpBodyChunk>> chunks;
+        size_t bytesReceived = 0;
+        size_t bytesReleased = 0;
+        size_t maxBytesOutstanding = 0;
+
+        std::condition_variable semaphore;
+        std::mutex semaphoreLock;
+
+        Http::HttpClientConnectionOptions httpClientConnectionOptions;
+        httpClientConnectionOptions.Bootstrap = &clientBootstrap;
+        httpClientConnectionOptions.OnConnectionSetupCallback =
+            [&](const std::shared_ptr<Http::HttpClientConnection> &newConnection, int)
+        {
+            std::lock_guard<std::mutex> lockGuard(semaphoreLock);
+            connection = newConnection;
+            connectionShutdown = !newConnection;
+            semaphore.notify_one();
+        };
+        httpClientConnectionOptions.OnConnectionShutdownCallback = [&](Http::HttpClientConnection &, int)
+        {
+            std::lock_guard<std::mutex> lockGuard(semaphoreLock);
+            connectionShutdown = true;
+            semaphore.notify_one();
+        };
+        httpClientConnectionOptions.SocketOptions = socketOptions;
+        httpClientConnectionOptions.TlsOptions = tlsConnectionOptions;
+        httpClientConnectionOptions.HostName = String((const char *)hostName.ptr, hostName.len);
+        httpClientConnectionOptions.Port = 443;
+        const size_t initialWindowSize = 4 * 1024;
+        httpClientConnectionOptions.ManualWindowManagement = true;
+        httpClientConnectionOptions.InitialWindowSize = initialWindowSize;
+
+        std::unique_lock<std::mutex> semaphoreULock(semaphoreLock);
+        ASSERT_TRUE(Http::HttpClientConnection::CreateConnection(httpClientConnectionOptions, allocator));
+        semaphore.wait(semaphoreULock, [&]() { return connection || connectionShutdown; });
+        ASSERT_TRUE(connection);
+
+        Http::HttpRequest request;
+        request.SetMethod(ByteCursorFromCString("GET"));
+        request.SetPath(uri.GetPathAndQuery());
+
+        Http::HttpHeader hostHeader;
+        hostHeader.name = ByteCursorFromCString("host");
+        hostHeader.value = uri.GetHostName();
+        request.AddHeader(hostHeader);
+
+        Http::HttpRequestOptions requestOptions;
+        requestOptions.request = &request;
+        requestOptions.onIncomingHeaders =
+            [](Http::HttpStream &, enum aws_http_header_block, const Http::HttpHeader *, std::size_t) {};
+        requestOptions.onIncomingBodyChunk =
+            [&](Http::HttpStream &, std::shared_ptr<const Http::HttpBodyChunk> chunk)
+        {
+            std::lock_guard<std::mutex> lockGuard(semaphoreLock);
+            bytesReceived += chunk->GetData().len;
+            maxBytesOutstanding = (std::max)(maxBytesOutstanding, bytesReceived - bytesReleased);
+            chunks.push_back(std::move(chunk));
+            semaphore.notify_one();
+        };
+        requestOptions.onStreamComplete = [&](Http::HttpStream &, int errorCode)
+        {
+            std::lock_guard<std::mutex> lockGuard(semaphoreLock);
+            streamCompleted = true;
+            streamError = errorCode;
+            semaphore.notify_one();
+        };
+
+        auto stream = connection->NewClientStream(requestOptions);
+        ASSERT_NOT_NULL(stream.get());
+        ASSERT_TRUE(stream->Activate());
+
+        /* while every chunk is held, the response stops once it has filled the initial window */
+        ASSERT_TRUE(semaphore.wait_for(
+            semaphoreULock, std::chrono::seconds(30), [&]() { return bytesReceived >= initialWindowSize; }));
+        semaphoreULock.unlock();
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        semaphoreULock.lock();
+        ASSERT_UINT_EQUALS(initialWindowSize, bytesReceived);
+        ASSERT_FALSE(streamCompleted);
+
+        /* the response only keeps flowing past the initial window as the chunks written out are released */
+        const char *fileName = "http_download_body_chunks_test_file.txt";
+        std::ofstream downloadedFile(fileName, std::ios_base::binary);
+        ASSERT_TRUE(downloadedFile);
+        while (true)
+        {
+            semaphore.wait(semaphoreULock, [&]() { return streamCompleted || !chunks.empty(); });
+            if (chunks.empty())
+            {
+                break;
+            }
+
+            Vector<std::shared_ptr<const Http::HttpBodyChunk>> received;
+            received.swap(chunks);
+            size_t receivedBytes = 0;
+            semaphoreULock.unlock();
+            for (const auto &chunk : received)
+            {
+                ByteCursor data = chunk->GetData();
+                downloadedFile.write((const char *)data.ptr, data.len);
+                receivedBytes += data.len;
+            }
+            semaphoreULock.lock();
+            /* counted before the release, which may let more body in right away */
+            bytesReleased += receivedBytes;
+            semaphoreULock.unlock();
+            received.clear();
+            semaphoreULock.lock();
+        }
+        ASSERT_INT_EQUALS(AWS_ERROR_SUCCESS, streamError);
+
+        /* held chunks were never credited back: no more than the initial window was ever outstanding */
+        ASSERT_TRUE(bytesReceived > initialWindowSize);
+        ASSERT_UINT_EQUALS(initialWindowSize, maxBytesOutstanding);
+
+        connection->Close();
+        semaphore.wait(semaphoreULock, [&]() { return connectionShutdown; });
+
+        downloadedFile.close();
+        result = s_VerifyFilesAreTheSame(allocator, fileName, "http_test_doc.txt");
+    }
+
+    return result;
+}
+
+AWS_TEST_CASE(HttpDownloadBodyChunksWithBackPressure, s_TestHttpDownloadBodyChunksWithBackPressure)
+
 static int s_TestHttpStreamUnActivated(struct aws_allocator *allocator, void *ctx)
 {
     (void)ctx;
@@ -348,6 +517,462 @@ static int s_TestHttpStreamUnActivated(struct aws_allocator *allocator, void *ct
 
 AWS_TEST_CASE(HttpStreamUnActivated, s_TestHttpStreamUnActivated)
 
+class CountingStreamHandler : public Http::HttpStreamHandler
+{
+  public:
+    void OnIncomingHeaders(Http::HttpStream &, enum aws_http_header_block, const Http::HttpHeader *, std::size_t)
+        override
+    {
+    }
+
+    void OnIncomingBody(Http::HttpStream &, const ByteCursor &data) override { bodyBytes += data.len; }
+
+    void OnStreamComplete(Http::HttpStream &stream, int errorCode) override
+    {
+        std::lock_guard<std::mutex> lockGuard(lock);
+        lastErrorCode = errorCode;
+        lastStatusCode = static_cast<Http::HttpClientStream &>(stream).GetResponseStatusCode();
+        completedStreams++;
+        signal.notify_one();
+    }
+
+    std::mutex lock;
+    std::condition_variable signal;
+    size_t bodyBytes = 0;
+    size_t completedStreams = 0;
+    int lastErrorCode = AWS_ERROR_SUCCESS;
+    int lastStatusCode = 0;
+};
+
+/* send requests one after another through pooled streams and make sure stream objects are reused. */
+static int s_TestHttpPooledStreamsAreRecycled(struct aws_allocator *allocator, void *ctx)
+{
+    (void)ctx;
+    {
+        Aws::Crt::ApiHandle apiHandle(allocator);
+        Aws::Crt::Io::TlsContextOptions tlsCtxOptions = Aws::Crt::Io::TlsContextOptions::InitDefaultClient();
+        Aws::Crt::Io::TlsContext tlsContext(tlsCtxOptions, Aws::Crt::Io::TlsMode::CLIENT, allocator);
+        ASSERT_TRUE(tlsContext);
+
+        Aws::Crt::Io::TlsConnectionOptions tlsConnectionOptions = tlsContext.NewConnectionOptions();
+
+        ByteCursor cursor = ByteCursorFromCString("https://aws-crt-test-stuff.s3.amazonaws.com/http_test_doc.txt");
+        Io::Uri uri(cursor, allocator);
+
+        auto hostName = uri.GetHostName();
+        tlsConnectionOptions.SetServerName(hostName);
+
+        Aws::Crt::Io::SocketOptions socketOptions;
+        socketOptions.SetConnectTimeoutMs(5000);
+
+        Aws::Crt::Io::EventLoopGroup eventLoopGroup(0, allocator);
+        ASSERT_TRUE(eventLoopGroup);
+
+        Aws::Crt::Io::DefaultHostResolver defaultHostResolver(eventLoopGroup, 8, 30, allocator);
+        ASSERT_TRUE(defaultHostResolver);
+
+        Aws::Crt::Io::ClientBootstrap clientBootstrap(eventLoopGroup, defaultHostResolver, allocator);
+        ASSERT_TRUE(clientBootstrap);
+        clientBootstrap.EnableBlockingShutdown();
+
+        std::shared_ptr<Http::HttpClientConnection> connection(nullptr);
+        bool errorOccured = true;
+        bool connectionShutdown = false;
+
+        std::condition_variable semaphore;
+        std::mutex semaphoreLock;
+
+        auto onConnectionSetup = [&](const std::shared_ptr<Http::HttpClientConnection> &newConnection, int errorCode)
+        {
+            std::lock_guard<std::mutex> lockGuard(semaphoreLock);
+
+            if (!errorCode)
+            {
+                connection = newConnection;
+                errorOccured = false;
+            }
+            else
+            {
+                connectionShutdown = true;
+            }
+
+            semaphore.notify_one();
+        };
+
+        auto onConnectionShutdown = [&](Http::HttpClientConnection &, int)
+        {
+            std::lock_guard<std::mutex> lockGuard(semaphoreLock);
+            connectionShutdown = true;
+            semaphore.notify_one();
+        };
+
+        Http::HttpClientConnectionOptions httpClientConnectionOptions;
+        httpClientConnectionOptions.Bootstrap = &clientBootstrap;
+        httpClientConnectionOptions.OnConnectionSetupCallback = onConnectionSetup;
+        httpClientConnectionOptions.OnConnectionShutdownCallback = onConnectionShutdown;
+        httpClientConnectionOptions.SocketOptions = socketOptions;
+        httpClientConnectionOptions.TlsOptions = tlsConnectionOptions;
+        httpClientConnectionOptions.HostName = String((const char *)hostName.ptr, hostName.len);
+        httpClientConnectionOptions.Port = 443;
+
+        {
+            std::unique_lock<std::mutex> semaphoreULock(semaphoreLock);
+            ASSERT_TRUE(Http::HttpClientConnection::CreateConnection(httpClientConnectionOptions, allocator));
+            semaphore.wait(semaphoreULock, [&]() { return connection || connectionShutdown; });
+            ASSERT_FALSE(errorOccured);
+            ASSERT_TRUE(connection);
+        }
+
+        Http::HttpRequest request;
+        request.SetMethod(ByteCursorFromCString("GET"));
+        request.SetPath(uri.GetPathAndQuery());
+
+        Http::HttpHeader hostHeader;
+        hostHeader.name = ByteCursorFromCString("host");
+        hostHeader.value = uri.GetHostName();
+        request.AddHeader(hostHeader);
+
+        /* A stream is recycled just after its completion callback returns, so the next request may race ahead of
+         * it, but every earlier stream has been recycled by then: sequential requests need at most two streams. */
+        CountingStreamHandler handler;
+        Vector<Http::HttpClientStream *> distinctStreams;
+        for (size_t i = 0; i < 4; ++i)
+        {
+            Http::HttpClientStream *stream = connection->NewPooledClientStream(request, handler);
+            ASSERT_NOT_NULL(stream);
+            if (std::find(distinctStreams.begin(), distinctStreams.end(), stream) == distinctStreams.end())
+            {
+                distinctStreams.push_back(stream);
+            }
+            ASSERT_TRUE(distinctStreams.size() <= 2);
+            ASSERT_TRUE(stream->Activate());
+
+            std::unique_lock<std::mutex> handlerULock(handler.lock);
+            handler.signal.wait(handlerULock, [&]() { return handler.completedStreams == i + 1; });
+            ASSERT_INT_EQUALS(AWS_ERROR_SUCCESS, handler.lastErrorCode);
+            ASSERT_INT_EQUALS(200, handler.lastStatusCode);
+        }
+
+        ASSERT_TRUE(handler.bodyBytes > 0);
+
+        connection->Close();
+        {
+            std::unique_lock<std::mutex> semaphoreULock(semaphoreLock);
+            semaphore.wait(semaphoreULock, [&]() { return connectionShutdown; });
+        }
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(HttpPooledStreamsAreRecycled, s_TestHttpPooledStreamsAreRecycled)
+
+/* a pooled stream that is never activated must not keep the connection that owns it alive. */
+static int s_TestHttpPooledStreamUnActivated(struct aws_allocator *allocator, void *ctx)
+{
+    (void)ctx;
+    {
+        Aws::Crt::ApiHandle apiHandle(allocator);
+        Aws::Crt::Io::TlsContextOptions tlsCtxOptions = Aws::Crt::Io::TlsContextOptions::InitDefaultClient();
+        Aws::Crt::Io::TlsContext tlsContext(tlsCtxOptions, Aws::Crt::Io::TlsMode::CLIENT, allocator);
+        ASSERT_TRUE(tlsContext);
+
+        Aws::Crt::Io::TlsConnectionOptions tlsConnectionOptions = tlsContext.NewConnectionOptions();
+
+        ByteCursor cursor = ByteCursorFromCString("https://aws-crt-test-stuff.s3.amazonaws.com/http_test_doc.txt");
+        Io::Uri uri(cursor, allocator);
+
+        auto hostName = uri.GetHostName();
+        tlsConnectionOptions.SetServerName(hostName);
+
+        Aws::Crt::Io::SocketOptions socketOptions;
+        socketOptions.SetConnectTimeoutMs(5000);
+
+        Aws::Crt::Io::EventLoopGroup eventLoopGroup(0, allocator);
+        ASSERT_TRUE(eventLoopGroup);
+
+        Aws::Crt::Io::DefaultHostResolver defaultHostResolver(eventLoopGroup, 8, 30, allocator);
+        ASSERT_TRUE(defaultHostResolver);
+
+        Aws::Crt::Io::ClientBootstrap clientBootstrap(eventLoopGroup, defaultHostResolver, allocator);
+        ASSERT_TRUE(clientBootstrap);
+        clientBootstrap.EnableBlockingShutdown();
+
+        std::shared_ptr<Http::HttpClientConnection> connection(nullptr);
+        bool errorOccured = true;
+        bool connectionShutdown = false;
+
+        std::condition_variable semaphore;
+        std::mutex semaphoreLock;
+
+        auto onConnectionSetup = [&](const std::shared_ptr<Http::HttpClientConnection> &newConnection, int errorCode)
+        {
+            std::lock_guard<std::mutex> lockGuard(semaphoreLock);
+
+            if (!errorCode)
+            {
+                connection = newConnection;
+                errorOccured = false;
+            }
+            else
+            {
+                connectionShutdown = true;
+            }
+
+            semaphore.notify_one();
+        };
+
+        auto onConnectionShutdown = [&](Http::HttpClientConnection &, int)
+        {
+            std::lock_guard<std::mutex> lockGuard(semaphoreLock);
+            connectionShutdown = true;
+            semaphore.notify_one();
+        };
+
+        Http::HttpClientConnectionOptions httpClientConnectionOptions;
+        httpClientConnectionOptions.Bootstrap = &clientBootstrap;
+        httpClientConnectionOptions.OnConnectionSetupCallback = onConnectionSetup;
+        httpClientConnectionOptions.OnConnectionShutdownCallback = onConnectionShutdown;
+        httpClientConnectionOptions.SocketOptions = socketOptions;
+        httpClientConnectionOptions.TlsOptions = tlsConnectionOptions;
+        httpClientConnectionOptions.HostName = String((const char *)hostName.ptr, hostName.len);
+        httpClientConnectionOptions.Port = 443;
+
+        std::unique_lock<std::mutex> semaphoreULock(semaphoreLock);
+        ASSERT_TRUE(Http::HttpClientConnection::CreateConnection(httpClientConnectionOptions, allocator));
+        semaphore.wait(semaphoreULock, [&]() { return connection || connectionShutdown; });
+        ASSERT_FALSE(errorOccured);
+        ASSERT_TRUE(connection);
+
+        Http::HttpRequest request;
+        request.SetMethod(ByteCursorFromCString("GET"));
+        request.SetPath(uri.GetPathAndQuery());
+
+        Http::HttpHeader hostHeader;
+        hostHeader.name = ByteCursorFromCString("host");
+        hostHeader.value = uri.GetHostName();
+        request.AddHeader(hostHeader);
+
+        CountingStreamHandler handler;
+        Http::HttpClientStream *stream = connection->NewPooledClientStream(request, handler);
+        ASSERT_NOT_NULL(stream);
+        ASSERT_PTR_EQUALS(connection.get(), &stream->GetConnection());
+
+        connection->Close();
+        semaphore.wait(semaphoreULock, [&]() { return connectionShutdown; });
+
+        /* dropping our reference frees the connection, and the stream with it */
+        std::weak_ptr<Http::HttpClientConnection> weakConnection = connection;
+        connection = nullptr;
+        ASSERT_TRUE(weakConnection.expired());
+        ASSERT_UINT_EQUALS(0, handler.completedStreams);
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(HttpPooledStreamUnActivated, s_TestHttpPooledStreamUnActivated)
+
+/* Byte at each offset of the request body, so that the receiver can check every byte arrived, in order */
+static uint8_t s_requestBodyByte(size_t offset)
+{
+    return static_cast<uint8_t>(offset * 31 + offset / 251);
+}
+
+/*
+ * Streams a request body through WriteData(ByteCursor) to a local server that stops reading it early, so the write
+ * buffer fills past its high-water mark.  Once the server reads again, the buffer must drain and the body must arrive
+ * whole and in order.
+ */
+static int s_TestHttpWriteDataPastHighWaterMark(struct aws_allocator *allocator, void *ctx)
+{
+    (void)ctx;
+    {
+        Aws::Crt::ApiHandle apiHandle(allocator);
+
+        Aws::Crt::Io::EventLoopGroup eventLoopGroup(2, allocator);
+        ASSERT_TRUE(eventLoopGroup);
+
+        Aws::Crt::Io::DefaultHostResolver defaultHostResolver(eventLoopGroup, 8, 30, allocator);
+        ASSERT_TRUE(defaultHostResolver);
+
+        Aws::Crt::Io::ClientBootstrap clientBootstrap(eventLoopGroup, defaultHostResolver, allocator);
+        ASSERT_TRUE(clientBootstrap);
+        clientBootstrap.EnableBlockingShutdown();
+
+        /* far more than the socket buffers between client and server can absorb while the server isn't reading */
+        const size_t bodySize = 32 * 1024 * 1024;
+        const size_t serverInitialWindow = 16 * 1024;
+
+        std::mutex lock;
+        std::condition_variable signal;
+        size_t bytesReceived = 0;
+        bool bodyInOrder = true;
+
+        LocalHttpServer server(allocator, eventLoopGroup);
+        server.InitialRequestWindow = serverInitialWindow;
+        server.OnRequestBody = [&](ByteCursor data)
+        {
+            std::lock_guard<std::mutex> lockGuard(lock);
+            for (size_t i = 0; i < data.len; ++i)
+            {
+                bodyInOrder = bodyInOrder && data.ptr[i] == s_requestBodyByte(bytesReceived + i);
+            }
+            bytesReceived += data.len;
+        };
+        ASSERT_TRUE(server.Start());
+
+        std::shared_ptr<Http::HttpClientConnection> connection(nullptr);
+        bool connectionShutdown = false;
+
+        Http::HttpClientConnectionOptions httpClientConnectionOptions;
+        httpClientConnectionOptions.Bootstrap = &clientBootstrap;
+        httpClientConnectionOptions.OnConnectionSetupCallback =
+            [&](const std::shared_ptr<Http::HttpClientConnection> &newConnection, int errorCode)
+        {
+            std::lock_guard<std::mutex> lockGuard(lock);
+            connection = newConnection;
+            connectionShutdown = errorCode != AWS_ERROR_SUCCESS;
+            signal.notify_one();
+        };
+        httpClientConnectionOptions.OnConnectionShutdownCallback = [&](Http::HttpClientConnection &, int)
+        {
+            std::lock_guard<std::mutex> lockGuard(lock);
+            connectionShutdown = true;
+            signal.notify_one();
+        };
+        httpClientConnectionOptions.HostName = "127.0.0.1";
+        httpClientConnectionOptions.Port = server.GetPort();
+
+        {
+            std::unique_lock<std::mutex> uniqueLock(lock);
+            ASSERT_TRUE(Http::HttpClientConnection::CreateConnection(httpClientConnectionOptions, allocator));
+            signal.wait(uniqueLock, [&]() { return connection || connectionShutdown; });
+            ASSERT_TRUE(connection);
+        }
+
+        Http::HttpRequest request;
+        request.SetMethod(ByteCursorFromCString("PUT"));
+        request.SetPath(ByteCursorFromCString("/upload"));
+
+        Http::HttpHeader hostHeader;
+        hostHeader.name = ByteCursorFromCString("host");
+        hostHeader.value = ByteCursorFromCString("127.0.0.1");
+        request.AddHeader(hostHeader);
+
+        String contentLength = std::to_string(bodySize).c_str();
+        Http::HttpHeader contentLengthHeader;
+        contentLengthHeader.name = ByteCursorFromCString("content-length");
+        contentLengthHeader.value = ByteCursorFromCString(contentLength.c_str());
+        request.AddHeader(contentLengthHeader);
+
+        bool aboveHighWaterMark = false;
+        size_t highWaterReports = 0;
+        size_t lowWaterReports = 0;
+        bool streamCompleted = false;
+        int streamErrorCode = AWS_ERROR_UNKNOWN;
+        int responseStatus = 0;
+
+        Http::HttpRequestOptions requestOptions;
+        requestOptions.request = &request;
+        requestOptions.UseManualDataWrites = true;
+        requestOptions.WriteBufferSize = 64 * 1024;
+        requestOptions.WriteBufferHighWaterMark = 48 * 1024;
+        requestOptions.onWriteBufferLevelChanged = [&](Http::HttpClientStream &, bool isAboveHighWaterMark)
+        {
+            std::lock_guard<std::mutex> lockGuard(lock);
+            aboveHighWaterMark = isAboveHighWaterMark;
+            ++(isAboveHighWaterMark ? highWaterReports : lowWaterReports);
+            signal.notify_one();
+        };
+        requestOptions.onIncomingHeaders =
+            [&](Http::HttpStream &, enum aws_http_header_block, const Http::HttpHeader *, std::size_t) {};
+        requestOptions.onStreamComplete = [&](Http::HttpStream &stream, int errorCode)
+        {
+            std::lock_guard<std::mutex> lockGuard(lock);
+            streamErrorCode = errorCode;
+            responseStatus = static_cast<Http::HttpClientStream &>(stream).GetResponseStatusCode();
+            streamCompleted = true;
+            signal.notify_one();
+        };
+
+        auto stream = connection->NewClientStream(requestOptions);
+        ASSERT_TRUE(stream);
+        ASSERT_TRUE(stream->Activate());
+
+        size_t writesQueued = 0;
+        size_t writesSucceeded = 0;
+        size_t writesFailed = 0;
+        auto onWriteComplete = [&](std::shared_ptr<Http::HttpStream> &, int errorCode)
+        {
+            std::lock_guard<std::mutex> lockGuard(lock);
+            ++(errorCode == AWS_ERROR_SUCCESS ? writesSucceeded : writesFailed);
+            signal.notify_one();
+        };
+
+        const size_t chunkSize = 4 * 1024;
+        uint8_t chunk[chunkSize];
+        size_t offset = 0;
+        size_t wouldBlockCount = 0;
+        while (offset < bodySize)
+        {
+            size_t length = (std::min)(chunkSize, bodySize - offset);
+            for (size_t i = 0; i < length; ++i)
+            {
+                chunk[i] = s_requestBodyByte(offset + i);
+            }
+
+            bool endStream = offset + length == bodySize;
+            if (stream->WriteData(ByteCursorFromArray(chunk, length), onWriteComplete, endStream) == AWS_OP_SUCCESS)
+            {
+                offset += length;
+                ++writesQueued;
+                continue;
+            }
+
+            ASSERT_INT_EQUALS(AWS_IO_READ_WOULD_BLOCK, aws_last_error());
+            ++wouldBlockCount;
+
+            std::unique_lock<std::mutex> uniqueLock(lock);
+            if (bytesReceived <= serverInitialWindow)
+            {
+                /* a no-op until the server has started reading the request */
+                server.OpenRequestWindow(bodySize);
+            }
+
+            /* level reports from the two threads can land out of order, so don't wait on a stale one forever */
+            signal.wait_for(uniqueLock, std::chrono::milliseconds(10), [&]() { return !aboveHighWaterMark; });
+        }
+
+        {
+            std::unique_lock<std::mutex> uniqueLock(lock);
+            signal.wait(
+                uniqueLock, [&]() { return streamCompleted && writesSucceeded + writesFailed == writesQueued; });
+
+            ASSERT_INT_EQUALS(AWS_ERROR_SUCCESS, streamErrorCode);
+            ASSERT_INT_EQUALS(200, responseStatus);
+            ASSERT_UINT_EQUALS(0, writesFailed);
+            ASSERT_UINT_EQUALS(bodySize, bytesReceived);
+            ASSERT_TRUE(bodyInOrder);
+
+            ASSERT_TRUE(wouldBlockCount > 0);
+            ASSERT_TRUE(highWaterReports > 0);
+            ASSERT_TRUE(lowWaterReports > 0);
+        }
+
+        stream = nullptr;
+        connection->Close();
+        {
+            std::unique_lock<std::mutex> uniqueLock(lock);
+            signal.wait(uniqueLock, [&]() { return connectionShutdown; });
+        }
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(HttpWriteDataPastHighWaterMark, s_TestHttpWriteDataPastHighWaterMark)
+
 static int s_TestHttpCreateConnectionInvalidTlsConnectionOptions(struct aws_allocator *allocator, void *ctx)
 {
     (void)ctx;
@@ -0,0 +1,537 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+#include <aws/crt/Api.h>
+#include <aws/crt/http/HttpConnection.h>
+#include <aws/crt/http/HttpContentDecoder.h>
+#include <aws/crt/io/Bootstrap.h>
+#include <aws/crt/io/HostResolver.h>
+
+#include "LocalHttpServer.h"
+
+#include <aws/http/http.h>
+#include <aws/testing/aws_test_harness.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+using namespace Aws::Crt;
+using namespace Aws::Crt::Http;
+
+/*
+ * Payloads produced by Python's zlib module, under tests/resources/content_decoder/:
+ *   dynamic.zz - s_pangram, zlib.compress(level=9); a single dynamic Huffman block
+ *   stored.zz  - s_expectedBody, compressed at level 0 with a Z_FULL_FLUSH after 150 bytes: two stored blocks with an
+ *                empty one between them
+ *   window.gz  - s_windowTestData(), gzip at level 9; most of it is copies from 30000 bytes back, which wrap around
+ *                the decoder's 32KiB window
+ */
+static const char s_pangram[] =
+    "The quick brown fox jumps over the lazy dog. Pack my box with five dozen liquor jugs! How vexingly quick daft "
+    "zebras jump; sphinx of black quartz, judge my vow.\n";
+
+/* 200000 bytes: 30000 pseudo-random 'a's and 'b's, then that sequence repeated */
+static String s_windowTestData()
+{
+    String data;
+    data.reserve(200000);
+    uint32_t state = 1;
+    for (size_t i = 0; i < 30000; ++i)
+    {
+        state = state * 1103515245u + 12345u;
+        data.push_back(static_cast<char>('a' + ((state >> 16) & 1)));
+    }
+    while (data.size() < 200000)
+    {
+        data.push_back(data[data.size() - 30000]);
+    }
+    return data;
+}
+
+/* s_expectedBody compressed at level 9 by gzip, zlib and raw deflate */
+static const char s_expectedBody[] =
+    "Decompressed http body, decompressed http body, decompressed http body.\n"
+    "Decompressed http body, decompressed http body, decompressed http body.\n"
+    "Decompressed http body, decompressed http body, decompressed http body.\n"
+    "Decompressed http body, decompressed http body, decompressed http body.\n";
+
+static const uint8_t s_gzipBody[] = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x73, 0x49, 0x4d, 0xce, 0xcf, 0x2d, 0x28, 0x4a,
+    0x2d, 0x2e, 0x4e, 0x4d, 0x51, 0xc8, 0x28, 0x29, 0x29, 0x50, 0x48, 0xca, 0x4f, 0xa9, 0xd4, 0x51, 0x48, 0x21,
+    0x49, 0x5c, 0x8f, 0xcb, 0x65, 0x98, 0x9a, 0x03, 0x00, 0xc3, 0x94, 0x16, 0xc8, 0x20, 0x01, 0x00, 0x00};
+
+static const uint8_t s_zlibBody[] = {
+    0x78, 0xda, 0x73, 0x49, 0x4d, 0xce, 0xcf, 0x2d, 0x28, 0x4a, 0x2d, 0x2e, 0x4e, 0x4d, 0x51, 0xc8, 0x28, 0x29,
+    0x29, 0x50, 0x48, 0xca, 0x4f, 0xa9, 0xd4, 0x51, 0x48, 0x21, 0x49, 0x5c, 0x8f, 0xcb, 0x65, 0x98, 0x9a, 0x03,
+    0x00, 0x9b, 0x34, 0x6a, 0xd1};
+
+static const uint8_t s_rawDeflateBody[] = {
+    0x73, 0x49, 0x4d, 0xce, 0xcf, 0x2d, 0x28, 0x4a, 0x2d, 0x2e, 0x4e, 0x4d, 0x51, 0xc8, 0x28, 0x29, 0x29, 0x50,
+    0x48, 0xca, 0x4f, 0xa9, 0xd4, 0x51, 0x48, 0x21, 0x49, 0x5c, 0x8f, 0xcb, 0x65, 0x98, 0x9a, 0x03, 0x00};
+
+/* s_expectedBody as a gzip member whose header has FEXTRA, FNAME, FCOMMENT and FHCRC set */
+static const uint8_t s_gzipHeaderFieldsBody[] = {
+    0x1f, 0x8b, 0x08, 0x1e, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x07, 0x00, 0x41, 0x42, 0x03, 0x00, 0x78, 0x79,
+    0x7a, 0x62, 0x6f, 0x64, 0x79, 0x2e, 0x74, 0x78, 0x74, 0x00, 0x61, 0x20, 0x63, 0x6f, 0x6d, 0x6d, 0x65, 0x6e,
+    0x74, 0x00, 0x76, 0xd1, 0x73, 0x49, 0x4d, 0xce, 0xcf, 0x2d, 0x28, 0x4a, 0x2d, 0x2e, 0x4e, 0x4d, 0x51, 0xc8,
+    0x28, 0x29, 0x29, 0x50, 0x48, 0xca, 0x4f, 0xa9, 0xd4, 0x51, 0x48, 0x21, 0x49, 0x5c, 0x8f, 0xcb, 0x65, 0x98,
+    0x9a, 0x03, 0x00, 0xc3, 0x94, 0x16, 0xc8, 0x20, 0x01, 0x00, 0x00};
+
+/* Decodes input in pieces of at most chunkSize bytes, appending the output to decoded */
+static bool s_decodeInChunks(
+    HttpContentDecoder &decoder,
+    const uint8_t *input,
+    size_t inputLength,
+    size_t chunkSize,
+    String &decoded)
+{
+    OnDecodedData onDecodedData = [&decoded](const ByteCursor &data)
+    { decoded.append(reinterpret_cast<const char *>(data.ptr), data.len); };
+
+    while (inputLength > 0)
+    {
+        size_t length = inputLength < chunkSize ? inputLength : chunkSize;
+        if (!decoder.Decode(ByteCursorFromArray(input, length), onDecodedData))
+        {
+            return false;
+        }
+        input += length;
+        inputLength -= length;
+    }
+
+    return true;
+}
+
+static int s_TestHttpContentDecoderFormats(struct aws_allocator *allocator, void *ctx)
+{
+    (void)ctx;
+    {
+        Aws::Crt::ApiHandle apiHandle(allocator);
+
+        struct
+        {
+            HttpContentEncoding encoding;
+            const uint8_t *input;
+            size_t inputLength;
+        } cases[] = {
+            {HttpContentEncoding::Gzip, s_gzipBody, sizeof(s_gzipBody)},
+            {HttpContentEncoding::Deflate, s_zlibBody, sizeof(s_zlibBody)},
+            {HttpContentEncoding::Deflate, s_rawDeflateBody, sizeof(s_rawDeflateBody)},
+            {HttpContentEncoding::Identity,
+             reinterpret_cast<const uint8_t *>(s_expectedBody),
+             sizeof(s_expectedBody) - 1},
+        };
+
+        for (const auto &testCase : cases)
+        {
+            /* Whole, and split at every byte boundary */
+            for (size_t chunkSize : {testCase.inputLength, static_cast<size_t>(1)})
+            {
+                HttpContentDecoder decoder(testCase.encoding, allocator);
+                ASSERT_TRUE(decoder);
+
+                String decoded;
+                ASSERT_TRUE(s_decodeInChunks(decoder, testCase.input, testCase.inputLength, chunkSize, decoded));
+                ASSERT_TRUE(decoder.IsComplete());
+                ASSERT_TRUE(decoded == s_expectedBody);
+                ASSERT_UINT_EQUALS(testCase.inputLength, decoder.GetInputByteCount());
+                ASSERT_UINT_EQUALS(sizeof(s_expectedBody) - 1, decoder.GetOutputByteCount());
+            }
+        }
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(HttpContentDecoderFormats, s_TestHttpContentDecoderFormats)
+
+static int s_TestHttpContentDecoderGzipMembersAndErrors(struct aws_allocator *allocator, void *ctx)
+{
+    (void)ctx;
+    {
+        Aws::Crt::ApiHandle apiHandle(allocator);
+
+        /* Concatenated gzip members decode to the concatenation of their contents */
+        uint8_t twoMembers[sizeof(s_gzipBody) * 2];
+        memcpy(twoMembers, s_gzipBody, sizeof(s_gzipBody));
+        memcpy(twoMembers + sizeof(s_gzipBody), s_gzipBody, sizeof(s_gzipBody));
+        {
+            HttpContentDecoder decoder(HttpContentEncoding::Gzip, allocator);
+            String decoded;
+            ASSERT_TRUE(s_decodeInChunks(decoder, twoMembers, sizeof(twoMembers), 7, decoded));
+            ASSERT_TRUE(decoder.IsComplete());
+            ASSERT_TRUE(decoded == String(s_expectedBody) + s_expectedBody);
+        }
+
+        /* Truncated data decodes without error but is not complete */
+        {
+            HttpContentDecoder decoder(HttpContentEncoding::Gzip, allocator);
+            String decoded;
+            ASSERT_TRUE(s_decodeInChunks(decoder, s_gzipBody, sizeof(s_gzipBody) - 1, 1, decoded));
+            ASSERT_FALSE(decoder.IsComplete());
+        }
+
+        /* A corrupted CRC-32 in the trailer fails, and so does all further input */
+        uint8_t corrupted[sizeof(s_gzipBody)];
+        memcpy(corrupted, s_gzipBody, sizeof(s_gzipBody));
+        corrupted[sizeof(corrupted) - 8] ^= 0x01;
+        {
+            HttpContentDecoder decoder(HttpContentEncoding::Gzip, allocator);
+            String decoded;
+            ASSERT_FALSE(s_decodeInChunks(decoder, corrupted, sizeof(corrupted), sizeof(corrupted), decoded));
+            ASSERT_INT_EQUALS(AWS_ERROR_HTTP_PROTOCOL_ERROR, aws_last_error());
+            ASSERT_FALSE(decoder.IsComplete());
+            ASSERT_FALSE(s_decodeInChunks(decoder, s_gzipBody, sizeof(s_gzipBody), sizeof(s_gzipBody), decoded));
+        }
+
+        /* Data that is not gzip at all */
+        {
+            HttpContentDecoder decoder(HttpContentEncoding::Gzip, allocator);
+            String decoded;
+            ASSERT_FALSE(s_decodeInChunks(decoder, s_zlibBody, sizeof(s_zlibBody), sizeof(s_zlibBody), decoded));
+            ASSERT_TRUE(decoded.empty());
+        }
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(HttpContentDecoderGzipMembersAndErrors, s_TestHttpContentDecoderGzipMembersAndErrors)
+
+static int s_TestHttpContentDecoderEncodingFromHeaderValue(struct aws_allocator *allocator, void *ctx)
+{
+    (void)ctx;
+    {
+        Aws::Crt::ApiHandle apiHandle(allocator);
+
+        auto encodingOf = [](const char *value)
+        { return HttpContentDecoder::EncodingFromHeaderValue(aws_byte_cursor_from_c_str(value)); };
+
+        ASSERT_TRUE(encodingOf("gzip").value() == HttpContentEncoding::Gzip);
+        ASSERT_TRUE(encodingOf(" X-GZIP ").value() == HttpContentEncoding::Gzip);
+        ASSERT_TRUE(encodingOf("Deflate").value() == HttpContentEncoding::Deflate);
+        ASSERT_TRUE(encodingOf("identity").value() == HttpContentEncoding::Identity);
+        ASSERT_FALSE(encodingOf("br").has_value());
+        ASSERT_FALSE(encodingOf("gzip, br").has_value());
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(HttpContentDecoderEncodingFromHeaderValue, s_TestHttpContentDecoderEncodingFromHeaderValue)
+
+static int s_TestHttpContentDecoderZlibPayloads(struct aws_allocator *allocator, void *ctx)
+{
+    (void)ctx;
+    {
+        Aws::Crt::ApiHandle apiHandle(allocator);
+
+        String windowTestData = s_windowTestData();
+        struct
+        {
+            const char *fileName;
+            HttpContentEncoding encoding;
+            String expected;
+        } cases[] = {
+            {"content_decoder/dynamic.zz", HttpContentEncoding::Deflate, s_pangram},
+            {"content_decoder/stored.zz", HttpContentEncoding::Deflate, s_expectedBody},
+            {"content_decoder/window.gz", HttpContentEncoding::Gzip, windowTestData},
+        };
+
+        for (const auto &testCase : cases)
+        {
+            ByteBuf input;
+            ASSERT_TRUE(ByteBufInitFromFile(input, allocator, testCase.fileName));
+
+            /* Whole, in pieces smaller than a block, and split at every byte boundary */
+            for (size_t chunkSize : {input.len, static_cast<size_t>(1000), static_cast<size_t>(1)})
+            {
+                HttpContentDecoder decoder(testCase.encoding, allocator);
+                ASSERT_TRUE(decoder);
+
+                String decoded;
+                ASSERT_TRUE(s_decodeInChunks(decoder, input.buffer, input.len, chunkSize, decoded));
+                ASSERT_TRUE(decoder.IsComplete());
+                ASSERT_TRUE(decoded == testCase.expected);
+                ASSERT_UINT_EQUALS(input.len, decoder.GetInputByteCount());
+                ASSERT_UINT_EQUALS(testCase.expected.size(), decoder.GetOutputByteCount());
+            }
+
+            ByteBufDelete(input);
+        }
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(HttpContentDecoderZlibPayloads, s_TestHttpContentDecoderZlibPayloads)
+
+static int s_TestHttpContentDecoderGzipHeaderFields(struct aws_allocator *allocator, void *ctx)
+{
+    (void)ctx;
+    {
+        Aws::Crt::ApiHandle apiHandle(allocator);
+
+        for (size_t chunkSize : {sizeof(s_gzipHeaderFieldsBody), static_cast<size_t>(1)})
+        {
+            HttpContentDecoder decoder(HttpContentEncoding::Gzip, allocator);
+            String decoded;
+            ASSERT_TRUE(
+                s_decodeInChunks(decoder, s_gzipHeaderFieldsBody, sizeof(s_gzipHeaderFieldsBody), chunkSize, decoded));
+            ASSERT_TRUE(decoder.IsComplete());
+            ASSERT_TRUE(decoded == s_expectedBody);
+        }
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(HttpContentDecoderGzipHeaderFields, s_TestHttpContentDecoderGzipHeaderFields)
+
+static int s_TestHttpContentDecoderMalformedDeflate(struct aws_allocator *allocator, void *ctx)
+{
+    (void)ctx;
+    {
+        Aws::Crt::ApiHandle apiHandle(allocator);
+
+        /* zlib header, then a final block of the reserved type 3 */
+        static const uint8_t s_invalidBlockType[] = {0x78, 0x9c, 0x07};
+        /* zlib header, then a stored block whose NLEN is not the complement of LEN */
+        static const uint8_t s_storedLengthMismatch[] = {0x78, 0x9c, 0x01, 0x05, 0x00, 0xfa, 0xfe};
+        /* raw deflate: "a", then a copy from further back than anything decoded so far */
+        static const uint8_t s_distanceTooFar[] = {0x4b, 0x04, 0x42, 0x00};
+
+        struct
+        {
+            const uint8_t *input;
+            size_t inputLength;
+        } cases[] = {
+            {s_invalidBlockType, sizeof(s_invalidBlockType)},
+            {s_storedLengthMismatch, sizeof(s_storedLengthMismatch)},
+            {s_distanceTooFar, sizeof(s_distanceTooFar)},
+        };
+
+        for (const auto &testCase : cases)
+        {
+            for (size_t chunkSize : {testCase.inputLength, static_cast<size_t>(1)})
+            {
+                HttpContentDecoder decoder(HttpContentEncoding::Deflate, allocator);
+                String decoded;
+                ASSERT_FALSE(s_decodeInChunks(decoder, testCase.input, testCase.inputLength, chunkSize, decoded));
+                ASSERT_INT_EQUALS(AWS_ERROR_HTTP_PROTOCOL_ERROR, aws_last_error());
+                ASSERT_FALSE(decoder.IsComplete());
+            }
+        }
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(HttpContentDecoderMalformedDeflate, s_TestHttpContentDecoderMalformedDeflate)
+
+static int s_TestHttpContentDecoderOutputLimit(struct aws_allocator *allocator, void *ctx)
+{
+    (void)ctx;
+    {
+        Aws::Crt::ApiHandle apiHandle(allocator);
+
+        String windowTestData = s_windowTestData();
+        ByteBuf input;
+        ASSERT_TRUE(ByteBufInitFromFile(input, allocator, "content_decoder/window.gz"));
+
+        /* A limit below the decompressed size fails without delivering more than the limit */
+        for (size_t chunkSize : {input.len, static_cast<size_t>(100)})
+        {
+            HttpContentDecoder decoder(HttpContentEncoding::Gzip, allocator);
+            decoder.SetMaxOutputByteCount(50000);
+
+            String decoded;
+            ASSERT_FALSE(s_decodeInChunks(decoder, input.buffer, input.len, chunkSize, decoded));
+            ASSERT_INT_EQUALS(AWS_ERROR_OVERFLOW_DETECTED, aws_last_error());
+            ASSERT_TRUE(decoded.size() <= 50000);
+            ASSERT_TRUE(decoded == windowTestData.substr(0, decoded.size()));
+            ASSERT_FALSE(decoder.IsComplete());
+
+            ASSERT_FALSE(decoder.Decode(ByteCursorFromArray(input.buffer, 1), [](ByteCursor) {}));
+            ASSERT_INT_EQUALS(AWS_ERROR_OVERFLOW_DETECTED, aws_last_error());
+        }
+
+        /* A limit equal to the decompressed size is not exceeded */
+        {
+            HttpContentDecoder decoder(HttpContentEncoding::Gzip, allocator);
+            decoder.SetMaxOutputByteCount(windowTestData.size());
+
+            String decoded;
+            ASSERT_TRUE(s_decodeInChunks(decoder, input.buffer, input.len, input.len, decoded));
+            ASSERT_TRUE(decoder.IsComplete());
+            ASSERT_TRUE(decoded == windowTestData);
+        }
+
+        ByteBufDelete(input);
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(HttpContentDecoderOutputLimit, s_TestHttpContentDecoderOutputLimit)
+
+/*
+ * Fetches a response served with `content-encoding: gzip` from a LocalHttpServer, with DecompressResponseBody set and
+ * the client's window managed manually: each piece of decompressed body is credited back in two UpdateWindow() calls.
+ */
+static int s_fetchDecompressedResponse(
+    struct aws_allocator *allocator,
+    const String &responseBody,
+    uint64_t maxDecompressedBodySize,
+    String &decoded,
+    int &streamErrorCode)
+{
+    Aws::Crt::Io::EventLoopGroup eventLoopGroup(1, allocator);
+    ASSERT_TRUE(eventLoopGroup);
+
+    Aws::Crt::Io::DefaultHostResolver defaultHostResolver(eventLoopGroup, 8, 30, allocator);
+    ASSERT_TRUE(defaultHostResolver);
+
+    Aws::Crt::Io::ClientBootstrap clientBootstrap(eventLoopGroup, defaultHostResolver, allocator);
+    ASSERT_TRUE(clientBootstrap);
+    clientBootstrap.EnableBlockingShutdown();
+
+    LocalHttpServer server(allocator, eventLoopGroup);
+    server.ResponseHeaders.emplace_back("content-encoding", "gzip");
+    server.ResponseBody = responseBody;
+    ASSERT_TRUE(server.Start());
+
+    std::mutex lock;
+    std::condition_variable signal;
+    std::shared_ptr<Http::HttpClientConnection> connection(nullptr);
+    bool connectionShutdown = false;
+
+    Http::HttpClientConnectionOptions connectionOptions;
+    connectionOptions.Bootstrap = &clientBootstrap;
+    connectionOptions.HostName = "127.0.0.1";
+    connectionOptions.Port = server.GetPort();
+    connectionOptions.ManualWindowManagement = true;
+    /* far smaller than the compressed body, so the transfer stalls unless every compressed byte is credited back */
+    connectionOptions.InitialWindowSize = 1024;
+    connectionOptions.OnConnectionSetupCallback =
+        [&](const std::shared_ptr<Http::HttpClientConnection> &newConnection, int errorCode)
+    {
+        std::lock_guard<std::mutex> lockGuard(lock);
+        connection = newConnection;
+        connectionShutdown = errorCode != AWS_ERROR_SUCCESS;
+        signal.notify_one();
+    };
+    connectionOptions.OnConnectionShutdownCallback = [&](Http::HttpClientConnection &, int)
+    {
+        std::lock_guard<std::mutex> lockGuard(lock);
+        connectionShutdown = true;
+        signal.notify_one();
+    };
+
+    {
+        std::unique_lock<std::mutex> uniqueLock(lock);
+        ASSERT_TRUE(Http::HttpClientConnection::CreateConnection(connectionOptions, allocator));
+        signal.wait(uniqueLock, [&]() { return connection || connectionShutdown; });
+        ASSERT_TRUE(connection);
+    }
+
+    Http::HttpRequest request;
+    request.SetMethod(ByteCursorFromCString("GET"));
+    request.SetPath(ByteCursorFromCString("/"));
+
+    Http::HttpHeader hostHeader;
+    hostHeader.name = ByteCursorFromCString("host");
+    hostHeader.value = ByteCursorFromCString("127.0.0.1");
+    request.AddHeader(hostHeader);
+
+    bool streamCompleted = false;
+    streamErrorCode = AWS_ERROR_UNKNOWN;
+
+    Http::HttpRequestOptions requestOptions;
+    requestOptions.request = &request;
+    requestOptions.DecompressResponseBody = true;
+    requestOptions.MaxDecompressedBodySize = maxDecompressedBodySize;
+    requestOptions.onIncomingHeaders =
+        [&](Http::HttpStream &, enum aws_http_header_block, const Http::HttpHeader *, std::size_t) {};
+    requestOptions.onIncomingBody = [&](Http::HttpStream &stream, const ByteCursor &data)
+    {
+        {
+            std::lock_guard<std::mutex> lockGuard(lock);
+            decoded.append(reinterpret_cast<const char *>(data.ptr), data.len);
+        }
+        stream.UpdateWindow(data.len / 2);
+        stream.UpdateWindow(data.len - data.len / 2);
+    };
+    requestOptions.onStreamComplete = [&](Http::HttpStream &, int errorCode)
+    {
+        std::lock_guard<std::mutex> lockGuard(lock);
+        streamErrorCode = errorCode;
+        streamCompleted = true;
+        signal.notify_one();
+    };
+
+    auto stream = connection->NewClientStream(requestOptions);
+    ASSERT_TRUE(stream);
+    ASSERT_TRUE(stream->Activate());
+
+    {
+        std::unique_lock<std::mutex> uniqueLock(lock);
+        ASSERT_TRUE(signal.wait_for(uniqueLock, std::chrono::seconds(30), [&]() { return streamCompleted; }));
+    }
+
+    stream = nullptr;
+    connection->Close();
+    {
+        std::unique_lock<std::mutex> uniqueLock(lock);
+        signal.wait(uniqueLock, [&]() { return connectionShutdown; });
+    }
+    connection = nullptr;
+
+    return AWS_OP_SUCCESS;
+}
+
+static int s_TestHttpDecompressedResponseWindow(struct aws_allocator *allocator, void *ctx)
+{
+    (void)ctx;
+    {
+        Aws::Crt::ApiHandle apiHandle(allocator);
+
+        ByteBuf compressed;
+        ASSERT_TRUE(ByteBufInitFromFile(compressed, allocator, "content_decoder/window.gz"));
+        String responseBody(reinterpret_cast<const char *>(compressed.buffer), compressed.len);
+        ByteBufDelete(compressed);
+
+        /* Completes, rather than stalling, when the decompressed bytes are credited back */
+        {
+            String decoded;
+            int streamErrorCode = AWS_ERROR_UNKNOWN;
+            ASSERT_SUCCESS(s_fetchDecompressedResponse(allocator, responseBody, 0, decoded, streamErrorCode));
+            ASSERT_INT_EQUALS(AWS_ERROR_SUCCESS, streamErrorCode);
+            ASSERT_TRUE(decoded == s_windowTestData());
+        }
+
+        /* A body that ends partway through the gzip member is a protocol error */
+        {
+            String decoded;
+            int streamErrorCode = AWS_ERROR_UNKNOWN;
+            ASSERT_SUCCESS(s_fetchDecompressedResponse(
+                allocator, responseBody.substr(0, responseBody.size() - 4), 0, decoded, streamErrorCode));
+            ASSERT_INT_EQUALS(AWS_ERROR_HTTP_PROTOCOL_ERROR, streamErrorCode);
+        }
+
+        /* A body that decompresses to more than MaxDecompressedBodySize is cut off */
+        {
+            String decoded;
+            int streamErrorCode = AWS_ERROR_UNKNOWN;
+            ASSERT_SUCCESS(s_fetchDecompressedResponse(allocator, responseBody, 50000, decoded, streamErrorCode));
+            ASSERT_INT_EQUALS(AWS_ERROR_OVERFLOW_DETECTED, streamErrorCode);
+            ASSERT_TRUE(decoded.size() <= 50000);
+        }
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(HttpDecompressedResponseWindow, s_TestHttpDecompressedResponseWindow)
@@ -48,3 +48,78 @@ static int s_HttpRequestTestCreateDestroy(struct aws_allocator *allocator, void
 }
 
 AWS_TEST_CASE(HttpRequestTestCreateDestroy, s_HttpRequestTestCreateDestroy)
+
+static int s_HttpRequestTestHeaderLookup(struct aws_allocator *allocator, void *ctx)
+{
+    (void)ctx;
+    {
+        Aws::Crt::ApiHandle apiHandle(allocator);
+
+        Aws::Crt::Http::HttpRequest request(allocator);
+
+        HttpHeader headers[] = {
+            {aws_byte_cursor_from_c_str("Host"), aws_byte_cursor_from_c_str("www.test.com")},
+            {aws_byte_cursor_from_c_str("x-amz-meta-a"), aws_byte_cursor_from_c_str("1")},
+            {aws_byte_cursor_from_c_str("ETag"), aws_byte_cursor_from_c_str("abc")},
+            {aws_byte_cursor_from_c_str("X-Amz-Meta-A"), aws_byte_cursor_from_c_str("2")},
+        };
+        for (const HttpHeader &header : headers)
+        {
+            ASSERT_TRUE(request.AddHeader(header));
+        }
+
+        size_t visited = 0;
+        for (HttpHeader header : request.GetHeaders())
+        {
+            ASSERT_TRUE(aws_byte_cursor_eq(&header.name, &headers[visited].name));
+            ++visited;
+        }
+        ASSERT_UINT_EQUALS(4, visited);
+
+        auto etag = request.FindHeader(aws_byte_cursor_from_c_str("etag"));
+        ASSERT_TRUE(etag.has_value());
+        ASSERT_TRUE(aws_byte_cursor_eq_c_str(&etag.value(), "abc"));
+
+        auto metaValues = request.GetHeaderValues(aws_byte_cursor_from_c_str("X-AMZ-META-A"));
+        ASSERT_UINT_EQUALS(2, metaValues.size());
+        ASSERT_TRUE(aws_byte_cursor_eq_c_str(&metaValues[0], "1"));
+        ASSERT_TRUE(aws_byte_cursor_eq_c_str(&metaValues[1], "2"));
+
+        ASSERT_FALSE(request.FindHeader(aws_byte_cursor_from_c_str("content-length")).has_value());
+
+        /* lookups must follow changes to the headers */
+        ASSERT_TRUE(request.EraseHeader(1));
+        metaValues = request.GetHeaderValues(aws_byte_cursor_from_c_str("x-amz-meta-a"));
+        ASSERT_UINT_EQUALS(1, metaValues.size());
+        ASSERT_TRUE(aws_byte_cursor_eq_c_str(&metaValues[0], "2"));
+
+        HttpHeader contentLength = {aws_byte_cursor_from_c_str("Content-Length"), aws_byte_cursor_from_c_str("42")};
+        aws_http_message_add_header(request.GetUnderlyingMessage(), contentLength);
+        auto length = request.FindHeader(aws_byte_cursor_from_c_str("content-length"));
+        ASSERT_TRUE(length.has_value());
+        ASSERT_TRUE(aws_byte_cursor_eq_c_str(&length.value(), "42"));
+
+        /* a header replaced through the C message, leaving the count unchanged, is found */
+        size_t headerCount = request.GetHeaderCount();
+        HttpHeader contentType = {aws_byte_cursor_from_c_str("Content-Type"), aws_byte_cursor_from_c_str("text/plain")};
+        ASSERT_SUCCESS(aws_http_message_erase_header(request.GetUnderlyingMessage(), headerCount - 1));
+        ASSERT_SUCCESS(aws_http_message_add_header(request.GetUnderlyingMessage(), contentType));
+        ASSERT_UINT_EQUALS(headerCount, request.GetHeaderCount());
+        ASSERT_FALSE(request.FindHeader(aws_byte_cursor_from_c_str("content-length")).has_value());
+        auto type = request.FindHeader(aws_byte_cursor_from_c_str("content-type"));
+        ASSERT_TRUE(type.has_value());
+        ASSERT_TRUE(aws_byte_cursor_eq_c_str(&type.value(), "text/plain"));
+
+        /* views over raw header arrays, as passed to OnIncomingHeaders */
+        HttpHeaderView arrayView(headers, AWS_ARRAY_SIZE(headers));
+        ASSERT_UINT_EQUALS(4, arrayView.size());
+        ASSERT_UINT_EQUALS(2, arrayView.GetHeaderValues(aws_byte_cursor_from_c_str("x-amz-meta-a")).size());
+        auto host = arrayView.FindHeader(aws_byte_cursor_from_c_str("HOST"));
+        ASSERT_TRUE(host.has_value());
+        ASSERT_TRUE(aws_byte_cursor_eq_c_str(&host.value(), "www.test.com"));
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(HttpRequestTestHeaderLookup, s_HttpRequestTestHeaderLookup)
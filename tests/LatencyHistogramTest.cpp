@@ -0,0 +1,82 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+#include <aws/crt/Api.h>
+#include <aws/crt/LatencyHistogram.h>
+
+#include <aws/testing/aws_test_harness.h>
+
+static int s_LatencyHistogramBasic(Aws::Crt::Allocator *allocator, void *ctx)
+{
+    (void)ctx;
+    {
+        Aws::Crt::ApiHandle apiHandle(allocator);
+
+        Aws::Crt::LatencyHistogram histogram;
+        ASSERT_UINT_EQUALS(0, histogram.GetSampleCount());
+        ASSERT_UINT_EQUALS(0, histogram.GetMinNs());
+        ASSERT_UINT_EQUALS(0, histogram.GetPercentileNs(50.0));
+
+        for (uint64_t i = 1; i <= 1000; ++i)
+        {
+            histogram.Record(i * 1000);
+        }
+
+        ASSERT_UINT_EQUALS(1000, histogram.GetSampleCount());
+        ASSERT_UINT_EQUALS(1000, histogram.GetMinNs());
+        ASSERT_UINT_EQUALS(1000000, histogram.GetMaxNs());
+        ASSERT_UINT_EQUALS(500500, histogram.GetMeanNs());
+
+        /* percentiles are bucket upper bounds, so they never under-report and are clamped to the maximum */
+        uint64_t p50 = histogram.GetPercentileNs(50.0);
+        ASSERT_TRUE(p50 >= 500000);
+        ASSERT_TRUE(p50 < 1000000);
+        ASSERT_UINT_EQUALS(1000000, histogram.GetPercentileNs(100.0));
+
+        uint64_t bucketTotal = 0;
+        for (size_t i = 0; i < Aws::Crt::LatencyHistogram::BUCKET_COUNT; ++i)
+        {
+            bucketTotal += histogram.GetBucketCount(i);
+        }
+        ASSERT_UINT_EQUALS(1000, bucketTotal);
+
+        histogram.Reset();
+        ASSERT_UINT_EQUALS(0, histogram.GetSampleCount());
+        ASSERT_UINT_EQUALS(0, histogram.GetMaxNs());
+    }
+
+    return AWS_ERROR_SUCCESS;
+}
+
+AWS_TEST_CASE(LatencyHistogramBasic, s_LatencyHistogramBasic)
+
+static int s_LatencyHistogramMerge(Aws::Crt::Allocator *allocator, void *ctx)
+{
+    (void)ctx;
+    {
+        Aws::Crt::ApiHandle apiHandle(allocator);
+
+        Aws::Crt::LatencyHistogram fast;
+        Aws::Crt::LatencyHistogram slow;
+        fast.Record(10);
+        fast.Record(20);
+        slow.Record(5000000);
+
+        fast.Merge(slow);
+        ASSERT_UINT_EQUALS(3, fast.GetSampleCount());
+        ASSERT_UINT_EQUALS(10, fast.GetMinNs());
+        ASSERT_UINT_EQUALS(5000000, fast.GetMaxNs());
+        ASSERT_UINT_EQUALS(5000030, fast.GetTotalNs());
+        ASSERT_UINT_EQUALS(5000000, fast.GetPercentileNs(99.0));
+
+        Aws::Crt::LatencyHistogram empty;
+        fast.Merge(empty);
+        ASSERT_UINT_EQUALS(3, fast.GetSampleCount());
+        ASSERT_UINT_EQUALS(10, fast.GetMinNs());
+    }
+
+    return AWS_ERROR_SUCCESS;
+}
+
+AWS_TEST_CASE(LatencyHistogramMerge, s_LatencyHistogramMerge)
@@ -0,0 +1,244 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+#include "LocalHttpServer.h"
+
+#include <aws/http/request_response.h>
+#include <aws/http/server.h>
+#include <aws/io/channel_bootstrap.h>
+#include <aws/io/socket.h>
+#include <aws/io/stream.h>
+
+#include <cstdio>
+
+using namespace Aws::Crt;
+
+/* One request being served; freed along with the server, after which nothing can refer to its stream */
+struct LocalHttpServer::RequestState
+{
+    LocalHttpServer *server = nullptr;
+    struct aws_http_stream *stream = nullptr;
+    struct aws_http_message *response = nullptr;
+    struct aws_input_stream *responseBody = nullptr;
+};
+
+LocalHttpServer::LocalHttpServer(Allocator *allocator, Io::EventLoopGroup &eventLoopGroup) noexcept
+    : m_allocator(allocator), m_eventLoopGroup(eventLoopGroup), m_bootstrap(nullptr), m_server(nullptr), m_port(0),
+      m_completedRequests(StlAllocator<RequestState *>(allocator)), m_currentRequest(nullptr), m_serverDestroyed(false)
+{
+}
+
+LocalHttpServer::~LocalHttpServer()
+{
+    if (m_server)
+    {
+        aws_http_server_release(m_server);
+        std::unique_lock<std::mutex> lock(m_lock);
+        m_signal.wait(lock, [this]() { return m_serverDestroyed; });
+    }
+
+    for (RequestState *request : m_completedRequests)
+    {
+        aws_http_stream_release(request->stream);
+        if (request->response)
+        {
+            aws_http_message_release(request->response);
+        }
+        if (request->responseBody)
+        {
+            aws_input_stream_release(request->responseBody);
+        }
+        Delete(request, m_allocator);
+    }
+
+    if (m_bootstrap)
+    {
+        aws_server_bootstrap_release(m_bootstrap);
+    }
+}
+
+bool LocalHttpServer::Start() noexcept
+{
+    m_bootstrap = aws_server_bootstrap_new(m_allocator, m_eventLoopGroup.GetUnderlyingHandle());
+    if (!m_bootstrap)
+    {
+        return false;
+    }
+
+    Io::SocketOptions socketOptions;
+    socketOptions.SetConnectTimeoutMs(3000);
+
+    struct aws_socket_endpoint endpoint;
+    AWS_ZERO_STRUCT(endpoint);
+    snprintf(endpoint.address, sizeof(endpoint.address), "127.0.0.1");
+
+    struct aws_http_server_options serverOptions;
+    AWS_ZERO_STRUCT(serverOptions);
+    serverOptions.self_size = sizeof(serverOptions);
+    serverOptions.allocator = m_allocator;
+    serverOptions.bootstrap = m_bootstrap;
+    serverOptions.endpoint = &endpoint;
+    serverOptions.socket_options = &socketOptions.GetImpl();
+    serverOptions.server_user_data = this;
+    serverOptions.on_incoming_connection = s_onIncomingConnection;
+    serverOptions.on_destroy_complete = s_onServerDestroyed;
+    if (InitialRequestWindow > 0)
+    {
+        serverOptions.manual_window_management = true;
+        serverOptions.initial_window_size = InitialRequestWindow;
+    }
+
+    m_server = aws_http_server_new(&serverOptions);
+    if (!m_server)
+    {
+        return false;
+    }
+
+    m_port = aws_http_server_get_listener_endpoint(m_server)->port;
+    return true;
+}
+
+void LocalHttpServer::OpenRequestWindow(size_t increment) noexcept
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    if (m_currentRequest)
+    {
+        aws_http_stream_update_window(m_currentRequest, increment);
+    }
+}
+
+void LocalHttpServer::s_onIncomingConnection(
+    struct aws_http_server *,
+    struct aws_http_connection *connection,
+    int errorCode,
+    void *userData) noexcept
+{
+    if (errorCode)
+    {
+        return;
+    }
+
+    struct aws_http_server_connection_options connectionOptions;
+    AWS_ZERO_STRUCT(connectionOptions);
+    connectionOptions.self_size = sizeof(connectionOptions);
+    connectionOptions.connection_user_data = userData;
+    connectionOptions.on_incoming_request = s_onIncomingRequest;
+
+    if (aws_http_connection_configure_server(connection, &connectionOptions))
+    {
+        aws_http_connection_release(connection);
+    }
+}
+
+struct aws_http_stream *LocalHttpServer::s_onIncomingRequest(
+    struct aws_http_connection *connection,
+    void *userData) noexcept
+{
+    auto *server = static_cast<LocalHttpServer *>(userData);
+    auto *request = New<RequestState>(server->m_allocator);
+    if (!request)
+    {
+        return nullptr;
+    }
+    request->server = server;
+
+    struct aws_http_request_handler_options handlerOptions;
+    AWS_ZERO_STRUCT(handlerOptions);
+    handlerOptions.self_size = sizeof(handlerOptions);
+    handlerOptions.server_connection = connection;
+    handlerOptions.user_data = request;
+    handlerOptions.on_request_body = s_onRequestBody;
+    handlerOptions.on_request_done = s_onRequestDone;
+    handlerOptions.on_complete = s_onRequestComplete;
+
+    request->stream = aws_http_stream_new_server_request_handler(&handlerOptions);
+    if (!request->stream)
+    {
+        Delete(request, server->m_allocator);
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(server->m_lock);
+    server->m_currentRequest = request->stream;
+    return request->stream;
+}
+
+int LocalHttpServer::s_onRequestBody(
+    struct aws_http_stream *,
+    const struct aws_byte_cursor *data,
+    void *userData) noexcept
+{
+    auto *request = static_cast<RequestState *>(userData);
+    if (request->server->OnRequestBody)
+    {
+        request->server->OnRequestBody(*data);
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+int LocalHttpServer::s_onRequestDone(struct aws_http_stream *stream, void *userData) noexcept
+{
+    auto *request = static_cast<RequestState *>(userData);
+    LocalHttpServer *server = request->server;
+
+    request->response = aws_http_message_new_response(server->m_allocator);
+    if (!request->response)
+    {
+        return AWS_OP_ERR;
+    }
+    aws_http_message_set_response_status(request->response, 200);
+
+    for (const auto &responseHeader : server->ResponseHeaders)
+    {
+        struct aws_http_header header;
+        AWS_ZERO_STRUCT(header);
+        header.name = aws_byte_cursor_from_c_str(responseHeader.first.c_str());
+        header.value = aws_byte_cursor_from_c_str(responseHeader.second.c_str());
+        aws_http_message_add_header(request->response, header);
+    }
+
+    char contentLength[32];
+    snprintf(contentLength, sizeof(contentLength), "%zu", server->ResponseBody.size());
+    struct aws_http_header contentLengthHeader;
+    AWS_ZERO_STRUCT(contentLengthHeader);
+    contentLengthHeader.name = aws_byte_cursor_from_c_str("content-length");
+    contentLengthHeader.value = aws_byte_cursor_from_c_str(contentLength);
+    aws_http_message_add_header(request->response, contentLengthHeader);
+
+    if (!server->ResponseBody.empty())
+    {
+        struct aws_byte_cursor body =
+            aws_byte_cursor_from_array(server->ResponseBody.data(), server->ResponseBody.size());
+        request->responseBody = aws_input_stream_new_from_cursor(server->m_allocator, &body);
+        if (!request->responseBody)
+        {
+            return AWS_OP_ERR;
+        }
+        aws_http_message_set_body_stream(request->response, request->responseBody);
+    }
+
+    return aws_http_stream_send_response(stream, request->response);
+}
+
+void LocalHttpServer::s_onRequestComplete(struct aws_http_stream *stream, int, void *userData) noexcept
+{
+    auto *request = static_cast<RequestState *>(userData);
+    LocalHttpServer *server = request->server;
+
+    std::lock_guard<std::mutex> lock(server->m_lock);
+    if (server->m_currentRequest == stream)
+    {
+        server->m_currentRequest = nullptr;
+    }
+    server->m_completedRequests.push_back(request);
+}
+
+void LocalHttpServer::s_onServerDestroyed(void *userData) noexcept
+{
+    auto *server = static_cast<LocalHttpServer *>(userData);
+    std::lock_guard<std::mutex> lock(server->m_lock);
+    server->m_serverDestroyed = true;
+    server->m_signal.notify_one();
+}
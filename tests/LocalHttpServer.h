@@ -0,0 +1,84 @@
+#pragma once
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+#include <aws/crt/Types.h>
+#include <aws/crt/io/EventLoopGroup.h>
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+
+struct aws_http_connection;
+struct aws_http_server;
+struct aws_http_stream;
+struct aws_server_bootstrap;
+
+/*
+ * Plain-text HTTP/1.1 server on 127.0.0.1, for tests that need a peer they control.  Every request is answered, once
+ * its body has been read, with a 200 carrying ResponseHeaders and ResponseBody.
+ */
+class LocalHttpServer
+{
+  public:
+    LocalHttpServer(Aws::Crt::Allocator *allocator, Aws::Crt::Io::EventLoopGroup &eventLoopGroup) noexcept;
+    ~LocalHttpServer();
+
+    LocalHttpServer(const LocalHttpServer &) = delete;
+    LocalHttpServer &operator=(const LocalHttpServer &) = delete;
+
+    /* Response sent for every request.  Set before Start(). */
+    Aws::Crt::Vector<std::pair<Aws::Crt::String, Aws::Crt::String>> ResponseHeaders;
+    Aws::Crt::String ResponseBody;
+
+    /*
+     * If non-zero, the server reads at most this many bytes of each request body until OpenRequestWindow() lets it
+     * read more.  Set before Start().
+     */
+    size_t InitialRequestWindow = 0;
+
+    /* Invoked, on the server's event loop, with each piece of request body as it is read */
+    std::function<void(Aws::Crt::ByteCursor data)> OnRequestBody;
+
+    /*
+     * Starts listening on an ephemeral port.
+     *
+     * @return true on success, false with the error raised otherwise
+     */
+    bool Start() noexcept;
+
+    uint32_t GetPort() const noexcept { return m_port; }
+
+    /* Lets the server read `increment` more bytes of the request body it is currently reading, if any */
+    void OpenRequestWindow(size_t increment) noexcept;
+
+  private:
+    struct RequestState;
+
+    static void s_onIncomingConnection(
+        struct aws_http_server *server,
+        struct aws_http_connection *connection,
+        int errorCode,
+        void *userData) noexcept;
+    static struct aws_http_stream *s_onIncomingRequest(struct aws_http_connection *connection, void *userData) noexcept;
+    static int s_onRequestBody(
+        struct aws_http_stream *stream,
+        const struct aws_byte_cursor *data,
+        void *userData) noexcept;
+    static int s_onRequestDone(struct aws_http_stream *stream, void *userData) noexcept;
+    static void s_onRequestComplete(struct aws_http_stream *stream, int errorCode, void *userData) noexcept;
+    static void s_onServerDestroyed(void *userData) noexcept;
+
+    Aws::Crt::Allocator *m_allocator;
+    Aws::Crt::Io::EventLoopGroup &m_eventLoopGroup;
+    struct aws_server_bootstrap *m_bootstrap;
+    struct aws_http_server *m_server;
+    uint32_t m_port;
+
+    std::mutex m_lock;
+    std::condition_variable m_signal;
+    Aws::Crt::Vector<RequestState *> m_completedRequests;
+    struct aws_http_stream *m_currentRequest;
+    bool m_serverDestroyed;
+};
@@ -9,10 +9,12 @@
 #include <aws/crt/http/HttpProxyStrategy.h>
 #include <aws/crt/mqtt/Mqtt5Packets.h>
 #include <aws/iot/Mqtt5Client.h>
+#include <aws/iot/Mqtt5ConnectScheduler.h>
 #include <aws/iot/MqttCommon.h>
 #include <aws/testing/aws_test_harness.h>
 
 #include <atomic>
+#include <chrono>
 #include <thread>
 #include <utility>
 
@@ -2859,6 +2861,111 @@ static int s_TestMqtt5OperationStatisticsSimple(Aws::Crt::Allocator *allocator,
 }
 AWS_TEST_CASE(Mqtt5OperationStatisticsSimple, s_TestMqtt5OperationStatisticsSimple)
 
+static int s_enableRttEstimation(Mqtt5ClientOptions &options, const Mqtt5TestEnvVars &, Mqtt5TestContext &)
+{
+    options.WithRttEstimationEnabled(true);
+
+    return AWS_OP_SUCCESS;
+}
+
+/*
+ * [Misc] round-trip estimation from acknowledged operations
+ */
+static int s_TestMqtt5OperationStatisticsRttEstimate(Aws::Crt::Allocator *allocator, void *)
+{
+    ApiHandle apiHandle(allocator);
+
+    const String TEST_TOPIC = "test/MQTT5_Binding_CPP" + Aws::Crt::UUID().ToString();
+
+    Mqtt5TestContext testContext = createTestContext(allocator, MQTT5CONNECT_DIRECT_IOT_CORE, s_enableRttEstimation);
+    if (testContext.testDirective == AWS_OP_SKIP)
+    {
+        return AWS_OP_SKIP;
+    }
+
+    std::shared_ptr<Mqtt5Client> mqtt5Client = testContext.client;
+    ASSERT_TRUE(mqtt5Client);
+
+    ASSERT_TRUE(mqtt5Client->Start());
+    ASSERT_TRUE(testContext.connectionPromise.get_future().get());
+
+    Mqtt5::Mqtt5ClientOperationStatistics statistics = mqtt5Client->GetOperationStatistics();
+    ASSERT_INT_EQUALS(0, statistics.rttSampleCount);
+    ASSERT_INT_EQUALS(0, statistics.derivedAckTimeoutSec);
+
+    ByteBuf payload = Aws::Crt::ByteBufFromCString("Hello World");
+    std::shared_ptr<Mqtt5::PublishPacket> publish = Aws::Crt::MakeShared<Mqtt5::PublishPacket>(
+        allocator, TEST_TOPIC, ByteCursorFromByteBuf(payload), Mqtt5::QOS::AWS_MQTT5_QOS_AT_LEAST_ONCE, allocator);
+    std::promise<void> publishComplete;
+    ASSERT_TRUE(mqtt5Client->Publish(
+        publish, [&publishComplete](int, std::shared_ptr<Mqtt5::PublishResult>) { publishComplete.set_value(); }));
+    publishComplete.get_future().get();
+
+    statistics = mqtt5Client->GetOperationStatistics();
+    ASSERT_INT_EQUALS(1, statistics.rttSampleCount);
+    ASSERT_TRUE(statistics.derivedAckTimeoutSec >= 1);
+    ASSERT_TRUE(statistics.derivedPingTimeoutMs >= 1000);
+
+    ASSERT_TRUE(mqtt5Client->Stop());
+    testContext.stoppedPromise.get_future().get();
+
+    return AWS_OP_SUCCESS;
+}
+AWS_TEST_CASE(Mqtt5OperationStatisticsRttEstimate, s_TestMqtt5OperationStatisticsRttEstimate)
+
+/*
+ * [Misc] operations queued while offline don't count towards the round-trip estimate
+ */
+static int s_TestMqtt5OperationStatisticsRttEstimateOfflineQueue(Aws::Crt::Allocator *allocator, void *)
+{
+    ApiHandle apiHandle(allocator);
+
+    const String TEST_TOPIC = "test/MQTT5_Binding_CPP" + Aws::Crt::UUID().ToString();
+
+    Mqtt5TestContext testContext = createTestContext(allocator, MQTT5CONNECT_DIRECT_IOT_CORE, s_enableRttEstimation);
+    if (testContext.testDirective == AWS_OP_SKIP)
+    {
+        return AWS_OP_SKIP;
+    }
+
+    std::shared_ptr<Mqtt5Client> mqtt5Client = testContext.client;
+    ASSERT_TRUE(mqtt5Client);
+
+    ByteBuf payload = Aws::Crt::ByteBufFromCString("Hello World");
+    std::shared_ptr<Mqtt5::PublishPacket> publish = Aws::Crt::MakeShared<Mqtt5::PublishPacket>(
+        allocator, TEST_TOPIC, ByteCursorFromByteBuf(payload), Mqtt5::QOS::AWS_MQTT5_QOS_AT_LEAST_ONCE, allocator);
+
+    /* Queued before the client is started, so it sits in the offline queue until the connection is up */
+    std::promise<int> offlinePublishComplete;
+    ASSERT_TRUE(mqtt5Client->Publish(
+        publish,
+        [&offlinePublishComplete](int errorCode, std::shared_ptr<Mqtt5::PublishResult>)
+        { offlinePublishComplete.set_value(errorCode); }));
+
+    ASSERT_TRUE(mqtt5Client->Start());
+    ASSERT_TRUE(testContext.connectionPromise.get_future().get());
+    ASSERT_INT_EQUALS(AWS_ERROR_SUCCESS, offlinePublishComplete.get_future().get());
+
+    Mqtt5::Mqtt5ClientOperationStatistics statistics = mqtt5Client->GetOperationStatistics();
+    ASSERT_INT_EQUALS(0, statistics.rttSampleCount);
+
+    std::promise<int> onlinePublishComplete;
+    ASSERT_TRUE(mqtt5Client->Publish(
+        publish,
+        [&onlinePublishComplete](int errorCode, std::shared_ptr<Mqtt5::PublishResult>)
+        { onlinePublishComplete.set_value(errorCode); }));
+    ASSERT_INT_EQUALS(AWS_ERROR_SUCCESS, onlinePublishComplete.get_future().get());
+
+    statistics = mqtt5Client->GetOperationStatistics();
+    ASSERT_INT_EQUALS(1, statistics.rttSampleCount);
+
+    ASSERT_TRUE(mqtt5Client->Stop());
+    testContext.stoppedPromise.get_future().get();
+
+    return AWS_OP_SUCCESS;
+}
+AWS_TEST_CASE(Mqtt5OperationStatisticsRttEstimateOfflineQueue, s_TestMqtt5OperationStatisticsRttEstimateOfflineQueue)
+
 /* Mqtt5-to-Mqtt3 Adapter Test */
 
 /* Test Helper Functions */
@@ -3543,4 +3650,155 @@ static int s_TestMqtt5to3AdapterMultipleAdapters(Aws::Crt::Allocator *allocator,
 
 AWS_TEST_CASE(Mqtt5to3AdapterMultipleAdapters, s_TestMqtt5to3AdapterMultipleAdapters)
 
+/*
+ * A scheduler with no clients reports all clients connected as soon as it starts and refuses a second start
+ */
+static int s_TestMqtt5ConnectSchedulerEmptyFleet(Aws::Crt::Allocator *allocator, void *)
+{
+    ApiHandle apiHandle(allocator);
+
+    std::promise<Aws::Iot::Mqtt5ConnectSchedulerStatistics> allConnectedPromise;
+    Aws::Iot::Mqtt5ConnectSchedulerOptions schedulerOptions;
+    schedulerOptions.WithConnectsPerSecond(10).WithBurstSize(2).WithMaxStartJitterMs(100);
+    schedulerOptions.WithAllClientsConnectedCallback(
+        [&allConnectedPromise](const Aws::Iot::Mqtt5ConnectSchedulerStatistics &statistics)
+        { allConnectedPromise.set_value(statistics); });
+
+    auto scheduler = Aws::Iot::Mqtt5ConnectScheduler::NewMqtt5ConnectScheduler(schedulerOptions, allocator);
+    ASSERT_NOT_NULL(scheduler);
+
+    ASSERT_TRUE(scheduler->Start());
+    ASSERT_FALSE(scheduler->Start());
+
+    Aws::Iot::Mqtt5ConnectSchedulerStatistics statistics = allConnectedPromise.get_future().get();
+    ASSERT_UINT_EQUALS(0, statistics.clientCount);
+    ASSERT_UINT_EQUALS(0, statistics.startedClientCount);
+    ASSERT_TRUE(statistics.timeToAllConnectedMs.has_value());
+    ASSERT_TRUE(scheduler->GetStatistics().timeToAllConnectedMs.has_value());
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(Mqtt5ConnectSchedulerEmptyFleet, s_TestMqtt5ConnectSchedulerEmptyFleet)
+
+/* The id of the thread running the single event loop of `eventLoopGroup` */
+static std::thread::id s_GetEventLoopThreadId(Aws::Crt::Io::EventLoopGroup &eventLoopGroup)
+{
+    std::promise<std::thread::id> threadIdPromise;
+    if (!eventLoopGroup.GetLoopAt(0).Schedule([&threadIdPromise](Aws::Crt::Io::TaskStatus)
+                                              { threadIdPromise.set_value(std::this_thread::get_id()); }))
+    {
+        return std::thread::id();
+    }
+
+    return threadIdPromise.get_future().get();
+}
+
+/*
+ * A fleet is started at the configured pace, spread across the scheduler's bootstraps, and the builder it was built
+ * from is left reusable
+ */
+static int s_TestMqtt5ConnectSchedulerPacedFleet(Aws::Crt::Allocator *allocator, void *)
+{
+    ApiHandle apiHandle(allocator);
+
+    Aws::Crt::Io::EventLoopGroup eventLoopGroupA(1, allocator);
+    Aws::Crt::Io::EventLoopGroup eventLoopGroupB(1, allocator);
+    Aws::Crt::Io::DefaultHostResolver defaultHostResolver(eventLoopGroupA, 8, 30, allocator);
+    Aws::Crt::Io::ClientBootstrap bootstrapA(eventLoopGroupA, defaultHostResolver, allocator);
+    Aws::Crt::Io::ClientBootstrap bootstrapB(eventLoopGroupB, defaultHostResolver, allocator);
+    ASSERT_TRUE(bootstrapA);
+    ASSERT_TRUE(bootstrapB);
+
+    /* Nothing listens on the endpoint; the clients only have to be started */
+    Aws::Iot::Mqtt5CustomAuthConfig authConfig(allocator);
+    authConfig.WithAuthorizerName("scheduler-test");
+    authConfig.WithUsername("scheduler-test");
+    auto builder =
+        Aws::Iot::Mqtt5ClientBuilder::CreateMqtt5ClientBuilderWithCustomAuthorizer("localhost", authConfig, allocator);
+    ASSERT_TRUE(builder);
+    builder->WithPort(1883);
+
+    /* Each client attempts its connects on the event loop it was bound to when built */
+    std::mutex attemptLock;
+    Aws::Crt::Map<size_t, std::thread::id> clientThreads;
+
+    const size_t fleetSize = 4;
+    const double connectsPerSecond = 20;
+    Aws::Iot::Mqtt5ConnectSchedulerOptions schedulerOptions;
+    schedulerOptions.WithConnectsPerSecond(connectsPerSecond).WithBurstSize(1);
+    schedulerOptions.WithBootstraps({&bootstrapA, &bootstrapB});
+
+    auto scheduler = Aws::Iot::Mqtt5ConnectScheduler::NewMqtt5ConnectScheduler(schedulerOptions, allocator);
+    ASSERT_NOT_NULL(scheduler);
+
+    Aws::Crt::Vector<std::shared_ptr<Mqtt5::Mqtt5Client>> clients;
+    for (size_t i = 0; i < fleetSize; ++i)
+    {
+        builder->WithClientAttemptingConnectCallback(
+            [&attemptLock, &clientThreads, i](const Mqtt5::OnAttemptingConnectEventData &)
+            {
+                std::lock_guard<std::mutex> lock(attemptLock);
+                clientThreads.emplace(i, std::this_thread::get_id());
+            });
+        auto client = scheduler->Build(*builder);
+        ASSERT_NOT_NULL(client);
+        clients.push_back(std::move(client));
+    }
+    ASSERT_UINT_EQUALS(fleetSize, scheduler->GetStatistics().clientCount);
+
+    /* The builder still builds clients of its own */
+    ASSERT_NOT_NULL(builder->Build());
+
+    auto startTime = std::chrono::steady_clock::now();
+    ASSERT_TRUE(scheduler->Start());
+    ASSERT_TRUE(scheduler->GetStatistics().startedClientCount < fleetSize);
+
+    while (scheduler->GetStatistics().startedClientCount < fleetSize)
+    {
+        ASSERT_TRUE(std::chrono::steady_clock::now() - startTime < std::chrono::seconds(10));
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+
+    /* One burst token up front, then one client per 1 / connectsPerSecond */
+    auto elapsed = std::chrono::steady_clock::now() - startTime;
+    auto minimumElapsed = std::chrono::milliseconds(static_cast<int64_t>((fleetSize - 1) * 1000 / connectsPerSecond));
+    ASSERT_TRUE(elapsed >= minimumElapsed - std::chrono::milliseconds(20));
+
+    /* Build() alternated between the bootstraps, so each event loop thread serves half of the fleet */
+    std::thread::id loopThreadA = s_GetEventLoopThreadId(eventLoopGroupA);
+    std::thread::id loopThreadB = s_GetEventLoopThreadId(eventLoopGroupB);
+    ASSERT_TRUE(loopThreadA != loopThreadB);
+    while (true)
+    {
+        ASSERT_TRUE(std::chrono::steady_clock::now() - startTime < std::chrono::seconds(10));
+        {
+            std::lock_guard<std::mutex> lock(attemptLock);
+            if (clientThreads.size() == fleetSize)
+            {
+                size_t clientsOnLoopA = 0;
+                size_t clientsOnLoopB = 0;
+                for (const auto &clientThread : clientThreads)
+                {
+                    clientsOnLoopA += clientThread.second == loopThreadA ? 1 : 0;
+                    clientsOnLoopB += clientThread.second == loopThreadB ? 1 : 0;
+                }
+                ASSERT_UINT_EQUALS(fleetSize / 2, clientsOnLoopA);
+                ASSERT_UINT_EQUALS(fleetSize / 2, clientsOnLoopB);
+                break;
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+
+    for (auto &client : clients)
+    {
+        client->Stop();
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(Mqtt5ConnectSchedulerPacedFleet, s_TestMqtt5ConnectSchedulerPacedFleet)
+
 #endif // !BYO_CRYPTO
@@ -15,6 +15,11 @@
 #include <aws/testing/aws_test_harness.h>
 
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <thread>
 #include <utility>
 
 enum ProtocolType
@@ -1188,3 +1193,436 @@ static int s_MqttRequestResponse_ShadowUpdatedStreamIncomingPublishSuccess311(Aw
 AWS_TEST_CASE(
     MqttRequestResponse_ShadowUpdatedStreamIncomingPublishSuccess311,
     s_MqttRequestResponse_ShadowUpdatedStreamIncomingPublishSuccess311)
+
+static int s_doGetNamedShadowCoalescedTest(Aws::Crt::Allocator *allocator, ProtocolType protocol)
+{
+    TestState state(allocator);
+    Aws::Crt::ApiHandle handle;
+
+    Aws::Iot::RequestResponse::RequestResponseClientOptions clientOptions;
+    clientOptions.WithMaxRequestResponseSubscriptions(4);
+    clientOptions.WithMaxStreamingSubscriptions(2);
+    clientOptions.WithOperationTimeoutInSeconds(30);
+    clientOptions.WithRequestCoalescingEnabled(true);
+    clientOptions.WithOperationMetricsEnabled(true);
+
+    auto context = s_CreateClient(allocator, protocol, &state, &clientOptions);
+    if (!context.client)
+    {
+        return AWS_OP_SKIP;
+    }
+
+    s_startProtocolClient(context);
+    s_waitForConnected(&state);
+
+    auto shadowName = Aws::Crt::UUID().ToString();
+
+    char subscriptionTopicFilter[256];
+    snprintf(
+        subscriptionTopicFilter,
+        AWS_ARRAY_SIZE(subscriptionTopicFilter),
+        "$aws/things/NoSuchThing/shadow/name/%s/get/+",
+        shadowName.c_str());
+
+    char acceptedTopic[256];
+    snprintf(
+        acceptedTopic,
+        AWS_ARRAY_SIZE(acceptedTopic),
+        "$aws/things/NoSuchThing/shadow/name/%s/get/accepted",
+        shadowName.c_str());
+
+    char rejectedTopic[256];
+    snprintf(
+        rejectedTopic,
+        AWS_ARRAY_SIZE(rejectedTopic),
+        "$aws/things/NoSuchThing/shadow/name/%s/get/rejected",
+        shadowName.c_str());
+
+    char publishTopic[256];
+    snprintf(
+        publishTopic, AWS_ARRAY_SIZE(publishTopic), "$aws/things/NoSuchThing/shadow/name/%s/get", shadowName.c_str());
+
+    struct aws_mqtt_request_operation_options requestOptions;
+    AWS_ZERO_STRUCT(requestOptions);
+
+    struct aws_byte_cursor subscription_topic_filters[1] = {
+        aws_byte_cursor_from_c_str(subscriptionTopicFilter),
+    };
+    requestOptions.subscription_topic_filters = subscription_topic_filters;
+    requestOptions.subscription_topic_filter_count = 1;
+
+    struct aws_mqtt_request_operation_response_path responsePaths[2];
+    AWS_ZERO_STRUCT(responsePaths[0]);
+    AWS_ZERO_STRUCT(responsePaths[1]);
+    responsePaths[0].topic = aws_byte_cursor_from_c_str(acceptedTopic);
+    responsePaths[1].topic = aws_byte_cursor_from_c_str(rejectedTopic);
+    requestOptions.response_paths = responsePaths;
+    requestOptions.response_path_count = 2;
+    requestOptions.publish_topic = aws_byte_cursor_from_c_str(publishTopic);
+    requestOptions.serialized_request = aws_byte_cursor_from_c_str("{}");
+
+    std::shared_ptr<ResponseTracker> trackers[2] = {s_addResponseTracker(&state), s_addResponseTracker(&state)};
+    for (const auto &tracker : trackers)
+    {
+        ResponseTracker *rawResponseTracker = tracker.get();
+        int result = context.client->SubmitRequest(
+            requestOptions,
+            [rawResponseTracker](Aws::Iot::RequestResponse::UnmodeledResult &&result)
+            { s_onRequestComplete(std::move(result), rawResponseTracker); });
+        ASSERT_INT_EQUALS(AWS_OP_SUCCESS, result);
+    }
+
+    for (const auto &tracker : trackers)
+    {
+        s_waitForResponse(tracker.get());
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(state.lock);
+        for (const auto &tracker : trackers)
+        {
+            ASSERT_INT_EQUALS(AWS_ERROR_SUCCESS, tracker->errorCode);
+            ASSERT_TRUE(tracker->topic == Aws::Crt::String(rejectedTopic));
+            ASSERT_TRUE(tracker->payload.find("No shadow exists with name") != std::string::npos);
+        }
+    }
+
+    Aws::Iot::RequestResponse::RequestResponseClientMetrics metrics = context.client->GetMetrics();
+    ASSERT_UINT_EQUALS(1, metrics.coalescedRequestCount);
+    ASSERT_UINT_EQUALS(1, metrics.completedRequestCount);
+    ASSERT_UINT_EQUALS(0, metrics.inFlightRequestCount);
+
+    return AWS_OP_SUCCESS;
+}
+
+static int s_MqttRequestResponse_GetNamedShadowCoalesced5(Aws::Crt::Allocator *allocator, void *)
+{
+    return s_doGetNamedShadowCoalescedTest(allocator, ProtocolType::Mqtt5);
+}
+AWS_TEST_CASE(MqttRequestResponse_GetNamedShadowCoalesced5, s_MqttRequestResponse_GetNamedShadowCoalesced5)
+
+static int s_MqttRequestResponse_GetNamedShadowCoalesced311(Aws::Crt::Allocator *allocator, void *)
+{
+    return s_doGetNamedShadowCoalescedTest(allocator, ProtocolType::Mqtt311);
+}
+AWS_TEST_CASE(MqttRequestResponse_GetNamedShadowCoalesced311, s_MqttRequestResponse_GetNamedShadowCoalesced311)
+
+struct DecodedShadowState
+{
+    int version = 0;
+    Aws::Crt::String color;
+};
+
+static bool s_decodeShadowStateFromJson(const Aws::Crt::JsonView &view, DecodedShadowState &target)
+{
+    if (!view.ValueExists("version") || !view.ValueExists("color"))
+    {
+        return false;
+    }
+
+    target.version = view.GetInteger("version");
+    target.color = view.GetString("color");
+    return true;
+}
+
+static bool s_decodeShadowStateFromCbor(Aws::Crt::Cbor::CborDecoder &decoder, DecodedShadowState &target)
+{
+    auto version = decoder.PopNextUnsignedIntVal();
+    auto color = decoder.PopNextTextVal();
+    if (!version.has_value() || !color.has_value())
+    {
+        return false;
+    }
+
+    target.version = static_cast<int>(version.value());
+    target.color = Aws::Crt::String(reinterpret_cast<const char *>(color->ptr), color->len);
+    return true;
+}
+
+static int s_MqttRequestResponse_JsonPayloadDecoder(Aws::Crt::Allocator *allocator, void *)
+{
+    Aws::Crt::ApiHandle apiHandle(allocator);
+
+    Aws::Iot::RequestResponse::JsonPayloadDecoder<DecodedShadowState> decoder(s_decodeShadowStateFromJson);
+    DecodedShadowState target;
+
+    ASSERT_TRUE(decoder.Decode(Aws::Crt::ByteCursorFromCString("{\"version\":3,\"color\":\"green\"}"), target));
+    ASSERT_INT_EQUALS(3, target.version);
+    ASSERT_TRUE(target.color == "green");
+
+    ASSERT_FALSE(decoder.Decode(Aws::Crt::ByteCursorFromCString("{\"version\":"), target));
+    ASSERT_FALSE(decoder.Decode(Aws::Crt::ByteCursorFromCString("{\"version\":4}"), target));
+
+    return AWS_OP_SUCCESS;
+}
+AWS_TEST_CASE(MqttRequestResponse_JsonPayloadDecoder, s_MqttRequestResponse_JsonPayloadDecoder)
+
+static int s_MqttRequestResponse_CborPayloadDecoder(Aws::Crt::Allocator *allocator, void *)
+{
+    Aws::Crt::ApiHandle apiHandle(allocator);
+
+    Aws::Crt::Cbor::CborEncoder encoder(allocator);
+    encoder.WriteUInt(7);
+    encoder.WriteText(Aws::Crt::ByteCursorFromCString("blue"));
+
+    Aws::Iot::RequestResponse::CborPayloadDecoder<DecodedShadowState> decoder(s_decodeShadowStateFromCbor, allocator);
+    DecodedShadowState target;
+
+    ASSERT_TRUE(decoder.Decode(encoder.GetEncodedData(), target));
+    ASSERT_INT_EQUALS(7, target.version);
+    ASSERT_TRUE(target.color == "blue");
+
+    ASSERT_FALSE(decoder.Decode(Aws::Crt::ByteCursorFromCString(""), target));
+
+    /* The decoder is reused across payloads, including after a failed one */
+    Aws::Crt::Cbor::CborEncoder nextEncoder(allocator);
+    nextEncoder.WriteUInt(8);
+    nextEncoder.WriteText(Aws::Crt::ByteCursorFromCString("red"));
+    ASSERT_TRUE(decoder.Decode(nextEncoder.GetEncodedData(), target));
+    ASSERT_INT_EQUALS(8, target.version);
+    ASSERT_TRUE(target.color == "red");
+
+    return AWS_OP_SUCCESS;
+}
+AWS_TEST_CASE(MqttRequestResponse_CborPayloadDecoder, s_MqttRequestResponse_CborPayloadDecoder)
+
+class CapturingStreamingOperation : public Aws::Iot::RequestResponse::IStreamingOperation
+{
+  public:
+    void Open() override {}
+};
+
+/* Request-response client that only records the streaming operations created on it */
+class CapturingRequestResponseClient : public Aws::Iot::RequestResponse::IMqttRequestResponseClient
+{
+  public:
+    int SubmitRequest(
+        const aws_mqtt_request_operation_options &,
+        Aws::Iot::RequestResponse::UnmodeledResultHandler &&) override
+    {
+        return aws_raise_error(AWS_ERROR_UNSUPPORTED_OPERATION);
+    }
+
+    std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation> CreateStream(
+        const Aws::Iot::RequestResponse::StreamingOperationOptionsInternal &options) override
+    {
+        capturedOptions = options;
+        return Aws::Crt::MakeShared<CapturingStreamingOperation>(Aws::Crt::ApiAllocator());
+    }
+
+    Aws::Iot::RequestResponse::StreamingOperationOptionsInternal capturedOptions;
+};
+
+static int s_MqttRequestResponse_DecodedStream(Aws::Crt::Allocator *allocator, void *)
+{
+    Aws::Crt::ApiHandle apiHandle(allocator);
+
+    CapturingRequestResponseClient client;
+    Aws::Iot::RequestResponse::DecodedStreamingOperationOptions<DecodedShadowState> options;
+
+    /* A decoder is required */
+    ASSERT_NULL(client.CreateDecodedStream(options, allocator));
+    ASSERT_INT_EQUALS(AWS_ERROR_INVALID_ARGUMENT, aws_last_error());
+
+    Aws::Crt::Vector<DecodedShadowState> decoded;
+    Aws::Crt::Vector<Aws::Crt::String> undecodable;
+    auto target = Aws::Crt::MakeShared<DecodedShadowState>(allocator);
+    options.WithSubscriptionTopicFilter(Aws::Crt::ByteCursorFromCString("shadow/updated"))
+        .WithPayloadDecoder(Aws::Crt::MakeShared<Aws::Iot::RequestResponse::JsonPayloadDecoder<DecodedShadowState>>(
+            allocator, s_decodeShadowStateFromJson))
+        .WithDecodeTarget(target)
+        .WithStreamHandler([&decoded](const DecodedShadowState &state) { decoded.push_back(state); })
+        .WithDecodeFailureHandler(
+            [&undecodable](Aws::Iot::RequestResponse::IncomingPublishEvent &&event)
+            {
+                Aws::Crt::ByteCursor payload = event.GetPayload();
+                undecodable.emplace_back(reinterpret_cast<const char *>(payload.ptr), payload.len);
+            });
+
+    auto stream = client.CreateDecodedStream(options, allocator);
+    ASSERT_NOT_NULL(stream);
+    ASSERT_TRUE(aws_byte_cursor_eq_c_str(&client.capturedOptions.subscriptionTopicFilter, "shadow/updated"));
+
+    auto &onIncomingPublish = client.capturedOptions.incomingPublishEventHandler;
+    const char *payloads[] = {
+        "{\"version\":1,\"color\":\"green\"}",
+        "not json",
+        "{\"version\":2,\"color\":\"blue\"}",
+    };
+    for (const char *payload : payloads)
+    {
+        Aws::Iot::RequestResponse::IncomingPublishEvent event;
+        event.WithTopic(Aws::Crt::ByteCursorFromCString("shadow/updated"))
+            .WithPayload(Aws::Crt::ByteCursorFromCString(payload));
+        onIncomingPublish(std::move(event));
+    }
+
+    /* Messages are decoded in order into the one target, and undecodable ones are handed over raw */
+    ASSERT_UINT_EQUALS(2, decoded.size());
+    ASSERT_INT_EQUALS(1, decoded[0].version);
+    ASSERT_TRUE(decoded[0].color == "green");
+    ASSERT_INT_EQUALS(2, decoded[1].version);
+    ASSERT_TRUE(decoded[1].color == "blue");
+    ASSERT_INT_EQUALS(2, target->version);
+
+    ASSERT_UINT_EQUALS(1, undecodable.size());
+    ASSERT_TRUE(undecodable[0] == "not json");
+
+    return AWS_OP_SUCCESS;
+}
+AWS_TEST_CASE(MqttRequestResponse_DecodedStream, s_MqttRequestResponse_DecodedStream)
+
+/*
+ * Operation metrics of a client whose protocol client never connects: requests are tracked while in flight and
+ * counted as timeouts once they expire, and streams are counted once however often they are opened
+ */
+static int s_MqttRequestResponse_OperationMetrics(Aws::Crt::Allocator *allocator, void *)
+{
+    Aws::Crt::ApiHandle apiHandle(allocator);
+
+    /* The protocol client gets its own loop so that the test can hold requests in flight */
+    Aws::Crt::Io::EventLoopGroup eventLoopGroup(1, allocator);
+    ASSERT_TRUE(eventLoopGroup);
+    Aws::Crt::Io::DefaultHostResolver defaultHostResolver(eventLoopGroup, 8, 30, allocator);
+    Aws::Crt::Io::ClientBootstrap bootstrap(eventLoopGroup, defaultHostResolver, allocator);
+    ASSERT_TRUE(bootstrap);
+    bootstrap.EnableBlockingShutdown();
+
+    Aws::Crt::Mqtt5::Mqtt5ClientOptions mqtt5Options(allocator);
+    mqtt5Options.WithHostName("localhost").WithPort(1883).WithBootstrap(&bootstrap);
+    auto protocolClient = Aws::Crt::Mqtt5::Mqtt5Client::NewMqtt5Client(mqtt5Options, allocator);
+    ASSERT_NOT_NULL(protocolClient);
+
+    Aws::Iot::RequestResponse::RequestResponseClientOptions clientOptions;
+    clientOptions.WithMaxRequestResponseSubscriptions(4);
+    clientOptions.WithMaxStreamingSubscriptions(2);
+    clientOptions.WithOperationTimeoutInSeconds(1);
+    clientOptions.WithOperationMetricsEnabled(true);
+    auto client = Aws::Iot::RequestResponse::NewClientFrom5(*protocolClient, clientOptions, allocator);
+    ASSERT_NOT_NULL(client);
+
+    /* Nothing submitted below can complete until the loop is released */
+    std::promise<void> releaseLoop;
+    std::shared_future<void> loopReleased = releaseLoop.get_future().share();
+    ASSERT_TRUE(
+        eventLoopGroup.GetLoopAt(0).Schedule([loopReleased](Aws::Crt::Io::TaskStatus) { loopReleased.wait(); }));
+
+    std::mutex lock;
+    std::condition_variable signal;
+    Aws::Crt::Vector<int> errorCodes;
+
+    struct
+    {
+        const char *publishTopic;
+        const char *correlationToken;
+    } requests[] = {
+        {"metrics/request", "token-1"},
+        {"metrics/request", "token-2"},
+        {"$aws/things/thing-1/shadow/name/shadow-a/get", "token-3"},
+        {"$aws/things/thing-2/shadow/name/shadow-b/get", "token-4"},
+    };
+    for (const auto &request : requests)
+    {
+        struct aws_byte_cursor subscriptionTopicFilters[1] = {
+            aws_byte_cursor_from_c_str("metrics/response/+"),
+        };
+        struct aws_mqtt_request_operation_response_path responsePaths[1];
+        AWS_ZERO_STRUCT(responsePaths[0]);
+        responsePaths[0].topic = aws_byte_cursor_from_c_str("metrics/response/accepted");
+        responsePaths[0].correlation_token_json_path = aws_byte_cursor_from_c_str("clientToken");
+
+        struct aws_mqtt_request_operation_options requestOptions;
+        AWS_ZERO_STRUCT(requestOptions);
+        requestOptions.subscription_topic_filters = subscriptionTopicFilters;
+        requestOptions.subscription_topic_filter_count = 1;
+        requestOptions.response_paths = responsePaths;
+        requestOptions.response_path_count = 1;
+        requestOptions.publish_topic = aws_byte_cursor_from_c_str(request.publishTopic);
+        requestOptions.correlation_token = aws_byte_cursor_from_c_str(request.correlationToken);
+        requestOptions.serialized_request = aws_byte_cursor_from_c_str(request.correlationToken);
+
+        ASSERT_SUCCESS(client->SubmitRequest(
+            requestOptions,
+            [&lock, &signal, &errorCodes](Aws::Iot::RequestResponse::UnmodeledResult &&result)
+            {
+                {
+                    std::lock_guard<std::mutex> guard(lock);
+                    errorCodes.push_back(result.IsSuccess() ? AWS_ERROR_SUCCESS : result.GetError());
+                }
+                signal.notify_one();
+            }));
+    }
+
+    /* A request the protocol client rejects leaves no trace behind */
+    {
+        struct aws_mqtt_request_operation_options requestOptions;
+        AWS_ZERO_STRUCT(requestOptions);
+        requestOptions.publish_topic = aws_byte_cursor_from_c_str("metrics/rejected");
+        requestOptions.serialized_request = aws_byte_cursor_from_c_str("rejected");
+
+        ASSERT_FAILS(client->SubmitRequest(requestOptions, [](Aws::Iot::RequestResponse::UnmodeledResult &&) {}));
+    }
+
+    Aws::Iot::RequestResponse::RequestResponseClientMetrics metrics = client->GetMetrics();
+    ASSERT_UINT_EQUALS(4, metrics.maxRequestResponseSubscriptions);
+    ASSERT_UINT_EQUALS(2, metrics.maxStreamingSubscriptions);
+    ASSERT_UINT_EQUALS(4, metrics.inFlightRequestCount);
+    ASSERT_UINT_EQUALS(4, metrics.inFlightCorrelatedRequestCount);
+    ASSERT_UINT_EQUALS(0, metrics.duplicateCorrelationTokenCount);
+    ASSERT_UINT_EQUALS(0, metrics.completedRequestCount);
+
+    /* All requests share one subscription topic filter */
+    ASSERT_UINT_EQUALS(1, metrics.requestResponseSubscriptionsInUse);
+
+    /* Requests for different things and shadows are counted as one operation */
+    ASSERT_UINT_EQUALS(2, metrics.operations.size());
+    ASSERT_UINT_EQUALS(2, metrics.operations["metrics/request"].submittedCount);
+    ASSERT_UINT_EQUALS(2, metrics.operations["$aws/things/+/shadow/name/+/get"].submittedCount);
+
+    releaseLoop.set_value();
+
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        ASSERT_TRUE(signal.wait_for(guard, std::chrono::seconds(30), [&errorCodes] { return errorCodes.size() == 4; }));
+    }
+
+    metrics = client->GetMetrics();
+    ASSERT_UINT_EQUALS(0, metrics.inFlightRequestCount);
+    ASSERT_UINT_EQUALS(0, metrics.inFlightCorrelatedRequestCount);
+    ASSERT_UINT_EQUALS(0, metrics.requestResponseSubscriptionsInUse);
+    ASSERT_UINT_EQUALS(4, metrics.completedRequestCount);
+    ASSERT_UINT_EQUALS(4, metrics.timeoutCount);
+    ASSERT_UINT_EQUALS(2, metrics.operations.size());
+    for (const auto &entry : metrics.operations)
+    {
+        const Aws::Iot::RequestResponse::RequestResponseOperationMetrics &operation = entry.second;
+        ASSERT_UINT_EQUALS(0, operation.successCount);
+        ASSERT_UINT_EQUALS(2, operation.failureCount);
+        ASSERT_UINT_EQUALS(2, operation.timeoutCount);
+        ASSERT_UINT_EQUALS(2, operation.latency.GetSampleCount());
+    }
+    ASSERT_TRUE(metrics.GetTimeoutRate() == 1.0);
+
+    /* Concurrent opens of one stream count it once, and closing it releases it */
+    Aws::Iot::RequestResponse::StreamingOperationOptionsInternal streamOptions;
+    streamOptions.subscriptionTopicFilter = aws_byte_cursor_from_c_str("metrics/stream");
+    auto stream = client->CreateStream(streamOptions);
+    ASSERT_NOT_NULL(stream);
+
+    Aws::Crt::Vector<std::thread> openers;
+    for (size_t i = 0; i < 4; ++i)
+    {
+        openers.emplace_back([&stream] { stream->Open(); });
+    }
+    for (auto &opener : openers)
+    {
+        opener.join();
+    }
+    ASSERT_UINT_EQUALS(1, client->GetMetrics().streamingSubscriptionsInUse);
+
+    stream = nullptr;
+    ASSERT_UINT_EQUALS(0, client->GetMetrics().streamingSubscriptionsInUse);
+
+    return AWS_OP_SUCCESS;
+}
+AWS_TEST_CASE(MqttRequestResponse_OperationMetrics, s_MqttRequestResponse_OperationMetrics)
@@ -16,8 +16,13 @@
 
 #include <aws/testing/aws_test_harness.h>
 
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <future>
 #include <mutex>
+#include <string>
+#include <thread>
 
 using namespace Aws;
 using namespace Aws::Crt;
@@ -1218,3 +1223,143 @@ static int s_TestMqttViaHttpProxyAlpnBasicAuth(struct aws_allocator *allocator,
 AWS_TEST_CASE(MqttViaHttpProxyAlpnBasicAuth, s_TestMqttViaHttpProxyAlpnBasicAuth)
 
 #endif // !BYO_CRYPTO
+
+static int s_TestCachedProxyCredentialTtlAndClear(struct aws_allocator *allocator, void *ctx)
+{
+    (void)ctx;
+    {
+        Aws::Crt::ApiHandle apiHandle(allocator);
+
+        size_t fetchCount = 0;
+        bool fetchSucceeds = true;
+        KerberosGetTokenFunction fetchCredential = [&](String &credential)
+        {
+            ++fetchCount;
+            credential = "credential-" + String(std::to_string(fetchCount).c_str());
+            return fetchSucceeds;
+        };
+
+        /* Without a ttl, every Get() fetches */
+        {
+            CachedProxyCredential uncached(0);
+            String credential;
+            ASSERT_TRUE(uncached.Get(fetchCredential, credential));
+            ASSERT_TRUE(uncached.Get(fetchCredential, credential));
+            ASSERT_UINT_EQUALS(2, fetchCount);
+            ASSERT_TRUE(credential == "credential-2");
+        }
+
+        fetchCount = 0;
+        CachedProxyCredential cached(200);
+        String credential;
+
+        /* A failed fetch is not cached */
+        fetchSucceeds = false;
+        ASSERT_FALSE(cached.Get(fetchCredential, credential));
+        fetchSucceeds = true;
+
+        /* Within the ttl, the fetched credential is reused */
+        ASSERT_TRUE(cached.Get(fetchCredential, credential));
+        ASSERT_TRUE(credential == "credential-2");
+        ASSERT_TRUE(cached.Get(fetchCredential, credential));
+        ASSERT_TRUE(credential == "credential-2");
+        ASSERT_UINT_EQUALS(2, fetchCount);
+
+        /* Clearing forces a fetch */
+        cached.Clear();
+        ASSERT_TRUE(cached.Get(fetchCredential, credential));
+        ASSERT_TRUE(credential == "credential-3");
+        ASSERT_UINT_EQUALS(3, fetchCount);
+
+        /* Once the ttl has passed, the credential is fetched again */
+        std::this_thread::sleep_for(std::chrono::milliseconds(300));
+        ASSERT_TRUE(cached.Get(fetchCredential, credential));
+        ASSERT_TRUE(credential == "credential-4");
+        ASSERT_TRUE(cached.Get(fetchCredential, credential));
+        ASSERT_UINT_EQUALS(4, fetchCount);
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(CachedProxyCredentialTtlAndClear, s_TestCachedProxyCredentialTtlAndClear)
+
+namespace
+{
+    class ClearCountingProxyStrategy : public HttpProxyStrategy
+    {
+      public:
+        ClearCountingProxyStrategy(struct aws_http_proxy_strategy *strategy) : HttpProxyStrategy(strategy), m_clears(0)
+        {
+        }
+
+        void ClearCachedCredentials() noexcept override { ++m_clears; }
+
+        std::atomic<size_t> m_clears;
+    };
+} // namespace
+
+static int s_TestProxiedConnectionManagerClearsCredentialsOnFailure(struct aws_allocator *allocator, void *ctx)
+{
+    (void)ctx;
+    {
+        Aws::Crt::ApiHandle apiHandle(allocator);
+
+        Io::EventLoopGroup eventLoopGroup(1, allocator);
+        ASSERT_TRUE(eventLoopGroup);
+        Io::DefaultHostResolver hostResolver(eventLoopGroup, 8, 30, allocator);
+        ASSERT_TRUE(hostResolver);
+        Io::ClientBootstrap clientBootstrap(eventLoopGroup, hostResolver, allocator);
+        ASSERT_TRUE(clientBootstrap);
+
+        struct aws_http_proxy_strategy_basic_auth_options basicConfig;
+        AWS_ZERO_STRUCT(basicConfig);
+        basicConfig.proxy_connection_type = AWS_HPCT_HTTP_TUNNEL;
+        basicConfig.user_name = aws_byte_cursor_from_c_str("user");
+        basicConfig.password = aws_byte_cursor_from_c_str("password");
+        struct aws_http_proxy_strategy *rawStrategy = aws_http_proxy_strategy_new_basic_auth(allocator, &basicConfig);
+        ASSERT_NOT_NULL(rawStrategy);
+        auto strategy = Aws::Crt::MakeShared<ClearCountingProxyStrategy>(allocator, rawStrategy);
+
+        Io::SocketOptions socketOptions;
+        socketOptions.SetConnectTimeoutMs(3000);
+
+        /* Nothing listens on the proxy port, so every connection the manager opens fails */
+        HttpClientConnectionProxyOptions proxyOptions;
+        proxyOptions.HostName = "127.0.0.1";
+        proxyOptions.Port = 1;
+        proxyOptions.ProxyConnectionType = AwsHttpProxyConnectionType::Tunneling;
+        proxyOptions.ProxyStrategy = strategy;
+
+        HttpClientConnectionManagerOptions connectionManagerOptions;
+        connectionManagerOptions.ConnectionOptions.Bootstrap = &clientBootstrap;
+        connectionManagerOptions.ConnectionOptions.SocketOptions = socketOptions;
+        connectionManagerOptions.ConnectionOptions.HostName = "127.0.0.1";
+        connectionManagerOptions.ConnectionOptions.Port = 80;
+        connectionManagerOptions.ConnectionOptions.ProxyOptions = proxyOptions;
+        connectionManagerOptions.MaxConnections = 1;
+
+        auto connectionManager =
+            HttpClientConnectionManager::NewClientConnectionManager(connectionManagerOptions, allocator);
+        ASSERT_NOT_NULL(connectionManager);
+
+        std::promise<int> acquisitionResult;
+        connectionManager->AcquireConnection(
+            [&](std::shared_ptr<HttpClientConnection> connection, int errorCode)
+            {
+                (void)connection;
+                acquisitionResult.set_value(errorCode);
+            });
+
+        ASSERT_TRUE(acquisitionResult.get_future().get() != AWS_ERROR_SUCCESS);
+        ASSERT_TRUE(strategy->m_clears.load() >= 1);
+
+        connectionManager->InitiateShutdown().get();
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(
+    ProxiedConnectionManagerClearsCredentialsOnFailure,
+    s_TestProxiedConnectionManagerClearsCredentialsOnFailure)
@@ -0,0 +1,105 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+#include <aws/crt/Api.h>
+#include <aws/crt/SpscByteRingBuffer.h>
+
+#include <aws/testing/aws_test_harness.h>
+
+#include <thread>
+
+static int s_SpscByteRingBufferWrapAround(Aws::Crt::Allocator *allocator, void *ctx)
+{
+    (void)ctx;
+    {
+        Aws::Crt::ApiHandle apiHandle(allocator);
+
+        Aws::Crt::SpscByteRingBuffer ringBuffer(7, allocator);
+        ASSERT_TRUE(ringBuffer);
+        ASSERT_UINT_EQUALS(7, ringBuffer.GetCapacity());
+
+        uint8_t input[10] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+        uint8_t output[10] = {0};
+
+        ASSERT_UINT_EQUALS(5, ringBuffer.Write(Aws::Crt::ByteCursorFromArray(input, 5)));
+
+        Aws::Crt::ByteBuf dest = Aws::Crt::ByteBufFromEmptyArray(output, 3);
+        ASSERT_UINT_EQUALS(3, ringBuffer.Read(dest));
+        ASSERT_UINT_EQUALS(3, dest.len);
+        ASSERT_UINT_EQUALS(2, output[2]);
+
+        /* only 5 of the 10 bytes fit, and they wrap around the end of the storage */
+        ASSERT_UINT_EQUALS(5, ringBuffer.Write(Aws::Crt::ByteCursorFromArray(input, 10)));
+        ASSERT_UINT_EQUALS(7, ringBuffer.GetSize());
+        ASSERT_UINT_EQUALS(0, ringBuffer.GetFreeSpace());
+        ASSERT_UINT_EQUALS(0, ringBuffer.Write(Aws::Crt::ByteCursorFromArray(input, 1)));
+
+        uint8_t next = 0;
+        ASSERT_TRUE(ringBuffer.Peek(next));
+        ASSERT_UINT_EQUALS(3, next);
+
+        dest = Aws::Crt::ByteBufFromEmptyArray(output, sizeof(output));
+        ASSERT_UINT_EQUALS(7, ringBuffer.Read(dest));
+        uint8_t expected[7] = {3, 4, 0, 1, 2, 3, 4};
+        ASSERT_BIN_ARRAYS_EQUALS(expected, sizeof(expected), dest.buffer, dest.len);
+
+        ASSERT_FALSE(ringBuffer.Peek(next));
+        ASSERT_UINT_EQUALS(0, ringBuffer.GetSize());
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(SpscByteRingBufferWrapAround, s_SpscByteRingBufferWrapAround)
+
+static int s_SpscByteRingBufferProducerConsumer(Aws::Crt::Allocator *allocator, void *ctx)
+{
+    (void)ctx;
+    {
+        Aws::Crt::ApiHandle apiHandle(allocator);
+
+        /* chunk sizes share no factor with the capacity so that reads and writes straddle the wrap point */
+        Aws::Crt::SpscByteRingBuffer ringBuffer(1000, allocator);
+        ASSERT_TRUE(ringBuffer);
+
+        const size_t totalBytes = 1000000;
+        std::thread producer(
+            [&ringBuffer, totalBytes]()
+            {
+                uint8_t chunk[97];
+                size_t written = 0;
+                while (written < totalBytes)
+                {
+                    size_t chunkSize = totalBytes - written < sizeof(chunk) ? totalBytes - written : sizeof(chunk);
+                    for (size_t i = 0; i < chunkSize; ++i)
+                    {
+                        chunk[i] = static_cast<uint8_t>(written + i);
+                    }
+                    written += ringBuffer.Write(Aws::Crt::ByteCursorFromArray(chunk, chunkSize));
+                }
+            });
+
+        size_t mismatches = 0;
+        size_t read = 0;
+        uint8_t chunk[61];
+        while (read < totalBytes)
+        {
+            Aws::Crt::ByteBuf dest = Aws::Crt::ByteBufFromEmptyArray(chunk, sizeof(chunk));
+            size_t chunkSize = ringBuffer.Read(dest);
+            for (size_t i = 0; i < chunkSize; ++i)
+            {
+                mismatches += chunk[i] != static_cast<uint8_t>(read + i) ? 1 : 0;
+            }
+            read += chunkSize;
+        }
+
+        producer.join();
+        ASSERT_UINT_EQUALS(0, mismatches);
+        ASSERT_UINT_EQUALS(0, ringBuffer.GetSize());
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(SpscByteRingBufferProducerConsumer, s_SpscByteRingBufferProducerConsumer)
@@ -7,10 +7,13 @@
 #include <aws/crt/io/Stream.h>
 
 #include <aws/common/byte_buf.h>
+#include <aws/common/file.h>
 #include <aws/io/stream.h>
 
 #include <aws/testing/aws_test_harness.h>
 
+#include <algorithm>
+#include <cstdio>
 #include <sstream>
 
 static int s_StreamTestCreateDestroyWrapper(struct aws_allocator *allocator, void *ctx)
@@ -210,3 +213,286 @@ static int s_StreamTestRefcount(struct aws_allocator *allocator, void *ctx)
 }
 
 AWS_TEST_CASE(StreamTestRefcount, s_StreamTestRefcount)
+
+/* Stream over a fixed buffer that lends its memory, counting cursors not yet released */
+class LendingInputStream : public Aws::Crt::Io::InputStream
+{
+  public:
+    LendingInputStream(Aws::Crt::ByteCursor contents, Aws::Crt::Allocator *allocator)
+        : InputStream(allocator), m_contents(contents), m_position(0), m_outstandingCursors(0)
+    {
+    }
+
+    bool IsValid() const noexcept override { return true; }
+
+    size_t GetOutstandingCursorCount() const { return m_outstandingCursors; }
+
+  protected:
+    bool ReadImpl(Aws::Crt::ByteBuf &buffer) noexcept override
+    {
+        size_t length = (std::min)(buffer.capacity - buffer.len, m_contents.len - m_position);
+        aws_byte_buf_write(&buffer, m_contents.ptr + m_position, length);
+        m_position += length;
+        return true;
+    }
+
+    bool ReadSomeImpl(Aws::Crt::ByteBuf &buffer) noexcept override { return ReadImpl(buffer); }
+
+    Aws::Crt::Io::StreamStatus GetStatusImpl() const noexcept override
+    {
+        Aws::Crt::Io::StreamStatus status;
+        status.is_end_of_stream = m_position == m_contents.len;
+        status.is_valid = true;
+        return status;
+    }
+
+    int64_t GetLengthImpl() const noexcept override { return static_cast<int64_t>(m_contents.len); }
+
+    bool SeekImpl(int64_t offset, Aws::Crt::Io::StreamSeekBasis seekBasis) noexcept override
+    {
+        int64_t position = seekBasis == Aws::Crt::Io::StreamSeekBasis::Begin
+                               ? offset
+                               : static_cast<int64_t>(m_contents.len) + offset;
+        if (position < 0 || position > static_cast<int64_t>(m_contents.len))
+        {
+            aws_raise_error(AWS_IO_STREAM_INVALID_SEEK_POSITION);
+            return false;
+        }
+
+        m_position = static_cast<size_t>(position);
+        return true;
+    }
+
+    int64_t PeekImpl() const noexcept override { return 0; }
+
+    bool ReadCursorImpl(Aws::Crt::ByteCursor &cursor, size_t maxLength) noexcept override
+    {
+        size_t length = (std::min)(maxLength, m_contents.len - m_position);
+        cursor = aws_byte_cursor_from_array(m_contents.ptr + m_position, length);
+        m_position += length;
+        ++m_outstandingCursors;
+        return true;
+    }
+
+    void ReleaseCursorImpl(const Aws::Crt::ByteCursor &) noexcept override { --m_outstandingCursors; }
+
+  private:
+    Aws::Crt::ByteCursor m_contents;
+    size_t m_position;
+    size_t m_outstandingCursors;
+};
+
+static int s_StreamTestReadCursor(struct aws_allocator *allocator, void *ctx)
+{
+    (void)ctx;
+    {
+        Aws::Crt::ApiHandle apiHandle(allocator);
+
+        /* Streams that can't lend their memory say so */
+        auto stringStream = Aws::Crt::MakeShared<Aws::Crt::StringStream>(allocator, STREAM_CONTENTS);
+        Aws::Crt::Io::StdIOStreamInputStream wrappedStream(stringStream, allocator);
+        Aws::Crt::ByteCursor cursor;
+        ASSERT_FALSE(wrappedStream.ReadCursor(cursor, 4));
+        ASSERT_INT_EQUALS(AWS_ERROR_UNSUPPORTED_OPERATION, aws_last_error());
+
+        LendingInputStream lendingStream(aws_byte_cursor_from_c_str(STREAM_CONTENTS), allocator);
+        Aws::Crt::ByteCursor first;
+        Aws::Crt::ByteCursor second;
+        ASSERT_TRUE(lendingStream.ReadCursor(first, 4));
+        ASSERT_TRUE(lendingStream.ReadCursor(second, 256));
+        ASSERT_UINT_EQUALS(2, lendingStream.GetOutstandingCursorCount());
+
+        /* Cursors point into the stream's memory, one after the other */
+        ASSERT_BIN_ARRAYS_EQUALS(STREAM_CONTENTS, 4, first.ptr, first.len);
+        ASSERT_PTR_EQUALS(first.ptr + first.len, second.ptr);
+        ASSERT_UINT_EQUALS(strlen(STREAM_CONTENTS) - 4, second.len);
+
+        lendingStream.ReleaseCursor(first);
+        lendingStream.ReleaseCursor(second);
+        ASSERT_UINT_EQUALS(0, lendingStream.GetOutstandingCursorCount());
+
+        /* The end of the stream lends an empty cursor; seeking back makes the data available again */
+        ASSERT_TRUE(lendingStream.ReadCursor(cursor, 4));
+        ASSERT_UINT_EQUALS(0, cursor.len);
+        lendingStream.ReleaseCursor(cursor);
+
+        ASSERT_TRUE(lendingStream.Seek(0, Aws::Crt::Io::StreamSeekBasis::Begin));
+        ASSERT_TRUE(lendingStream.ReadCursor(cursor, 4));
+        ASSERT_BIN_ARRAYS_EQUALS(STREAM_CONTENTS, 4, cursor.ptr, cursor.len);
+        lendingStream.ReleaseCursor(cursor);
+        ASSERT_UINT_EQUALS(0, lendingStream.GetOutstandingCursorCount());
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(StreamTestReadCursor, s_StreamTestReadCursor)
+
+static bool s_WriteTestFile(const char *path, const char *contents, size_t length)
+{
+    FILE *file = aws_fopen(path, "wb");
+    if (file == nullptr)
+    {
+        return false;
+    }
+
+    bool written = fwrite(contents, 1, length, file) == length;
+    return fclose(file) == 0 && written;
+}
+
+static int s_CheckMmapFileContents(struct aws_allocator *allocator, const char *path, Aws::Crt::Io::FileReadMode mode)
+{
+    Aws::Crt::Io::MmapFileInputStream fileStream(path, mode, allocator);
+    ASSERT_TRUE(fileStream.IsValid());
+#if !defined(_WIN32)
+    ASSERT_TRUE(fileStream.IsMapped() == (mode != Aws::Crt::Io::FileReadMode::PositionalRead));
+#else
+    ASSERT_FALSE(fileStream.IsMapped());
+#endif
+
+    int64_t length = 0;
+    ASSERT_TRUE(fileStream.GetLength(length));
+    ASSERT_UINT_EQUALS(strlen(STREAM_CONTENTS), static_cast<uint64_t>(length));
+
+    uint8_t storage[4];
+    Aws::Crt::ByteBuf buffer = aws_byte_buf_from_empty_array(storage, sizeof(storage));
+    ASSERT_TRUE(fileStream.Read(buffer));
+    ASSERT_BIN_ARRAYS_EQUALS(STREAM_CONTENTS, 4, buffer.buffer, buffer.len);
+
+    /* Seeks are range checked against the file's length */
+    ASSERT_FALSE(fileStream.Seek(1, Aws::Crt::Io::StreamSeekBasis::End));
+    ASSERT_TRUE(fileStream.Seek(-4, Aws::Crt::Io::StreamSeekBasis::End));
+    buffer.len = 0;
+    ASSERT_TRUE(fileStream.Read(buffer));
+    ASSERT_BIN_ARRAYS_EQUALS("ents", 4, buffer.buffer, buffer.len);
+
+    Aws::Crt::Io::StreamStatus status;
+    ASSERT_TRUE(fileStream.GetStatus(status));
+    ASSERT_TRUE(status.is_end_of_stream);
+
+    /* Mapped files lend their pages; positional reads have nothing to lend */
+    ASSERT_TRUE(fileStream.Seek(4, Aws::Crt::Io::StreamSeekBasis::Begin));
+    Aws::Crt::ByteCursor cursor;
+    if (fileStream.IsMapped())
+    {
+        ASSERT_TRUE(fileStream.ReadCursor(cursor, 256));
+        ASSERT_BIN_ARRAYS_EQUALS(STREAM_CONTENTS + 4, strlen(STREAM_CONTENTS) - 4, cursor.ptr, cursor.len);
+        fileStream.ReleaseCursor(cursor);
+    }
+    else
+    {
+        ASSERT_FALSE(fileStream.ReadCursor(cursor, 256));
+        ASSERT_INT_EQUALS(AWS_ERROR_UNSUPPORTED_OPERATION, aws_last_error());
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+static int s_CheckMmapFileEmpty(struct aws_allocator *allocator, const char *path)
+{
+    /* There is nothing to map, so Auto falls back to positional reads */
+    Aws::Crt::Io::MmapFileInputStream fileStream(path, Aws::Crt::Io::FileReadMode::Auto, allocator);
+    ASSERT_TRUE(fileStream.IsValid());
+    ASSERT_FALSE(fileStream.IsMapped());
+
+    int64_t length = -1;
+    ASSERT_TRUE(fileStream.GetLength(length));
+    ASSERT_INT_EQUALS(0, length);
+
+    Aws::Crt::Io::StreamStatus status;
+    ASSERT_TRUE(fileStream.GetStatus(status));
+    ASSERT_TRUE(status.is_end_of_stream);
+
+    uint8_t storage[4];
+    Aws::Crt::ByteBuf buffer = aws_byte_buf_from_empty_array(storage, sizeof(storage));
+    ASSERT_TRUE(fileStream.Read(buffer));
+    ASSERT_UINT_EQUALS(0, buffer.len);
+
+    Aws::Crt::Io::MmapFileInputStream mappedStream(path, Aws::Crt::Io::FileReadMode::Mmap, allocator);
+    ASSERT_FALSE(mappedStream.IsValid());
+#if !defined(_WIN32)
+    ASSERT_INT_EQUALS(AWS_ERROR_INVALID_ARGUMENT, aws_last_error());
+#else
+    ASSERT_INT_EQUALS(AWS_ERROR_PLATFORM_NOT_SUPPORTED, aws_last_error());
+#endif
+
+    return AWS_OP_SUCCESS;
+}
+
+static int s_CheckMmapFileTruncated(struct aws_allocator *allocator, const char *path)
+{
+    Aws::Crt::Io::MmapFileInputStream fileStream(path, Aws::Crt::Io::FileReadMode::PositionalRead, allocator);
+    ASSERT_TRUE(fileStream.IsValid());
+
+    /* Truncating the file after it was opened makes the positional read come up short */
+    ASSERT_TRUE(s_WriteTestFile(path, STREAM_CONTENTS, 4));
+
+    uint8_t storage[64];
+    Aws::Crt::ByteBuf buffer = aws_byte_buf_from_empty_array(storage, sizeof(storage));
+    ASSERT_TRUE(fileStream.Read(buffer));
+    ASSERT_BIN_ARRAYS_EQUALS(STREAM_CONTENTS, 4, buffer.buffer, buffer.len);
+
+    /* The stream ends where the file now does */
+    int64_t length = 0;
+    ASSERT_TRUE(fileStream.GetLength(length));
+    ASSERT_INT_EQUALS(4, length);
+
+    Aws::Crt::Io::StreamStatus status;
+    ASSERT_TRUE(fileStream.GetStatus(status));
+    ASSERT_TRUE(status.is_end_of_stream);
+
+    return AWS_OP_SUCCESS;
+}
+
+static int s_StreamTestMmapFile(struct aws_allocator *allocator, void *ctx)
+{
+    (void)ctx;
+    {
+        Aws::Crt::ApiHandle apiHandle(allocator);
+
+        /* Each check runs on a fresh file that is removed whether or not the check passed */
+        const char *path = "stream_test_mmap_file.txt";
+        for (auto mode :
+             {Aws::Crt::Io::FileReadMode::Auto,
+              Aws::Crt::Io::FileReadMode::Mmap,
+              Aws::Crt::Io::FileReadMode::PositionalRead})
+        {
+#if defined(_WIN32)
+            if (mode == Aws::Crt::Io::FileReadMode::Mmap)
+            {
+                continue;
+            }
+#endif
+            ASSERT_TRUE(s_WriteTestFile(path, STREAM_CONTENTS, strlen(STREAM_CONTENTS)));
+            int result = s_CheckMmapFileContents(allocator, path, mode);
+            remove(path);
+            ASSERT_SUCCESS(result);
+        }
+
+#if defined(_WIN32)
+        ASSERT_TRUE(s_WriteTestFile(path, STREAM_CONTENTS, strlen(STREAM_CONTENTS)));
+        Aws::Crt::Io::MmapFileInputStream unsupportedStream(path, Aws::Crt::Io::FileReadMode::Mmap, allocator);
+        int lastError = aws_last_error();
+        remove(path);
+        ASSERT_FALSE(unsupportedStream.IsValid());
+        ASSERT_INT_EQUALS(AWS_ERROR_PLATFORM_NOT_SUPPORTED, lastError);
+#endif
+
+        ASSERT_TRUE(s_WriteTestFile(path, "", 0));
+        int emptyResult = s_CheckMmapFileEmpty(allocator, path);
+        remove(path);
+        ASSERT_SUCCESS(emptyResult);
+
+        ASSERT_TRUE(s_WriteTestFile(path, STREAM_CONTENTS, strlen(STREAM_CONTENTS)));
+        int truncatedResult = s_CheckMmapFileTruncated(allocator, path);
+        remove(path);
+        ASSERT_SUCCESS(truncatedResult);
+
+        Aws::Crt::Io::MmapFileInputStream missingStream(path, Aws::Crt::Io::FileReadMode::Auto, allocator);
+        ASSERT_FALSE(missingStream.IsValid());
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(StreamTestMmapFile, s_StreamTestMmapFile)
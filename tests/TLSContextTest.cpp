@@ -3,8 +3,14 @@
  * SPDX-License-Identifier: Apache-2.0.
  */
 #include <aws/crt/Api.h>
+#include <aws/crt/http/HttpConnection.h>
 
+#include <aws/io/channel_bootstrap.h>
+#include <aws/io/socket.h>
 #include <aws/testing/aws_test_harness.h>
+
+#include <condition_variable>
+#include <mutex>
 #include <utility>
 #if !BYO_CRYPTO
 static int s_TestTLSContextResourceSafety(Aws::Crt::Allocator *allocator, void *ctx)
@@ -51,4 +57,337 @@ static int s_TestTLSContextUninitializedNewConnectionOptions(Aws::Crt::Allocator
 }
 
 AWS_TEST_CASE(TLSContextUninitializedNewConnectionOptions, s_TestTLSContextUninitializedNewConnectionOptions)
+
+/*
+ * TLS server on 127.0.0.1 presenting the self-signed certificate in tests/resources/tls.  Accepted connections are
+ * left alone until the client closes them.
+ */
+class LocalTlsListener
+{
+  public:
+    LocalTlsListener(Aws::Crt::Allocator *allocator, Aws::Crt::Io::EventLoopGroup &eventLoopGroup) noexcept
+        : m_allocator(allocator), m_eventLoopGroup(eventLoopGroup), m_bootstrap(nullptr), m_listener(nullptr),
+          m_port(0), m_listenerDestroyed(false)
+    {
+    }
+
+    ~LocalTlsListener()
+    {
+        if (m_listener)
+        {
+            aws_server_bootstrap_destroy_socket_listener(m_bootstrap, m_listener);
+            std::unique_lock<std::mutex> lock(m_lock);
+            m_signal.wait(lock, [this]() { return m_listenerDestroyed; });
+        }
+
+        if (m_bootstrap)
+        {
+            aws_server_bootstrap_release(m_bootstrap);
+        }
+    }
+
+    bool Start() noexcept
+    {
+        Aws::Crt::Io::TlsContextOptions tlsCtxOptions =
+            Aws::Crt::Io::TlsContextOptions::InitClientWithMtls("tls/server.crt", "tls/server.key", m_allocator);
+        if (!tlsCtxOptions)
+        {
+            return false;
+        }
+        tlsCtxOptions.SetVerifyPeer(false);
+
+        m_tlsContext = Aws::Crt::Io::TlsContext(tlsCtxOptions, Aws::Crt::Io::TlsMode::SERVER, m_allocator);
+        if (!m_tlsContext)
+        {
+            return false;
+        }
+        Aws::Crt::Io::TlsConnectionOptions tlsConnectionOptions = m_tlsContext.NewConnectionOptions();
+
+        m_bootstrap = aws_server_bootstrap_new(m_allocator, m_eventLoopGroup.GetUnderlyingHandle());
+        if (!m_bootstrap)
+        {
+            return false;
+        }
+
+        Aws::Crt::Io::SocketOptions socketOptions;
+        socketOptions.SetConnectTimeoutMs(3000);
+
+        struct aws_server_socket_channel_bootstrap_options listenerOptions;
+        AWS_ZERO_STRUCT(listenerOptions);
+        listenerOptions.bootstrap = m_bootstrap;
+        listenerOptions.host_name = "127.0.0.1";
+        listenerOptions.port = 0;
+        listenerOptions.socket_options = &socketOptions.GetImpl();
+        listenerOptions.tls_options = tlsConnectionOptions.GetUnderlyingHandle();
+        listenerOptions.incoming_callback = s_onIncomingChannel;
+        listenerOptions.shutdown_callback = s_onIncomingChannel;
+        listenerOptions.destroy_callback = s_onListenerDestroyed;
+        listenerOptions.user_data = this;
+
+        m_listener = aws_server_bootstrap_new_socket_listener(&listenerOptions);
+        if (!m_listener)
+        {
+            return false;
+        }
+
+        struct aws_socket_endpoint endpoint;
+        AWS_ZERO_STRUCT(endpoint);
+        if (aws_socket_get_bound_address(m_listener, &endpoint))
+        {
+            return false;
+        }
+        m_port = endpoint.port;
+        return true;
+    }
+
+    uint32_t GetPort() const noexcept { return m_port; }
+
+  private:
+    static void s_onIncomingChannel(struct aws_server_bootstrap *, int, struct aws_channel *, void *) {}
+
+    static void s_onListenerDestroyed(struct aws_server_bootstrap *, void *userData)
+    {
+        auto *listener = static_cast<LocalTlsListener *>(userData);
+        std::lock_guard<std::mutex> lock(listener->m_lock);
+        listener->m_listenerDestroyed = true;
+        listener->m_signal.notify_one();
+    }
+
+    Aws::Crt::Allocator *m_allocator;
+    Aws::Crt::Io::EventLoopGroup &m_eventLoopGroup;
+    Aws::Crt::Io::TlsContext m_tlsContext;
+    struct aws_server_bootstrap *m_bootstrap;
+    struct aws_socket *m_listener;
+    uint32_t m_port;
+
+    std::mutex m_lock;
+    std::condition_variable m_signal;
+    bool m_listenerDestroyed;
+};
+
+/* Records the handshakes reported to a TlsContext's observer */
+struct HandshakeObserver
+{
+    void OnHandshakeCompleted(const Aws::Crt::Io::TlsHandshakeMetrics &handshakeMetrics)
+    {
+        std::lock_guard<std::mutex> lockGuard(lock);
+        metrics = handshakeMetrics;
+        ++handshakeCount;
+        signal.notify_one();
+    }
+
+    std::mutex lock;
+    std::condition_variable signal;
+    Aws::Crt::Io::TlsHandshakeMetrics metrics;
+    size_t handshakeCount = 0;
+};
+
+/*
+ * Opens an HTTP/1.1 connection with `tlsConnectionOptions` and closes it again once set up, waiting for the
+ * handshake to be reported to `observer`.
+ *
+ * @return the connection setup error code
+ */
+static int s_ConnectAndClose(
+    Aws::Crt::Allocator *allocator,
+    Aws::Crt::Io::ClientBootstrap &clientBootstrap,
+    const Aws::Crt::Io::TlsConnectionOptions &tlsConnectionOptions,
+    const Aws::Crt::String &hostName,
+    uint32_t port,
+    HandshakeObserver &observer)
+{
+    std::mutex lock;
+    std::condition_variable signal;
+    std::shared_ptr<Aws::Crt::Http::HttpClientConnection> connection;
+    bool setupCompleted = false;
+    int setupErrorCode = AWS_ERROR_SUCCESS;
+    bool connectionShutdown = false;
+
+    Aws::Crt::Io::SocketOptions socketOptions;
+    socketOptions.SetConnectTimeoutMs(5000);
+
+    Aws::Crt::Http::HttpClientConnectionOptions connectionOptions;
+    connectionOptions.Bootstrap = &clientBootstrap;
+    connectionOptions.OnConnectionSetupCallback =
+        [&](const std::shared_ptr<Aws::Crt::Http::HttpClientConnection> &newConnection, int errorCode)
+    {
+        std::lock_guard<std::mutex> lockGuard(lock);
+        connection = newConnection;
+        setupErrorCode = errorCode;
+        setupCompleted = true;
+        signal.notify_one();
+    };
+    connectionOptions.OnConnectionShutdownCallback = [&](Aws::Crt::Http::HttpClientConnection &, int)
+    {
+        std::lock_guard<std::mutex> lockGuard(lock);
+        connectionShutdown = true;
+        signal.notify_one();
+    };
+    connectionOptions.SocketOptions = socketOptions;
+    connectionOptions.TlsOptions = tlsConnectionOptions;
+    connectionOptions.HostName = hostName;
+    connectionOptions.Port = port;
+
+    if (!Aws::Crt::Http::HttpClientConnection::CreateConnection(connectionOptions, allocator))
+    {
+        return Aws::Crt::LastErrorOrUnknown();
+    }
+
+    {
+        std::unique_lock<std::mutex> uniqueLock(lock);
+        signal.wait(uniqueLock, [&]() { return setupCompleted; });
+    }
+
+    {
+        std::unique_lock<std::mutex> uniqueLock(observer.lock);
+        observer.signal.wait(uniqueLock, [&]() { return observer.handshakeCount > 0; });
+    }
+
+    if (connection)
+    {
+        connection->Close();
+        std::unique_lock<std::mutex> uniqueLock(lock);
+        signal.wait(uniqueLock, [&]() { return connectionShutdown; });
+    }
+
+    return setupErrorCode;
+}
+
+static int s_TestTLSContextHandshakeMetrics(Aws::Crt::Allocator *allocator, void *ctx)
+{
+    (void)ctx;
+    {
+        Aws::Crt::ApiHandle apiHandle(allocator);
+
+        Aws::Crt::Io::EventLoopGroup eventLoopGroup(1, allocator);
+        ASSERT_TRUE(eventLoopGroup);
+
+        Aws::Crt::Io::DefaultHostResolver defaultHostResolver(eventLoopGroup, 8, 30, allocator);
+        ASSERT_TRUE(defaultHostResolver);
+
+        Aws::Crt::Io::ClientBootstrap clientBootstrap(eventLoopGroup, defaultHostResolver, allocator);
+        ASSERT_TRUE(clientBootstrap);
+        clientBootstrap.EnableBlockingShutdown();
+
+        LocalTlsListener listener(allocator, eventLoopGroup);
+        ASSERT_TRUE(listener.Start());
+
+        Aws::Crt::Io::TlsContextOptions tlsCtxOptions = Aws::Crt::Io::TlsContextOptions::InitDefaultClient(allocator);
+        tlsCtxOptions.SetVerifyPeer(false);
+        Aws::Crt::Io::TlsContext tlsContext(tlsCtxOptions, Aws::Crt::Io::TlsMode::CLIENT, allocator);
+        ASSERT_TRUE(tlsContext);
+
+        /* Connections of an unobserved context don't report their handshakes at all */
+        Aws::Crt::Io::TlsConnectionOptions unobservedOptions = tlsContext.NewConnectionOptions();
+        ASSERT_TRUE(unobservedOptions);
+        ASSERT_NULL(unobservedOptions.GetUnderlyingHandle()->on_negotiation_result);
+
+        HandshakeObserver observer;
+        tlsContext.EnableHandshakeStatistics();
+        tlsContext.SetOnHandshakeCompleted([&](const Aws::Crt::Io::TlsHandshakeMetrics &metrics)
+                                           { observer.OnHandshakeCompleted(metrics); });
+
+        Aws::Crt::Io::TlsConnectionOptions tlsConnectionOptions = tlsContext.NewConnectionOptions();
+        ASSERT_TRUE(tlsConnectionOptions);
+        ASSERT_NOT_NULL(tlsConnectionOptions.GetUnderlyingHandle()->on_negotiation_result);
+
+        uint32_t port = listener.GetPort();
+        ASSERT_INT_EQUALS(
+            AWS_ERROR_SUCCESS,
+            s_ConnectAndClose(allocator, clientBootstrap, tlsConnectionOptions, "127.0.0.1", port, observer));
+        ASSERT_UINT_EQUALS(1, observer.handshakeCount);
+        ASSERT_INT_EQUALS(AWS_ERROR_SUCCESS, observer.metrics.ErrorCode);
+
+        Aws::Crt::Io::TlsHandshakeStatistics statistics = tlsContext.GetHandshakeStatistics();
+        ASSERT_UINT_EQUALS(1, statistics.SuccessCount);
+        ASSERT_UINT_EQUALS(0, statistics.FailureCount);
+        ASSERT_UINT_EQUALS(1, statistics.NegotiatedProtocolCounts[observer.metrics.NegotiatedProtocol]);
+        size_t expectedLatencySamples = observer.metrics.HandshakeDurationNs > 0 ? 1 : 0;
+        ASSERT_UINT_EQUALS(expectedLatencySamples, statistics.HandshakeLatency.GetSampleCount());
+
+        /*
+         * The listener's self-signed certificate fails verification.  The failure is still reported after every copy
+         * of the context is gone, since the connection options hold on to its handshake metrics.
+         */
+        HandshakeObserver verifyingObserver;
+        Aws::Crt::Io::TlsConnectionOptions verifyingOptions;
+        {
+            Aws::Crt::Io::TlsContextOptions verifyingCtxOptions =
+                Aws::Crt::Io::TlsContextOptions::InitDefaultClient(allocator);
+            Aws::Crt::Io::TlsContext verifyingContext(verifyingCtxOptions, Aws::Crt::Io::TlsMode::CLIENT, allocator);
+            ASSERT_TRUE(verifyingContext);
+            verifyingContext.SetOnHandshakeCompleted([&](const Aws::Crt::Io::TlsHandshakeMetrics &metrics)
+                                                     { verifyingObserver.OnHandshakeCompleted(metrics); });
+            verifyingOptions = verifyingContext.NewConnectionOptions();
+        }
+        ASSERT_TRUE(verifyingOptions);
+
+        ASSERT_TRUE(
+            AWS_ERROR_SUCCESS !=
+            s_ConnectAndClose(allocator, clientBootstrap, verifyingOptions, "127.0.0.1", port, verifyingObserver));
+        ASSERT_UINT_EQUALS(1, verifyingObserver.handshakeCount);
+        ASSERT_TRUE(verifyingObserver.metrics.ErrorCode != AWS_ERROR_SUCCESS);
+        ASSERT_TRUE(verifyingObserver.metrics.NegotiatedProtocol.empty());
+
+        /* The failure was reported to the other context only */
+        ASSERT_UINT_EQUALS(1, tlsContext.GetHandshakeStatistics().SuccessCount);
+        ASSERT_UINT_EQUALS(0, tlsContext.GetHandshakeStatistics().FailureCount);
+    }
+
+    return AWS_ERROR_SUCCESS;
+}
+
+AWS_TEST_CASE(TLSContextHandshakeMetrics, s_TestTLSContextHandshakeMetrics)
+
+static int s_TestTLSContextHandshakeMetricsRemotePeer(Aws::Crt::Allocator *allocator, void *ctx)
+{
+    (void)ctx;
+    {
+        Aws::Crt::ApiHandle apiHandle(allocator);
+        Aws::Crt::Io::TlsContextOptions tlsCtxOptions = Aws::Crt::Io::TlsContextOptions::InitDefaultClient();
+        Aws::Crt::Io::TlsContext tlsContext(tlsCtxOptions, Aws::Crt::Io::TlsMode::CLIENT, allocator);
+        ASSERT_TRUE(tlsContext);
+
+        HandshakeObserver observer;
+        tlsContext.EnableHandshakeStatistics();
+        tlsContext.SetOnHandshakeCompleted([&](const Aws::Crt::Io::TlsHandshakeMetrics &metrics)
+                                           { observer.OnHandshakeCompleted(metrics); });
+
+        Aws::Crt::Io::TlsConnectionOptions tlsConnectionOptions = tlsContext.NewConnectionOptions();
+
+        Aws::Crt::ByteCursor hostName = Aws::Crt::ByteCursorFromCString("aws-crt-test-stuff.s3.amazonaws.com");
+        tlsConnectionOptions.SetServerName(hostName);
+        if (Aws::Crt::Io::TlsContextOptions::IsAlpnSupported())
+        {
+            tlsConnectionOptions.SetAlpnList("http/1.1");
+        }
+
+        Aws::Crt::Io::EventLoopGroup eventLoopGroup(0, allocator);
+        ASSERT_TRUE(eventLoopGroup);
+
+        Aws::Crt::Io::DefaultHostResolver defaultHostResolver(eventLoopGroup, 8, 30, allocator);
+        ASSERT_TRUE(defaultHostResolver);
+
+        Aws::Crt::Io::ClientBootstrap clientBootstrap(eventLoopGroup, defaultHostResolver, allocator);
+        ASSERT_TRUE(clientBootstrap);
+        clientBootstrap.EnableBlockingShutdown();
+
+        Aws::Crt::String hostNameString((const char *)hostName.ptr, hostName.len);
+        ASSERT_INT_EQUALS(
+            AWS_ERROR_SUCCESS,
+            s_ConnectAndClose(allocator, clientBootstrap, tlsConnectionOptions, hostNameString, 443, observer));
+        ASSERT_INT_EQUALS(AWS_ERROR_SUCCESS, observer.metrics.ErrorCode);
+
+        Aws::Crt::Io::TlsHandshakeStatistics statistics = tlsContext.GetHandshakeStatistics();
+        ASSERT_UINT_EQUALS(1, statistics.SuccessCount);
+        ASSERT_UINT_EQUALS(0, statistics.FailureCount);
+        ASSERT_UINT_EQUALS(1, statistics.NegotiatedProtocolCounts[observer.metrics.NegotiatedProtocol]);
+        size_t expectedLatencySamples = observer.metrics.HandshakeDurationNs > 0 ? 1 : 0;
+        ASSERT_UINT_EQUALS(expectedLatencySamples, statistics.HandshakeLatency.GetSampleCount());
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(TLSContextHandshakeMetricsRemotePeer, s_TestTLSContextHandshakeMetricsRemotePeer)
 #endif // !BYO_CRYPTO